@@ -13,3 +13,4 @@ CFLAG:=\
 -Weverything -Wall -Wextra -Wno-c++98-compat -Wno-c++98-compat-pedantic -Wno-padded -Wno-zero-as-null-pointer-constant \
 
 LFLAG:=\
+-pthread \
@@ -3,4 +3,7 @@ ROOT:=$(CURDIR)
 
 DEFAULT_CONFIG:=MinGW-Debug
 PROJECT_NAME:=PROJECT
-SOURCE_DIRECTORY:=src
+SRC:=src
+BENCH:=bench
+AUDIT:=audit
+BENCH_NAME:=BENCH
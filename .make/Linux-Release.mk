@@ -0,0 +1,16 @@
+COMPILER:=g++
+EXECUTABLE_SHELL:=
+
+BIN:=bin/Linux
+BUILD:=Release
+PROJECT_NAME_PREFIX:=
+PROJECT_NAME_POSTFIX:=
+ARG:=
+
+CFLAG:=\
+-std=c++20 \
+-DNDEBUG -O3 \
+-Wall -Wextra -Wpedantic \
+
+LFLAG:=\
+-pthread \
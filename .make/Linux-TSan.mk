@@ -0,0 +1,16 @@
+COMPILER:=g++
+EXECUTABLE_SHELL:=
+
+BIN:=bin/Linux
+BUILD:=TSan
+PROJECT_NAME_PREFIX:=
+PROJECT_NAME_POSTFIX:=
+ARG:=
+
+CFLAG:=\
+-std=c++20 \
+-D_DEBUG -O1 -g -fsanitize=thread \
+-Wall -Wextra -Wpedantic \
+
+LFLAG:=\
+-pthread -fsanitize=thread \
@@ -0,0 +1,164 @@
+#include <cstddef>
+#include <cmath>
+#include <compare>
+#include "MathVector.hpp"
+#include "MathVectorN.hpp"
+#include "MathVectorSwizzle.hpp"
+#include "MathVectorTransform.hpp"
+
+/*
+ * Codegen audit: each operation is written twice, once against a plain struct the way one would by hand ('ref_*'),
+ * and once through ink::Vec ('vec_*'). This file is only compiled to an object and disassembled;
+ * codegen_audit.sh then checks that every pair lowers to the same number of instructions and calls.
+ *
+ * The functions take and return through pointers so that no ABI difference between the two types can show up
+ * in the comparison, only the code of the operation itself.
+ */
+
+namespace {
+
+	template<typename T>
+	struct Plain { T x, y, z; };
+
+	template<typename T>
+	struct Plain2 { T x, y; };
+
+	template<typename T>
+	struct Plain4 { T x, y, z, w; };
+
+	template<typename T>
+	struct PlainAffine { Plain<Plain<T>> m; Plain<T> t; };
+
+	// A multiply-add as written by hand: std::fma where the target has it as an instruction, the plain expression otherwise.
+	template<typename T>
+	T
+	ref_fma(T a, T b, T c) {
+		#if defined(FP_FAST_FMAF) && defined(FP_FAST_FMA)
+		if constexpr(std::is_floating_point_v<T>) return std::fma(a, b, c);
+		#endif
+		return a * b + c;
+	}
+
+	template<typename T> using V = ink::Vec<T>;
+	template<typename T> using V2 = ink::Vec<T, T, void>;
+	template<typename T> using VN3 = ink::VecN<T, T, T>;
+	template<typename T> using VN4 = ink::VecN<T, T, T, T>;
+
+}
+
+#define INK_AUDIT_PAIR(name, type, ref_result, vec_result, ref_body, vec_body) \
+	extern "C" void ref_##name([[maybe_unused]] Plain<type> const* a, [[maybe_unused]] Plain<type> const* b, ref_result* o) { ref_body; } \
+	extern "C" void vec_##name([[maybe_unused]] V<type> const* a, [[maybe_unused]] V<type> const* b, vec_result* o) { vec_body; }
+
+#define INK_AUDIT_ARITHMETIC(suffix, type) \
+	INK_AUDIT_PAIR(add_##suffix, type, Plain<type>, V<type>, \
+		(*o = { a->x + b->x, a->y + b->y, a->z + b->z }), (*o = *a + *b)) \
+	INK_AUDIT_PAIR(sub_##suffix, type, Plain<type>, V<type>, \
+		(*o = { a->x - b->x, a->y - b->y, a->z - b->z }), (*o = *a - *b)) \
+	INK_AUDIT_PAIR(mul_##suffix, type, Plain<type>, V<type>, \
+		(*o = { a->x * b->x, a->y * b->y, a->z * b->z }), (*o = *a * *b)) \
+	INK_AUDIT_PAIR(div_##suffix, type, Plain<type>, V<type>, \
+		(*o = { a->x / b->x, a->y / b->y, a->z / b->z }), (*o = *a / *b)) \
+	INK_AUDIT_PAIR(mul_scalar_##suffix, type, Plain<type>, V<type>, \
+		(*o = { a->x * b->x, a->y * b->x, a->z * b->x }), (*o = *a * b->x)) \
+	INK_AUDIT_PAIR(scalar_mul_##suffix, type, Plain<type>, V<type>, \
+		(*o = { b->x * a->x, b->x * a->y, b->x * a->z }), (*o = b->x * *a)) \
+	INK_AUDIT_PAIR(div_scalar_##suffix, type, Plain<type>, V<type>, \
+		(*o = { a->x / b->x, a->y / b->x, a->z / b->x }), (*o = *a / b->x)) \
+	INK_AUDIT_PAIR(neg_##suffix, type, Plain<type>, V<type>, \
+		(*o = { -a->x, -a->y, -a->z }), (*o = -*a)) \
+	INK_AUDIT_PAIR(add_assign_##suffix, type, Plain<type>, V<type>, \
+		(o->x += a->x, o->y += a->y, o->z += a->z), (*o += *a)) \
+	INK_AUDIT_PAIR(mul_assign_scalar_##suffix, type, Plain<type>, V<type>, \
+		(o->x *= b->x, o->y *= b->x, o->z *= b->x), (*o *= b->x)) \
+	INK_AUDIT_PAIR(eq_##suffix, type, Plain<bool>, V<bool>, \
+		(*o = { a->x == b->x, a->y == b->y, a->z == b->z }), (*o = *a == *b)) \
+	INK_AUDIT_PAIR(lt_##suffix, type, Plain<bool>, V<bool>, \
+		(*o = { a->x < b->x, a->y < b->y, a->z < b->z }), (*o = *a < *b)) \
+	INK_AUDIT_PAIR(dot_##suffix, type, type, type, \
+		(*o = (a->x * b->x) + (a->y * b->y) + (a->z * b->z)), (*o = a->dot(*b))) \
+	INK_AUDIT_PAIR(mag2_##suffix, type, type, type, \
+		(*o = (a->x * a->x) + (a->y * a->y) + (a->z * a->z)), (*o = a->mag2())) \
+	INK_AUDIT_PAIR(cross_##suffix, type, Plain<type>, V<type>, \
+		(*o = { (a->y * b->z) - (a->z * b->y), (a->z * b->x) - (a->x * b->z), (a->x * b->y) - (a->y * b->x) }), (*o = a->cross(*b))) \
+	INK_AUDIT_PAIR(fma_##suffix, type, Plain<type>, V<type>, \
+		(*o = { ref_fma(a->x, b->x, o->x), ref_fma(a->y, b->y, o->y), ref_fma(a->z, b->z, o->z) }), (*o = fma(*a, *b, *o))) \
+	INK_AUDIT_PAIR(axpy_##suffix, type, Plain<type>, V<type>, \
+		(*o = { ref_fma(a->x, b->x, o->x), ref_fma(a->y, b->x, o->y), ref_fma(a->z, b->x, o->z) }), (*o = axpy(b->x, *a, *o))) \
+	INK_AUDIT_PAIR(dot_fma_##suffix, type, type, type, \
+		(*o = ref_fma(a->x, b->x, ref_fma(a->y, b->y, a->z * b->z))), (*o = a->dot_fma(*b)))
+
+INK_AUDIT_ARITHMETIC(int, int)
+INK_AUDIT_ARITHMETIC(float, float)
+INK_AUDIT_ARITHMETIC(double, double)
+
+INK_AUDIT_PAIR(mod_int, int, Plain<int>, V<int>,
+	(*o = { a->x % b->x, a->y % b->y, a->z % b->z }), (*o = *a % *b))
+INK_AUDIT_PAIR(and_int, int, Plain<int>, V<int>,
+	(*o = { a->x & b->x, a->y & b->y, a->z & b->z }), (*o = *a & *b))
+INK_AUDIT_PAIR(xor_scalar_int, int, Plain<int>, V<int>,
+	(*o = { a->x ^ b->x, a->y ^ b->x, a->z ^ b->x }), (*o = *a ^ b->x))
+INK_AUDIT_PAIR(shr_scalar_int, int, Plain<int>, V<int>,
+	(*o = { a->x >> b->x, a->y >> b->x, a->z >> b->x }), (*o = *a >> b->x))
+INK_AUDIT_PAIR(not_int, int, Plain<int>, V<int>,
+	(*o = { ~a->x, ~a->y, ~a->z }), (*o = ~*a))
+
+// A 'void' axis must cost nothing at all.
+extern "C" void ref_add_void_float(Plain2<float> const* a, Plain2<float> const* b, Plain2<float>* o) { *o = { a->x + b->x, a->y + b->y }; }
+extern "C" void vec_add_void_float(V2<float> const* a, V2<float> const* b, V2<float>* o) { *o = *a + *b; }
+
+extern "C" void ref_mul_scalar_void_float(Plain2<float> const* a, float const* s, Plain2<float>* o) { *o = { a->x * *s, a->y * *s }; }
+extern "C" void vec_mul_scalar_void_float(V2<float> const* a, float const* s, V2<float>* o) { *o = *a * *s; }
+
+extern "C" void ref_dot_void_float(Plain2<float> const* a, Plain2<float> const* b, float* o) { *o = (a->x * b->x) + (a->y * b->y); }
+extern "C" void vec_dot_void_float(V2<float> const* a, V2<float> const* b, float* o) { *o = a->dot(*b); }
+
+// Transforms, against the row by row expressions of a column-major matrix.
+extern "C" void ref_mat3_mul_float(Plain<Plain<float>> const* m, Plain<float> const* v, Plain<float>* o) {
+	*o = {
+		m->x.x * v->x + m->y.x * v->y + m->z.x * v->z,
+		m->x.y * v->x + m->y.y * v->y + m->z.y * v->z,
+		m->x.z * v->x + m->y.z * v->y + m->z.z * v->z };
+}
+extern "C" void vec_mat3_mul_float(ink::Mat3<float> const* m, V<float> const* v, V<float>* o) { *o = *m * *v; }
+
+extern "C" void ref_affine_point_float(PlainAffine<float> const* a, Plain<float> const* v, Plain<float>* o) {
+	*o = {
+		a->m.x.x * v->x + a->m.y.x * v->y + a->m.z.x * v->z + a->t.x,
+		a->m.x.y * v->x + a->m.y.y * v->y + a->m.z.y * v->z + a->t.y,
+		a->m.x.z * v->x + a->m.y.z * v->y + a->m.z.z * v->z + a->t.z };
+}
+extern "C" void vec_affine_point_float(ink::Affine<float> const* m, V<float> const* v, V<float>* o) { *o = m->transform_point(*v); }
+
+extern "C" void ref_mat3_mul_void_float(Plain<Plain<float>> const* m, Plain2<float> const* v, Plain2<float>* o) {
+	*o = { m->x.x * v->x + m->y.x * v->y, m->x.y * v->x + m->y.y * v->y };
+}
+extern "C" void vec_mat3_mul_void_float(ink::Mat3<float> const* m, V2<float> const* v, V2<float>* o) { *o = *m * *v; }
+
+// VecN unrolls its folds to the same code as the hand-written axes, at any size.
+extern "C" void ref_vecn_add_float(Plain<float> const* a, Plain<float> const* b, Plain<float>* o) { *o = { a->x + b->x, a->y + b->y, a->z + b->z }; }
+extern "C" void vec_vecn_add_float(VN3<float> const* a, VN3<float> const* b, VN3<float>* o) { *o = *a + *b; }
+
+extern "C" void ref_vecn_dot_float(Plain<float> const* a, Plain<float> const* b, float* o) { *o = (a->x * b->x) + (a->y * b->y) + (a->z * b->z); }
+extern "C" void vec_vecn_dot_float(VN3<float> const* a, VN3<float> const* b, float* o) { *o = a->dot(*b); }
+
+extern "C" void ref_vecn4_mul_scalar_float(Plain4<float> const* a, float const* s, Plain4<float>* o) { *o = { a->x * *s, a->y * *s, a->z * *s, a->w * *s }; }
+extern "C" void vec_vecn4_mul_scalar_float(VN4<float> const* a, float const* s, VN4<float>* o) { *o = *a * *s; }
+
+extern "C" void ref_vecn4_dot_float(Plain4<float> const* a, Plain4<float> const* b, float* o) {
+	*o = (a->x * b->x) + (a->y * b->y) + (a->z * b->z) + (a->w * b->w);
+}
+extern "C" void vec_vecn4_dot_float(VN4<float> const* a, VN4<float> const* b, float* o) { *o = a->dot(*b); }
+
+// Swizzles only rename registers, or shuffle them once.
+extern "C" void ref_swizzle_zyx_float(Plain<float> const* a, Plain<float>* o) { *o = { a->z, a->y, a->x }; }
+extern "C" void vec_swizzle_zyx_float(V<float> const* a, V<float>* o) { *o = ink::swizzle<"zyx">(*a); }
+
+extern "C" void ref_swizzle_zx_float(Plain<float> const* a, Plain2<float>* o) { *o = { a->z, a->x }; }
+extern "C" void vec_swizzle_zx_float(V<float> const* a, V2<float>* o) { *o = ink::swizzle<"zx">(*a); }
+
+extern "C" void ref_swizzle_add_float(Plain<float> const* a, Plain<float> const* b, Plain<float>* o) { *o = { a->y + b->x, a->z + b->y, a->x + b->z }; }
+extern "C" void vec_swizzle_add_float(V<float> const* a, V<float> const* b, V<float>* o) { *o = ink::swizzle<"yzx">(*a) + *b; }
+
+extern "C" void ref_swizzle_ref_float(Plain<float> const* a, Plain<float>* o) { o->z = a->x; o->x = a->y; }
+extern "C" void vec_swizzle_ref_float(V<float> const* a, V<float>* o) { ink::swizzle_ref<"zx">(*o) = *a; }
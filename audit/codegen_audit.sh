@@ -0,0 +1,50 @@
+#!/bin/sh
+# Compiles audit/codegen.cpp, disassembles it, and compares every 'ref_<name>' function against its 'vec_<name>' twin.
+# Fails when a pair differs in instruction count, or when one of them calls something the other does not.
+#
+# usage: codegen_audit.sh <compiler> <include dir> <object file> [compiler flags...]
+# The object dumper defaults to 'objdump', override it with the OBJDUMP environment variable.
+
+set -eu
+
+COMPILER=$1
+INCLUDE=$2
+OBJECT=$3
+shift 3
+
+AUDIT_DIR=$(dirname "$0")
+OBJDUMP=${OBJDUMP:-objdump}
+
+"$COMPILER" -c "$AUDIT_DIR/codegen.cpp" -I"$INCLUDE" -o "$OBJECT" "$@"
+
+# One line per function: '<name> <instructions> <calls>'. Alignment padding (nops) is not counted.
+"$OBJDUMP" -d --no-show-raw-insn "$OBJECT" | awk '
+	/^[0-9a-f]+ <.*>:$/ {
+		name = $2; gsub(/[<>:]/, "", name)
+		order[++n] = name; insns[name] = 0; calls[name] = 0
+		next
+	}
+	name != "" && /^ *[0-9a-f]+:\t/ {
+		split($0, cols, "\t"); op = cols[2]; sub(/ .*/, "", op)
+		if (op == "" || op ~ /^(nop|nopw|nopl|xchg|data16|cs)/) next
+		insns[name]++
+		if (op ~ /^call/ || cols[2] ~ /^jmp +[0-9a-f]+ </) calls[name]++
+	}
+	END { for (i = 1; i <= n; i++) print order[i], insns[order[i]], calls[order[i]] }
+' | awk '
+	{ insns[$1] = $2; calls[$1] = $3; if ($1 ~ /^ref_/) refs[++n] = substr($1, 5) }
+	END {
+		failed = 0
+		printf "%-28s %8s %8s %8s %8s\n", "Operation", "ref", "vec", "ref call", "vec call"
+		for (i = 1; i <= n; i++) {
+			op = refs[i]
+			if (!(("vec_" op) in insns)) { printf "%-28s missing vec_%s\n", op, op; failed = 1; continue }
+			r = insns["ref_" op]; v = insns["vec_" op]; rc = calls["ref_" op]; vc = calls["vec_" op]
+			status = (r == v && (rc > 0) == (vc > 0)) ? "" : "  MISMATCH"
+			if (status != "") failed = 1
+			printf "%-28s %8d %8d %8d %8d%s\n", op, r, v, rc, vc, status
+		}
+		if (n == 0) { print "no ref_* functions found"; failed = 1 }
+		exit failed
+	}
+'
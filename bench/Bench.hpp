@@ -0,0 +1,171 @@
+#ifndef INK_GENERIC_VEC_BENCH_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_BENCH_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define INK_GENERIC_VEC_BENCH_TSC
+#include <x86intrin.h>
+#endif
+
+/*
+ * Minimal micro-benchmark harness, in the spirit of Google Benchmark, with no dependency beyond the standard library.
+ *
+ * A benchmark is a callable running one pass over 'n' elements. The harness repeats passes until the minimum time
+ * is reached, and reports the time per element (ns/op), time stamp counter ticks per element (cycles/op) and the
+ * memory throughput implied by the bytes each element reads and writes (GB/s).
+ *
+ * Cycles are read from the TSC, which ticks at a fixed reference frequency: on CPUs that boost or throttle, cycles/op
+ * is proportional to, but not exactly equal to, core clock cycles. It reads as '-' where no TSC is available.
+ */
+namespace ink::bench {
+
+	// Keeps the compiler from optimizing away the computation that produced the memory at 'p'.
+	template<typename T>
+	inline void
+	escape(T const* p)
+	noexcept {
+		#if defined(__GNUC__)
+		asm volatile("" : : "g"(p) : "memory");
+		#else
+		static T const* volatile sink;
+		sink = p;
+		#endif
+	}
+
+	inline std::uint64_t
+	ticks()
+	noexcept {
+		#ifdef INK_GENERIC_VEC_BENCH_TSC
+		return __rdtsc();
+		#else
+		return 0;
+		#endif
+	}
+
+	// Working set sizes, picked to land in each level of a typical cache hierarchy.
+	struct Footprint {
+		char const* name;
+		std::size_t bytes;
+	};
+
+	inline constexpr Footprint footprints[] = {
+		{ "L1",   16u << 10 },
+		{ "L2",  256u << 10 },
+		{ "L3",    4u << 20 },
+		{ "DRAM", 64u << 20 },
+	};
+
+	struct Options {
+		std::string filter;
+		double min_seconds = 0.05;
+		bool csv = false;
+		bool list = false;
+	};
+
+	class Runner {
+
+		private: Options M_options;
+		private: std::size_t M_count = 0;
+
+		public: explicit
+		Runner(Options options)
+		: M_options(std::move(options)) {}
+
+		// Whether a benchmark named 'name' is selected by the filter.
+		public: bool
+		selected(std::string_view name) const
+		noexcept { return M_options.filter.empty() || name.find(M_options.filter) != std::string_view::npos; }
+
+		public: void
+		header() const {
+			if (M_options.list) return;
+			if (M_options.csv) std::printf("name,footprint,items,ns_per_op,cycles_per_op,gb_per_s\n");
+			else std::printf("%-48s %-5s %10s %10s %10s %10s\n", "Benchmark", "Set", "Items", "ns/op", "cycles/op", "GB/s");
+		}
+
+		/**
+		 * Runs 'body(n)' repeatedly and prints one result line.
+		 * 'bytes_per_op' is the memory traffic of a single element, reads and writes combined.
+		 */
+		public: template<typename Body>
+		void
+		run(std::string_view name, Footprint const& footprint, std::size_t n, std::size_t bytes_per_op, Body&& body) {
+			if (!selected(name)) return;
+			++M_count;
+			if (M_options.list) { std::printf("%.*s/%s\n", int(name.size()), name.data(), footprint.name); return; }
+
+			using clock = std::chrono::steady_clock;
+
+			// Warm up caches, page tables and branch predictors.
+			body(n);
+
+			std::size_t passes = 1;
+			double seconds = 0;
+			std::uint64_t cycles = 0;
+			for (;;) {
+				const auto t0 = clock::now();
+				const auto c0 = ticks();
+				for (std::size_t p = 0; p < passes; ++p) body(n);
+				const auto c1 = ticks();
+				const auto t1 = clock::now();
+
+				seconds = std::chrono::duration<double>(t1 - t0).count();
+				cycles = c1 - c0;
+				if (seconds >= M_options.min_seconds) break;
+				passes *= seconds > 0 ? std::max<std::size_t>(2, std::size_t(1.4 * M_options.min_seconds / seconds)) : 10;
+			}
+
+			const double ops = double(passes) * double(n);
+			const double ns = seconds * 1e9 / ops;
+			const double gbps = double(bytes_per_op) * ops / seconds / 1e9;
+
+			char cyc[32] = "-";
+			#ifdef INK_GENERIC_VEC_BENCH_TSC
+			std::snprintf(cyc, sizeof(cyc), "%.2f", double(cycles) / ops);
+			#else
+			(void)cycles;
+			#endif
+
+			if (M_options.csv) std::printf("%.*s,%s,%zu,%.4f,%s,%.3f\n", int(name.size()), name.data(), footprint.name, n, ns, cyc, gbps);
+			else std::printf("%-48.*s %-5s %10zu %10.3f %10s %10.2f\n", int(name.size()), name.data(), footprint.name, n, ns, cyc, gbps);
+			std::fflush(stdout);
+		}
+
+		// Number of benchmarks that were selected so far.
+		public: std::size_t
+		count() const
+		noexcept { return M_count; }
+
+	};
+
+	// Parses '--filter=<substring>', '--min-time=<seconds>', '--csv' and '--list'.
+	inline Options
+	parse_options(int argc, char const* const* argv) {
+		Options options;
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view arg = argv[i];
+			if		(arg.starts_with("--filter=")) options.filter = arg.substr(9);
+			else if	(arg.starts_with("--min-time=")) options.min_seconds = std::atof(argv[i] + 11);
+			else if	(arg == "--csv") options.csv = true;
+			else if	(arg == "--list") options.list = true;
+			else {
+				std::fprintf(stderr, "usage: %s [--filter=<substring>] [--min-time=<seconds>] [--csv] [--list]\n", argv[0]);
+				std::exit(2);
+			}
+		}
+		return options;
+	}
+
+}
+
+#endif
@@ -0,0 +1,729 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Bench.hpp"
+#include "MathVector.hpp"
+#include "MathVectorArena.hpp"
+#include "MathVectorCompact.hpp"
+#include "MathVectorExpr.hpp"
+#include "MathVectorFile.hpp"
+#include "MathVectorGrid.hpp"
+#include "MathVectorMask.hpp"
+#include "MathVectorN.hpp"
+#include "MathVectorPadded.hpp"
+#include "MathVectorParallel.hpp"
+#include "MathVectorSoA.hpp"
+#include "MathVectorSpatial.hpp"
+#include "MathVectorStream.hpp"
+#include "MathVectorSum.hpp"
+#include "MathVectorSwizzle.hpp"
+#include "MathVectorTransform.hpp"
+#include "MathVectorSimd.hpp"
+
+using ink::bench::Runner;
+using ink::bench::footprints;
+using ink::bench::escape;
+
+namespace {
+
+	// Small, non-zero values, so that division, modulo and shifts stay well defined.
+	template<typename T>
+	void
+	fill_axis(T& axis, std::size_t k)
+	{ axis = static_cast<T>(k); }
+
+	void
+	fill_axis(ink::NoState const&, std::size_t)
+	{}
+
+	template<typename V>
+	V
+	sample(std::size_t i) {
+		V v;
+		if constexpr(ink::generic_vec::detail::is_vec_n<V>) {
+			[&]<std::size_t... a>(std::index_sequence<a...>) {
+				constexpr std::size_t primes[] = { 7, 11, 13, 17, 19, 23, 29, 31 };
+				(fill_axis(v.template get<a>(), i % primes[a % 8] + 1), ...);
+			}(std::make_index_sequence<V::size>{});
+		} else {
+			fill_axis(v.x, i % 7 + 1);
+			fill_axis(v.y, i % 11 + 1);
+			fill_axis(v.z, i % 13 + 1);
+		}
+		return v;
+	}
+
+	template<typename V>
+	std::vector<V>
+	samples(std::size_t n, std::size_t seed) {
+		std::vector<V> out;
+		out.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) out.push_back(sample<V>(i + seed));
+		return out;
+	}
+
+	std::string
+	name_of(std::string_view group, std::string_view op)
+	{ return std::string(group) + "/" + std::string(op); }
+
+
+
+	// out[i] = op(a[i], b[i]). Skipped where 'op' is not defined for V.
+	template<typename V, typename Op>
+	void
+	bench_binary(Runner& runner, std::string_view group, std::string_view op_name, Op op) {
+		if constexpr(std::is_invocable_v<Op, V const&, V const&>) {
+			using R = std::remove_cvref_t<std::invoke_result_t<Op, V const&, V const&>>;
+			const std::string name = name_of(group, op_name);
+			if (!runner.selected(name)) return;
+
+			const std::size_t bytes = 2 * sizeof(V) + sizeof(R);
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / bytes;
+				const auto a = samples<V>(n, 0), b = samples<V>(n, 3);
+				std::vector<R> out(n, op(a[0], b[0]));
+				runner.run(name, fp, n, bytes, [&](std::size_t count) {
+					for (std::size_t i = 0; i < count; ++i) out[i] = op(a[i], b[i]);
+					escape(out.data());
+				});
+			}
+		}
+	}
+
+	// out[i] = op(a[i]). Skipped where 'op' is not defined for V.
+	template<typename V, typename Op>
+	void
+	bench_unary(Runner& runner, std::string_view group, std::string_view op_name, Op op) {
+		if constexpr(std::is_invocable_v<Op, V const&>) {
+			using R = std::remove_cvref_t<std::invoke_result_t<Op, V const&>>;
+			const std::string name = name_of(group, op_name);
+			if (!runner.selected(name)) return;
+
+			const std::size_t bytes = sizeof(V) + sizeof(R);
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / bytes;
+				const auto a = samples<V>(n, 0);
+				std::vector<R> out(n, op(a[0]));
+				runner.run(name, fp, n, bytes, [&](std::size_t count) {
+					for (std::size_t i = 0; i < count; ++i) out[i] = op(a[i]);
+					escape(out.data());
+				});
+			}
+		}
+	}
+
+	// out[i] = a[i]; op(out[i], b[i]). Restarting from 'a' on every pass keeps values from drifting.
+	template<typename V, typename Op>
+	void
+	bench_compound(Runner& runner, std::string_view group, std::string_view op_name, Op op) {
+		if constexpr(std::is_invocable_v<Op, V&, V const&>) {
+			const std::string name = name_of(group, op_name);
+			if (!runner.selected(name)) return;
+
+			const std::size_t bytes = 3 * sizeof(V);
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / bytes;
+				const auto a = samples<V>(n, 0), b = samples<V>(n, 3);
+				std::vector<V> out(a);
+				runner.run(name, fp, n, bytes, [&](std::size_t count) {
+					for (std::size_t i = 0; i < count; ++i) { out[i] = a[i]; op(out[i], b[i]); }
+					escape(out.data());
+				});
+			}
+		}
+	}
+
+
+
+	/**
+	 * Every operator and geometric operation of Vec, for one vector type V and scalar type S.
+	 * Operators that V does not support are skipped, so the same list serves every instantiation.
+	 */
+	template<typename V, typename S>
+	void
+	bench_vec(Runner& runner, std::string_view type) {
+		const std::string group = std::string(type);
+		const S s = S(3);
+
+		bench_binary<V>(runner, group, "a+b",   [](auto const& a, auto const& b) -> decltype(a + b) { return a + b; });
+		bench_binary<V>(runner, group, "a-b",   [](auto const& a, auto const& b) -> decltype(a - b) { return a - b; });
+		bench_binary<V>(runner, group, "a*b",   [](auto const& a, auto const& b) -> decltype(a * b) { return a * b; });
+		bench_binary<V>(runner, group, "a/b",   [](auto const& a, auto const& b) -> decltype(a / b) { return a / b; });
+		bench_binary<V>(runner, group, "a%b",   [](auto const& a, auto const& b) -> decltype(a % b) { return a % b; });
+		bench_binary<V>(runner, group, "a&b",   [](auto const& a, auto const& b) -> decltype(a & b) { return a & b; });
+		bench_binary<V>(runner, group, "a|b",   [](auto const& a, auto const& b) -> decltype(a | b) { return a | b; });
+		bench_binary<V>(runner, group, "a^b",   [](auto const& a, auto const& b) -> decltype(a ^ b) { return a ^ b; });
+		bench_binary<V>(runner, group, "a<<b",  [](auto const& a, auto const& b) -> decltype(a << b) { return a << b; });
+		bench_binary<V>(runner, group, "a>>b",  [](auto const& a, auto const& b) -> decltype(a >> b) { return a >> b; });
+		bench_binary<V>(runner, group, "a==b",  [](auto const& a, auto const& b) -> decltype(a == b) { return a == b; });
+		bench_binary<V>(runner, group, "a!=b",  [](auto const& a, auto const& b) -> decltype(a != b) { return a != b; });
+		bench_binary<V>(runner, group, "a<b",   [](auto const& a, auto const& b) -> decltype(a < b) { return a < b; });
+		bench_binary<V>(runner, group, "a<=b",  [](auto const& a, auto const& b) -> decltype(a <= b) { return a <= b; });
+		bench_binary<V>(runner, group, "a>b",   [](auto const& a, auto const& b) -> decltype(a > b) { return a > b; });
+		bench_binary<V>(runner, group, "a>=b",  [](auto const& a, auto const& b) -> decltype(a >= b) { return a >= b; });
+		bench_binary<V>(runner, group, "a<=>b", [](auto const& a, auto const& b) -> decltype(a <=> b) { return a <=> b; });
+		bench_binary<V>(runner, group, "a&&b",  [](auto const& a, auto const& b) -> decltype(a && b) { return a && b; });
+		bench_binary<V>(runner, group, "a||b",  [](auto const& a, auto const& b) -> decltype(a || b) { return a || b; });
+
+		bench_unary<V>(runner, group, "a*s",  [s](auto const& a) -> decltype(a * s) { return a * s; });
+		bench_unary<V>(runner, group, "s*a",  [s](auto const& a) -> decltype(s * a) { return s * a; });
+		bench_unary<V>(runner, group, "a/s",  [s](auto const& a) -> decltype(a / s) { return a / s; });
+		bench_unary<V>(runner, group, "a%s",  [s](auto const& a) -> decltype(a % s) { return a % s; });
+		bench_unary<V>(runner, group, "a&&s", [s](auto const& a) -> decltype(a && s) { return a && s; });
+		bench_unary<V>(runner, group, "a||s", [s](auto const& a) -> decltype(a || s) { return a || s; });
+		bench_unary<V>(runner, group, "a&s",  [s](auto const& a) -> decltype(a & s) { return a & s; });
+		bench_unary<V>(runner, group, "a>>s", [s](auto const& a) -> decltype(a >> s) { return a >> s; });
+		bench_unary<V>(runner, group, "+a",   [](auto const& a) -> decltype(+a) { return +a; });
+		bench_unary<V>(runner, group, "-a",   [](auto const& a) -> decltype(-a) { return -a; });
+		bench_unary<V>(runner, group, "!a",   [](auto const& a) -> decltype(!a) { return !a; });
+		bench_unary<V>(runner, group, "~a",   [](auto const& a) -> decltype(~a) { return ~a; });
+
+		bench_compound<V>(runner, group, "a+=b",  [](auto& a, auto const& b) -> decltype(a += b) { return a += b; });
+		bench_compound<V>(runner, group, "a-=b",  [](auto& a, auto const& b) -> decltype(a -= b) { return a -= b; });
+		bench_compound<V>(runner, group, "a*=b",  [](auto& a, auto const& b) -> decltype(a *= b) { return a *= b; });
+		bench_compound<V>(runner, group, "a/=b",  [](auto& a, auto const& b) -> decltype(a /= b) { return a /= b; });
+		bench_compound<V>(runner, group, "a%=b",  [](auto& a, auto const& b) -> decltype(a %= b) { return a %= b; });
+		bench_compound<V>(runner, group, "a&=b",  [](auto& a, auto const& b) -> decltype(a &= b) { return a &= b; });
+		bench_compound<V>(runner, group, "a|=b",  [](auto& a, auto const& b) -> decltype(a |= b) { return a |= b; });
+		bench_compound<V>(runner, group, "a^=b",  [](auto& a, auto const& b) -> decltype(a ^= b) { return a ^= b; });
+		bench_compound<V>(runner, group, "a<<=b", [](auto& a, auto const& b) -> decltype(a <<= b) { return a <<= b; });
+		bench_compound<V>(runner, group, "a>>=b", [](auto& a, auto const& b) -> decltype(a >>= b) { return a >>= b; });
+		bench_compound<V>(runner, group, "a*=s",  [s](auto& a, auto const&) -> decltype(a *= s) { return a *= s; });
+		bench_compound<V>(runner, group, "a/=s",  [s](auto& a, auto const&) -> decltype(a /= s) { return a /= s; });
+
+		bench_binary<V>(runner, group, "dot",   [](auto const& a, auto const& b) -> decltype(a.dot(b)) { return a.dot(b); });
+		bench_binary<V>(runner, group, "cross", [](auto const& a, auto const& b) -> decltype(a.cross(b)) { return a.cross(b); });
+		bench_unary<V>(runner, group, "mag2",   [](auto const& a) -> decltype(a.mag2()) { return a.mag2(); });
+
+		bench_binary<V>(runner, group, "fma",     [](auto const& a, auto const& b) -> decltype(fma(a, b, a)) { return fma(a, b, a); });
+		bench_binary<V>(runner, group, "axpy",    [s](auto const& a, auto const& b) -> decltype(axpy(s, a, b)) { return axpy(s, a, b); });
+		bench_binary<V>(runner, group, "dot_fma", [](auto const& a, auto const& b) -> decltype(a.dot_fma(b)) { return a.dot_fma(b); });
+		bench_unary<V>(runner, group, "mag2_fma", [](auto const& a) -> decltype(a.mag2_fma()) { return a.mag2_fma(); });
+
+		[[maybe_unused]] constexpr auto fast = ink::Precision::Fast;
+		bench_unary<V>(runner, group, "mag",            [](auto const& a) -> decltype(a.mag()) { return a.mag(); });
+		bench_unary<V>(runner, group, "mag:fast",       [](auto const& a) -> decltype(a.template mag<fast>()) { return a.template mag<fast>(); });
+		bench_unary<V>(runner, group, "inv_mag",        [](auto const& a) -> decltype(a.inv_mag()) { return a.inv_mag(); });
+		bench_unary<V>(runner, group, "inv_mag:fast",   [](auto const& a) -> decltype(a.template inv_mag<fast>()) { return a.template inv_mag<fast>(); });
+		bench_unary<V>(runner, group, "normalize",      [](auto const& a) -> decltype(a.normalize()) { return a.normalize(); });
+		bench_unary<V>(runner, group, "normalize:fast", [](auto const& a) -> decltype(a.template normalize<fast>()) { return a.template normalize<fast>(); });
+		bench_binary<V>(runner, group, "distance",      [](auto const& a, auto const& b) -> decltype(a.distance(b)) { return a.distance(b); });
+		bench_binary<V>(runner, group, "distance:fast", [](auto const& a, auto const& b) -> decltype(a.template distance<fast>(b)) { return a.template distance<fast>(b); });
+	}
+
+	// The same chained expression, evaluated eagerly and through MathVectorExpr.hpp.
+	template<typename T>
+	void
+	bench_expr(Runner& runner, std::string_view type) {
+		using V = ink::Vec<T>;
+		const std::string group = std::string(type);
+		bench_binary<V>(runner, group, "eager:a+b*s-a", [](V const& a, V const& b) -> V { return a + b * T(2) - a; });
+		bench_binary<V>(runner, group, "lazy:a+b*s-a",  [](V const& a, V const& b) -> V { return ink::lazy(a) + ink::lazy(b) * T(2) - ink::lazy(a); });
+	}
+
+	// Batched operations of VecSoA. Each call allocates its result, as the API does.
+	template<typename T>
+	void
+	bench_soa(Runner& runner, std::string_view type) {
+		using V = ink::Vec<T>;
+		using SoA = ink::VecSoA<T>;
+
+		auto run = [&](std::string_view op_name, std::size_t bytes_per_op, auto op) {
+			const std::string name = name_of(type, op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / bytes_per_op;
+				SoA a, b;
+				a.reserve(n); b.reserve(n);
+				for (std::size_t i = 0; i < n; ++i) { a.push_back(sample<V>(i)); b.push_back(sample<V>(i + 3)); }
+				runner.run(name, fp, n, bytes_per_op, [&](std::size_t) {
+					const auto out = op(a, b);
+					escape(&out);
+				});
+			}
+		};
+
+		run("a+b",   3 * sizeof(V), [](SoA const& a, SoA const& b) { return a + b; });
+		run("a*b",   3 * sizeof(V), [](SoA const& a, SoA const& b) { return a * b; });
+		run("a*s",   2 * sizeof(V), [](SoA const& a, SoA const&) { return a * T(3); });
+		run("dot",   2 * sizeof(V) + sizeof(T), [](SoA const& a, SoA const& b) { return a.dot(b); });
+		run("cross", 3 * sizeof(V), [](SoA const& a, SoA const& b) { return a.cross(b); });
+		run("mag2",  sizeof(V) + sizeof(T), [](SoA const& a, SoA const&) { return a.mag2(); });
+	}
+
+	// sum() of MathVectorSum.hpp in each of its modes.
+	template<typename T>
+	void
+	bench_sum(Runner& runner, std::string_view type) {
+		using V = ink::Vec<T>;
+		const std::string group = std::string("sum<") + std::string(type) + ">";
+
+		auto run = [&]<ink::Summation mode>(std::string_view op_name) {
+			const std::string name = name_of(group, op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / sizeof(V);
+				const auto a = samples<V>(n, 0);
+				runner.run(name, fp, n, sizeof(V), [&](std::size_t count) {
+					const auto r = ink::generic_vec::sum<mode>(a.data(), count);
+					escape(&r);
+				});
+			}
+		};
+
+		run.template operator()<ink::Summation::Naive>("naive");
+		run.template operator()<ink::Summation::Pairwise>("pairwise");
+		run.template operator()<ink::Summation::Kahan>("kahan");
+	}
+
+	// Algorithms of MathVectorParallel.hpp on the shared pool. Compare with the single threaded Vec<T> results.
+	template<typename T>
+	void
+	bench_parallel(Runner& runner, std::string_view type) {
+		namespace parallel = ink::generic_vec::parallel;
+		using V = ink::Vec<T>;
+		const std::string group = std::string("parallel<") + std::string(type) + ">";
+
+		auto run = [&](std::string_view op_name, std::size_t bytes_per_op, auto op) {
+			const std::string name = name_of(group, op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / bytes_per_op;
+				const auto a = samples<V>(n, 0), b = samples<V>(n, 3);
+				std::vector<V> out(n);
+				runner.run(name, fp, n, bytes_per_op, [&](std::size_t count) { op(a.data(), b.data(), out.data(), count); });
+			}
+		};
+
+		run("a+b", 3 * sizeof(V), [](V const* a, V const* b, V* out, std::size_t n) { parallel::transform(a, b, out, n, std::plus<>()); escape(out); });
+		run("sum", sizeof(V), [](V const* a, V const*, V*, std::size_t n) { const auto r = parallel::sum(a, n); escape(&r); });
+		run("min", sizeof(V), [](V const* a, V const*, V*, std::size_t n) { const auto r = parallel::min(a, n); escape(&r); });
+		run("dot_sum", 2 * sizeof(V), [](V const* a, V const* b, V*, std::size_t n) { const auto r = parallel::dot_sum(a, b, n); escape(&r); });
+		run("mag2_sum", sizeof(V), [](V const* a, V const*, V*, std::size_t n) { const auto r = parallel::mag2_sum(a, n); escape(&r); });
+	}
+
+	// Grid helpers of MathVectorGrid.hpp, one vector at a time and batched.
+	void
+	bench_grid(Runner& runner) {
+		namespace gv = ink::generic_vec;
+		using U = ink::Vec<std::uint32_t>;
+		using I = ink::Vec<std::int32_t>;
+		using F = ink::Vec<float>;
+
+		bench_unary<U>(runner, "grid", "morton_encode", [](U const& a) { return gv::morton_encode(a); });
+		bench_unary<I>(runner, "grid", "spatial_hash",  [](I const& a) { return gv::spatial_hash(a); });
+		bench_unary<F>(runner, "grid", "to_cell",       [](F const& a) { return gv::to_cell(a, 0.75f); });
+		bench_unary<I>(runner, "grid", "floor_div",     [](I const& a) { return gv::floor_div(a, 3); });
+
+		auto run = [&]<typename V, typename R>(std::string_view op_name, auto op) {
+			const std::string name = name_of("grid", op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / (sizeof(V) + sizeof(R));
+				const auto a = samples<V>(n, 0);
+				std::vector<R> out(n);
+				runner.run(name, fp, n, sizeof(V) + sizeof(R), [&](std::size_t count) { op(a.data(), out.data(), count); escape(out.data()); });
+			}
+		};
+
+		run.template operator()<U, std::uint64_t>("simd::morton_encode", [](U const* a, std::uint64_t* out, std::size_t n) { gv::simd::morton_encode(a, out, n); });
+		run.template operator()<I, std::uint32_t>("simd::spatial_hash", [](I const* a, std::uint32_t* out, std::size_t n) { gv::simd::spatial_hash(a, out, n); });
+		run.template operator()<F, I>("simd::to_cell", [](F const* a, I* out, std::size_t n) { gv::simd::to_cell(a, 0.75f, out, n); });
+	}
+
+	// Masks of MathVectorMask.hpp: scalar compare and select, and the batched compares to packed masks.
+	void
+	bench_mask(Runner& runner) {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+
+		bench_binary<F>(runner, "mask", "mask<", [](F const& a, F const& b) { return gv::mask(a, b, std::less<>()); });
+		bench_binary<F>(runner, "mask", "select", [](F const& a, F const& b) { return gv::select(gv::mask(a, b, std::less<>()), a, b); });
+		bench_binary<F>(runner, "mask", "blend", [](F const& a, F const& b) { return gv::blend<0b101u>(a, b); });
+
+		auto run = [&]<typename R>(std::string_view op_name, std::size_t per_word, auto op) {
+			const std::string name = name_of("mask", op_name);
+			if (!runner.selected(name)) return;
+			const std::size_t bytes = 2 * sizeof(F) + sizeof(R) / per_word;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / bytes;
+				const auto a = samples<F>(n, 0), b = samples<F>(n, 3);
+				std::vector<R> out(n / per_word + 1);
+				runner.run(name, fp, n, bytes, [&](std::size_t count) { op(a.data(), b.data(), out.data(), count); escape(out.data()); });
+			}
+		};
+
+		run.template operator()<gv::VecMask<>>("simd::mask<", 1, [](F const* a, F const* b, gv::VecMask<>* out, std::size_t n) { gv::simd::mask(a, b, std::less<float>(), out, n); });
+		run.template operator()<std::uint64_t>("simd::mask_all<", 64, [](F const* a, F const* b, std::uint64_t* out, std::size_t n) { gv::simd::mask_all(a, b, std::less<float>(), out, n); });
+		run.template operator()<std::uint64_t>("simd::mask_any<", 64, [](F const* a, F const* b, std::uint64_t* out, std::size_t n) { gv::simd::mask_any(a, b, std::less<float>(), out, n); });
+	}
+
+	// Transforms of MathVectorTransform.hpp, one vector at a time and batched, as for a vertex buffer.
+	void
+	bench_transform(Runner& runner) {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+		const auto rotation = ink::Quat<float>::axis_angle(F(0.48f, 0.6f, 0.64f), 0.7f);
+		const auto affine = ink::Affine<float>::trs(F(1.f, -2.f, 3.f), rotation, F(1.5f, 0.5f, 2.f));
+
+		bench_unary<F>(runner, "transform", "point",     [&](F const& a) { return affine.transform_point(a); });
+		bench_unary<F>(runner, "transform", "direction", [&](F const& a) { return affine.transform_direction(a); });
+		bench_unary<F>(runner, "transform", "rotate",    [&](F const& a) { return rotation.rotate(a); });
+
+		auto run = [&](std::string_view op_name, auto op) {
+			const std::string name = name_of("transform", op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / (2 * sizeof(F));
+				const auto a = samples<F>(n, 0);
+				std::vector<F> out(n);
+				runner.run(name, fp, n, 2 * sizeof(F), [&](std::size_t count) { op(a.data(), out.data(), count); escape(out.data()); });
+			}
+		};
+
+		run("simd::transform_points",     [&](F const* a, F* out, std::size_t n) { gv::simd::transform_points(affine, a, out, n); });
+		run("simd::transform_directions", [&](F const* a, F* out, std::size_t n) { gv::simd::transform_directions(affine, a, out, n); });
+		run("simd::rotate",               [&](F const* a, F* out, std::size_t n) { gv::simd::rotate(rotation, a, out, n); });
+	}
+
+	// Swizzles of MathVectorSwizzle.hpp, one vector at a time and batched.
+	void
+	bench_swizzle(Runner& runner) {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+
+		bench_unary<F>(runner, "swizzle", "zyx",     [](F const& a) { return ink::swizzle<"zyx">(a); });
+		bench_unary<F>(runner, "swizzle", "yzx+",    [](F const& a) { return ink::swizzle<"yzx">(a) + a; });
+		bench_unary<F>(runner, "swizzle", "ref zx=", [](F const& a) { F v = a; ink::swizzle_ref<"zx">(v) = a; return v; });
+
+		auto run = [&](std::string_view op_name, auto op) {
+			const std::string name = name_of("swizzle", op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / (2 * sizeof(F));
+				const auto a = samples<F>(n, 0);
+				std::vector<F> out(n);
+				runner.run(name, fp, n, 2 * sizeof(F), [&](std::size_t count) { op(a.data(), out.data(), count); escape(out.data()); });
+			}
+		};
+
+		run("simd::swizzle<zyx>", [](F const* a, F* out, std::size_t n) { gv::simd::swizzle<"zyx">(a, out, n); });
+		run("simd::swizzle<yzx>", [](F const* a, F* out, std::size_t n) { gv::simd::swizzle<"yzx">(a, out, n); });
+		run("simd::swizzle<xxz>", [](F const* a, F* out, std::size_t n) { gv::simd::swizzle<"xxz">(a, out, n); });
+	}
+
+	// Conversions to and from the compact storage of MathVectorCompact.hpp, over whole arrays.
+	void
+	bench_compact(Runner& runner) {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+		using H = ink::Vec<ink::Half>;
+		using B = ink::Vec<ink::BFloat16>;
+		using Q = ink::Vec<std::int16_t>;
+
+		bench_unary<H>(runner, "compact", "Half dot", [](H const& a) { return a.dot(a); });
+
+		// 'op' converts an array of From into one of To.
+		auto run = [&]<typename From, typename To>(std::string_view op_name, auto op) {
+			const std::string name = name_of("compact", op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / (sizeof(From) + sizeof(To));
+				const auto floats = samples<F>(n, 0);
+				std::vector<From> a(n);
+				if constexpr(std::same_as<From, F>) a = floats;
+				else if constexpr(std::same_as<From, Q>) gv::simd::quantize(ink::Quantization<float>::fit(floats.data(), n), floats.data(), a.data(), n);
+				else gv::simd::pack(floats.data(), a.data(), n);
+				std::vector<To> out(n);
+				runner.run(name, fp, n, sizeof(From) + sizeof(To), [&](std::size_t count) { op(a.data(), out.data(), count); escape(out.data()); });
+			}
+		};
+
+		const auto q = ink::Quantization<float>(F(0.01f, 0.01f, 0.01f), F(0.f, 0.f, 0.f));
+
+		run.operator()<F, H>("simd::pack<Half>",     [](F const* a, H* out, std::size_t n) { gv::simd::pack(a, out, n); });
+		run.operator()<H, F>("simd::unpack<Half>",   [](H const* a, F* out, std::size_t n) { gv::simd::unpack(a, out, n); });
+		run.operator()<F, B>("simd::pack<BFloat16>", [](F const* a, B* out, std::size_t n) { gv::simd::pack(a, out, n); });
+		run.operator()<B, F>("simd::unpack<BFloat16>", [](B const* a, F* out, std::size_t n) { gv::simd::unpack(a, out, n); });
+		run.operator()<F, Q>("simd::quantize",       [&](F const* a, Q* out, std::size_t n) { gv::simd::quantize(q, a, out, n); });
+		run.operator()<Q, F>("simd::dequantize",     [&](Q const* a, F* out, std::size_t n) { gv::simd::dequantize(q, a, out, n); });
+	}
+
+	// Array casts between element types: one converting constructor per element, against simd::convert.
+	void
+	bench_convert(Runner& runner) {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+		using D = ink::Vec<double>;
+		using I = ink::Vec<std::int32_t>;
+
+		// 'op' converts an array of From into one of To.
+		auto run = [&]<typename From, typename To>(std::string_view op_name, auto op) {
+			const std::string name = name_of("convert", op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / (sizeof(From) + sizeof(To));
+				const auto floats = samples<F>(n, 0);
+				std::vector<From> a(n);
+				for (std::size_t i = 0; i < n; ++i) a[i] = From(floats[i] * 1000.f);
+				std::vector<To> out(n);
+				runner.run(name, fp, n, sizeof(From) + sizeof(To), [&](std::size_t count) { op(a.data(), out.data(), count); escape(out.data()); });
+			}
+		};
+
+		auto per_element = []<typename From, typename To>(From const* a, To* out, std::size_t n) {
+			for (std::size_t i = 0; i < n; ++i) out[i] = To(a[i]);
+		};
+
+		run.operator()<F, D>("float -> double, per element", per_element);
+		run.operator()<F, D>("float -> double, simd::convert", [](F const* a, D* out, std::size_t n) { gv::simd::convert(a, out, n); });
+		run.operator()<D, F>("double -> float, per element", per_element);
+		run.operator()<D, F>("double -> float, simd::convert", [](D const* a, F* out, std::size_t n) { gv::simd::convert(a, out, n); });
+		run.operator()<F, I>("float -> int32, per element", per_element);
+		run.operator()<F, I>("float -> int32, simd::convert", [](F const* a, I* out, std::size_t n) { gv::simd::convert(a, out, n); });
+		run.operator()<I, F>("int32 -> float, per element", per_element);
+		run.operator()<I, F>("int32 -> float, simd::convert", [](I const* a, F* out, std::size_t n) { gv::simd::convert(a, out, n); });
+	}
+
+	// Per-frame arrays of MathVectorArena.hpp: a frame fills 16 fresh arrays, from the heap or from an arena reset each frame.
+	void
+	bench_arena(Runner& runner) {
+		using F = ink::Vec<float>;
+
+		auto run = [&](std::string_view op_name, auto frame) {
+			const std::string name = name_of("arena", op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / sizeof(F);
+				const auto a = samples<F>(n, 0);
+				runner.run(name, fp, n, sizeof(F), [&](std::size_t count) { frame(a.data(), count); });
+			}
+		};
+
+		run("std::vector", [](F const* a, std::size_t n) {
+			for (std::size_t k = 0; k < 16; ++k) {
+				std::vector<F> out(a + k * n / 16, a + (k + 1) * n / 16);
+				escape(out.data());
+			}
+		});
+
+		ink::VecArena arena;
+		run("VecVector + VecArena", [&](F const* a, std::size_t n) {
+			for (std::size_t k = 0; k < 16; ++k) {
+				ink::VecVector<float> out(a + k * n / 16, a + (k + 1) * n / 16, &arena);
+				escape(out.data());
+			}
+			arena.reset();
+		});
+
+		auto pool = ink::VecPool::of<F>(footprints[std::size(footprints) - 1].bytes / sizeof(F) / 16 + 1, 16);
+		run("VecVector + VecPool", [&](F const* a, std::size_t n) {
+			for (std::size_t k = 0; k < 16; ++k) {
+				ink::VecVector<float> out(a + k * n / 16, a + (k + 1) * n / 16, &pool);
+				escape(out.data());
+			}
+		});
+	}
+
+	// Files of MathVectorFile.hpp, in the page cache: writing, copying back into memory, summing in place, and streaming.
+	void
+	bench_file(Runner& runner) {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+
+		const std::string path = (std::filesystem::temp_directory_path() / "ink_generic_vec_bench.vec").string();
+
+		auto run = [&](std::string_view op_name, auto op) {
+			const std::string name = name_of("file", op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / sizeof(F);
+				const auto a = samples<F>(n, 0);
+				gv::save(path.c_str(), a);
+				runner.run(name, fp, n, sizeof(F), [&](std::size_t) { op(a); });
+			}
+			std::filesystem::remove(path);
+		};
+
+		run("save",          [&](std::vector<F> const& a) { gv::save(path.c_str(), a); });
+		run("load",          [&](std::vector<F> const&) { auto v = gv::load<float>(path.c_str()); escape(v.data()); });
+		run("VecFile + sum", [&](std::vector<F> const&) {
+			const ink::VecFile<float> file(path.c_str());
+			F sum(0.f, 0.f, 0.f);
+			for (F const& v : file.vecs()) sum += v;
+			escape(&sum);
+		});
+		run("stream + sum",  [&](std::vector<F> const&) {
+			F sum = gv::stream<float>(path.c_str(), 1u << 20).sum<gv::Summation::Naive>();
+			escape(&sum);
+		});
+		run("stream + filter_all + count", [&](std::vector<F> const&) {
+			std::size_t n = gv::stream<float>(path.c_str(), 1u << 20).filter_all(std::less<>(), F(8.f, 8.f, 8.f)).count();
+			escape(&n);
+		});
+	}
+
+	// Spatial indices of MathVectorSpatial.hpp, sized to each footprint, one query at a time and batched.
+	void
+	bench_spatial(Runner& runner) {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+		using Hit = gv::QueryHit<float>;
+
+		// Points scattered over the cube [0, side)^3, by a multiplicative hash of the index.
+		auto scatter = [](std::size_t n, std::size_t seed, float side) {
+			auto unit = [](std::uint64_t h) { return float(h >> 40) * 0x1p-24f; };
+			std::vector<F> out(n);
+			for (std::size_t i = 0; i < n; ++i) {
+				const std::uint64_t h = (i + seed) * 0x9E3779B97F4A7C15ull;
+				out[i] = F(side * unit(h), side * unit(h * 0xD6E8FEB86659FD93ull), side * unit(h * 0xBF58476D1CE4E5B9ull));
+			}
+			return out;
+		};
+
+		auto run = [&](std::string_view op_name, auto op) {
+			const std::string name = name_of("spatial", op_name);
+			if (!runner.selected(name)) return;
+			for (auto const& fp : footprints) {
+				const std::size_t n = fp.bytes / (sizeof(gv::AABB<float>) + sizeof(gv::BVH<float>::Node));
+				// About one point per unit cube.
+				const float side = std::cbrt(float(n));
+				const auto points = scatter(n, 0, side);
+				// Queries as dense as the points, in Morton order of their cell: the coherent batches packets are for.
+				const std::size_t q = std::min<std::size_t>(n, 8192);
+				auto queries = scatter(q, n, std::cbrt(float(q)));
+				std::sort(queries.begin(), queries.end(), [](F const& a, F const& b) {
+					return gv::morton_encode(gv::to_cell<std::uint32_t>(a, 1.f)) < gv::morton_encode(gv::to_cell<std::uint32_t>(b, 1.f));
+				});
+				std::vector<F> dirs(queries.size());
+				// Rays of length 4 in about the same direction, like those of a camera.
+				for (std::size_t i = 0; i < dirs.size(); ++i) dirs[i] = F(3.f, 2.f, 1.f + float(i % 16) / 16.f) * 0.75f;
+				std::vector<Hit> out(queries.size());
+				const gv::BVH<float> bvh(points.data(), n);
+				const gv::HashGrid<float> grid(points.data(), n, 1.f);
+				runner.run(name, fp, queries.size(), sizeof(F) + sizeof(Hit), [&](std::size_t count) {
+					op(bvh, grid, queries.data(), dirs.data(), out.data(), count);
+					escape(out.data());
+				});
+			}
+		};
+
+		using B = gv::BVH<float>;
+		using G = gv::HashGrid<float>;
+		run("bvh/nearest", [](B const& b, G const&, F const* q, F const*, Hit* out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) out[i] = b.nearest(q[i]); });
+		run("bvh/nearest:batch", [](B const& b, G const&, F const* q, F const*, Hit* out, std::size_t n) { b.nearest(q, n, out); });
+		run("bvh/ray", [](B const& b, G const&, F const* q, F const* d, Hit* out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) out[i] = b.ray(q[i], d[i], 1.f); });
+		run("bvh/ray:batch", [](B const& b, G const&, F const* q, F const* d, Hit* out, std::size_t n) { b.rays(q, d, 1.f, n, out); });
+		run("bvh/radius", [](B const& b, G const&, F const* q, F const*, Hit* out, std::size_t n) {
+			for (std::size_t i = 0; i < n; ++i) b.radius(q[i], 1.5f, [&](std::uint32_t index) { out[i].index = index; });
+		});
+		run("bvh/radius:batch", [](B const& b, G const&, F const* q, F const*, Hit* out, std::size_t n) {
+			b.radius(q, 1.5f, n, [&](std::size_t i, std::uint32_t index) { out[i].index = index; });
+		});
+		run("grid/nearest", [](B const&, G const& g, F const* q, F const*, Hit* out, std::size_t n) { g.nearest(q, n, out, 4.f); });
+		run("grid/radius", [](B const&, G const& g, F const* q, F const*, Hit* out, std::size_t n) {
+			g.radius(q, 1.5f, n, [&](std::size_t i, std::uint32_t index) { out[i].index = index; });
+		});
+	}
+
+	// Batch kernels of MathVectorSimd.hpp, for every instruction set the running CPU supports.
+	template<typename T>
+	void
+	bench_simd(Runner& runner, std::string_view type) {
+		namespace simd = ink::generic_vec::simd;
+		using V = ink::Vec<T>;
+		constexpr char const* isa_names[] = { "scalar", "sse2", "avx2", "avx512" };
+
+		for (std::size_t level = 0; level <= std::size_t(simd::active_isa()); ++level) {
+			const auto table = simd::kernels_for<T>(simd::Isa(level));
+			const std::string group = std::string("simd::") + isa_names[level] + "<" + std::string(type) + ">";
+
+			auto run = [&](std::string_view op_name, std::size_t bytes_per_op, auto op) {
+				const std::string name = name_of(group, op_name);
+				if (!runner.selected(name)) return;
+				for (auto const& fp : footprints) {
+					const std::size_t n = fp.bytes / bytes_per_op;
+					const auto a = samples<V>(n, 0), b = samples<V>(n, 3);
+					std::vector<V> out(n);
+					std::vector<T> scalars(n);
+					std::vector<ink::Vec<bool>> masks(n);
+					runner.run(name, fp, n, bytes_per_op, [&](std::size_t count) {
+						op(simd::detail::flat(a.data()), simd::detail::flat(b.data()), out, scalars, masks, count);
+						escape(out.data()); escape(scalars.data()); escape(masks.data());
+					});
+				}
+			};
+
+			run("add", 3 * sizeof(V), [&](T const* a, T const* b, auto& out, auto&, auto&, std::size_t n) { table.add(a, b, simd::detail::flat(out.data()), 3 * n); });
+			run("mul", 3 * sizeof(V), [&](T const* a, T const* b, auto& out, auto&, auto&, std::size_t n) { table.mul(a, b, simd::detail::flat(out.data()), 3 * n); });
+			run("div", 3 * sizeof(V), [&](T const* a, T const* b, auto& out, auto&, auto&, std::size_t n) { table.div(a, b, simd::detail::flat(out.data()), 3 * n); });
+			run("mul_scalar", 2 * sizeof(V), [&](T const* a, T const*, auto& out, auto&, auto&, std::size_t n) { table.mul_scalar(a, T(3), simd::detail::flat(out.data()), 3 * n); });
+			run("less", 2 * sizeof(V) + sizeof(ink::Vec<bool>), [&](T const* a, T const* b, auto&, auto&, auto& masks, std::size_t n) {
+				table.cmp[std::size_t(simd::detail::CmpOp::Lt)](a, b, simd::detail::flat(masks.data()), 3 * n);
+			});
+			run("dot", 2 * sizeof(V) + sizeof(T), [&](T const* a, T const* b, auto&, auto& scalars, auto&, std::size_t n) { table.dot(a, b, scalars.data(), n); });
+			run("cross", 3 * sizeof(V), [&](T const* a, T const* b, auto& out, auto&, auto&, std::size_t n) { table.cross(a, b, simd::detail::flat(out.data()), n); });
+
+			for (std::size_t p = 0; p < 2; ++p) {
+				const std::string tier = p == std::size_t(ink::Precision::Fast) ? ":fast" : "";
+				run("mag" + tier, sizeof(V) + sizeof(T), [&](T const* a, T const*, auto&, auto& scalars, auto&, std::size_t n) { table.mag[p](a, scalars.data(), n); });
+				run("inv_mag" + tier, sizeof(V) + sizeof(T), [&](T const* a, T const*, auto&, auto& scalars, auto&, std::size_t n) { table.inv_mag[p](a, scalars.data(), n); });
+				run("normalize" + tier, 2 * sizeof(V), [&](T const* a, T const*, auto& out, auto&, auto&, std::size_t n) { table.normalize[p](a, simd::detail::flat(out.data()), n); });
+				run("distance" + tier, 2 * sizeof(V) + sizeof(T), [&](T const* a, T const* b, auto&, auto& scalars, auto&, std::size_t n) { table.distance[p](a, b, scalars.data(), n); });
+			}
+		}
+	}
+
+}
+
+
+
+int main(int argc, char const* argv[]) {
+
+	Runner runner(ink::bench::parse_options(argc, argv));
+	runner.header();
+
+	bench_vec<ink::Vec<int>, int>(runner, "Vec<int>");
+	bench_vec<ink::Vec<float>, float>(runner, "Vec<float>");
+	bench_vec<ink::Vec<double>, double>(runner, "Vec<double>");
+	bench_vec<ink::Vec<int, float, double>, int>(runner, "Vec<int,float,double>");
+	bench_vec<ink::Vec<float, float, void>, float>(runner, "Vec<float,float,void>");
+	bench_vec<ink::PaddedVec<float>, float>(runner, "PaddedVec<float>");
+	bench_vec<ink::PaddedVec<double>, double>(runner, "PaddedVec<double>");
+	bench_vec<ink::VecN<float, float, float>, float>(runner, "VecN<float x3>");
+	bench_vec<ink::VecN<float, float, float, float>, float>(runner, "VecN<float x4>");
+	bench_vec<ink::VecN<float, float, float, float, float, float, float, float>, float>(runner, "VecN<float x8>");
+	bench_vec<ink::VecN<char, double, void, int>, int>(runner, "VecN<char,double,void,int>");
+
+	bench_expr<float>(runner, "Expr<float>");
+	bench_soa<float>(runner, "VecSoA<float>");
+	bench_soa<double>(runner, "VecSoA<double>");
+	bench_sum<float>(runner, "float");
+	bench_sum<double>(runner, "double");
+	bench_parallel<float>(runner, "float");
+	bench_parallel<double>(runner, "double");
+	bench_grid(runner);
+	bench_mask(runner);
+	bench_transform(runner);
+	bench_swizzle(runner);
+	bench_compact(runner);
+	bench_convert(runner);
+	bench_arena(runner);
+	bench_file(runner);
+	bench_spatial(runner);
+	bench_simd<float>(runner, "float");
+	bench_simd<double>(runner, "double");
+
+	if (runner.count() == 0) {
+		std::fprintf(stderr, "No benchmark matches the filter.\n");
+		return 1;
+	}
+
+	return 0;
+}
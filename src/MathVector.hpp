@@ -2,9 +2,29 @@
 #define INK_GENERIC_VEC_LIB_FILE_GUARD
 
 #include <concepts>
+#include <type_traits>
 #include <utility>
-#include <tuple>
 #include <cstdint>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// x86 reciprocal square root estimate, behind the Precision::Fast tier of magnitudes. The only intrinsic of this header:
+// targets without SSE, ARM64EC included, and builds defining INK_GENERIC_VEC_NO_INTRINSICS, use the exact square root.
+#if !defined(INK_GENERIC_VEC_NO_INTRINSICS) && (defined(__SSE__) || (defined(_M_X64) && !defined(_M_ARM64EC)) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#include <xmmintrin.h>
+#define INK_GENERIC_VEC_RSQRT_ESTIMATE
+#endif
+
+// Forces inlining of the tiny helpers every operator goes through, so that unoptimized builds do not pay a call per axis.
+// Define INK_GENERIC_VEC_NO_FORCE_INLINE to leave inlining entirely to the compiler.
+#if defined(__GNUC__) && !defined(INK_GENERIC_VEC_NO_FORCE_INLINE)
+#define INK_GENERIC_VEC_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+#define INK_GENERIC_VEC_FORCE_INLINE inline
+#endif
 
 namespace ink::concepts {
 	
@@ -309,6 +329,96 @@ namespace ink::concepts {
 		
 		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
 		concept can_logical_or = can_logical_or_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_add_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs += rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs += rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_add_assign = can_add_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_sub_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs -= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs -= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_sub_assign = can_sub_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_mul_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs *= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs *= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_mul_assign = can_mul_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_div_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs /= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs /= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_div_assign = can_div_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_mod_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs %= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs %= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_mod_assign = can_mod_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_bitwise_and_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs &= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs &= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_bitwise_and_assign = can_bitwise_and_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_bitwise_or_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs |= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs |= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_bitwise_or_assign = can_bitwise_or_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_bitwise_xor_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs ^= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs ^= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_bitwise_xor_assign = can_bitwise_xor_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_shift_left_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs <<= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs <<= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_shift_left_assign = can_shift_left_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
+		
+		
+		
+		template<typename Lhs, typename Rhs = Lhs, std_bool_constant MustBeNoexcept = std::false_type>
+		struct can_shift_right_assign_t:
+		std::bool_constant<(requires(Lhs lhs, Rhs rhs) { {lhs >>= rhs}; } && !MustBeNoexcept{}) || requires(Lhs lhs, Rhs rhs) { {lhs >>= rhs} noexcept; }> {};
+		
+		template<typename Lhs, typename Rhs = Lhs, typename MustBeNoexcept = std::false_type>
+		concept can_shift_right_assign = can_shift_right_assign_t<Lhs, Rhs, MustBeNoexcept>::value;
 	}
 	
 	using namespace operator_constraints;
@@ -450,15 +560,16 @@ namespace ink {
 			
 			
 			
+			// Adding NoState yields 'v', promoted as 'v + 0' would be, without the floating point addition that could not be folded away.
 			public: template<typename T> requires(std::is_arithmetic_v<T>)
 			friend constexpr decltype(auto)
 			operator+(NoState, T v)
-			noexcept { return value + v; }
+			noexcept { return +v; }
 			
 			public: template<typename T> requires(std::is_arithmetic_v<T>)
 			friend constexpr decltype(auto)
 			operator+(T v, NoState)
-			noexcept { return v + value; }
+			noexcept { return +v; }
 			
 			public: friend constexpr decltype(auto)
 			operator+(NoState, NoState)
@@ -492,8 +603,7 @@ namespace ink {
 			operator<<(T v, NoState)
 			noexcept { return v << value; }
 			
-			public: template<std::integral T>
-			friend constexpr decltype(auto)
+			public: friend constexpr decltype(auto)
 			operator<<(NoState, NoState)
 			noexcept { return NoState(); }
 			
@@ -509,8 +619,7 @@ namespace ink {
 			operator>>(T v, NoState)
 			noexcept { return v >> value; }
 			
-			public: template<std::integral T>
-			friend constexpr decltype(auto)
+			public: friend constexpr decltype(auto)
 			operator>>(NoState, NoState)
 			noexcept { return NoState(); }
 			
@@ -712,7 +821,7 @@ namespace ink {
 				private:
 				using base = Member<T, tag>;
 				
-				public: constexpr explicit
+				public: INK_GENERIC_VEC_FORCE_INLINE constexpr explicit
 				Axis(NoState)
 				noexcept( noexcept(base{}) )
 				requires( std::default_initializable<base> )
@@ -721,7 +830,7 @@ namespace ink {
 				public: template<typename U>
 				requires (!std::convertible_to<std::remove_cvref_t<U>, NoState>) &&
 				requires (U u) { {base{u}}; } 
-				constexpr explicit
+				INK_GENERIC_VEC_FORCE_INLINE constexpr explicit
 				Axis(U&& u)
 				noexcept( noexcept(base{std::declval<U>()}) )
 				: base{std::forward<U>(u)} {}
@@ -758,7 +867,7 @@ namespace ink {
 				private: using base2 = aligned_axis_at<2, X, Y, Z>;
 				
 				private: template<typename TargetBase, typename OX, typename OY, typename OZ>
-				static constexpr decltype(auto)
+				INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 				M_fwd_param(OX&& ox, OY&& oy, OZ&& oz) noexcept {
 					if		constexpr(std::same_as<baseX, TargetBase>) return std::forward<OX>(ox);
 					else if	constexpr(std::same_as<baseY, TargetBase>) return std::forward<OY>(oy);
@@ -767,7 +876,7 @@ namespace ink {
 				
 				public:
 				template<typename OX, typename OY, typename OZ>
-				constexpr explicit
+				INK_GENERIC_VEC_FORCE_INLINE constexpr explicit
 				VecBase(OX&& vx, OY&& vy, OZ&& vz)
 				noexcept( noexcept(baseX{std::declval<OX>()}) && noexcept(baseY{std::declval<OY>()}) && noexcept(baseZ{std::declval<OZ>()}) )
 				requires( requires(OX ox, OY oy, OZ oz) { baseX{ox}; baseY{oy}; baseZ{oz}; } )
@@ -787,15 +896,163 @@ namespace ink {
 		template<typename X, typename Y, typename Z>
 		class Vec;
 		
-		template<typename Lhs, typename Rhs>
-		static constexpr decltype(auto)
-		DefaultToNoState(Lhs&& lhs, Rhs&& rhs) noexcept {
-			constexpr auto lNoState = std::same_as<std::remove_cvref_t<Lhs>, NoState>;
-			constexpr auto rNoState = std::same_as<std::remove_cvref_t<Rhs>, NoState>;
-			if constexpr(lNoState || rNoState)
-			{ return std::make_tuple(NoState(), NoState()); }
-			else
-			{ return std::tie(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)); }
+		/**
+		 * A lazily evaluated vector expression.
+		 * Each of x(), y() and z() computes only its own axis, so a Vec can be built or assigned from it in a single pass.
+		 */
+		template<typename E>
+		concept vec_expression = requires(E const& e) {
+			typename E::is_vec_expression;
+			{e.x()}; {e.y()}; {e.z()};
+		};
+		
+		namespace detail {
+			
+			// Whether Vec<X, Y, Z> holds copies of the axes of a Vec<OX, OY, OZ>: the same types, without reference or const.
+			template<typename X, typename Y, typename Z, typename OX, typename OY, typename OZ>
+			concept copies_axes =
+				!std::is_reference_v<X> && !std::is_reference_v<Y> && !std::is_reference_v<Z> &&
+				!std::is_const_v<X> && !std::is_const_v<Y> && !std::is_const_v<Z> &&
+				std::same_as<X, std::remove_cvref_t<OX>> && std::same_as<Y, std::remove_cvref_t<OY>> && std::same_as<Z, std::remove_cvref_t<OZ>>;
+			
+			// Whether T is a Vec, or a class derived from one, as PaddedVec is. Operators never take such a T for a scalar.
+			template<typename T>
+			concept derives_from_vec = requires(T const& v) { []<typename X, typename Y, typename Z>(Vec<X, Y, Z> const&) {}(v); };
+			
+		}
+		
+		template<template<typename...> typename Constraint, typename LHS, typename RHS, bool MustBeNoexcept = false>
+		struct OpConstraint_t;
+		
+		// OpConstraint_t of a compound assignment from a Vec, for which a 'void' rhs axis leaves the lhs axis alone.
+		template<template<typename...> typename Constraint, typename LHS, typename RHS, bool MustBeNoexcept = false>
+		struct AssignConstraint_t;
+		
+		/**
+		 * How mag(), inv_mag(), normalize() and distance() take their square roots.
+		 * - Exact: std::sqrt, correctly rounded.
+		 * - Fast:  for float, the hardware reciprocal square root estimate refined by one Newton-Raphson step,
+		 *          within 3 ulps, and no division. Magnitudes of vectors whose squared magnitude is
+		 *          not a normal float come out too small, zero staying exactly zero. Infinite magnitudes stay infinite,
+		 *          but their inverse is that of the largest float, about 5.4e-20, rather than 0. The inverse of a zero
+		 *          magnitude is NaN, rather than infinity. NaN stays NaN.
+		 *          Types and targets without such an estimate (double, or no SSE) get the exact result.
+		 */
+		enum class Precision
+		{ Exact , Fast };
+		
+		namespace detail {
+			
+			// Bit i is set when axis i (x, y, z) of Vec<X, Y, Z> holds state, that is, is not 'void'.
+			template<typename X, typename Y, typename Z>
+			inline constexpr unsigned axis_mask =
+				(unsigned(!std::is_void_v<X>) << std::size_t(XYZ::X)) |
+				(unsigned(!std::is_void_v<Y>) << std::size_t(XYZ::Y)) |
+				(unsigned(!std::is_void_v<Z>) << std::size_t(XYZ::Z));
+			
+			template<unsigned mask, XYZ tag>
+			inline constexpr bool has_axis = (mask >> std::size_t(tag)) & 1u;
+			
+			/**
+			 * Yields 'value' itself when 'active', or NoState in its place otherwise.
+			 * Operators route the other operand of a possibly 'void' axis through this, so that the axis stays NoState
+			 * instead of becoming, say, 'NoState * 2 == 0'. It is resolved at compile time and creates no temporary.
+			 */
+			template<bool active, typename T>
+			INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+			masked(T const& value)
+			noexcept {
+				if constexpr(active) return (value);
+				else return NoState();
+			}
+			
+			/**
+			 * Whether std::fma on T is a single hardware instruction, rather than a much slower library call.
+			 * Defining INK_GENERIC_VEC_EXACT_FMA forces the fused, singly rounded, result everywhere, whatever it costs.
+			 */
+			template<typename T> inline constexpr bool fast_fma = false;
+			#if defined(FP_FAST_FMAF) || defined(INK_GENERIC_VEC_EXACT_FMA)
+			template<> inline constexpr bool fast_fma<float> = true;
+			#endif
+			#if defined(FP_FAST_FMA) || defined(INK_GENERIC_VEC_EXACT_FMA)
+			template<> inline constexpr bool fast_fma<double> = true;
+			#endif
+			#if defined(FP_FAST_FMAL) || defined(INK_GENERIC_VEC_EXACT_FMA)
+			template<> inline constexpr bool fast_fma<long double> = true;
+			#endif
+			
+			// Arithmetic operands whose 'a * b + c' is computed in a type with a fast fused multiply-add.
+			template<typename A, typename B, typename C>
+			concept fusable =
+				std::is_arithmetic_v<A> && std::is_arithmetic_v<B> && std::is_arithmetic_v<C> &&
+				fast_fma<std::common_type_t<A, B, C>>;
+			
+			/**
+			 * 'a * b + c' for a single axis, fused into one instruction with a single rounding when the operands are fusable.
+			 * Anything else, NoState included, is the plain expression.
+			 */
+			template<typename A, typename B, typename C>
+			requires requires(A const& a, B const& b, C const& c) { {a * b + c}; }
+			INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+			fused_mul_add(A const& a, B const& b, C const& c)
+			noexcept(noexcept(a * b + c)) {
+				if constexpr(fusable<A, B, C>) {
+					using T = std::common_type_t<A, B, C>;
+					#if defined(__GNUC__)
+					// Unlike std::fma, the builtins also fold in constant expressions.
+					if		constexpr(std::same_as<T, float>) return __builtin_fmaf(T(a), T(b), T(c));
+					else if	constexpr(std::same_as<T, double>) return __builtin_fma(T(a), T(b), T(c));
+					else return __builtin_fmal(T(a), T(b), T(c));
+					#else
+					if (std::is_constant_evaluated()) return T(a * b + c);
+					return T(std::fma(T(a), T(b), T(c)));
+					#endif
+				}
+				else return a * b + c;
+			}
+			
+			// Whether 1 / sqrt(T) has a fast estimate to start from.
+			template<typename T>
+			inline constexpr bool rsqrt_estimate =
+				#if defined(INK_GENERIC_VEC_RSQRT_ESTIMATE)
+				std::same_as<T, float>;
+				#else
+				false;
+				#endif
+			
+			// 1 / sqrt(value), to the given precision. Integers are promoted to double, as by std::sqrt.
+			template<Precision precision, typename T>
+			requires std::is_arithmetic_v<T>
+			INK_GENERIC_VEC_FORCE_INLINE auto
+			inv_sqrt(T const& value)
+			noexcept {
+				#if defined(INK_GENERIC_VEC_RSQRT_ESTIMATE)
+				if constexpr(precision == Precision::Fast && rsqrt_estimate<T>) {
+					// Infinity is clamped to the largest float, whose estimate is not 0: the step would make inf * 0, NaN.
+					const float v = std::min(value, std::numeric_limits<float>::max());
+					const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(v)));
+					// One Newton-Raphson step takes the 12 bit estimate to nearly full precision.
+					return y * (1.5f - 0.5f * v * y * y);
+				}
+				else
+				#endif
+				{
+					using R = decltype(std::sqrt(value));
+					return R(1) / std::sqrt(value);
+				}
+			}
+			
+			// sqrt(value), to the given precision. Fast multiplies by the reciprocal square root rather than dividing.
+			template<Precision precision, typename T>
+			requires std::is_arithmetic_v<T>
+			INK_GENERIC_VEC_FORCE_INLINE auto
+			sqrt(T const& value)
+			noexcept {
+				if constexpr(precision == Precision::Fast && rsqrt_estimate<T>)
+					return value * inv_sqrt<precision>(std::max(value, std::numeric_limits<T>::min()));
+				else return std::sqrt(value);
+			}
+			
 		}
 		
 	}
@@ -818,6 +1075,9 @@ namespace ink {
 			
 			public: using NoState = generic_vec::NoState;
 			
+			// Axes holding state, as a bit mask indexed by detail::XYZ.
+			public: static constexpr unsigned axes = detail::axis_mask<X, Y, Z>;
+			
 			
 			
 			public: constexpr
@@ -829,7 +1089,7 @@ namespace ink {
 			
 			
 			public: template<typename OX, typename OY, typename OZ>
-			constexpr
+			INK_GENERIC_VEC_FORCE_INLINE constexpr
 			Vec(OX&& vx, OY&& vy, OZ&& vz)
 			noexcept(noexcept(base(std::declval<OX>(), std::declval<OY>(), std::declval<OZ>())))
 			requires(std::constructible_from<base, OX, OY, OZ>)
@@ -860,63 +1120,118 @@ namespace ink {
 			
 			
 			
+			// Converts every axis, as static_cast does. Implicit when it only copies the values of a Vec of references.
 			public: template<typename OX, typename OY, typename OZ>
 			requires (
 					(std::convertible_to<OX, value_type_x> || std::is_void_v<OX> || std::is_void_v<X>)
 				&&	(std::convertible_to<OY, value_type_y> || std::is_void_v<OY> || std::is_void_v<Y>)
 				&&	(std::convertible_to<OZ, value_type_z> || std::is_void_v<OZ> || std::is_void_v<Z>) )
-			constexpr explicit
+			constexpr explicit(!detail::copies_axes<X, Y, Z, OX, OY, OZ>)
 			Vec(Vec<OX, OY, OZ> const& ovec)
 			noexcept(noexcept(base(static_cast<value_type_x>(ovec.x), static_cast<value_type_y>(ovec.y), static_cast<value_type_z>(ovec.z))))
 			: base(static_cast<value_type_x>(ovec.x), static_cast<value_type_y>(ovec.y), static_cast<value_type_z>(ovec.z)) {}
 			
 			
 			
+			public: template<vec_expression E>
+			requires(
+					std::is_constructible_v<value_type_x, decltype(std::declval<E const&>().x())>
+				&&	std::is_constructible_v<value_type_y, decltype(std::declval<E const&>().y())>
+				&&	std::is_constructible_v<value_type_z, decltype(std::declval<E const&>().z())> )
+			constexpr
+			Vec(E const& e)
+			noexcept(noexcept(base(e.x(), e.y(), e.z())))
+			: base(e.x(), e.y(), e.z()) {}
+			
+			
+			
 			// Returns the dot product of this and the rhs vector.
 			template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
 			requires requires(value_type_x lx, value_type_y ly, value_type_z lz, RVec r) { {lx * r.x}; {ly * r.y}; {lz * r.z}; }
-			constexpr decltype(auto)
+			INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
 			dot(Vec<OX, OY, OZ> const& rhs) const
 			noexcept( requires(value_type_x lx, value_type_y ly, value_type_z lz, RVec r) { {lx * r.x} noexcept; {ly * r.y} noexcept; {lz * r.z} noexcept; } )
 			{ return (this->x * rhs.x) + (this->y * rhs.y) + (this->z * rhs.z); }
 			
 			// Returns the cross product of this and the rhs vector.
 			template<typename RX, typename RY, typename RZ, typename RVec = Vec<RX, RY, RZ>>
-			requires requires(value_type_x lx, value_type_x ly, value_type_x lz, RVec r) { {generic_vec::Vec((ly * r.z), -(lz * r.x), (lx * r.y))}; }
-			constexpr decltype(auto)
+			requires requires(value_type_x lx, value_type_x ly, value_type_x lz, RVec r) { {generic_vec::Vec((ly * r.z), (lz * r.x), (lx * r.y))}; }
+			INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
 			cross(Vec<RX, RY, RZ> const& rhs) const {
 				
-				auto&& [lxc, rxc] = [&]() {
-					auto&& [ly, rz] = DefaultToNoState(this->y, rhs.z);
-					auto&& [lz, ry] = DefaultToNoState(this->z, rhs.y);
-					return std::make_tuple(ly * rz, lz * ry);
-				}();
+				using detail::masked;
+				using detail::has_axis;
+				using detail::XYZ;
 				
-				auto&& [lyc, ryc] = [&]() {
-					auto&& [lx, rz] = DefaultToNoState(this->x, rhs.z);
-					auto&& [lz, rx] = DefaultToNoState(this->z, rhs.x);
-					return std::make_tuple(lx * rz, lz * rx);
-				}();
+				// A product only exists where both of its axes do.
+				constexpr bool yz = has_axis<axes, XYZ::Y> && has_axis<RVec::axes, XYZ::Z>;
+				constexpr bool zy = has_axis<axes, XYZ::Z> && has_axis<RVec::axes, XYZ::Y>;
+				constexpr bool zx = has_axis<axes, XYZ::Z> && has_axis<RVec::axes, XYZ::X>;
+				constexpr bool xz = has_axis<axes, XYZ::X> && has_axis<RVec::axes, XYZ::Z>;
+				constexpr bool xy = has_axis<axes, XYZ::X> && has_axis<RVec::axes, XYZ::Y>;
+				constexpr bool yx = has_axis<axes, XYZ::Y> && has_axis<RVec::axes, XYZ::X>;
 				
-				auto&& [lzc, rzc] = [&]() {
-					auto&& [lx, ry] = DefaultToNoState(this->x, rhs.y);
-					auto&& [ly, rx] = DefaultToNoState(this->y, rhs.x);
-					return std::make_tuple(lx * ry, ly * rx);
-				}();
-				
-				auto&& x = lxc - rxc;
-				auto&& y = lyc - ryc;
-				auto&& z = lzc - rzc;
-				
-				return generic_vec::Vec(x, -y, z);
+				return generic_vec::Vec{
+					(masked<yz>(this->y) * masked<yz>(rhs.z)) - (masked<zy>(this->z) * masked<zy>(rhs.y)),
+					(masked<zx>(this->z) * masked<zx>(rhs.x)) - (masked<xz>(this->x) * masked<xz>(rhs.z)),
+					(masked<xy>(this->x) * masked<xy>(rhs.y)) - (masked<yx>(this->y) * masked<yx>(rhs.x)) };
 			}
 			
 			// Returns the magnitude of the vector squared. Cheaper than directly getting the magnitude.
-			constexpr decltype(auto)
+			INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
 			mag2() const
 			noexcept(requires(Vec<X, Y, Z> const& v) { {v.dot(v)} noexcept; })
 			{ return dot(*this); }
 			
+			// dot(), accumulated with fused multiply-adds where the axes allow it: fewer instructions and a single rounding per axis.
+			template<typename OX, typename OY, typename OZ>
+			requires requires(Vec<X, Y, Z> const& l, Vec<OX, OY, OZ> const& r) { {detail::fused_mul_add(l.x, r.x, detail::fused_mul_add(l.y, r.y, l.z * r.z))}; }
+			INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+			dot_fma(Vec<OX, OY, OZ> const& rhs) const
+			noexcept(noexcept(detail::fused_mul_add(this->x, rhs.x, detail::fused_mul_add(this->y, rhs.y, this->z * rhs.z))))
+			{ return detail::fused_mul_add(this->x, rhs.x, detail::fused_mul_add(this->y, rhs.y, this->z * rhs.z)); }
+			
+			// mag2(), accumulated with fused multiply-adds. See dot_fma().
+			INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+			mag2_fma() const
+			noexcept(requires(Vec<X, Y, Z> const& v) { {v.dot_fma(v)} noexcept; })
+			{ return dot_fma(*this); }
+			
+			// Returns the magnitude (length) of the vector. See Precision for the tiers.
+			template<Precision precision = Precision::Exact>
+			requires requires(Vec<X, Y, Z> const& v) { {detail::sqrt<precision>(v.mag2())}; }
+			INK_GENERIC_VEC_FORCE_INLINE decltype(auto)
+			mag() const
+			{ return detail::sqrt<precision>(mag2()); }
+			
+			// Returns 1 / mag(). Not finite for the zero vector.
+			template<Precision precision = Precision::Exact>
+			requires requires(Vec<X, Y, Z> const& v) { {detail::inv_sqrt<precision>(v.mag2())}; }
+			INK_GENERIC_VEC_FORCE_INLINE decltype(auto)
+			inv_mag() const
+			{ return detail::inv_sqrt<precision>(mag2()); }
+			
+			// Returns the vector scaled to a magnitude of 1, by a single multiplication with inv_mag(). NaN for the zero vector.
+			template<Precision precision = Precision::Exact>
+			requires requires(Vec<X, Y, Z> const& v) { {v * v.template inv_mag<precision>()}; }
+			INK_GENERIC_VEC_FORCE_INLINE decltype(auto)
+			normalize() const
+			{ return *this * inv_mag<precision>(); }
+			
+			// Returns the magnitude of (this - rhs) squared.
+			template<typename OX, typename OY, typename OZ>
+			requires requires(Vec<X, Y, Z> const& l, Vec<OX, OY, OZ> const& r) { {(l - r).mag2()}; }
+			INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+			distance2(Vec<OX, OY, OZ> const& rhs) const
+			{ return (*this - rhs).mag2(); }
+			
+			// Returns the magnitude of (this - rhs). See Precision for the tiers.
+			template<Precision precision = Precision::Exact, typename OX, typename OY, typename OZ>
+			requires requires(Vec<X, Y, Z> const& l, Vec<OX, OY, OZ> const& r) { {detail::sqrt<precision>(l.distance2(r))}; }
+			INK_GENERIC_VEC_FORCE_INLINE decltype(auto)
+			distance(Vec<OX, OY, OZ> const& rhs) const
+			{ return detail::sqrt<precision>(distance2(rhs)); }
+			
 			
 			
 			public: template<typename OX, typename OY, typename OZ>
@@ -929,23 +1244,257 @@ namespace ink {
 				this->z = static_cast<std::remove_reference_t<value_type_z>>(other.z);
 			}
 			
-			public: friend constexpr decltype(auto)
+			// Evaluates every axis of the expression before assigning any, as the eager operators would:
+			// an expression that reads this vector sees none of its new values.
+			public: template<vec_expression E>
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator=(E const& e)
+			noexcept(noexcept(this->x = e.x()) && noexcept(this->y = e.y()) && noexcept(this->z = e.z()))
+			{
+				auto x = e.x();
+				auto y = e.y();
+				auto z = e.z();
+				this->x = std::move(x);
+				this->y = std::move(y);
+				this->z = std::move(z);
+				return *this;
+			}
+			
+			// Compound assignment, in place. Also writes through reference axes, and leaves 'void' axes alone, as well as
+			// the axes the rhs has none for: a += b gives what a = a + b does.
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_add_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator+=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_add_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x += rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y += rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z += rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_add_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator+=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_add_assign_t, Vec, T, true>{}())
+			{ this->x += rhs; this->y += rhs; this->z += rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_sub_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator-=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_sub_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x -= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y -= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z -= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_sub_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator-=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_sub_assign_t, Vec, T, true>{}())
+			{ this->x -= rhs; this->y -= rhs; this->z -= rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_mul_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator*=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_mul_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x *= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y *= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z *= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_mul_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator*=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_mul_assign_t, Vec, T, true>{}())
+			{ this->x *= rhs; this->y *= rhs; this->z *= rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_div_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator/=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_div_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x /= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y /= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z /= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_div_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator/=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_div_assign_t, Vec, T, true>{}())
+			{ this->x /= rhs; this->y /= rhs; this->z /= rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_mod_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator%=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_mod_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x %= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y %= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z %= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_mod_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator%=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_mod_assign_t, Vec, T, true>{}())
+			{ this->x %= rhs; this->y %= rhs; this->z %= rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_bitwise_and_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator&=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_bitwise_and_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x &= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y &= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z &= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_bitwise_and_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator&=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_bitwise_and_assign_t, Vec, T, true>{}())
+			{ this->x &= rhs; this->y &= rhs; this->z &= rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_bitwise_or_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator|=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_bitwise_or_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x |= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y |= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z |= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_bitwise_or_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator|=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_bitwise_or_assign_t, Vec, T, true>{}())
+			{ this->x |= rhs; this->y |= rhs; this->z |= rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_bitwise_xor_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator^=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_bitwise_xor_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x ^= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y ^= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z ^= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_bitwise_xor_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator^=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_bitwise_xor_assign_t, Vec, T, true>{}())
+			{ this->x ^= rhs; this->y ^= rhs; this->z ^= rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_shift_left_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator<<=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_shift_left_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x <<= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y <<= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z <<= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_shift_left_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator<<=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_shift_left_assign_t, Vec, T, true>{}())
+			{ this->x <<= rhs; this->y <<= rhs; this->z <<= rhs; return *this; }
+			
+			
+			
+			public: template<typename OX, typename OY, typename OZ, typename RVec = Vec<OX, OY, OZ>>
+			requires( AssignConstraint_t<concepts::can_shift_right_assign_t, Vec, RVec>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator>>=(Vec<OX, OY, OZ> const& rhs)
+			noexcept(AssignConstraint_t<concepts::can_shift_right_assign_t, Vec, RVec, true>{}())
+			{
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::X>) this->x >>= rhs.x;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Y>) this->y >>= rhs.y;
+				if constexpr(detail::has_axis<RVec::axes, detail::XYZ::Z>) this->z >>= rhs.z;
+				return *this;
+			}
+			
+			public: template<typename T>
+			requires( OpConstraint_t<concepts::can_shift_right_assign_t, Vec, T>{}() )
+			INK_GENERIC_VEC_FORCE_INLINE constexpr Vec&
+			operator>>=(T const& rhs)
+			noexcept(OpConstraint_t<concepts::can_shift_right_assign_t, Vec, T, true>{}())
+			{ this->x >>= rhs; this->y >>= rhs; this->z >>= rhs; return *this; }
+			
+			
+			
+			public: INK_GENERIC_VEC_FORCE_INLINE friend constexpr decltype(auto)
 			operator+(Vec const& vec)
 			noexcept( noexcept(+vec.x) && noexcept(+vec.y) && noexcept(+vec.z) )
 			requires(concepts::can_unary_add<value_type_x> && concepts::can_unary_add<value_type_y> && concepts::can_unary_add<value_type_z>)
-			{ return generic_vec::Vec(+vec.x, +vec.y, +vec.z); }
+			{ return generic_vec::Vec{+vec.x, +vec.y, +vec.z}; }
 			
-			public: friend constexpr decltype(auto)
+			public: INK_GENERIC_VEC_FORCE_INLINE friend constexpr decltype(auto)
 			operator-(Vec const& vec)
 			noexcept( noexcept(-vec.x) && noexcept(-vec.y) && noexcept(-vec.z) )
 			requires(concepts::can_unary_sub<value_type_x> && concepts::can_unary_sub<value_type_y> && concepts::can_unary_sub<value_type_z>)
-			{ return generic_vec::Vec(-vec.x, -vec.y, -vec.z); }
+			{ return generic_vec::Vec{-vec.x, -vec.y, -vec.z}; }
 			
-			public: friend constexpr decltype(auto)
+			public: INK_GENERIC_VEC_FORCE_INLINE friend constexpr decltype(auto)
 			operator!(Vec const& vec)
 			noexcept( noexcept(!vec.x) && noexcept(!vec.y) && noexcept(!vec.z) )
 			requires(concepts::can_logical_not<value_type_x> && concepts::can_logical_not<value_type_y> && concepts::can_logical_not<value_type_z>)
-			{ return generic_vec::Vec(!vec.x, !vec.y, !vec.z); }
+			{ return generic_vec::Vec{!vec.x, !vec.y, !vec.z}; }
+			
+			public: INK_GENERIC_VEC_FORCE_INLINE friend constexpr decltype(auto)
+			operator~(Vec const& vec)
+			noexcept( noexcept(~vec.x) && noexcept(~vec.y) && noexcept(~vec.z) )
+			requires(concepts::can_bitwise_not<value_type_x> && concepts::can_bitwise_not<value_type_y> && concepts::can_bitwise_not<value_type_z>)
+			{ return generic_vec::Vec{~vec.x, ~vec.y, ~vec.z}; }
 			
 		};
 		
@@ -969,10 +1518,40 @@ namespace ink {
 	
 	using generic_vec::Vec;
 	using generic_vec::NoState;
+	using generic_vec::Precision;
+	
+	namespace generic_vec::detail {
+		
+		// True when an array of Vec<T> has the same memory layout as an array of T three times as long, in x, y, z order.
+		template<typename T>
+		concept interleaved_layout =
+			std::is_trivially_copyable_v<T> &&
+			sizeof(Vec<T>) == 3 * sizeof(T) &&
+			std::bit_cast<std::array<T, 3>>(Vec<T>(T(1), T(2), T(3))) == std::array<T, 3>{T(1), T(2), T(3)};
+		
+	}
 	
 	namespace generic_vec {
 		
-		template<template<typename...> typename Constraint, typename LHS, typename RHS, bool MustBeNoexcept = false>
+		/**
+		 * True when Vec<X, Y, Z> may be copied and relocated as raw bytes, by std::memcpy, std::memmove or std::bit_cast,
+		 * and its arrays begin their lifetime in raw memory, as an implicit-lifetime type: trivially copyable, with a trivial
+		 * copy constructor and a trivial destructor. Holds for arithmetic axes, and void ones.
+		 * Vec is not standard-layout, each axis living in a base class of its own; none of the above needs it.
+		 */
+		template<typename V>
+		concept bitwise_copyable =
+			std::is_trivially_copyable_v<V> &&
+			std::is_trivially_copy_constructible_v<V> &&
+			std::is_trivially_destructible_v<V>;
+		
+	}
+	
+	using generic_vec::bitwise_copyable;
+	
+	namespace generic_vec {
+		
+		template<template<typename...> typename Constraint, typename LHS, typename RHS, bool MustBeNoexcept>
 		struct OpConstraint_t: std::bool_constant<(Constraint<LHS, RHS, std::bool_constant<MustBeNoexcept> >{}())> {};
 		
 		// Vectorial Operation.
@@ -989,7 +1568,7 @@ namespace ink {
 		// Scalar Operation. Scalar Right Hand Side.
 		template<typename LX, typename LY, typename LZ, typename RHS,
 		template<typename...> typename Constraint, bool MustBeNoexcept>
-		requires(!concepts::same_template<RHS, Vec<void>>)
+		requires(!detail::derives_from_vec<RHS> && !vec_expression<RHS>)
 		struct OpConstraint_t<Constraint, Vec<LX, LY, LZ>, RHS, MustBeNoexcept>:
 		std::bool_constant<(
 				Constraint<typename Vec<LX, LY, LZ>::value_type_x, RHS, std::bool_constant<MustBeNoexcept> >{}()
@@ -998,114 +1577,154 @@ namespace ink {
 		)> {};
 		
 		// Scalar Operation. Scalar Left Hand Side.
+		// The operators mask the scalar to NoState on 'void' axes, so that 2 / Vec<int, void, int> divides no integer by NoState.
 		template<typename RX, typename RY, typename RZ, typename LHS,
 		template<typename...> typename Constraint, bool MustBeNoexcept>
-		requires(!concepts::same_template<LHS, Vec<void>>)
+		requires(!detail::derives_from_vec<LHS> && !vec_expression<LHS>)
 		struct OpConstraint_t<Constraint, LHS, Vec<RX, RY, RZ>, MustBeNoexcept>:
 		std::bool_constant<(
-				Constraint<LHS, typename Vec<RX, RY, RZ>::value_type_x, std::bool_constant<MustBeNoexcept> >{}()
-			&&	Constraint<LHS, typename Vec<RX, RY, RZ>::value_type_y, std::bool_constant<MustBeNoexcept> >{}()
-			&&	Constraint<LHS, typename Vec<RX, RY, RZ>::value_type_z, std::bool_constant<MustBeNoexcept> >{}()
+				Constraint<std::conditional_t<std::is_void_v<RX>, NoState, LHS>, typename Vec<RX, RY, RZ>::value_type_x, std::bool_constant<MustBeNoexcept> >{}()
+			&&	Constraint<std::conditional_t<std::is_void_v<RY>, NoState, LHS>, typename Vec<RX, RY, RZ>::value_type_y, std::bool_constant<MustBeNoexcept> >{}()
+			&&	Constraint<std::conditional_t<std::is_void_v<RZ>, NoState, LHS>, typename Vec<RX, RY, RZ>::value_type_z, std::bool_constant<MustBeNoexcept> >{}()
+		)> {};
+		
+		// Expressions are not scalars; operations mixing them with a Vec are left to the expression's own operators.
+		// Neither are classes derived from a Vec: mixed with another Vec, they take the Vec operators, as the Vec they are.
+		template<typename LX, typename LY, typename LZ, typename RHS,
+		template<typename...> typename Constraint, bool MustBeNoexcept>
+		requires(vec_expression<RHS> || (detail::derives_from_vec<RHS> && !concepts::same_template<RHS, Vec<void>>))
+		struct OpConstraint_t<Constraint, Vec<LX, LY, LZ>, RHS, MustBeNoexcept>: std::false_type {};
+		
+		template<typename RX, typename RY, typename RZ, typename LHS,
+		template<typename...> typename Constraint, bool MustBeNoexcept>
+		requires(vec_expression<LHS> || (detail::derives_from_vec<LHS> && !concepts::same_template<LHS, Vec<void>>))
+		struct OpConstraint_t<Constraint, LHS, Vec<RX, RY, RZ>, MustBeNoexcept>: std::false_type {};
+		
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+		template<typename...> typename Constraint, bool MustBeNoexcept>
+		struct AssignConstraint_t<Constraint, Vec<LX, LY, LZ>, Vec<RX, RY, RZ>, MustBeNoexcept >:
+		std::bool_constant<(
+				(std::is_void_v<RX> || Constraint<typename Vec<LX, LY, LZ>::value_type_x, typename Vec<RX, RY, RZ>::value_type_x, std::bool_constant<MustBeNoexcept>>{}())
+			&&	(std::is_void_v<RY> || Constraint<typename Vec<LX, LY, LZ>::value_type_y, typename Vec<RX, RY, RZ>::value_type_y, std::bool_constant<MustBeNoexcept>>{}())
+			&&	(std::is_void_v<RZ> || Constraint<typename Vec<LX, LY, LZ>::value_type_z, typename Vec<RX, RY, RZ>::value_type_z, std::bool_constant<MustBeNoexcept>>{}())
 		)> {};
 		
 		
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_mul_t, OVec, T>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator*(Vec<X, Y, Z> const& lhs, T const& rhs)
 		noexcept(OpConstraint_t<concepts::can_mul_t, OVec, T, true>{}()) {
-			auto&& [lx, rx] = DefaultToNoState(lhs.x, rhs);
-			auto&& [ly, ry] = DefaultToNoState(lhs.y, rhs);
-			auto&& [lz, rz] = DefaultToNoState(lhs.z, rhs);
-			return ink::Vec(lx * rx, ly * ry, lz * rz);
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				lhs.x * masked<has_axis<axes, detail::XYZ::X>>(rhs),
+				lhs.y * masked<has_axis<axes, detail::XYZ::Y>>(rhs),
+				lhs.z * masked<has_axis<axes, detail::XYZ::Z>>(rhs) };
 		}
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_mul_t, T, OVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator*(T const& lhs, Vec<X, Y, Z> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_mul_t, T, OVec, true>{}()) {
-			auto&& [lx, rx] = DefaultToNoState(lhs, rhs.x);
-			auto&& [ly, ry] = DefaultToNoState(lhs, rhs.y);
-			auto&& [lz, rz] = DefaultToNoState(lhs, rhs.z);
-			return ink::Vec(lx * rx, ly * ry, lz * rz);
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(lhs) * rhs.x,
+				masked<has_axis<axes, detail::XYZ::Y>>(lhs) * rhs.y,
+				masked<has_axis<axes, detail::XYZ::Z>>(lhs) * rhs.z };
 		}
 		
 		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_mul_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator*(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_mul_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z); }
+		{ return ink::Vec{lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z}; }
 		
 		
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_div_t, OVec, T>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator/(Vec<X, Y, Z> const& lhs, T const& rhs)
 		noexcept(OpConstraint_t<concepts::can_div_t, OVec, T, true>{}()) {
-			auto&& [lx, rx] = DefaultToNoState(lhs.x, rhs);
-			auto&& [ly, ry] = DefaultToNoState(lhs.y, rhs);
-			auto&& [lz, rz] = DefaultToNoState(lhs.z, rhs);
-			return ink::Vec(lx / rx, ly / ry, lz / rz);
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				lhs.x / masked<has_axis<axes, detail::XYZ::X>>(rhs),
+				lhs.y / masked<has_axis<axes, detail::XYZ::Y>>(rhs),
+				lhs.z / masked<has_axis<axes, detail::XYZ::Z>>(rhs) };
 		}
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_div_t, T, OVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator/(T const& lhs, Vec<X, Y, Z> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_div_t, T, OVec, true>{}()) {
-			auto&& [lx, rx] = DefaultToNoState(lhs, rhs.x);
-			auto&& [ly, ry] = DefaultToNoState(lhs, rhs.y);
-			auto&& [lz, rz] = DefaultToNoState(lhs, rhs.z);
-			return ink::Vec(lx / rx, ly / ry, lz / rz);
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(lhs) / rhs.x,
+				masked<has_axis<axes, detail::XYZ::Y>>(lhs) / rhs.y,
+				masked<has_axis<axes, detail::XYZ::Z>>(lhs) / rhs.z };
 		}
 		
 		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_div_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator/(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_div_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z); }
+		{ return ink::Vec{lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z}; }
 		
 		
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_mod_t, OVec, T>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator%(Vec<X, Y, Z> const& lhs, T const& rhs)
 		noexcept(OpConstraint_t<concepts::can_mod_t, OVec, T, true>{}()) {
-			auto&& [lx, rx] = DefaultToNoState(lhs.x, rhs);
-			auto&& [ly, ry] = DefaultToNoState(lhs.y, rhs);
-			auto&& [lz, rz] = DefaultToNoState(lhs.z, rhs);
-			return ink::Vec(lx % rx, ly % ry, lz % rz);
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				lhs.x % masked<has_axis<axes, detail::XYZ::X>>(rhs),
+				lhs.y % masked<has_axis<axes, detail::XYZ::Y>>(rhs),
+				lhs.z % masked<has_axis<axes, detail::XYZ::Z>>(rhs) };
 		}
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_mod_t, T, OVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator%(T const& lhs, Vec<X, Y, Z> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_mod_t, T, OVec, true>{}()) {
-			auto&& [lx, rx] = DefaultToNoState(lhs, rhs.x);
-			auto&& [ly, ry] = DefaultToNoState(lhs, rhs.y);
-			auto&& [lz, rz] = DefaultToNoState(lhs, rhs.z);
-			return ink::Vec(lx % rx, ly % ry, lz % rz);
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(lhs) % rhs.x,
+				masked<has_axis<axes, detail::XYZ::Y>>(lhs) % rhs.y,
+				masked<has_axis<axes, detail::XYZ::Z>>(lhs) % rhs.z };
 		}
 		
 		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_mod_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator%(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_mod_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x % rhs.x, lhs.y % rhs.y, lhs.z % rhs.z); }
+		{ return ink::Vec{lhs.x % rhs.x, lhs.y % rhs.y, lhs.z % rhs.z}; }
 		
 		
 		
@@ -1113,10 +1732,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_add_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator+(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_add_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z); }
+		{ return ink::Vec{lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z}; }
 		
 		
 		
@@ -1124,10 +1743,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_sub_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator-(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_sub_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z); }
+		{ return ink::Vec{lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z}; }
 		
 		
 		
@@ -1135,10 +1754,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_cmp_eq_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator==(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_cmp_eq_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x == rhs.x, lhs.y == rhs.y, lhs.z == rhs.z); }
+		{ return ink::Vec{lhs.x == rhs.x, lhs.y == rhs.y, lhs.z == rhs.z}; }
 		
 		
 		
@@ -1146,10 +1765,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_cmp_neq_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator!=(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_cmp_neq_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x != rhs.x, lhs.y != rhs.y, lhs.z != rhs.z); }
+		{ return ink::Vec{lhs.x != rhs.x, lhs.y != rhs.y, lhs.z != rhs.z}; }
 		
 		
 		
@@ -1157,10 +1776,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_cmp_threeway_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator<=>(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_cmp_threeway_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x <=> rhs.x, lhs.y <=> rhs.y, lhs.z <=> rhs.z); }
+		{ return ink::Vec{lhs.x <=> rhs.x, lhs.y <=> rhs.y, lhs.z <=> rhs.z}; }
 		
 		
 		
@@ -1168,10 +1787,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_cmp_greater_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator>(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_cmp_neq_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x > rhs.x, lhs.y > rhs.y, lhs.z > rhs.z); }
+		{ return ink::Vec{lhs.x > rhs.x, lhs.y > rhs.y, lhs.z > rhs.z}; }
 		
 		
 		
@@ -1179,10 +1798,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_cmp_less_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator<(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_cmp_less_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x < rhs.x, lhs.y < rhs.y, lhs.z < rhs.z); }
+		{ return ink::Vec{lhs.x < rhs.x, lhs.y < rhs.y, lhs.z < rhs.z}; }
 		
 		
 		
@@ -1190,10 +1809,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_cmp_greater_eq_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator>=(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_cmp_greater_eq_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x >= rhs.x, lhs.y >= rhs.y, lhs.z >= rhs.z); }
+		{ return ink::Vec{lhs.x >= rhs.x, lhs.y >= rhs.y, lhs.z >= rhs.z}; }
 		
 		
 		
@@ -1201,10 +1820,10 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_cmp_less_eq_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator<=(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_cmp_less_eq_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x <= rhs.x, lhs.y <= rhs.y, lhs.z <= rhs.z); }
+		{ return ink::Vec{lhs.x <= rhs.x, lhs.y <= rhs.y, lhs.z <= rhs.z}; }
 		
 		
 		
@@ -1212,24 +1831,24 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_logical_and_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator&&(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_logical_and_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x && rhs.x, lhs.y && rhs.y, lhs.z && rhs.z); }
+		{ return ink::Vec{lhs.x && rhs.x, lhs.y && rhs.y, lhs.z && rhs.z}; }
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_logical_and_t, OVec, T>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator&&(Vec<X, Y, Z> const& lhs, T const& rhs)
 		noexcept(OpConstraint_t<concepts::can_logical_and_t, OVec, T, true>{}())
-		{ return ink::Vec(lhs.x && rhs, lhs.y && rhs, lhs.z && rhs); }
+		{ return ink::Vec{lhs.x && rhs, lhs.y && rhs, lhs.z && rhs}; }
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_logical_and_t, T, OVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator&&(T const& lhs, Vec<X, Y, Z> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_logical_and_t, T, OVec, true>{}())
-		{ return ink::Vec(lhs && rhs.x, lhs && rhs.y, lhs && rhs.z); }
+		{ return ink::Vec{lhs && rhs.x, lhs && rhs.y, lhs && rhs.z}; }
 		
 		
 		
@@ -1237,27 +1856,354 @@ namespace ink {
 			typename LVec = Vec<LX, LY, LZ>,
 			typename RVec = Vec<RX, RY, RZ>>
 		requires( OpConstraint_t<concepts::can_logical_or_t, LVec, RVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator||(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_logical_or_t, LVec, RVec, true>{}())
-		{ return ink::Vec(lhs.x || rhs.x, lhs.y || rhs.y, lhs.z || rhs.z); }
+		{ return ink::Vec{lhs.x || rhs.x, lhs.y || rhs.y, lhs.z || rhs.z}; }
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_logical_or_t, OVec, T>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator||(Vec<X, Y, Z> const& lhs, T const& rhs)
 		noexcept(OpConstraint_t<concepts::can_logical_or_t, OVec, T, true>{}())
-		{ return ink::Vec(lhs.x || rhs, lhs.y || rhs, lhs.z || rhs); }
+		{ return ink::Vec{lhs.x || rhs, lhs.y || rhs, lhs.z || rhs}; }
 		
 		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
 		requires( OpConstraint_t<concepts::can_logical_or_t, T, OVec>{}() )
-		static constexpr decltype(auto)
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
 		operator||(T const& lhs, Vec<X, Y, Z> const& rhs)
 		noexcept(OpConstraint_t<concepts::can_logical_or_t, T, OVec, true>{}())
-		{ return ink::Vec(lhs || rhs.x, lhs || rhs.y, lhs || rhs.z); }
+		{ return ink::Vec{lhs || rhs.x, lhs || rhs.y, lhs || rhs.z}; }
+		
+		
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_bitwise_and_t, OVec, T>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator&(Vec<X, Y, Z> const& lhs, T const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_and_t, OVec, T, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				lhs.x & masked<has_axis<axes, detail::XYZ::X>>(rhs),
+				lhs.y & masked<has_axis<axes, detail::XYZ::Y>>(rhs),
+				lhs.z & masked<has_axis<axes, detail::XYZ::Z>>(rhs) };
+		}
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_bitwise_and_t, T, OVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator&(T const& lhs, Vec<X, Y, Z> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_and_t, T, OVec, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(lhs) & rhs.x,
+				masked<has_axis<axes, detail::XYZ::Y>>(lhs) & rhs.y,
+				masked<has_axis<axes, detail::XYZ::Z>>(lhs) & rhs.z };
+		}
+		
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_bitwise_and_t, LVec, RVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator&(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_and_t, LVec, RVec, true>{}())
+		{ return ink::Vec{lhs.x & rhs.x, lhs.y & rhs.y, lhs.z & rhs.z}; }
+		
+		
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_bitwise_or_t, OVec, T>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator|(Vec<X, Y, Z> const& lhs, T const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_or_t, OVec, T, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				lhs.x | masked<has_axis<axes, detail::XYZ::X>>(rhs),
+				lhs.y | masked<has_axis<axes, detail::XYZ::Y>>(rhs),
+				lhs.z | masked<has_axis<axes, detail::XYZ::Z>>(rhs) };
+		}
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_bitwise_or_t, T, OVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator|(T const& lhs, Vec<X, Y, Z> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_or_t, T, OVec, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(lhs) | rhs.x,
+				masked<has_axis<axes, detail::XYZ::Y>>(lhs) | rhs.y,
+				masked<has_axis<axes, detail::XYZ::Z>>(lhs) | rhs.z };
+		}
+		
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_bitwise_or_t, LVec, RVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator|(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_or_t, LVec, RVec, true>{}())
+		{ return ink::Vec{lhs.x | rhs.x, lhs.y | rhs.y, lhs.z | rhs.z}; }
+		
+		
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_bitwise_xor_t, OVec, T>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator^(Vec<X, Y, Z> const& lhs, T const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_xor_t, OVec, T, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				lhs.x ^ masked<has_axis<axes, detail::XYZ::X>>(rhs),
+				lhs.y ^ masked<has_axis<axes, detail::XYZ::Y>>(rhs),
+				lhs.z ^ masked<has_axis<axes, detail::XYZ::Z>>(rhs) };
+		}
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_bitwise_xor_t, T, OVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator^(T const& lhs, Vec<X, Y, Z> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_xor_t, T, OVec, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(lhs) ^ rhs.x,
+				masked<has_axis<axes, detail::XYZ::Y>>(lhs) ^ rhs.y,
+				masked<has_axis<axes, detail::XYZ::Z>>(lhs) ^ rhs.z };
+		}
+		
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_bitwise_xor_t, LVec, RVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator^(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_bitwise_xor_t, LVec, RVec, true>{}())
+		{ return ink::Vec{lhs.x ^ rhs.x, lhs.y ^ rhs.y, lhs.z ^ rhs.z}; }
+		
+		
+		
+		// The scalar operand of a shift must be an integer, so that 'stream << vec' is never mistaken for a shift of each axis.
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_shift_left_t, OVec, T>{}() && std::integral<T> )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator<<(Vec<X, Y, Z> const& lhs, T const& rhs)
+		noexcept(OpConstraint_t<concepts::can_shift_left_t, OVec, T, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				lhs.x << masked<has_axis<axes, detail::XYZ::X>>(rhs),
+				lhs.y << masked<has_axis<axes, detail::XYZ::Y>>(rhs),
+				lhs.z << masked<has_axis<axes, detail::XYZ::Z>>(rhs) };
+		}
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_shift_left_t, T, OVec>{}() && std::integral<T> )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator<<(T const& lhs, Vec<X, Y, Z> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_shift_left_t, T, OVec, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(lhs) << rhs.x,
+				masked<has_axis<axes, detail::XYZ::Y>>(lhs) << rhs.y,
+				masked<has_axis<axes, detail::XYZ::Z>>(lhs) << rhs.z };
+		}
+		
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_shift_left_t, LVec, RVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator<<(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_shift_left_t, LVec, RVec, true>{}())
+		{ return ink::Vec{lhs.x << rhs.x, lhs.y << rhs.y, lhs.z << rhs.z}; }
+		
+		
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_shift_right_t, OVec, T>{}() && std::integral<T> )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator>>(Vec<X, Y, Z> const& lhs, T const& rhs)
+		noexcept(OpConstraint_t<concepts::can_shift_right_t, OVec, T, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				lhs.x >> masked<has_axis<axes, detail::XYZ::X>>(rhs),
+				lhs.y >> masked<has_axis<axes, detail::XYZ::Y>>(rhs),
+				lhs.z >> masked<has_axis<axes, detail::XYZ::Z>>(rhs) };
+		}
+		
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_shift_right_t, T, OVec>{}() && std::integral<T> )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator>>(T const& lhs, Vec<X, Y, Z> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_shift_right_t, T, OVec, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(lhs) >> rhs.x,
+				masked<has_axis<axes, detail::XYZ::Y>>(lhs) >> rhs.y,
+				masked<has_axis<axes, detail::XYZ::Z>>(lhs) >> rhs.z };
+		}
+		
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_shift_right_t, LVec, RVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		operator>>(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+		noexcept(OpConstraint_t<concepts::can_shift_right_t, LVec, RVec, true>{}())
+		{ return ink::Vec{lhs.x >> rhs.x, lhs.y >> rhs.y, lhs.z >> rhs.z}; }
+		
+		
+		
+		/**
+		 * Returns 'a * b + c', computed axis by axis with a single fused multiply-add where the axis type allows it
+		 * (see detail::fused_mul_add), and without the temporary that the two operators would need.
+		 * Found by argument-dependent lookup, and deliberately not brought into ink, where it would hide std::fma from
+		 * unqualified calls on scalars.
+		 */
+		template<typename AX, typename AY, typename AZ, typename BX, typename BY, typename BZ, typename CX, typename CY, typename CZ>
+		requires requires(Vec<AX, AY, AZ> const& a, Vec<BX, BY, BZ> const& b, Vec<CX, CY, CZ> const& c) {
+			{ink::Vec{detail::fused_mul_add(a.x, b.x, c.x), detail::fused_mul_add(a.y, b.y, c.y), detail::fused_mul_add(a.z, b.z, c.z)}}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		fma(Vec<AX, AY, AZ> const& a, Vec<BX, BY, BZ> const& b, Vec<CX, CY, CZ> const& c)
+		noexcept(noexcept(ink::Vec{detail::fused_mul_add(a.x, b.x, c.x), detail::fused_mul_add(a.y, b.y, c.y), detail::fused_mul_add(a.z, b.z, c.z)}))
+		{ return ink::Vec{detail::fused_mul_add(a.x, b.x, c.x), detail::fused_mul_add(a.y, b.y, c.y), detail::fused_mul_add(a.z, b.z, c.z)}; }
+		
+		// Returns 'a * s + c', for a scalar 's'.
+		template<typename AX, typename AY, typename AZ, typename S, typename CX, typename CY, typename CZ>
+		requires(!detail::derives_from_vec<S> && !vec_expression<S>) &&
+		requires(Vec<AX, AY, AZ> const& a, S const& s, Vec<CX, CY, CZ> const& c) {
+			{ink::Vec{detail::fused_mul_add(a.x, s, c.x), detail::fused_mul_add(a.y, s, c.y), detail::fused_mul_add(a.z, s, c.z)}}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		fma(Vec<AX, AY, AZ> const& a, S const& s, Vec<CX, CY, CZ> const& c)
+		noexcept(noexcept(ink::Vec{detail::fused_mul_add(a.x, s, c.x), detail::fused_mul_add(a.y, s, c.y), detail::fused_mul_add(a.z, s, c.z)})) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = Vec<AX, AY, AZ>::axes;
+			return ink::Vec{
+				detail::fused_mul_add(a.x, masked<has_axis<axes, detail::XYZ::X>>(s), c.x),
+				detail::fused_mul_add(a.y, masked<has_axis<axes, detail::XYZ::Y>>(s), c.y),
+				detail::fused_mul_add(a.z, masked<has_axis<axes, detail::XYZ::Z>>(s), c.z) };
+		}
+		
+		// Returns 's * x + y', the BLAS 'axpy' update, for a scalar 's'.
+		template<typename S, typename XX, typename XY, typename XZ, typename YX, typename YY, typename YZ>
+		requires requires(S const& s, Vec<XX, XY, XZ> const& x, Vec<YX, YY, YZ> const& y) { {generic_vec::fma(x, s, y)}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		axpy(S const& s, Vec<XX, XY, XZ> const& x, Vec<YX, YY, YZ> const& y)
+		noexcept(noexcept(generic_vec::fma(x, s, y)))
+		{ return generic_vec::fma(x, s, y); }
+		
+		
+		
+		namespace detail {
+			
+			template<typename L, typename R>
+			INK_GENERIC_VEC_FORCE_INLINE constexpr auto
+			axis_min(L const& lhs, R const& rhs)
+			noexcept(noexcept(rhs < lhs ? rhs : lhs))
+			{ return rhs < lhs ? rhs : lhs; }
+			
+			INK_GENERIC_VEC_FORCE_INLINE constexpr NoState
+			axis_min(NoState, NoState)
+			noexcept { return NoState(); }
+			
+			template<typename L, typename R>
+			INK_GENERIC_VEC_FORCE_INLINE constexpr auto
+			axis_max(L const& lhs, R const& rhs)
+			noexcept(noexcept(lhs < rhs ? rhs : lhs))
+			{ return lhs < rhs ? rhs : lhs; }
+			
+			INK_GENERIC_VEC_FORCE_INLINE constexpr NoState
+			axis_max(NoState, NoState)
+			noexcept { return NoState(); }
+			
+		}
+		
+		// Returns the smaller of each pair of axes. Where they compare equal, or unordered, the axis of 'lhs' is kept.
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ>
+		requires requires(Vec<LX, LY, LZ> const& l, Vec<RX, RY, RZ> const& r) {
+			{ink::Vec{detail::axis_min(l.x, r.x), detail::axis_min(l.y, r.y), detail::axis_min(l.z, r.z)}}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		min(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+		noexcept(noexcept(ink::Vec{detail::axis_min(lhs.x, rhs.x), detail::axis_min(lhs.y, rhs.y), detail::axis_min(lhs.z, rhs.z)}))
+		{ return ink::Vec{detail::axis_min(lhs.x, rhs.x), detail::axis_min(lhs.y, rhs.y), detail::axis_min(lhs.z, rhs.z)}; }
+		
+		// Returns the larger of each pair of axes. Where they compare equal, or unordered, the axis of 'lhs' is kept.
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ>
+		requires requires(Vec<LX, LY, LZ> const& l, Vec<RX, RY, RZ> const& r) {
+			{ink::Vec{detail::axis_max(l.x, r.x), detail::axis_max(l.y, r.y), detail::axis_max(l.z, r.z)}}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		max(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+		noexcept(noexcept(ink::Vec{detail::axis_max(lhs.x, rhs.x), detail::axis_max(lhs.y, rhs.y), detail::axis_max(lhs.z, rhs.z)}))
+		{ return ink::Vec{detail::axis_max(lhs.x, rhs.x), detail::axis_max(lhs.y, rhs.y), detail::axis_max(lhs.z, rhs.z)}; }
+		
+		// Whether every axis holding state is true, as for the Vec<bool> that comparisons return. True with no axes at all.
+		template<typename X, typename Y, typename Z>
+		requires requires(Vec<X, Y, Z> const& v) { {bool(v.x)}; {bool(v.y)}; {bool(v.z)}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+		all(Vec<X, Y, Z> const& vec)
+		noexcept {
+			using detail::has_axis;
+			constexpr auto axes = Vec<X, Y, Z>::axes;
+			return
+				(!has_axis<axes, detail::XYZ::X> || bool(vec.x)) &&
+				(!has_axis<axes, detail::XYZ::Y> || bool(vec.y)) &&
+				(!has_axis<axes, detail::XYZ::Z> || bool(vec.z));
+		}
+		
+		// Whether any axis holding state is true. False with no axes at all.
+		template<typename X, typename Y, typename Z>
+		requires requires(Vec<X, Y, Z> const& v) { {bool(v.x)}; {bool(v.y)}; {bool(v.z)}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+		any(Vec<X, Y, Z> const& vec)
+		noexcept {
+			using detail::has_axis;
+			constexpr auto axes = Vec<X, Y, Z>::axes;
+			return
+				(has_axis<axes, detail::XYZ::X> && bool(vec.x)) ||
+				(has_axis<axes, detail::XYZ::Y> && bool(vec.y)) ||
+				(has_axis<axes, detail::XYZ::Z> && bool(vec.z));
+		}
 		
 	}
 	
+	using generic_vec::axpy;
+	using generic_vec::all;
+	using generic_vec::any;
+	
 }
 
+/**
+ * A Vec of references and the Vec of values it refers to have that Vec of values as their common reference, as an element
+ * of a VecView and its value_type: what makes iterators that yield reference proxies indirectly_readable.
+ */
+template<typename X, typename Y, typename Z, typename OX, typename OY, typename OZ, template<typename> typename XQ, template<typename> typename OQ>
+requires(
+		!std::same_as<ink::Vec<X, Y, Z>, ink::Vec<OX, OY, OZ>>
+	&&	std::same_as<std::remove_cvref_t<X>, std::remove_cvref_t<OX>>
+	&&	std::same_as<std::remove_cvref_t<Y>, std::remove_cvref_t<OY>>
+	&&	std::same_as<std::remove_cvref_t<Z>, std::remove_cvref_t<OZ>> )
+struct std::basic_common_reference<ink::Vec<X, Y, Z>, ink::Vec<OX, OY, OZ>, XQ, OQ> {
+	using type = ink::Vec<std::remove_cvref_t<X>, std::remove_cvref_t<Y>, std::remove_cvref_t<Z>>;
+};
+
 #endif
@@ -0,0 +1,333 @@
+#ifndef INK_GENERIC_VEC_ARENA_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_ARENA_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MathVector.hpp"
+
+/*
+ * Memory resources for the short-lived arrays of Vec of a frame or a request, as std::pmr::memory_resource.
+ *
+ * VecArena hands out memory by bumping a pointer through large blocks, and frees nothing until reset(), which frees
+ * everything at once. After a reset it keeps its memory, merged into a single block as large as all of the ones it took,
+ * so that once frames stop growing it never goes back to the heap. VecPool hands out blocks of one fixed size from a free
+ * list, for arrays of a known maximal size that come and go in any order.
+ *
+ * Every allocation of both is aligned to at least detail::arena_alignment, a cache line, which is also the width of the
+ * widest register of the simd:: kernels: no array of them ever starts in the middle of a line.
+ *
+ * Both plug into std::pmr containers, as VecVector, an std::pmr::vector of Vec:
+ *
+ *     VecArena frame;
+ *     VecVector<float> normals(&frame);
+ *     ...
+ *     frame.reset();   // once 'normals' and the rest of the frame's containers are gone
+ *
+ * and allocate_array() takes arrays straight from them for the batch algorithms of simd:: and parallel::, which work on
+ * pointers. Neither resource is thread-safe: keep one per thread, as one per frame or request usually is.
+ */
+namespace ink::generic_vec {
+
+	namespace detail {
+
+		// Smallest alignment of the allocations of the resources of this file. See the top of this file.
+		inline constexpr std::size_t arena_alignment = 64;
+
+		constexpr std::size_t
+		align_up(std::size_t size, std::size_t alignment)
+		noexcept { return (size + alignment - 1) & ~(alignment - 1); }
+
+		/**
+		 * 'count' default-initialized T from 'resource', for types that need no destructor, since the memory is freed all at once.
+		 * Throws std::bad_array_new_length if their size does not fit in a std::size_t, as new T[count] would.
+		 */
+		template<typename T>
+		requires(std::is_trivially_destructible_v<T> && std::is_default_constructible_v<T>)
+		inline std::span<T>
+		allocate_array(std::pmr::memory_resource& resource, std::size_t count) {
+			if (count > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+			T* data = static_cast<T*>(resource.allocate(count * sizeof(T), std::max(alignof(T), arena_alignment)));
+			std::uninitialized_default_construct_n(data, count);
+			return std::span<T>(data, count);
+		}
+
+	}
+
+	// A std::pmr::vector of Vec, as from a VecArena or a VecPool.
+	template<typename X, typename Y = X, typename Z = Y>
+	using VecVector = std::pmr::vector<Vec<X, Y, Z>>;
+
+	/**
+	 * Monotonic arena: allocation bumps a pointer, deallocation does nothing, and reset() frees everything at once.
+	 * Not thread-safe. See the top of this file.
+	 */
+	class VecArena: public std::pmr::memory_resource {
+
+		// Each block starts with this, and its memory follows, aligned.
+		private: struct Block {
+			Block* next;
+			std::size_t size;
+		};
+
+		private: static constexpr std::size_t M_header = detail::align_up(sizeof(Block), detail::arena_alignment);
+
+		private: std::pmr::memory_resource* M_upstream;
+		private: Block* M_blocks = nullptr;
+		private: unsigned char* M_cursor = nullptr;
+		private: unsigned char* M_end = nullptr;
+		private: std::size_t M_next_size;
+		private: std::size_t M_used = 0;
+
+		// An arena whose first block holds 'initial_bytes', taking its blocks from 'upstream'.
+		public: explicit
+		VecArena(std::size_t initial_bytes = 64u << 10, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		noexcept: M_upstream(upstream), M_next_size(std::max(initial_bytes, detail::arena_alignment)) {}
+
+		public:
+		VecArena(VecArena const&) = delete;
+
+		public: VecArena&
+		operator=(VecArena const&) = delete;
+
+		public:
+		~VecArena()
+		{ release(); }
+
+		/**
+		 * Frees everything allocated so far, at once: nothing allocated from it may be used any more.
+		 * The memory stays with the arena, in a single block large enough for all that was allocated since the last reset.
+		 */
+		public: void
+		reset() {
+			if (M_blocks != nullptr && M_blocks->next != nullptr) {
+				std::size_t total = 0;
+				for (Block* block = M_blocks; block != nullptr; block = block->next) total += block->size;
+				release();
+				M_next_size = total;
+				M_grow(total - M_header);
+			}
+			if (M_blocks != nullptr) {
+				M_cursor = reinterpret_cast<unsigned char*>(M_blocks) + M_header;
+				M_end = reinterpret_cast<unsigned char*>(M_blocks) + M_blocks->size;
+			}
+			M_used = 0;
+		}
+
+		// Frees everything allocated so far, and gives all of the arena's memory back to its upstream resource.
+		public: void
+		release()
+		noexcept {
+			while (M_blocks != nullptr) {
+				Block* next = M_blocks->next;
+				M_upstream->deallocate(M_blocks, M_blocks->size, detail::arena_alignment);
+				M_blocks = next;
+			}
+			M_cursor = M_end = nullptr;
+			M_used = 0;
+		}
+
+		// Bytes handed out since the last reset, alignment padding included.
+		public: std::size_t
+		used() const
+		noexcept { return M_used; }
+
+		// Bytes the arena holds from its upstream resource.
+		public: std::size_t
+		capacity() const
+		noexcept {
+			std::size_t total = 0;
+			for (Block* block = M_blocks; block != nullptr; block = block->next) total += block->size;
+			return total;
+		}
+
+		public: std::pmr::memory_resource*
+		upstream() const
+		noexcept { return M_upstream; }
+
+		// 'count' default-initialized T, aligned for the simd:: kernels, until the next reset. T must need no destructor.
+		public: template<typename T>
+		requires(std::is_trivially_destructible_v<T> && std::is_default_constructible_v<T>)
+		std::span<T>
+		allocate_array(std::size_t count)
+		{ return detail::allocate_array<T>(*this, count); }
+
+		private: void*
+		do_allocate(std::size_t bytes, std::size_t alignment) override {
+			alignment = std::max(alignment, detail::arena_alignment);
+			unsigned char* at = M_align(M_cursor, alignment);
+			if (M_cursor == nullptr || at > M_end || bytes > std::size_t(M_end - at)) {
+				if (bytes > std::size_t(-1) - alignment) throw std::bad_alloc();
+				M_grow(bytes + alignment - detail::arena_alignment);
+				at = M_align(M_cursor, alignment);
+			}
+			M_used += std::size_t(at - M_cursor) + bytes;
+			M_cursor = at + bytes;
+			return at;
+		}
+
+		private: void
+		do_deallocate(void*, std::size_t, std::size_t) override {}
+
+		private: bool
+		do_is_equal(std::pmr::memory_resource const& other) const
+		noexcept override { return this == &other; }
+
+		private: static unsigned char*
+		M_align(unsigned char* at, std::size_t alignment)
+		noexcept { return reinterpret_cast<unsigned char*>(detail::align_up(reinterpret_cast<std::uintptr_t>(at), alignment)); }
+
+		// Starts a new block with room for at least 'bytes', twice as large as the previous one unless more is needed.
+		private: void
+		M_grow(std::size_t bytes) {
+			if (bytes > std::size_t(-1) - M_header - detail::arena_alignment) throw std::bad_alloc();
+			const std::size_t size = detail::align_up(std::max(M_next_size, M_header + bytes), detail::arena_alignment);
+			Block* block = static_cast<Block*>(M_upstream->allocate(size, detail::arena_alignment));
+			block->next = M_blocks;
+			block->size = size;
+			M_blocks = block;
+			M_cursor = reinterpret_cast<unsigned char*>(block) + M_header;
+			M_end = reinterpret_cast<unsigned char*>(block) + size;
+			M_next_size = 2 * size;
+		}
+
+	};
+
+	/**
+	 * Pool of blocks of one fixed size, carved out of larger slabs, and kept on a free list once deallocated.
+	 * Requests larger than a block, or more aligned, go to the upstream resource instead. Not thread-safe.
+	 * See the top of this file.
+	 */
+	class VecPool: public std::pmr::memory_resource {
+
+		private: struct Free {
+			Free* next;
+		};
+
+		private: struct Slab {
+			Slab* next;
+		};
+
+		private: static constexpr std::size_t M_header = detail::align_up(sizeof(Slab), detail::arena_alignment);
+
+		private: std::pmr::memory_resource* M_upstream;
+		private: std::size_t M_block_size;
+		private: std::size_t M_blocks_per_slab;
+		private: Slab* M_slabs = nullptr;
+		private: Free* M_free = nullptr;
+
+		// A pool of blocks of 'block_bytes', taken from 'upstream' by slabs of 'blocks_per_slab' of them.
+		public: explicit
+		VecPool(std::size_t block_bytes, std::size_t blocks_per_slab = 64, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		noexcept:
+			M_upstream(upstream),
+			M_block_size(detail::align_up(std::max(block_bytes, sizeof(Free)), detail::arena_alignment)),
+			M_blocks_per_slab(std::max<std::size_t>(blocks_per_slab, 1)) {}
+
+		// A pool whose blocks each hold an array of 'count' T.
+		public: template<typename T>
+		static VecPool
+		of(std::size_t count, std::size_t blocks_per_slab = 64, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		noexcept { return VecPool(count * sizeof(T), blocks_per_slab, upstream); }
+
+		public:
+		VecPool(VecPool const&) = delete;
+
+		public: VecPool&
+		operator=(VecPool const&) = delete;
+
+		public:
+		~VecPool()
+		{ release(); }
+
+		// Frees every block at once, and gives the slabs back to the upstream resource.
+		public: void
+		release()
+		noexcept {
+			while (M_slabs != nullptr) {
+				Slab* next = M_slabs->next;
+				M_upstream->deallocate(M_slabs, M_slab_size(), detail::arena_alignment);
+				M_slabs = next;
+			}
+			M_free = nullptr;
+		}
+
+		public: std::size_t
+		block_size() const
+		noexcept { return M_block_size; }
+
+		// The number of T that fit in a block, as a container to allocate from the pool would reserve().
+		public: template<typename T>
+		std::size_t
+		capacity() const
+		noexcept { return M_block_size / sizeof(T); }
+
+		public: std::pmr::memory_resource*
+		upstream() const
+		noexcept { return M_upstream; }
+
+		// 'count' default-initialized T, aligned for the simd:: kernels. T must need no destructor.
+		public: template<typename T>
+		requires(std::is_trivially_destructible_v<T> && std::is_default_constructible_v<T>)
+		std::span<T>
+		allocate_array(std::size_t count)
+		{ return detail::allocate_array<T>(*this, count); }
+
+		private: void*
+		do_allocate(std::size_t bytes, std::size_t alignment) override {
+			if (!M_pooled(bytes, alignment)) return M_upstream->allocate(bytes, std::max(alignment, detail::arena_alignment));
+			if (M_free == nullptr) M_grow();
+			Free* block = M_free;
+			M_free = block->next;
+			return block;
+		}
+
+		private: void
+		do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+			if (!M_pooled(bytes, alignment)) return M_upstream->deallocate(pointer, bytes, std::max(alignment, detail::arena_alignment));
+			Free* block = ::new(pointer) Free{ M_free };
+			M_free = block;
+		}
+
+		private: bool
+		do_is_equal(std::pmr::memory_resource const& other) const
+		noexcept override { return this == &other; }
+
+		private: bool
+		M_pooled(std::size_t bytes, std::size_t alignment) const
+		noexcept { return bytes <= M_block_size && alignment <= detail::arena_alignment; }
+
+		private: std::size_t
+		M_slab_size() const
+		noexcept { return M_header + M_blocks_per_slab * M_block_size; }
+
+		// Takes a new slab, and puts all of its blocks on the free list, the first one at the front.
+		private: void
+		M_grow() {
+			Slab* slab = static_cast<Slab*>(M_upstream->allocate(M_slab_size(), detail::arena_alignment));
+			slab->next = M_slabs;
+			M_slabs = slab;
+			unsigned char* blocks = reinterpret_cast<unsigned char*>(slab) + M_header;
+			for (std::size_t i = M_blocks_per_slab; i-- > 0;) M_free = ::new(blocks + i * M_block_size) Free{ M_free };
+		}
+
+	};
+
+}
+
+namespace ink {
+
+	using generic_vec::VecArena;
+	using generic_vec::VecPool;
+	using generic_vec::VecVector;
+
+}
+
+#endif
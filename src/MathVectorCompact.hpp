@@ -0,0 +1,244 @@
+#ifndef INK_GENERIC_VEC_COMPACT_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_COMPACT_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <type_traits>
+#include "MathVector.hpp"
+#include "MathVectorSimd.hpp"
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+/*
+ * Compact storage for Vec: 16 bit floating point axes, and 16 bit quantized ones.
+ *
+ * Half (IEEE binary16) and BFloat16 are storage types. They convert to float for any arithmetic, so a Vec<Half>
+ * goes through the usual mixed-type operators, along with Vec<float> or scalars, and gives float results:
+ * Vec<Half> + Vec<float> is a Vec<float>. Converting back to them rounds to nearest even. Half keeps 11 significant
+ * bits up to 65504, BFloat16 keeps the whole float range with 8.
+ *
+ * Quantization maps the axes of Vec<float> / Vec<double> onto Vec<std::int16_t>, each through its own scale and
+ * offset, fitted once to a whole batch: 16 bits, at a fixed step over the range of the batch rather than a relative one.
+ *
+ * The batch forms in simd:: convert whole arrays, with F16C or AVX-512 conversions where the processor has them.
+ * At half or a quarter of the bytes of a Vec<float>, memory-bound passes over them go about that much faster.
+ */
+namespace ink::generic_vec {
+
+	// The 16 bit floating point formats of Float16.
+	enum class Float16Format
+	{ IEEE , Brain };
+
+	/**
+	 * A 16 bit floating point number, stored as its bits: IEEE binary16, or bfloat16, the top half of a float.
+	 * Converts implicitly from and to float. See the top of this file.
+	 */
+	template<Float16Format format>
+	class Float16 {
+
+		private: std::uint16_t M_bits = 0;
+
+		public: constexpr
+		Float16() = default;
+
+		public: constexpr
+		Float16(float value)
+		noexcept: M_bits(M_from_float(value)) {}
+
+		// The number of the given bits.
+		public: static constexpr Float16
+		from_bits(std::uint16_t bits)
+		noexcept {
+			Float16 out;
+			out.M_bits = bits;
+			return out;
+		}
+
+		public: constexpr std::uint16_t
+		bits() const
+		noexcept { return M_bits; }
+
+		public: constexpr
+		operator float() const
+		noexcept {
+			if constexpr(format == Float16Format::IEEE) {
+				#if defined(__F16C__)
+				if (!std::is_constant_evaluated()) return _cvtsh_ss(M_bits);
+				#endif
+				return simd::detail::half_to_float(M_bits);
+			}
+			else return simd::detail::bfloat_to_float(M_bits);
+		}
+
+		private: static constexpr std::uint16_t
+		M_from_float(float value)
+		noexcept {
+			if constexpr(format == Float16Format::IEEE) {
+				#if defined(__F16C__)
+				if (!std::is_constant_evaluated()) return _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+				#endif
+				return simd::detail::half_from_float(value);
+			}
+			else return simd::detail::bfloat_from_float(value);
+		}
+
+		// Computed in float, then rounded back.
+		public: template<typename T> requires requires(float f, T const& t) { {f + t} -> std::convertible_to<float>; }
+		constexpr Float16& operator+=(T const& rhs) noexcept { return *this = Float16(float(*this) + rhs); }
+
+		public: template<typename T> requires requires(float f, T const& t) { {f - t} -> std::convertible_to<float>; }
+		constexpr Float16& operator-=(T const& rhs) noexcept { return *this = Float16(float(*this) - rhs); }
+
+		public: template<typename T> requires requires(float f, T const& t) { {f * t} -> std::convertible_to<float>; }
+		constexpr Float16& operator*=(T const& rhs) noexcept { return *this = Float16(float(*this) * rhs); }
+
+		public: template<typename T> requires requires(float f, T const& t) { {f / t} -> std::convertible_to<float>; }
+		constexpr Float16& operator/=(T const& rhs) noexcept { return *this = Float16(float(*this) / rhs); }
+
+	};
+
+	using Half = Float16<Float16Format::IEEE>;
+	using BFloat16 = Float16<Float16Format::Brain>;
+
+	/**
+	 * A per-axis affine map between floating point vectors and Vec<std::int16_t>: value = q * scale + offset.
+	 * fit() picks the one that spreads a batch over the whole int16 range. See the top of this file.
+	 */
+	template<std::floating_point T>
+	class Quantization {
+
+		public: using value_type = T;
+
+		public: Vec<T> scale;
+		public: Vec<T> offset;
+
+		// The identity: every integer stands for itself.
+		public: constexpr
+		Quantization()
+		noexcept: scale(T(1), T(1), T(1)), offset(T(0), T(0), T(0)) {}
+
+		public: constexpr
+		Quantization(Vec<T> const& vscale, Vec<T> const& voffset)
+		noexcept: scale(vscale), offset(voffset) {}
+
+		/**
+		 * The quantization mapping the bounding box of 'count' vectors onto [-32767, 32767] on each axis, its centre
+		 * onto 0. An axis that does not vary keeps a scale of 1. The identity when 'count' is 0.
+		 */
+		public: static Quantization
+		fit(Vec<T> const* in, std::size_t count)
+		noexcept {
+			if (count == 0) return Quantization();
+			Vec<T> lo = in[0], hi = in[0];
+			for (std::size_t i = 1; i < count; ++i) {
+				lo = generic_vec::min(lo, in[i]);
+				hi = generic_vec::max(hi, in[i]);
+			}
+			const auto step = [](T l, T h) { return h > l ? (h - l) / T(65534) : T(1); };
+			return Quantization(Vec<T>(step(lo.x, hi.x), step(lo.y, hi.y), step(lo.z, hi.z)), (lo + hi) * T(0.5));
+		}
+
+		// 'value' quantized, rounded to nearest even and saturated, exactly as simd::quantize() does it.
+		public: Vec<std::int16_t>
+		encode(Vec<T> const& value) const
+		noexcept {
+			const Vec<T> inverse = inverse_scale();
+			const Vec<T> scaled = (value - offset) * inverse;
+			return Vec<std::int16_t>(
+				simd::detail::quantize_scalar(scaled.x),
+				simd::detail::quantize_scalar(scaled.y),
+				simd::detail::quantize_scalar(scaled.z));
+		}
+
+		// The value 'q' stands for.
+		public: constexpr Vec<T>
+		decode(Vec<std::int16_t> const& q) const
+		noexcept { return Vec<T>(T(q.x) * scale.x + offset.x, T(q.y) * scale.y + offset.y, T(q.z) * scale.z + offset.z); }
+
+		public: constexpr Vec<T>
+		inverse_scale() const
+		noexcept { return Vec<T>(T(1) / scale.x, T(1) / scale.y, T(1) / scale.z); }
+
+	};
+
+
+
+	namespace simd {
+
+		namespace detail {
+
+			// The kernels treat an array of Vec<Float16> as the flat array of the bits of its 3 * count axes.
+			template<Float16Format format>
+			inline std::uint16_t const*
+			bits(Vec<Float16<format>> const* vecs)
+			noexcept { return reinterpret_cast<std::uint16_t const*>(vecs); }
+
+			template<Float16Format format>
+			inline std::uint16_t*
+			bits(Vec<Float16<format>>* vecs)
+			noexcept { return reinterpret_cast<std::uint16_t*>(vecs); }
+
+			static_assert(sizeof(Vec<Half>) == 3 * sizeof(std::uint16_t) && std::is_trivially_copyable_v<Vec<Half>>);
+			static_assert(sizeof(Vec<BFloat16>) == 3 * sizeof(std::uint16_t) && std::is_trivially_copyable_v<Vec<BFloat16>>);
+			static_assert(generic_vec::detail::interleaved_layout<std::int16_t>);
+
+		}
+
+		// out[i] = Vec<Half>(in[i]), for 'count' vectors, rounding to nearest even.
+		template<std::floating_point T>
+		inline void
+		pack(Vec<T> const* in, Vec<Half>* out, std::size_t count)
+		noexcept { kernels<T>().to_half(detail::flat(in), detail::bits(out), 3 * count); }
+
+		// out[i] = Vec<BFloat16>(in[i]), for 'count' vectors, rounding to nearest even.
+		template<std::floating_point T>
+		inline void
+		pack(Vec<T> const* in, Vec<BFloat16>* out, std::size_t count)
+		noexcept { kernels<T>().to_bfloat(detail::flat(in), detail::bits(out), 3 * count); }
+
+		// out[i] = Vec<T>(in[i]), for 'count' vectors. Exact.
+		template<std::floating_point T>
+		inline void
+		unpack(Vec<Half> const* in, Vec<T>* out, std::size_t count)
+		noexcept { kernels<T>().from_half(detail::bits(in), detail::flat(out), 3 * count); }
+
+		template<std::floating_point T>
+		inline void
+		unpack(Vec<BFloat16> const* in, Vec<T>* out, std::size_t count)
+		noexcept { kernels<T>().from_bfloat(detail::bits(in), detail::flat(out), 3 * count); }
+
+		// out[i] = q.encode(in[i]), for 'count' vectors.
+		template<std::floating_point T>
+		inline void
+		quantize(Quantization<T> const& q, Vec<T> const* in, Vec<std::int16_t>* out, std::size_t count)
+		noexcept {
+			const Vec<T> inverse = q.inverse_scale();
+			const T params[6] = { inverse.x, inverse.y, inverse.z, q.offset.x, q.offset.y, q.offset.z };
+			kernels<T>().quantize(detail::flat(in), params, detail::flat(out), count);
+		}
+
+		// out[i] = q.decode(in[i]), for 'count' vectors.
+		template<std::floating_point T>
+		inline void
+		dequantize(Quantization<T> const& q, Vec<std::int16_t> const* in, Vec<T>* out, std::size_t count)
+		noexcept {
+			const T params[6] = { q.scale.x, q.scale.y, q.scale.z, q.offset.x, q.offset.y, q.offset.z };
+			kernels<T>().dequantize(detail::flat(in), params, detail::flat(out), count);
+		}
+
+	}
+
+}
+
+namespace ink {
+
+	using generic_vec::Half;
+	using generic_vec::BFloat16;
+	using generic_vec::Quantization;
+
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef INK_GENERIC_VEC_EXPR_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_EXPR_LIB_FILE_GUARD
+
+#include <type_traits>
+#include <utility>
+#include "MathVector.hpp"
+
+/*
+ * Opt-in lazy evaluation of Vec arithmetic.
+ * Wrapping any operand in ink::lazy() makes '+', '-', '*' and '/' build lightweight expression nodes instead of vectors.
+ * Nothing is computed until the expression is assigned to a Vec (or a Vec of references), at which point
+ * every axis is evaluated in one pass through the whole expression, with no intermediate vectors.
+ *
+ * Leaves refer to their Vec by reference, so an expression must not outlive the vectors it was built from.
+ * Scalars are held by value.
+ */
+namespace ink::generic_vec::expr {
+
+	namespace detail {
+
+		struct Add { template<typename L, typename R> constexpr decltype(auto) operator()(L&& l, R&& r) const noexcept(noexcept(l + r)) { return l + r; } };
+		struct Sub { template<typename L, typename R> constexpr decltype(auto) operator()(L&& l, R&& r) const noexcept(noexcept(l - r)) { return l - r; } };
+		struct Mul { template<typename L, typename R> constexpr decltype(auto) operator()(L&& l, R&& r) const noexcept(noexcept(l * r)) { return l * r; } };
+		struct Div { template<typename L, typename R> constexpr decltype(auto) operator()(L&& l, R&& r) const noexcept(noexcept(l / r)) { return l / r; } };
+
+	}
+
+
+
+	// Leaf referring to an existing vector.
+	template<typename V>
+	class Ref {
+
+		public: using is_vec_expression = void;
+		public: using value_type = V;
+		public: static constexpr bool is_noexcept = true;
+
+		private: V const& M_vec;
+
+		public: constexpr explicit
+		Ref(V const& vec)
+		noexcept: M_vec(vec) {}
+
+		public: constexpr decltype(auto) x() const noexcept { return (M_vec.x); }
+		public: constexpr decltype(auto) y() const noexcept { return (M_vec.y); }
+		public: constexpr decltype(auto) z() const noexcept { return (M_vec.z); }
+
+		public: constexpr auto
+		eval() const
+		{ return generic_vec::Vec(x(), y(), z()); }
+
+	};
+
+	// Scalar operand, broadcast across every axis.
+	template<typename T>
+	class Scalar {
+
+		public: using value_type = T;
+		public: static constexpr bool is_noexcept = true;
+
+		private: T M_value;
+
+		public: constexpr explicit
+		Scalar(T const& value)
+		noexcept(std::is_nothrow_copy_constructible_v<T>): M_value(value) {}
+
+		public: constexpr T const& x() const noexcept { return M_value; }
+		public: constexpr T const& y() const noexcept { return M_value; }
+		public: constexpr T const& z() const noexcept { return M_value; }
+
+	};
+
+
+
+	template<typename T> struct is_scalar_node: std::false_type {};
+	template<typename T> struct is_scalar_node<Scalar<T>>: std::true_type {};
+
+	template<typename T>
+	concept scalar_node = is_scalar_node<T>::value;
+
+	/**
+	 * Binary operation node.
+	 * 'Constraint' is the concepts::can_*_t trait the equivalent eager operator is constrained with.
+	 * Like the eager scalar operators, an axis that is NoState on the vector side stays NoState when the other side is a scalar.
+	 */
+	template<template<typename...> typename Constraint, typename Op, typename L, typename R>
+	class Binary {
+
+		public: using is_vec_expression = void;
+		public: static constexpr bool is_noexcept =
+			OpConstraint_t<Constraint, typename L::value_type, typename R::value_type, true>{}() && L::is_noexcept && R::is_noexcept;
+
+		private: L M_lhs;
+		private: R M_rhs;
+
+		public: constexpr
+		Binary(L lhs, R rhs)
+		noexcept(std::is_nothrow_move_constructible_v<L> && std::is_nothrow_move_constructible_v<R>)
+		: M_lhs(std::move(lhs)), M_rhs(std::move(rhs)) {}
+
+		private: template<typename Lhs, typename Rhs>
+		static constexpr decltype(auto)
+		M_apply(Lhs&& l, Rhs&& r)
+		noexcept(is_noexcept) {
+			constexpr bool scalar = scalar_node<L> || scalar_node<R>;
+			constexpr bool nostate = std::same_as<std::remove_cvref_t<Lhs>, NoState> || std::same_as<std::remove_cvref_t<Rhs>, NoState>;
+			if constexpr(scalar && nostate) return NoState();
+			else return Op{}(std::forward<Lhs>(l), std::forward<Rhs>(r));
+		}
+
+		public: constexpr decltype(auto) x() const noexcept(is_noexcept) { return M_apply(M_lhs.x(), M_rhs.x()); }
+		public: constexpr decltype(auto) y() const noexcept(is_noexcept) { return M_apply(M_lhs.y(), M_rhs.y()); }
+		public: constexpr decltype(auto) z() const noexcept(is_noexcept) { return M_apply(M_lhs.z(), M_rhs.z()); }
+
+		// Evaluates the expression into a new vector, of the same type the eager operators would have produced.
+		public: constexpr auto
+		eval() const
+		noexcept(is_noexcept)
+		{ return generic_vec::Vec(x(), y(), z()); }
+
+		public: using value_type = decltype(std::declval<Binary const&>().eval());
+
+	};
+
+
+
+	namespace detail {
+
+		// Wraps an operand into its node: expressions pass through, vectors become Ref, anything else becomes Scalar.
+		template<typename T>
+		constexpr auto
+		wrap(T const& operand)
+		noexcept(noexcept(Scalar<T>(operand))) {
+			if		constexpr(vec_expression<T>) return operand;
+			else if	constexpr(concepts::same_template<T, Vec<void>>) return Ref<T>(operand);
+			else return Scalar<T>(operand);
+		}
+
+		template<typename T>
+		using wrap_t = decltype(wrap(std::declval<T const&>()));
+
+		template<typename T>
+		concept vec_like = vec_expression<T> || concepts::same_template<T, Vec<void>>;
+
+		// At least one side is an expression, and every side is a vector or expression.
+		template<typename L, typename R>
+		concept vector_operands = (vec_expression<L> || vec_expression<R>) && vec_like<L> && vec_like<R>;
+
+		// At least one side is an expression, and the other may be a scalar.
+		template<typename L, typename R>
+		concept mixed_operands = (vec_expression<L> && !vec_like<R>) || (!vec_like<L> && vec_expression<R>) || vector_operands<L, R>;
+
+		template<template<typename...> typename Constraint, typename L, typename R, bool MustBeNoexcept = false>
+		concept node_constraint = OpConstraint_t<Constraint, typename wrap_t<L>::value_type, typename wrap_t<R>::value_type, MustBeNoexcept>{}();
+
+	}
+
+
+
+	template<typename L, typename R>
+	requires(detail::vector_operands<L, R> && detail::node_constraint<concepts::can_add_t, L, R>)
+	static constexpr auto
+	operator+(L const& lhs, R const& rhs)
+	noexcept(noexcept(detail::wrap(lhs)) && noexcept(detail::wrap(rhs)))
+	{ return Binary<concepts::can_add_t, detail::Add, detail::wrap_t<L>, detail::wrap_t<R>>(detail::wrap(lhs), detail::wrap(rhs)); }
+
+	template<typename L, typename R>
+	requires(detail::vector_operands<L, R> && detail::node_constraint<concepts::can_sub_t, L, R>)
+	static constexpr auto
+	operator-(L const& lhs, R const& rhs)
+	noexcept(noexcept(detail::wrap(lhs)) && noexcept(detail::wrap(rhs)))
+	{ return Binary<concepts::can_sub_t, detail::Sub, detail::wrap_t<L>, detail::wrap_t<R>>(detail::wrap(lhs), detail::wrap(rhs)); }
+
+	template<typename L, typename R>
+	requires(detail::mixed_operands<L, R> && detail::node_constraint<concepts::can_mul_t, L, R>)
+	static constexpr auto
+	operator*(L const& lhs, R const& rhs)
+	noexcept(noexcept(detail::wrap(lhs)) && noexcept(detail::wrap(rhs)))
+	{ return Binary<concepts::can_mul_t, detail::Mul, detail::wrap_t<L>, detail::wrap_t<R>>(detail::wrap(lhs), detail::wrap(rhs)); }
+
+	template<typename L, typename R>
+	requires(detail::mixed_operands<L, R> && detail::node_constraint<concepts::can_div_t, L, R>)
+	static constexpr auto
+	operator/(L const& lhs, R const& rhs)
+	noexcept(noexcept(detail::wrap(lhs)) && noexcept(detail::wrap(rhs)))
+	{ return Binary<concepts::can_div_t, detail::Div, detail::wrap_t<L>, detail::wrap_t<R>>(detail::wrap(lhs), detail::wrap(rhs)); }
+
+}
+
+namespace ink::generic_vec {
+
+	// Starts a lazy expression from 'vec'. See MathVectorExpr.hpp.
+	template<typename X, typename Y, typename Z>
+	constexpr auto
+	lazy(Vec<X, Y, Z> const& vec)
+	noexcept { return expr::Ref<Vec<X, Y, Z>>(vec); }
+
+}
+
+namespace ink {
+
+	using generic_vec::lazy;
+
+}
+
+#endif
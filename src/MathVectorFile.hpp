@@ -0,0 +1,609 @@
+#ifndef INK_GENERIC_VEC_FILE_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_FILE_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MathVector.hpp"
+#include "MathVectorCompact.hpp"
+#include "MathVectorSoA.hpp"
+#include "MathVectorView.hpp"
+
+#if defined(_WIN32)
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/*
+ * A binary file format for arrays of Vec, that can be mapped into memory and used in place.
+ *
+ * A file is a 64 byte header followed by the raw axes, either interleaved, as an array of Vec<X, Y, Z> is in memory,
+ * or planar, one contiguous lane per axis as in a VecSoA. The header records the element type of each axis ('void' for
+ * none), where each axis lies, the number of vectors, and the byte order of the machine that wrote it. Data starts on
+ * 64 byte boundaries, so that the mapped axes are aligned for any instruction set.
+ *
+ * save() writes an array of Vec or a VecSoA in one pass. VecFile<X, Y, Z> maps a file read-only, and checks that its
+ * axes are exactly X, Y and Z: opening costs the same for 20 GB as for 20 bytes, and pages are read from disk as the
+ * vectors on them are first used. A file of interleaved Vec in the byte order of the machine is an array of
+ * Vec<X, Y, Z> const that every operator and simd:: algorithm runs on directly; any other file is still a VecView.
+ * load() and load_soa() copy a file into memory instead, converting its layout and byte order.
+ *
+ * Errors from the system throw std::system_error, files that are not of the expected format or type throw FileError.
+ */
+namespace ink::generic_vec {
+
+	// How the axes of a file are stored.
+	enum class FileLayout: std::uint8_t
+	{ Interleaved = 0 , Planar = 1 };
+
+	// The element type of an axis of a file. Integers are stored by size, so 'long' reads back wherever it has as many bytes.
+	enum class FileType: std::uint8_t
+	{ Void = 0 , Bool , Int8 , UInt8 , Int16 , UInt16 , Int32 , UInt32 , Int64 , UInt64 , Half , BFloat16 , Float , Double };
+
+	// Thrown by the readers of this file, for a file that is not in its format, or holds other types than expected.
+	class FileError: public std::runtime_error {
+
+		public:
+		using std::runtime_error::runtime_error;
+
+	};
+
+	namespace detail {
+
+		// The code of an axis type in a file, or Void for types that cannot be stored.
+		template<typename T>
+		consteval FileType
+		file_type_of()
+		noexcept {
+			if		constexpr(std::is_void_v<T>) return FileType::Void;
+			else if	constexpr(std::same_as<T, bool>) return FileType::Bool;
+			else if	constexpr(std::same_as<T, Half>) return FileType::Half;
+			else if	constexpr(std::same_as<T, BFloat16>) return FileType::BFloat16;
+			else if	constexpr(std::same_as<T, float> && std::numeric_limits<float>::is_iec559) return FileType::Float;
+			else if	constexpr(std::same_as<T, double> && std::numeric_limits<double>::is_iec559) return FileType::Double;
+			else if	constexpr(std::integral<T>) {
+				constexpr bool s = std::is_signed_v<T>;
+				if		constexpr(sizeof(T) == 1) return s ? FileType::Int8 : FileType::UInt8;
+				else if	constexpr(sizeof(T) == 2) return s ? FileType::Int16 : FileType::UInt16;
+				else if	constexpr(sizeof(T) == 4) return s ? FileType::Int32 : FileType::UInt32;
+				else if	constexpr(sizeof(T) == 8) return s ? FileType::Int64 : FileType::UInt64;
+				else return FileType::Void;
+			}
+			else return FileType::Void;
+		}
+
+		template<typename T>
+		concept file_axis = std::is_void_v<T> || file_type_of<T>() != FileType::Void;
+
+		// The axes a file can hold: plain values of the types of FileType, or 'void'.
+		template<typename X, typename Y, typename Z>
+		concept file_vec = file_axis<X> && file_axis<Y> && file_axis<Z> && std::is_trivially_copyable_v<Vec<X, Y, Z>>;
+
+		// The first bytes of every file, the version of its format, and the alignment of its data.
+		inline constexpr char file_magic[8] = { 'I', 'N', 'K', 'V', 'E', 'C', '\r', '\n' };
+		inline constexpr std::uint16_t file_version = 1;
+		inline constexpr std::uint64_t file_alignment = 64;
+
+		// Written as is: it reads back as 0x04030201 on a machine of the other byte order.
+		inline constexpr std::uint32_t file_byte_order = 0x01020304u;
+
+		/**
+		 * The header of a file. 'offset[a]' is the position of axis 'a' within a record for interleaved files, and
+		 * of its lane from the start of the file for planar ones. 'data' is where the records start, 0 for planar files.
+		 */
+		struct FileHeader {
+			char magic[8];
+			std::uint32_t byte_order;
+			std::uint16_t version;
+			FileLayout layout;
+			std::uint8_t reserved0;
+			FileType type[3];
+			std::uint8_t reserved1;
+			std::uint32_t record_size;
+			std::uint64_t count;
+			std::uint64_t offset[3];
+			std::uint64_t data;
+		};
+
+		static_assert(sizeof(FileHeader) == 64 && std::is_trivially_copyable_v<FileHeader>);
+
+		inline constexpr std::uint64_t
+		align_file_offset(std::uint64_t offset)
+		noexcept { return (offset + file_alignment - 1) & ~(file_alignment - 1); }
+
+		inline void
+		reverse_bytes(void* value, std::size_t size)
+		noexcept {
+			auto* bytes = static_cast<unsigned char*>(value);
+			for (std::size_t i = 0, j = size - 1; i < j; ++i, --j) std::swap(bytes[i], bytes[j]);
+		}
+
+		// The header in the byte order of this machine.
+		inline void
+		swap_header(FileHeader& header)
+		noexcept {
+			reverse_bytes(&header.byte_order, sizeof(header.byte_order));
+			reverse_bytes(&header.version, sizeof(header.version));
+			reverse_bytes(&header.record_size, sizeof(header.record_size));
+			reverse_bytes(&header.count, sizeof(header.count));
+			for (auto& offset : header.offset) reverse_bytes(&offset, sizeof(offset));
+			reverse_bytes(&header.data, sizeof(header.data));
+		}
+
+		// The size of an element of an axis, 0 for 'void'.
+		template<typename T>
+		consteval std::size_t
+		axis_size()
+		noexcept {
+			if constexpr(std::is_void_v<T>) return 0;
+			else return sizeof(T);
+		}
+
+		// The size of a lane of 'count' elements of an axis.
+		template<typename T>
+		constexpr std::uint64_t
+		lane_bytes(std::uint64_t count)
+		noexcept { return count * axis_size<T>(); }
+
+		// The type of a read-only axis, which stays 'void' for 'void' axes.
+		template<typename T>
+		using file_const_t = std::conditional_t<std::is_void_v<T>, void, T const>;
+
+		// The position of each axis within a Vec<X, Y, Z>, 0 for 'void' axes.
+		template<typename X, typename Y, typename Z>
+		inline std::array<std::uint64_t, 3>
+		record_offsets()
+		noexcept {
+			const Vec<X, Y, Z> vec{};
+			const auto at = [&](auto const& axis) -> std::uint64_t {
+				if constexpr(std::same_as<std::remove_cvref_t<decltype(axis)>, NoState>) return 0;
+				else return std::uint64_t(reinterpret_cast<unsigned char const*>(&axis) - reinterpret_cast<unsigned char const*>(&vec));
+			};
+			return { at(vec.x), at(vec.y), at(vec.z) };
+		}
+
+		template<typename X, typename Y, typename Z>
+		inline FileHeader
+		make_header(FileLayout layout, std::uint64_t count)
+		noexcept {
+			FileHeader header{};
+			std::memcpy(header.magic, file_magic, sizeof(file_magic));
+			header.byte_order = file_byte_order;
+			header.version = file_version;
+			header.layout = layout;
+			header.type[0] = file_type_of<X>();
+			header.type[1] = file_type_of<Y>();
+			header.type[2] = file_type_of<Z>();
+			header.count = count;
+			if (layout == FileLayout::Interleaved) {
+				const auto offsets = record_offsets<X, Y, Z>();
+				header.record_size = sizeof(Vec<X, Y, Z>);
+				for (std::size_t a = 0; a < 3; ++a) header.offset[a] = offsets[a];
+				header.data = align_file_offset(sizeof(FileHeader));
+			} else {
+				const std::uint64_t sizes[3] = { lane_bytes<X>(count), lane_bytes<Y>(count), lane_bytes<Z>(count) };
+				std::uint64_t at = align_file_offset(sizeof(FileHeader));
+				for (std::size_t a = 0; a < 3; ++a) {
+					if (header.type[a] == FileType::Void) continue;
+					header.offset[a] = at;
+					at = align_file_offset(at + sizes[a]);
+				}
+			}
+			return header;
+		}
+
+		// An std::FILE that closes itself.
+		struct FileCloser {
+			void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+		};
+
+		using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+		[[noreturn]] inline void
+		throw_errno(char const* what, char const* path)
+		{ throw std::system_error(errno, std::generic_category(), std::string(what) + " '" + path + "'"); }
+
+		inline FilePtr
+		open_for_writing(char const* path) {
+			FilePtr file(std::fopen(path, "wb"));
+			if (!file) throw_errno("cannot create", path);
+			return file;
+		}
+
+		inline void
+		write_bytes(std::FILE* file, void const* data, std::size_t size, char const* path)
+		{ if (size != 0 && std::fwrite(data, 1, size, file) != size) throw_errno("cannot write to", path); }
+
+		// Writes zeros up to 'offset', the position of the next part of the file.
+		inline void
+		pad_to(std::FILE* file, std::uint64_t& position, std::uint64_t offset, char const* path) {
+			static constexpr unsigned char zeros[file_alignment] = {};
+			write_bytes(file, zeros, std::size_t(offset - position), path);
+			position = offset;
+		}
+
+		inline void
+		close_written(FilePtr file, char const* path)
+		{ if (std::fclose(file.release()) != 0) throw_errno("cannot write to", path); }
+
+		// Where axis 'a' of the first vector lies in the file.
+		inline std::uint64_t
+		axis_start(FileHeader const& header, std::size_t a)
+		noexcept { return header.layout == FileLayout::Interleaved ? header.data + header.offset[a] : header.offset[a]; }
+
+		// The distance in bytes between consecutive elements of an axis of type T in the file.
+		template<typename T>
+		inline std::ptrdiff_t
+		axis_stride(FileHeader const& header)
+		noexcept {
+			if constexpr(std::is_void_v<T>) return 0;
+			else return header.layout == FileLayout::Interleaved ? std::ptrdiff_t(header.record_size) : std::ptrdiff_t(sizeof(T));
+		}
+
+		// Whether the records of the file are Vec<X, Y, Z> exactly as this machine lays them out.
+		template<typename X, typename Y, typename Z>
+		inline bool
+		contiguous_records(FileHeader const& header, bool native)
+		noexcept {
+			if (!native || header.layout != FileLayout::Interleaved || header.record_size != sizeof(Vec<X, Y, Z>)) return false;
+			const auto offsets = record_offsets<X, Y, Z>();
+			for (std::size_t a = 0; a < 3; ++a)
+				if (header.type[a] != FileType::Void && header.offset[a] != offsets[a]) return false;
+			return true;
+		}
+
+		// The element of an axis at 'at', in the byte order of this machine. NoState for 'void' axes.
+		template<typename T>
+		inline auto
+		read_element(unsigned char const* at, bool native)
+		noexcept {
+			if constexpr(std::is_void_v<T>) return NoState();
+			else {
+				T value;
+				std::memcpy(&value, at, sizeof(T));
+				if (!native) reverse_bytes(&value, sizeof(T));
+				return value;
+			}
+		}
+
+		/**
+		 * The header of a file of 'file_size' bytes starting at 'bytes', checked against X, Y and Z and turned into the byte
+		 * order of this machine. 'native' tells whether it was so already. Throws FileError.
+		 */
+		template<typename X, typename Y, typename Z>
+		inline FileHeader
+		read_header(void const* bytes, std::uint64_t file_size, char const* path, bool& native) {
+			const auto fail = [path](char const* why) { throw FileError(std::string("'") + path + "' " + why); };
+
+			FileHeader header;
+			if (file_size < sizeof(header)) fail("is too short for a vector file");
+			std::memcpy(&header, bytes, sizeof(header));
+			if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0) fail("is not a vector file");
+
+			native = header.byte_order == file_byte_order;
+			if (!native) {
+				swap_header(header);
+				if (header.byte_order != file_byte_order) fail("has an unknown byte order");
+			}
+			if (header.version == 0 || header.version > file_version) fail("is of an unsupported version of the format");
+			if (header.layout != FileLayout::Interleaved && header.layout != FileLayout::Planar) fail("has an unknown layout");
+
+			constexpr FileType types[3] = { file_type_of<X>(), file_type_of<Y>(), file_type_of<Z>() };
+			constexpr std::uint64_t sizes[3] = { axis_size<X>(), axis_size<Y>(), axis_size<Z>() };
+			for (std::size_t a = 0; a < 3; ++a)
+				if (header.type[a] != types[a]) fail("holds vectors of other axis types");
+
+			// Every axis within the file, and aligned for its type, for any count up to the size of the file.
+			const std::uint64_t count = header.count;
+			const auto fits = [&](std::uint64_t start, std::uint64_t element, std::uint64_t stride) {
+				if (count == 0) return true;
+				if (start > file_size || element > file_size - start) return false;
+				return count == 1 || (count - 1) <= (file_size - start - element) / stride;
+			};
+			for (std::size_t a = 0; a < 3; ++a) {
+				if (types[a] == FileType::Void) continue;
+				if (header.layout == FileLayout::Interleaved && header.offset[a] + sizes[a] > header.record_size) fail("has an axis outside of its records");
+				const std::uint64_t start = axis_start(header, a), stride = header.layout == FileLayout::Interleaved ? header.record_size : sizes[a];
+				if (start % sizes[a] != 0 || stride % sizes[a] != 0) fail("has a misaligned axis");
+				if (!fits(start, sizes[a], stride)) fail("is shorter than its header says");
+			}
+			return header;
+		}
+
+		/**
+		 * A whole file, mapped read-only into memory. Pages are read from disk as they are first touched.
+		 * The mapping stays valid until this is destroyed, even once the file is deleted.
+		 */
+		class MappedFile {
+
+			private: void const* M_data = nullptr;
+			private: std::size_t M_size = 0;
+
+			public: constexpr
+			MappedFile() = default;
+
+			public: explicit
+			MappedFile(char const* path) {
+				#if defined(_WIN32)
+				const auto fail = [path](char const* what) -> void {
+					throw std::system_error(int(GetLastError()), std::system_category(), std::string(what) + " '" + path + "'");
+				};
+				const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file == INVALID_HANDLE_VALUE) fail("cannot open");
+				LARGE_INTEGER size;
+				if (!GetFileSizeEx(file, &size)) { CloseHandle(file); fail("cannot read the size of"); }
+				M_size = std::size_t(size.QuadPart);
+				if (M_size != 0) {
+					const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+					if (mapping == nullptr) { CloseHandle(file); fail("cannot map"); }
+					M_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+					CloseHandle(mapping);
+					if (M_data == nullptr) { CloseHandle(file); fail("cannot map"); }
+				}
+				CloseHandle(file);
+				#else
+				const int file = ::open(path, O_RDONLY | O_CLOEXEC);
+				if (file < 0) throw_errno("cannot open", path);
+				struct stat status;
+				if (::fstat(file, &status) != 0) { ::close(file); throw_errno("cannot read the size of", path); }
+				M_size = std::size_t(status.st_size);
+				if (M_size != 0) {
+					void* data = ::mmap(nullptr, M_size, PROT_READ, MAP_PRIVATE, file, 0);
+					if (data == MAP_FAILED) { ::close(file); throw_errno("cannot map", path); }
+					M_data = data;
+				}
+				::close(file);
+				#endif
+			}
+
+			public:
+			MappedFile(MappedFile&& other)
+			noexcept: M_data(std::exchange(other.M_data, nullptr)), M_size(std::exchange(other.M_size, 0)) {}
+
+			public: MappedFile&
+			operator=(MappedFile&& other)
+			noexcept {
+				if (this != &other) {
+					M_unmap();
+					M_data = std::exchange(other.M_data, nullptr);
+					M_size = std::exchange(other.M_size, 0);
+				}
+				return *this;
+			}
+
+			public:
+			~MappedFile()
+			{ M_unmap(); }
+
+			public: unsigned char const*
+			data() const
+			noexcept { return static_cast<unsigned char const*>(M_data); }
+
+			public: std::size_t
+			size() const
+			noexcept { return M_size; }
+
+			private: void
+			M_unmap()
+			noexcept {
+				if (M_data == nullptr) return;
+				#if defined(_WIN32)
+				UnmapViewOfFile(M_data);
+				#else
+				::munmap(const_cast<void*>(M_data), M_size);
+				#endif
+			}
+
+		};
+
+	}
+
+	// Writes 'vecs' to a new file at 'path', interleaved as they are in memory, replacing any file there.
+	template<typename X, typename Y, typename Z>
+	requires detail::file_vec<X, Y, Z>
+	inline void
+	save(char const* path, std::span<Vec<X, Y, Z> const> vecs) {
+		const detail::FileHeader header = detail::make_header<X, Y, Z>(FileLayout::Interleaved, vecs.size());
+		detail::FilePtr file = detail::open_for_writing(path);
+		std::uint64_t position = sizeof(header);
+		detail::write_bytes(file.get(), &header, sizeof(header), path);
+		detail::pad_to(file.get(), position, header.data, path);
+		detail::write_bytes(file.get(), vecs.data(), vecs.size_bytes(), path);
+		detail::close_written(std::move(file), path);
+	}
+
+	template<typename X, typename Y, typename Z>
+	requires detail::file_vec<X, Y, Z>
+	inline void
+	save(char const* path, std::vector<Vec<X, Y, Z>> const& vecs)
+	{ save(path, std::span<Vec<X, Y, Z> const>(vecs)); }
+
+	// Writes the lanes of 'soa' to a new file at 'path', planar, replacing any file there.
+	template<typename X, typename Y, typename Z>
+	requires detail::file_vec<X, Y, Z>
+	inline void
+	save(char const* path, VecSoA<X, Y, Z> const& soa) {
+		const detail::FileHeader header = detail::make_header<X, Y, Z>(FileLayout::Planar, soa.size());
+		detail::FilePtr file = detail::open_for_writing(path);
+		std::uint64_t position = sizeof(header);
+		detail::write_bytes(file.get(), &header, sizeof(header), path);
+		const auto lane = [&]<typename T>(std::type_identity<T>, auto const& values, std::size_t a) {
+			if constexpr(!std::is_void_v<T>) {
+				detail::pad_to(file.get(), position, header.offset[a], path);
+				detail::write_bytes(file.get(), values.data(), values.size() * sizeof(T), path);
+				position += values.size() * sizeof(T);
+			}
+		};
+		lane(std::type_identity<X>(), soa.x, 0);
+		lane(std::type_identity<Y>(), soa.y, 1);
+		lane(std::type_identity<Z>(), soa.z, 2);
+		detail::close_written(std::move(file), path);
+	}
+
+	/**
+	 * A file of Vec<X, Y, Z> mapped read-only into memory, to use in place. Opening it checks the header against X, Y
+	 * and Z, and throws FileError on any difference. It must outlive every span and view taken from it.
+	 * See the top of this file.
+	 */
+	template<typename X, typename Y = X, typename Z = Y>
+	requires detail::file_vec<X, Y, Z>
+	class VecFile {
+
+		public: using value_type = Vec<X, Y, Z>;
+		public: using size_type = std::size_t;
+		public: using view_type = VecView<detail::file_const_t<X>, detail::file_const_t<Y>, detail::file_const_t<Z>>;
+
+		private: detail::MappedFile M_file;
+		private: bool M_native = true;
+		private: detail::FileHeader M_header{};
+
+		public: explicit
+		VecFile(char const* path)
+		: M_file(path), M_header(detail::read_header<X, Y, Z>(M_file.data(), M_file.size(), path, M_native)) {}
+
+		public: explicit
+		VecFile(std::string const& path)
+		: VecFile(path.c_str()) {}
+
+		public: size_type
+		size() const
+		noexcept { return size_type(M_header.count); }
+
+		public: bool
+		empty() const
+		noexcept { return M_header.count == 0; }
+
+		public: FileLayout
+		layout() const
+		noexcept { return M_header.layout; }
+
+		// Whether the file was written on a machine of the byte order of this one. Only such files can be viewed in place.
+		public: bool
+		native() const
+		noexcept { return M_native; }
+
+		// Whether the file is an array of Vec<X, Y, Z> exactly as this machine lays it out, which vecs() returns.
+		public: bool
+		contiguous() const
+		noexcept { return detail::contiguous_records<X, Y, Z>(M_header, M_native); }
+
+		// The vectors of the file, in place. Throws FileError unless contiguous(): view() or to_vector() read any file.
+		public: std::span<value_type const>
+		vecs() const {
+			if (!contiguous()) throw FileError("the file is not an array of vectors as this machine lays them out");
+			return std::span<value_type const>(reinterpret_cast<value_type const*>(M_file.data() + M_header.data), size());
+		}
+
+		// A view of the vectors of the file in place, whatever its layout. Throws FileError unless native(): to_vector() reads any file.
+		public: view_type
+		view() const {
+			if (!M_native) throw FileError("the file is in the other byte order, and cannot be viewed in place");
+			return view_type(M_axis<X>(0), M_axis<Y>(1), M_axis<Z>(2), size(), M_stride<X>(), M_stride<Y>(), M_stride<Z>());
+		}
+
+		// A copy of the vectors of the file, in the byte order of this machine.
+		public: std::vector<value_type>
+		to_vector() const {
+			std::vector<value_type> out(size());
+			if (contiguous()) {
+				if (!out.empty()) std::memcpy(out.data(), M_file.data() + M_header.data, out.size() * sizeof(value_type));
+			} else {
+				for (size_type i = 0; i < out.size(); ++i) out[i] = value_type(M_read<X>(0, i), M_read<Y>(1, i), M_read<Z>(2, i));
+			}
+			return out;
+		}
+
+		// A copy of the vectors of the file, one lane per axis, in the byte order of this machine.
+		public: VecSoA<X, Y, Z>
+		to_soa() const {
+			VecSoA<X, Y, Z> out(size());
+			M_copy_lane<X>(out.x, 0);
+			M_copy_lane<Y>(out.y, 1);
+			M_copy_lane<Z>(out.z, 2);
+			return out;
+		}
+
+		// The first element of axis 'a' in the mapping.
+		private: template<typename T>
+		detail::file_const_t<T>*
+		M_axis(std::size_t a) const
+		noexcept {
+			if constexpr(std::is_void_v<T>) return nullptr;
+			else return reinterpret_cast<T const*>(M_file.data() + detail::axis_start(M_header, a));
+		}
+
+		private: template<typename T>
+		std::ptrdiff_t
+		M_stride() const
+		noexcept { return detail::axis_stride<T>(M_header); }
+
+		// Element 'i' of axis 'a', in the byte order of this machine.
+		private: template<typename T>
+		auto
+		M_read(std::size_t a, size_type i) const
+		noexcept {
+			if constexpr(std::is_void_v<T>) return NoState();
+			else return detail::read_element<T>(reinterpret_cast<unsigned char const*>(M_axis<T>(a)) + std::ptrdiff_t(i) * M_stride<T>(), M_native);
+		}
+
+		private: template<typename T, typename Lane>
+		void
+		M_copy_lane(Lane& lane, std::size_t a) const {
+			if constexpr(!std::is_void_v<T>) {
+				if (M_native && M_header.layout == FileLayout::Planar) {
+					if (!lane.empty()) std::memcpy(lane.data(), M_axis<T>(a), lane.size() * sizeof(T));
+				}
+				else for (size_type i = 0; i < lane.size(); ++i) lane[i] = M_read<T>(a, i);
+			}
+		}
+
+	};
+
+	// The vectors of the file at 'path', copied into memory. Throws as VecFile does.
+	template<typename X, typename Y = X, typename Z = Y>
+	requires detail::file_vec<X, Y, Z>
+	inline std::vector<Vec<X, Y, Z>>
+	load(char const* path)
+	{ return VecFile<X, Y, Z>(path).to_vector(); }
+
+	// The vectors of the file at 'path', copied into one lane per axis. Throws as VecFile does.
+	template<typename X, typename Y = X, typename Z = Y>
+	requires detail::file_vec<X, Y, Z>
+	inline VecSoA<X, Y, Z>
+	load_soa(char const* path)
+	{ return VecFile<X, Y, Z>(path).to_soa(); }
+
+}
+
+namespace ink {
+
+	using generic_vec::FileLayout;
+	using generic_vec::FileError;
+	using generic_vec::VecFile;
+
+}
+
+#endif
@@ -0,0 +1,489 @@
+#ifndef INK_GENERIC_VEC_GRID_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_GRID_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+#include "MathVector.hpp"
+#include "MathVectorSimd.hpp"
+
+// Native parallel bit deposit / extract, for morton_encode() and morton_decode() when the target has them.
+#if defined(__BMI2__) && defined(__x86_64__)
+#include <immintrin.h>
+#define INK_GENERIC_VEC_BMI2
+#endif
+
+/*
+ * Integer grid helpers for voxel and spatial hashing code: Morton (Z-order) codes, spatial hashes, and the cell of a point.
+ *
+ * Every helper works on the axes a Vec holds state in, so a Vec<int, int, void> is a 2D point throughout:
+ * its Morton code interleaves two axes instead of three, and its 'void' axis stays 'void' in cells.
+ * The batched versions, in the simd namespace, cover the Vec<std::uint32_t> / Vec<std::int32_t> / Vec<float> arrays
+ * the hot loops of a voxel hash run on.
+ */
+namespace ink::generic_vec {
+
+	namespace detail {
+
+		// Integer axes, or 'void' ones.
+		template<typename T>
+		concept grid_axis = std::is_void_v<T> || std::integral<std::remove_cvref_t<T>>;
+
+		// Integer or floating point axes, or 'void' ones.
+		template<typename T>
+		concept cell_axis = std::is_void_v<T> || std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+		// Bits of code under each axis of a Morton code over 'axes' axes: 21 for 3D, 32 for 2D, 64 for 1D.
+		template<unsigned axes>
+		inline constexpr unsigned morton_bits = 64 / axes;
+
+		// Bits of a Morton code that belong to its first axis. The others are the same, shifted by their rank.
+		template<unsigned axes>
+		inline constexpr std::uint64_t morton_mask =
+			axes == 3 ? 0x1249249249249249 :
+			axes == 2 ? 0x5555555555555555 :
+			~std::uint64_t(0);
+
+		// Spreads the low morton_bits<axes> bits of 'v' out to the bits of morton_mask<axes>.
+		template<unsigned axes>
+		constexpr std::uint64_t
+		morton_spread(std::uint64_t v)
+		noexcept {
+			#if defined(INK_GENERIC_VEC_BMI2)
+			if (!std::is_constant_evaluated()) return _pdep_u64(v, morton_mask<axes>);
+			#endif
+			if constexpr(axes == 3) {
+				v &= 0x1FFFFF;
+				v = (v | (v << 32)) & 0x1F00000000FFFF;
+				v = (v | (v << 16)) & 0x1F0000FF0000FF;
+				v = (v | (v << 8))  & 0x100F00F00F00F00F;
+				v = (v | (v << 4))  & 0x10C30C30C30C30C3;
+				v = (v | (v << 2))  & 0x1249249249249249;
+			}
+			else if constexpr(axes == 2) {
+				v &= 0xFFFFFFFF;
+				v = (v | (v << 16)) & 0x0000FFFF0000FFFF;
+				v = (v | (v << 8))  & 0x00FF00FF00FF00FF;
+				v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0F;
+				v = (v | (v << 2))  & 0x3333333333333333;
+				v = (v | (v << 1))  & 0x5555555555555555;
+			}
+			return v;
+		}
+
+		// Gathers the bits of morton_mask<axes> back into the low bits. The inverse of morton_spread().
+		template<unsigned axes>
+		constexpr std::uint64_t
+		morton_compact(std::uint64_t v)
+		noexcept {
+			#if defined(INK_GENERIC_VEC_BMI2)
+			if (!std::is_constant_evaluated()) return _pext_u64(v, morton_mask<axes>);
+			#endif
+			if constexpr(axes == 3) {
+				v &= 0x1249249249249249;
+				v = (v | (v >> 2))  & 0x10C30C30C30C30C3;
+				v = (v | (v >> 4))  & 0x100F00F00F00F00F;
+				v = (v | (v >> 8))  & 0x1F0000FF0000FF;
+				v = (v | (v >> 16)) & 0x1F00000000FFFF;
+				v = (v | (v >> 32)) & 0x1FFFFF;
+			}
+			else if constexpr(axes == 2) {
+				v &= 0x5555555555555555;
+				v = (v | (v >> 1))  & 0x3333333333333333;
+				v = (v | (v >> 2))  & 0x0F0F0F0F0F0F0F0F;
+				v = (v | (v >> 4))  & 0x00FF00FF00FF00FF;
+				v = (v | (v >> 8))  & 0x0000FFFF0000FFFF;
+				v = (v | (v >> 16)) & 0xFFFFFFFF;
+			}
+			return v;
+		}
+
+		// Position of 'tag' among the axes of 'mask' that hold state.
+		template<unsigned mask, XYZ tag>
+		inline constexpr unsigned axis_rank = unsigned(std::popcount(mask & ((1u << std::size_t(tag)) - 1)));
+
+		template<unsigned mask, XYZ tag, typename T>
+		constexpr std::uint64_t
+		morton_axis(T const& value)
+		noexcept {
+			if constexpr(has_axis<mask, tag>)
+				return morton_spread<unsigned(std::popcount(mask))>(std::uint64_t(value)) << axis_rank<mask, tag>;
+			else return 0;
+		}
+
+		template<unsigned mask, XYZ tag, typename T>
+		constexpr auto
+		morton_axis_of(std::uint64_t code)
+		noexcept {
+			if constexpr(has_axis<mask, tag>)
+				return std::remove_cvref_t<T>(morton_compact<unsigned(std::popcount(mask))>(code >> axis_rank<mask, tag>));
+			else return NoState();
+		}
+
+		// Quotient of 'lhs / rhs', rounded towards negative infinity rather than towards zero.
+		template<std::integral L, std::integral R>
+		constexpr auto
+		floor_div_axis(L lhs, R rhs)
+		noexcept {
+			auto q = lhs / rhs;
+			if ((lhs % rhs != 0) && ((lhs < 0) != (rhs < 0))) --q;
+			return q;
+		}
+
+		constexpr NoState
+		floor_div_axis(NoState, NoState)
+		noexcept { return NoState(); }
+
+		// The cell 'value' falls in, along one axis, for cells of 'size': floor(value / size), as an I.
+		template<std::integral I, typename T, typename S>
+		requires std::is_arithmetic_v<T> && std::is_arithmetic_v<S>
+		constexpr I
+		cell_axis_of(T value, S size)
+		noexcept {
+			if constexpr(std::integral<T> && std::integral<S>) return I(floor_div_axis(value, size));
+			else {
+				// Truncates, then steps down where that rounded up, exactly as the batched kernels do.
+				const auto q = value / size;
+				const I t = I(q);
+				return q < decltype(q)(t) ? I(t - 1) : t;
+			}
+		}
+
+		template<std::integral I>
+		constexpr NoState
+		cell_axis_of(NoState, NoState)
+		noexcept { return NoState(); }
+
+		// Murmur3's 32 bit finalizer: every bit of the input affects every bit of the output.
+		constexpr std::uint32_t
+		mix32(std::uint32_t h)
+		noexcept {
+			h ^= h >> 16;
+			h *= 0x85EBCA6Bu;
+			h ^= h >> 13;
+			h *= 0xC2B2AE35u;
+			h ^= h >> 16;
+			return h;
+		}
+
+		// Odd multipliers of the spatial hash, one per axis (Teschner et al., "Optimized Spatial Hashing", 2003).
+		inline constexpr std::uint32_t hash_prime_x = 73856093u;
+		inline constexpr std::uint32_t hash_prime_y = 19349663u;
+		inline constexpr std::uint32_t hash_prime_z = 83492791u;
+
+		template<unsigned mask, XYZ tag, typename T>
+		constexpr std::uint32_t
+		hash_axis(T const& value, std::uint32_t prime)
+		noexcept {
+			if constexpr(has_axis<mask, tag>) return std::uint32_t(value) * prime;
+			else return 0;
+		}
+
+	}
+
+
+
+	/**
+	 * Morton (Z-order) code of a point with integer axes: bit i of the k-th axis holding state goes to bit
+	 * (axes holding state) * i + k. Each axis keeps its low 21 bits in 3D, 32 in 2D and 64 in 1D.
+	 * Negative coordinates go in as their two's complement bits, so bias them first where the order matters.
+	 * Uses the BMI2 'pdep' instruction when compiled for it. Its microcode version on AMD before Zen 3 is slower than
+	 * the portable shifts: do not build for BMI2 on those.
+	 */
+	template<typename X, typename Y, typename Z>
+	requires(detail::grid_axis<X> && detail::grid_axis<Y> && detail::grid_axis<Z> && Vec<X, Y, Z>::axes != 0)
+	constexpr std::uint64_t
+	morton_encode(Vec<X, Y, Z> const& point)
+	noexcept {
+		constexpr auto axes = Vec<X, Y, Z>::axes;
+		return
+			detail::morton_axis<axes, detail::XYZ::X>(point.x) |
+			detail::morton_axis<axes, detail::XYZ::Y>(point.y) |
+			detail::morton_axis<axes, detail::XYZ::Z>(point.z);
+	}
+
+	// The point of type V of a Morton code. The inverse of morton_encode(), up to the bits each axis keeps.
+	template<typename V = Vec<std::uint32_t>>
+	requires concepts::same_template<V, Vec<void>> && requires(V const& v) { {morton_encode(v)}; }
+	constexpr V
+	morton_decode(std::uint64_t code)
+	noexcept {
+		constexpr auto axes = V::axes;
+		return V(
+			detail::morton_axis_of<axes, detail::XYZ::X, typename V::value_type_x>(code),
+			detail::morton_axis_of<axes, detail::XYZ::Y, typename V::value_type_y>(code),
+			detail::morton_axis_of<axes, detail::XYZ::Z, typename V::value_type_z>(code));
+	}
+
+	/**
+	 * 32 bit hash of the cell a Vec of integers names, for hash tables of sparse voxels:
+	 * each axis is multiplied by its own odd constant, the products are xor-ed, and the result is mixed.
+	 * Axes wider than 32 bits contribute their low 32 bits only.
+	 */
+	template<typename X, typename Y, typename Z>
+	requires(detail::grid_axis<X> && detail::grid_axis<Y> && detail::grid_axis<Z>)
+	constexpr std::uint32_t
+	spatial_hash(Vec<X, Y, Z> const& cell)
+	noexcept {
+		constexpr auto axes = Vec<X, Y, Z>::axes;
+		return detail::mix32(
+			detail::hash_axis<axes, detail::XYZ::X>(cell.x, detail::hash_prime_x) ^
+			detail::hash_axis<axes, detail::XYZ::Y>(cell.y, detail::hash_prime_y) ^
+			detail::hash_axis<axes, detail::XYZ::Z>(cell.z, detail::hash_prime_z));
+	}
+
+	// Quotient of 'lhs / rhs' per axis, rounded towards negative infinity: the cell of an integer point, for cells of 'rhs'.
+	template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ>
+	requires requires(Vec<LX, LY, LZ> const& l, Vec<RX, RY, RZ> const& r) {
+		{ink::Vec{detail::floor_div_axis(l.x, r.x), detail::floor_div_axis(l.y, r.y), detail::floor_div_axis(l.z, r.z)}}; }
+	constexpr decltype(auto)
+	floor_div(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+	noexcept { return ink::Vec{detail::floor_div_axis(lhs.x, rhs.x), detail::floor_div_axis(lhs.y, rhs.y), detail::floor_div_axis(lhs.z, rhs.z)}; }
+
+	// floor_div() by the same scalar on every axis. For a power of two, 'lhs >> log2(rhs)' is the same, and cheaper.
+	template<typename X, typename Y, typename Z, std::integral T>
+	requires(detail::grid_axis<X> && detail::grid_axis<Y> && detail::grid_axis<Z>)
+	constexpr decltype(auto)
+	floor_div(Vec<X, Y, Z> const& lhs, T const& rhs)
+	noexcept {
+		using detail::masked;
+		using detail::has_axis;
+		constexpr auto axes = Vec<X, Y, Z>::axes;
+		return ink::Vec{
+			detail::floor_div_axis(lhs.x, masked<has_axis<axes, detail::XYZ::X>>(rhs)),
+			detail::floor_div_axis(lhs.y, masked<has_axis<axes, detail::XYZ::Y>>(rhs)),
+			detail::floor_div_axis(lhs.z, masked<has_axis<axes, detail::XYZ::Z>>(rhs)) };
+	}
+
+	/**
+	 * The cell of a grid of cubic cells of side 'cell_size', with a corner at the origin, that 'point' falls in:
+	 * floor(point / cell_size) per axis, as integers of type I. Works for integer and floating point points alike.
+	 * Floating point coordinates whose cell does not fit in an I give an unspecified cell.
+	 */
+	template<std::integral I = std::int32_t, typename X, typename Y, typename Z, typename S>
+	requires(detail::cell_axis<X> && detail::cell_axis<Y> && detail::cell_axis<Z> && std::is_arithmetic_v<S>)
+	constexpr decltype(auto)
+	to_cell(Vec<X, Y, Z> const& point, S const& cell_size)
+	noexcept {
+		using detail::masked;
+		using detail::has_axis;
+		constexpr auto axes = Vec<X, Y, Z>::axes;
+		return ink::Vec{
+			detail::cell_axis_of<I>(point.x, masked<has_axis<axes, detail::XYZ::X>>(cell_size)),
+			detail::cell_axis_of<I>(point.y, masked<has_axis<axes, detail::XYZ::Y>>(cell_size)),
+			detail::cell_axis_of<I>(point.z, masked<has_axis<axes, detail::XYZ::Z>>(cell_size)) };
+	}
+
+}
+
+
+
+namespace ink::generic_vec::simd {
+
+	#if defined(INK_GENERIC_VEC_SIMD_X86) && defined(__x86_64__)
+
+	// Morton codes with the BMI2 bit deposit / extract instructions, one vector at a time.
+	namespace bmi2 {
+
+		#if defined(__clang__)
+		#pragma clang attribute push(__attribute__((target("bmi2"))), apply_to = function)
+		#else
+		#pragma GCC push_options
+		#pragma GCC target("bmi2")
+		#endif
+
+		inline void
+		morton_encode(std::uint32_t const* in, std::uint64_t* out, std::size_t count) {
+			constexpr std::uint64_t mask = generic_vec::detail::morton_mask<3>;
+			for (std::size_t i = 0; i < count; ++i, in += 3)
+				out[i] = _pdep_u64(in[0], mask) | _pdep_u64(in[1], mask << 1) | _pdep_u64(in[2], mask << 2);
+		}
+
+		inline void
+		morton_decode(std::uint64_t const* in, std::uint32_t* out, std::size_t count) {
+			constexpr std::uint64_t mask = generic_vec::detail::morton_mask<3>;
+			for (std::size_t i = 0; i < count; ++i, out += 3) {
+				out[0] = std::uint32_t(_pext_u64(in[i], mask));
+				out[1] = std::uint32_t(_pext_u64(in[i], mask << 1));
+				out[2] = std::uint32_t(_pext_u64(in[i], mask << 2));
+			}
+		}
+
+		#if defined(__clang__)
+		#pragma clang attribute pop
+		#else
+		#pragma GCC pop_options
+		#endif
+
+	}
+
+	#endif
+
+	#ifdef INK_GENERIC_VEC_SIMD_X86
+
+	namespace sse2 {
+
+		#if defined(__clang__)
+		#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+		#else
+		#pragma GCC push_options
+		#pragma GCC target("sse2")
+		#endif
+
+		// floor(in / cell_size) for 'n' scalars: truncate, then step down the lanes where that rounded up.
+		inline void
+		to_cell(float const* in, float cell_size, std::int32_t* out, std::size_t n) {
+			const __m128 size = _mm_set1_ps(cell_size);
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				const __m128 q = _mm_div_ps(_mm_loadu_ps(in + i), size);
+				const __m128i t = _mm_cvttps_epi32(q);
+				// The comparison is all ones, that is -1, exactly where the truncation rounded up.
+				const __m128i up = _mm_castps_si128(_mm_cmplt_ps(q, _mm_cvtepi32_ps(t)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(t, up));
+			}
+			for (; i < n; ++i) out[i] = generic_vec::detail::cell_axis_of<std::int32_t>(in[i], cell_size);
+		}
+
+		#if defined(__clang__)
+		#pragma clang attribute pop
+		#else
+		#pragma GCC pop_options
+		#endif
+
+	}
+
+	namespace avx2 {
+
+		#if defined(__clang__)
+		#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+		#else
+		#pragma GCC push_options
+		#pragma GCC target("avx2")
+		#endif
+
+		// floor(in / cell_size) for 'n' scalars.
+		inline void
+		to_cell(float const* in, float cell_size, std::int32_t* out, std::size_t n) {
+			const __m256 size = _mm256_set1_ps(cell_size);
+			std::size_t i = 0;
+			for (; i + 8 <= n; i += 8) {
+				const __m256 q = _mm256_div_ps(_mm256_loadu_ps(in + i), size);
+				const __m256i t = _mm256_cvttps_epi32(q);
+				const __m256i up = _mm256_castps_si256(_mm256_cmp_ps(q, _mm256_cvtepi32_ps(t), _CMP_LT_OQ));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(t, up));
+			}
+			for (; i < n; ++i) out[i] = generic_vec::detail::cell_axis_of<std::int32_t>(in[i], cell_size);
+		}
+
+		static inline __m256i
+		mix32(__m256i h) {
+			h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+			h = _mm256_mullo_epi32(h, _mm256_set1_epi32(std::int32_t(0x85EBCA6Bu)));
+			h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+			h = _mm256_mullo_epi32(h, _mm256_set1_epi32(std::int32_t(0xC2B2AE35u)));
+			return _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+		}
+
+		// spatial_hash() of 'count' interleaved xyz cells, eight at a time, deinterleaved as the float kernels do.
+		inline void
+		spatial_hash(std::int32_t const* in, std::uint32_t* out, std::size_t count) {
+			using isa = traits<float>;
+			const __m256i px = _mm256_set1_epi32(std::int32_t(generic_vec::detail::hash_prime_x));
+			const __m256i py = _mm256_set1_epi32(std::int32_t(generic_vec::detail::hash_prime_y));
+			const __m256i pz = _mm256_set1_epi32(std::int32_t(generic_vec::detail::hash_prime_z));
+			std::size_t i = 0;
+			for (; i + isa::width <= count; i += isa::width) {
+				isa::reg x, y, z;
+				isa::load3(reinterpret_cast<float const*>(in + 3 * i), x, y, z);
+				const __m256i h = _mm256_xor_si256(
+					_mm256_xor_si256(_mm256_mullo_epi32(_mm256_castps_si256(x), px), _mm256_mullo_epi32(_mm256_castps_si256(y), py)),
+					_mm256_mullo_epi32(_mm256_castps_si256(z), pz));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), mix32(h));
+			}
+			for (; i < count; ++i)
+				out[i] = generic_vec::spatial_hash(Vec<std::int32_t>(in[3 * i], in[3 * i + 1], in[3 * i + 2]));
+		}
+
+		#if defined(__clang__)
+		#pragma clang attribute pop
+		#else
+		#pragma GCC pop_options
+		#endif
+
+	}
+
+	#endif
+
+	namespace detail {
+
+		/**
+		 * Whether the running CPU has fast BMI2. Detected once, on first use.
+		 * AMD families 15h and 17h (up to Zen 2) run pdep / pext in microcode, far slower than the portable shifts.
+		 */
+		inline bool
+		has_bmi2()
+		noexcept {
+			#if defined(INK_GENERIC_VEC_SIMD_X86) && defined(__x86_64__)
+			static const bool bmi2 = [] {
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("bmi2") && !__builtin_cpu_is("amdfam15h") && !__builtin_cpu_is("amdfam17h");
+			}();
+			return bmi2;
+			#else
+			return false;
+			#endif
+		}
+
+		static_assert(generic_vec::detail::interleaved_layout<std::int32_t> && generic_vec::detail::interleaved_layout<std::uint32_t>);
+
+	}
+
+
+
+	// out[i] = morton_encode(in[i]), for 'count' points. Uses BMI2 when the running CPU has it fast.
+	inline void
+	morton_encode(Vec<std::uint32_t> const* in, std::uint64_t* out, std::size_t count)
+	noexcept {
+		#if defined(INK_GENERIC_VEC_SIMD_X86) && defined(__x86_64__)
+		if (detail::has_bmi2()) return bmi2::morton_encode(detail::flat(in), out, count);
+		#endif
+		for (std::size_t i = 0; i < count; ++i) out[i] = generic_vec::morton_encode(in[i]);
+	}
+
+	// out[i] = morton_decode(in[i]), for 'count' codes. Uses BMI2 when the running CPU has it fast.
+	inline void
+	morton_decode(std::uint64_t const* in, Vec<std::uint32_t>* out, std::size_t count)
+	noexcept {
+		#if defined(INK_GENERIC_VEC_SIMD_X86) && defined(__x86_64__)
+		if (detail::has_bmi2()) return bmi2::morton_decode(in, detail::flat(out), count);
+		#endif
+		for (std::size_t i = 0; i < count; ++i) out[i] = generic_vec::morton_decode(in[i]);
+	}
+
+	// out[i] = spatial_hash(in[i]), for 'count' cells.
+	inline void
+	spatial_hash(Vec<std::int32_t> const* in, std::uint32_t* out, std::size_t count)
+	noexcept {
+		#ifdef INK_GENERIC_VEC_SIMD_X86
+		if (active_isa() >= Isa::AVX2) return avx2::spatial_hash(detail::flat(in), out, count);
+		#endif
+		for (std::size_t i = 0; i < count; ++i) out[i] = generic_vec::spatial_hash(in[i]);
+	}
+
+	// out[i] = to_cell(in[i], cell_size), for 'count' points.
+	inline void
+	to_cell(Vec<float> const* in, float cell_size, Vec<std::int32_t>* out, std::size_t count)
+	noexcept {
+		#ifdef INK_GENERIC_VEC_SIMD_X86
+		if (active_isa() >= Isa::AVX2) return avx2::to_cell(detail::flat(in), cell_size, detail::flat(out), 3 * count);
+		if (active_isa() >= Isa::SSE2) return sse2::to_cell(detail::flat(in), cell_size, detail::flat(out), 3 * count);
+		#endif
+		for (std::size_t i = 0; i < count; ++i) out[i] = generic_vec::to_cell(in[i], cell_size);
+	}
+
+}
+
+#endif
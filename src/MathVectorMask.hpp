@@ -0,0 +1,404 @@
+#ifndef INK_GENERIC_VEC_MASK_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_MASK_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include "MathVector.hpp"
+#include "MathVectorSimd.hpp"
+
+/*
+ * Per-axis boolean masks as bitsets, and branch-free selection by them.
+ *
+ * Comparisons of Vec return a Vec<bool> of three separate bools. mask() packs one into a VecMask: one bit per axis,
+ * bit 0 for x, 1 for y and 2 for z, in a single byte, where any(), all() and none() are one integer test each.
+ * The bits of the 'void' axes are excluded from the type itself, so that they never count: a VecMask of a
+ * Vec<float, float, void> is all() as soon as x and y are set. Since the comparison operators hold 'void' axes equal,
+ * and so return a bool for them too, mask(lhs, rhs, cmp) compares and packs in one go, and keeps only the axes of both.
+ *
+ * The batch forms in simd:: compare whole arrays of vectors in SIMD registers, and pack the results straight from the
+ * comparisons' movemasks: either one VecMask per vector, or one bit per vector, 64 to a word.
+ */
+namespace ink::generic_vec {
+
+	/**
+	 * The axes of a Vec for which some condition holds, as bits: bit 0 for x, 1 for y, 2 for z.
+	 * 'axes' holds the axes that exist, as Vec::axes does: the other bits are always clear.
+	 */
+	template<unsigned axes_ = 0b111u>
+	requires(axes_ <= 0b111u)
+	class VecMask {
+
+		public: static constexpr unsigned axes = axes_;
+
+		private: std::uint8_t M_bits = 0;
+
+		public:
+		constexpr VecMask() = default;
+
+		// The mask of the given bits. Those of axes that do not exist are dropped.
+		public: constexpr explicit
+		VecMask(unsigned bits)
+		noexcept : M_bits(static_cast<std::uint8_t>(bits & axes)) {}
+
+		public: constexpr unsigned
+		bits() const
+		noexcept { return M_bits; }
+
+		// Whether the given axis, 0 for x, 1 for y and 2 for z, is set.
+		public: constexpr bool
+		test(std::size_t axis) const
+		noexcept { return (M_bits >> axis) & 1u; }
+
+		public: constexpr bool
+		x() const
+		noexcept { return test(0); }
+
+		public: constexpr bool
+		y() const
+		noexcept { return test(1); }
+
+		public: constexpr bool
+		z() const
+		noexcept { return test(2); }
+
+		// Whether every existing axis is set. True when there are none.
+		public: constexpr bool
+		all() const
+		noexcept { return M_bits == axes; }
+
+		public: constexpr bool
+		any() const
+		noexcept { return M_bits != 0; }
+
+		public: constexpr bool
+		none() const
+		noexcept { return M_bits == 0; }
+
+		// Number of axes set.
+		public: constexpr int
+		count() const
+		noexcept { return std::popcount(M_bits); }
+
+		public: friend constexpr VecMask
+		operator&(VecMask lhs, VecMask rhs)
+		noexcept { return VecMask(lhs.M_bits & rhs.M_bits); }
+
+		public: friend constexpr VecMask
+		operator|(VecMask lhs, VecMask rhs)
+		noexcept { return VecMask(lhs.M_bits | rhs.M_bits); }
+
+		public: friend constexpr VecMask
+		operator^(VecMask lhs, VecMask rhs)
+		noexcept { return VecMask(lhs.M_bits ^ rhs.M_bits); }
+
+		// The complement within the existing axes.
+		public: friend constexpr VecMask
+		operator~(VecMask mask)
+		noexcept { return VecMask(~unsigned(mask.M_bits)); }
+
+		public: constexpr VecMask&
+		operator&=(VecMask rhs)
+		noexcept { return *this = *this & rhs; }
+
+		public: constexpr VecMask&
+		operator|=(VecMask rhs)
+		noexcept { return *this = *this | rhs; }
+
+		public: constexpr VecMask&
+		operator^=(VecMask rhs)
+		noexcept { return *this = *this ^ rhs; }
+
+		public: friend constexpr bool
+		operator==(VecMask, VecMask)
+		noexcept = default;
+
+	};
+
+
+
+	namespace detail {
+
+		template<typename T>
+		inline constexpr bool is_vec_mask = false;
+
+		template<unsigned axes>
+		inline constexpr bool is_vec_mask<VecMask<axes>> = true;
+
+		// The bit of an axis in mask(): false for NoState.
+		template<typename T>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+		mask_bit(T const& value)
+		noexcept(noexcept(bool(value)))
+		{ return bool(value); }
+
+		INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+		mask_bit(NoState)
+		noexcept { return false; }
+
+		/**
+		 * 'lhs' where 'take' is true, 'rhs' otherwise, without branching.
+		 * Integers and floating point numbers go through their bits, so that no compiler turns the choice back into
+		 * a jump: it costs a handful of cheap instructions, instead of a mispredicted branch whenever the masks
+		 * look random. Other types get the plain conditional operator.
+		 */
+		template<typename L, typename R>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr auto
+		select_axis(bool take, L const& lhs, R const& rhs)
+		noexcept(noexcept(take ? lhs : rhs)) {
+			using C = std::remove_cvref_t<decltype(take ? lhs : rhs)>;
+			if constexpr(std::integral<C> && !std::same_as<C, bool>) {
+				using U = std::make_unsigned_t<C>;
+				const U l = U(C(lhs)), r = U(C(rhs));
+				return C(r ^ ((l ^ r) & U(-U(take))));
+			}
+			else if constexpr(std::floating_point<C> && (sizeof(C) == 4 || sizeof(C) == 8)) {
+				using U = std::conditional_t<sizeof(C) == 4, std::uint32_t, std::uint64_t>;
+				const U l = std::bit_cast<U>(C(lhs)), r = std::bit_cast<U>(C(rhs));
+				return std::bit_cast<C>(U(r ^ ((l ^ r) & U(-U(take)))));
+			}
+			else return C(take ? lhs : rhs);
+		}
+
+		INK_GENERIC_VEC_FORCE_INLINE constexpr NoState
+		select_axis(bool, NoState, NoState)
+		noexcept { return NoState(); }
+
+		// Axis 'tag' of a VecMask or of a Vec of bools.
+		template<XYZ tag, typename M>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+		mask_axis(M const& mask)
+		noexcept {
+			if constexpr(is_vec_mask<M>) return mask.test(std::size_t(tag));
+			else if constexpr(tag == XYZ::X) return mask_bit(mask.x);
+			else if constexpr(tag == XYZ::Y) return mask_bit(mask.y);
+			else return mask_bit(mask.z);
+		}
+
+		template<bool take, typename L, typename R>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		blend_axis(L const& lhs, R const& rhs)
+		noexcept {
+			if constexpr(take) return (lhs);
+			else return (rhs);
+		}
+
+		// cmp(lhs, rhs) for an axis both sides hold, and false, without calling it, for any other.
+		template<bool exists, typename Cmp, typename L, typename R>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+		compare_axis(Cmp& cmp, L const& lhs, R const& rhs)
+		noexcept(!exists || noexcept(cmp(lhs, rhs))) {
+			if constexpr(exists) return bool(cmp(lhs, rhs));
+			else return false;
+		}
+
+	}
+
+	/**
+	 * Packs a Vec of bools, as the comparison operators return, into a VecMask of the same axes.
+	 *
+	 *     if (mask(point < lo).any()) ...
+	 */
+	template<typename X, typename Y, typename Z>
+	requires requires(Vec<X, Y, Z> const& v) { {detail::mask_bit(v.x)}; {detail::mask_bit(v.y)}; {detail::mask_bit(v.z)}; }
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecMask<Vec<X, Y, Z>::axes>
+	mask(Vec<X, Y, Z> const& vec)
+	noexcept {
+		return VecMask<Vec<X, Y, Z>::axes>(
+			unsigned(detail::mask_bit(vec.x)) |
+			unsigned(detail::mask_bit(vec.y)) << 1 |
+			unsigned(detail::mask_bit(vec.z)) << 2);
+	}
+
+	/**
+	 * The axes, of those that exist in both 'lhs' and 'rhs', for which cmp(lhs, rhs) holds.
+	 *
+	 *     if (mask(xy, lo, std::less<>()).any()) ...
+	 */
+	template<typename Cmp, typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecMask<Vec<LX, LY, LZ>::axes & Vec<RX, RY, RZ>::axes>
+	mask(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs, Cmp cmp)
+	noexcept(noexcept(cmp(lhs.x, rhs.x)) && noexcept(cmp(lhs.y, rhs.y)) && noexcept(cmp(lhs.z, rhs.z))) {
+		using detail::has_axis;
+		constexpr auto axes = Vec<LX, LY, LZ>::axes & Vec<RX, RY, RZ>::axes;
+		return VecMask<axes>(
+			unsigned(detail::compare_axis<has_axis<axes, detail::XYZ::X>>(cmp, lhs.x, rhs.x)) |
+			unsigned(detail::compare_axis<has_axis<axes, detail::XYZ::Y>>(cmp, lhs.y, rhs.y)) << 1 |
+			unsigned(detail::compare_axis<has_axis<axes, detail::XYZ::Z>>(cmp, lhs.z, rhs.z)) << 2);
+	}
+
+	template<unsigned axes>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+	all(VecMask<axes> mask)
+	noexcept { return mask.all(); }
+
+	template<unsigned axes>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+	any(VecMask<axes> mask)
+	noexcept { return mask.any(); }
+
+	template<unsigned axes>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+	none(VecMask<axes> mask)
+	noexcept { return mask.none(); }
+
+	// Whether no axis holding state is true. True with no axes at all.
+	template<typename X, typename Y, typename Z>
+	requires requires(Vec<X, Y, Z> const& v) { {generic_vec::mask(v)}; }
+	INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+	none(Vec<X, Y, Z> const& vec)
+	noexcept { return generic_vec::mask(vec).none(); }
+
+	template<unsigned axes>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr int
+	popcount(VecMask<axes> mask)
+	noexcept { return mask.count(); }
+
+	// Number of axes holding state that are true.
+	template<typename X, typename Y, typename Z>
+	requires requires(Vec<X, Y, Z> const& v) { {generic_vec::mask(v)}; }
+	INK_GENERIC_VEC_FORCE_INLINE constexpr int
+	popcount(Vec<X, Y, Z> const& vec)
+	noexcept { return generic_vec::mask(vec).count(); }
+
+	/**
+	 * Each axis of 'lhs' where 'mask' is set, and of 'rhs' where it is not, without branching.
+	 * 'mask' is a VecMask or a Vec of bools. 'void' axes, which must be so on both sides, stay 'void'.
+	 * Found by argument-dependent lookup, and deliberately not brought into ink, where it would clash with POSIX ::select.
+	 *
+	 *     const auto clamped = select(mask(v < lo), lo, v);
+	 */
+	template<typename M, typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ>
+	requires
+		(detail::is_vec_mask<M> || requires(M const& m) { {generic_vec::mask(m)}; }) &&
+		requires(Vec<LX, LY, LZ> const& l, Vec<RX, RY, RZ> const& r) {
+			{ink::Vec{detail::select_axis(true, l.x, r.x), detail::select_axis(true, l.y, r.y), detail::select_axis(true, l.z, r.z)}}; }
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	select(M const& mask, Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+	noexcept(noexcept(ink::Vec{detail::select_axis(true, lhs.x, rhs.x), detail::select_axis(true, lhs.y, rhs.y), detail::select_axis(true, lhs.z, rhs.z)})) {
+		return ink::Vec{
+			detail::select_axis(detail::mask_axis<detail::XYZ::X>(mask), lhs.x, rhs.x),
+			detail::select_axis(detail::mask_axis<detail::XYZ::Y>(mask), lhs.y, rhs.y),
+			detail::select_axis(detail::mask_axis<detail::XYZ::Z>(mask), lhs.z, rhs.z) };
+	}
+
+	/**
+	 * select() by a mask known at compile time: each axis of 'lhs' whose bit is set in 'bits', and of 'rhs' otherwise.
+	 * Only the chosen axes need to exist, and they keep their own type:
+	 *
+	 *     blend<0b011>(xy, Vec<void, void, float>(...))    // x and y of 'xy', z of the other
+	 */
+	template<unsigned bits, typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ>
+	requires(bits <= 0b111u)
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	blend(Vec<LX, LY, LZ> const& lhs, Vec<RX, RY, RZ> const& rhs)
+	noexcept {
+		return ink::Vec{
+			detail::blend_axis<bool(bits & 1u)>(lhs.x, rhs.x),
+			detail::blend_axis<bool(bits & 2u)>(lhs.y, rhs.y),
+			detail::blend_axis<bool(bits & 4u)>(lhs.z, rhs.z) };
+	}
+
+
+
+	namespace simd {
+
+		namespace detail {
+
+			// The kernel comparison of each std:: comparison function object.
+			template<typename Cmp> inline constexpr bool is_comparison = false;
+			template<typename T> inline constexpr bool is_comparison<std::equal_to<T>> = true;
+			template<typename T> inline constexpr bool is_comparison<std::not_equal_to<T>> = true;
+			template<typename T> inline constexpr bool is_comparison<std::less<T>> = true;
+			template<typename T> inline constexpr bool is_comparison<std::less_equal<T>> = true;
+			template<typename T> inline constexpr bool is_comparison<std::greater<T>> = true;
+			template<typename T> inline constexpr bool is_comparison<std::greater_equal<T>> = true;
+
+			template<template<typename> typename Cmp> inline constexpr CmpOp cmp_op_of = CmpOp::Eq;
+			template<> inline constexpr CmpOp cmp_op_of<std::not_equal_to> = CmpOp::Neq;
+			template<> inline constexpr CmpOp cmp_op_of<std::less> = CmpOp::Lt;
+			template<> inline constexpr CmpOp cmp_op_of<std::less_equal> = CmpOp::Le;
+			template<> inline constexpr CmpOp cmp_op_of<std::greater> = CmpOp::Gt;
+			template<> inline constexpr CmpOp cmp_op_of<std::greater_equal> = CmpOp::Ge;
+
+			template<template<typename> typename Cmp, typename T>
+			constexpr std::size_t
+			cmp_index(Cmp<T> const&)
+			noexcept { return std::size_t(cmp_op_of<Cmp>); }
+
+			static_assert(sizeof(VecMask<>) == 1 && std::is_standard_layout_v<VecMask<>>);
+
+			inline std::uint8_t*
+			flat(VecMask<>* masks)
+			noexcept { return reinterpret_cast<std::uint8_t*>(masks); }
+
+		}
+
+		/**
+		 * out[i] = mask(cmp(lhs[i], rhs[i])), for 'count' vectors. 'cmp' is one of std::less<>, std::equal_to<>
+		 * and the other standard comparison function objects.
+		 *
+		 *     simd::mask(points, bounds, std::less<>(), out, count);
+		 */
+		template<typename Cmp, std::floating_point T>
+		requires detail::is_comparison<Cmp>
+		inline void
+		mask(Vec<T> const* lhs, Vec<T> const* rhs, Cmp cmp, VecMask<>* out, std::size_t count)
+		noexcept { kernels<T>().cmp_mask[detail::cmp_index(cmp)](detail::flat(lhs), detail::flat(rhs), false, detail::flat(out), count); }
+
+		// out[i] = mask(cmp(lhs[i], rhs)), for 'count' vectors.
+		template<typename Cmp, std::floating_point T>
+		requires detail::is_comparison<Cmp>
+		inline void
+		mask(Vec<T> const* lhs, Vec<T> const& rhs, Cmp cmp, VecMask<>* out, std::size_t count)
+		noexcept { kernels<T>().cmp_mask[detail::cmp_index(cmp)](detail::flat(lhs), detail::flat(&rhs), true, detail::flat(out), count); }
+
+		/**
+		 * Bit i % 64 of out[(i / 64)] = all(cmp(lhs[i], rhs[i])), for 'count' vectors: out must hold (count + 63) / 64
+		 * words. The bits past 'count' in the last word are cleared, so that whole words can be tested and counted.
+		 */
+		template<typename Cmp, std::floating_point T>
+		requires detail::is_comparison<Cmp>
+		inline void
+		mask_all(Vec<T> const* lhs, Vec<T> const* rhs, Cmp cmp, std::uint64_t* out, std::size_t count)
+		noexcept { kernels<T>().cmp_all[detail::cmp_index(cmp)](detail::flat(lhs), detail::flat(rhs), false, out, count); }
+
+		// mask_all() against the single vector 'rhs'.
+		template<typename Cmp, std::floating_point T>
+		requires detail::is_comparison<Cmp>
+		inline void
+		mask_all(Vec<T> const* lhs, Vec<T> const& rhs, Cmp cmp, std::uint64_t* out, std::size_t count)
+		noexcept { kernels<T>().cmp_all[detail::cmp_index(cmp)](detail::flat(lhs), detail::flat(&rhs), true, out, count); }
+
+		// Bit i % 64 of out[(i / 64)] = any(cmp(lhs[i], rhs[i])), for 'count' vectors. See mask_all().
+		template<typename Cmp, std::floating_point T>
+		requires detail::is_comparison<Cmp>
+		inline void
+		mask_any(Vec<T> const* lhs, Vec<T> const* rhs, Cmp cmp, std::uint64_t* out, std::size_t count)
+		noexcept { kernels<T>().cmp_any[detail::cmp_index(cmp)](detail::flat(lhs), detail::flat(rhs), false, out, count); }
+
+		// mask_any() against the single vector 'rhs'.
+		template<typename Cmp, std::floating_point T>
+		requires detail::is_comparison<Cmp>
+		inline void
+		mask_any(Vec<T> const* lhs, Vec<T> const& rhs, Cmp cmp, std::uint64_t* out, std::size_t count)
+		noexcept { kernels<T>().cmp_any[detail::cmp_index(cmp)](detail::flat(lhs), detail::flat(&rhs), true, out, count); }
+
+	}
+
+}
+
+namespace ink {
+
+	using generic_vec::VecMask;
+	using generic_vec::mask;
+	using generic_vec::none;
+	using generic_vec::popcount;
+	using generic_vec::blend;
+
+}
+
+#endif
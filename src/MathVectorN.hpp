@@ -0,0 +1,1069 @@
+#ifndef INK_GENERIC_VEC_N_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_N_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include "MathVector.hpp"
+
+/*
+ * VecN<T...>: a Vec with any number of axes, one type per axis, for homogeneous coordinates, colours and feature vectors.
+ *
+ * It keeps what Vec does with three: a 'void' axis holds no state and costs nothing, the axes may have different types,
+ * and they are laid out by decreasing alignment, ties in declaration order, as detail::aligned_axis_at lays out x, y
+ * and z, so that no padding is left between them. Axes are reached by index, with get<i>() or structured bindings.
+ *
+ * Every operation is a fold expression over the axes, unrolled at compile time, so one code path serves every
+ * dimension: VecN<float, float, float> compiles to the same code as Vec<float>, and VecN<float, float, float, float>
+ * to the same code as four hand-written floats.
+ */
+namespace ink::generic_vec {
+
+	template<typename... Ts>
+	class VecN;
+
+	namespace detail {
+
+		template<typename T> inline constexpr bool is_vec_n = false;
+		template<typename... Ts> inline constexpr bool is_vec_n<VecN<Ts...>> = true;
+
+		// The i-th type of Ts.
+		template<std::size_t i, typename T, typename... Ts>
+		struct type_at_t { using type = typename type_at_t<i - 1, Ts...>::type; };
+
+		template<typename T, typename... Ts>
+		struct type_at_t<0, T, Ts...> { using type = T; };
+
+		template<std::size_t i, typename... Ts>
+		using type_at = typename type_at_t<i, Ts...>::type;
+
+		// NoState, once per type of a pack.
+		template<typename>
+		using no_state_for = NoState;
+
+		// Axis i of a VecN, as Member and Axis are for x, y and z.
+		template<std::size_t i, typename T> struct MemberN { T value; };
+		template<std::size_t i> struct MemberN<i, void> { static constexpr NoState value{}; };
+
+		template<std::size_t i, typename T>
+		class AxisN:
+			public MemberN<i, T>
+		{
+
+			private:
+			using base = MemberN<i, T>;
+
+			public: INK_GENERIC_VEC_FORCE_INLINE constexpr explicit
+			AxisN(NoState)
+			noexcept( noexcept(base{}) )
+			requires( std::default_initializable<base> )
+			: base{} {}
+
+			public: template<typename U>
+			requires (!std::convertible_to<std::remove_cvref_t<U>, NoState>) &&
+			requires (U u) { {base{u}}; }
+			INK_GENERIC_VEC_FORCE_INLINE constexpr explicit
+			AxisN(U&& u)
+			noexcept( noexcept(base{std::declval<U>()}) )
+			: base{std::forward<U>(u)} {}
+
+		};
+
+		/**
+		 * Storage slot k of a VecN<Ts...> holds axis 'order[k]': by decreasing alignment, ties in declaration order,
+		 * the order aligned_axis_at picks for three axes.
+		 */
+		template<typename... Ts>
+		inline constexpr std::array<std::size_t, sizeof...(Ts)> axis_order = [] {
+			constexpr std::size_t size = sizeof...(Ts);
+			constexpr std::array<std::size_t, size> align{ alignof(AxisN<0, Ts>)... };
+			std::array<std::size_t, size> order{};
+			for (std::size_t i = 0; i < size; ++i) {
+				std::size_t rank = 0;
+				for (std::size_t j = 0; j < size; ++j) rank += (align[j] > align[i]) || (align[j] == align[i] && j < i);
+				order[rank] = i;
+			}
+			return order;
+		}();
+
+		template<std::size_t k, typename... Ts>
+		using aligned_axis_n_at = AxisN<axis_order<Ts...>[k], type_at<axis_order<Ts...>[k], Ts...>>;
+
+		// The i-th of 'args', forwarded.
+		template<std::size_t i, typename A, typename... As>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		arg_at(A&& arg, As&&... args)
+		noexcept {
+			if constexpr(i == 0) return std::forward<A>(arg);
+			else return detail::arg_at<i - 1>(std::forward<As>(args)...);
+		}
+
+		template<typename Slots, typename... Ts>
+		class VecNBase;
+
+		template<std::size_t... k, typename... Ts>
+		class VecNBase<std::index_sequence<k...>, Ts...>:
+			public aligned_axis_n_at<k, Ts...>...
+		{
+
+			// The arguments come in axis order, and each slot picks its own.
+			public: template<typename... Os>
+			INK_GENERIC_VEC_FORCE_INLINE constexpr explicit
+			VecNBase(Os&&... os)
+			noexcept( (noexcept(aligned_axis_n_at<k, Ts...>(detail::arg_at<axis_order<Ts...>[k]>(std::forward<Os>(os)...))) && ...) )
+			: aligned_axis_n_at<k, Ts...>(detail::arg_at<axis_order<Ts...>[k]>(std::forward<Os>(os)...))... {}
+
+		};
+
+		// A pack of types, to pass two of them at once.
+		template<typename... Ts>
+		struct types {};
+
+		// Whether axis i of a VecN<Ts...> can be built from the i-th of Os, for every i.
+		template<typename Axes, typename Args>
+		inline constexpr bool axes_constructible = false;
+
+		template<typename... Ts, typename... Os>
+		requires(sizeof...(Ts) == sizeof...(Os))
+		inline constexpr bool axes_constructible<types<Ts...>, types<Os...>> =
+			[]<std::size_t... i>(std::index_sequence<i...>) {
+				return (std::constructible_from<AxisN<i, Ts>, Os> && ...);
+			}(std::index_sequence_for<Ts...>{});
+
+		// Bit i is set when axis i of VecN<Ts...> holds state.
+		template<typename... Ts>
+		inline constexpr std::uint64_t axis_mask_n =
+			[]<std::size_t... i>(std::index_sequence<i...>) {
+				return ((std::uint64_t(!std::is_void_v<Ts>) << i) | ... | std::uint64_t(0));
+			}(std::index_sequence_for<Ts...>{});
+
+	}
+
+	/**
+	 * A vector of sizeof...(Ts) axes, axis i of type Ts[i], or of no state at all where that is 'void'.
+	 * See the top of this file.
+	 */
+	template<typename... Ts>
+	class VecN:
+		public detail::VecNBase<std::make_index_sequence<sizeof...(Ts)>, Ts...>
+	{
+
+		static_assert(sizeof...(Ts) <= 64, "VecN::axes has one bit per axis");
+
+		private: using base = detail::VecNBase<std::make_index_sequence<sizeof...(Ts)>, Ts...>;
+
+		private: template<std::size_t i>
+		using axis_base = detail::AxisN<i, detail::type_at<i, Ts...>>;
+
+		public: using NoState = generic_vec::NoState;
+
+		public: static constexpr std::size_t size = sizeof...(Ts);
+
+		// Axes holding state, as a bit mask: bit i for axis i.
+		public: static constexpr std::uint64_t axes = detail::axis_mask_n<Ts...>;
+
+		public: template<std::size_t i>
+		using value_type_at = decltype(axis_base<i>::value);
+
+
+
+		public: constexpr
+		VecN()
+		noexcept(noexcept(base(detail::no_state_for<Ts>{}...)))
+		requires(detail::axes_constructible<detail::types<Ts...>, detail::types<detail::no_state_for<Ts>...>>)
+		: base(detail::no_state_for<Ts>{}...) {}
+
+		// One value per axis, NoState or nullptr for the 'void' ones.
+		public: template<typename... Os>
+		requires(sizeof...(Os) == sizeof...(Ts) && sizeof...(Os) > 0 && detail::axes_constructible<detail::types<Ts...>, detail::types<Os...>>)
+		INK_GENERIC_VEC_FORCE_INLINE constexpr
+		VecN(Os&&... os)
+		noexcept(noexcept(base(std::forward<Os>(os)...)))
+		: base(std::forward<Os>(os)...) {}
+
+		// Converts each axis, as Vec's converting constructor does. A 'void' axis on either side stays or becomes NoState.
+		public: template<typename... Us>
+		requires(sizeof...(Us) == sizeof...(Ts) && !std::same_as<VecN<Us...>, VecN>)
+		constexpr explicit
+		VecN(VecN<Us...> const& other)
+		: VecN([&]<std::size_t... i>(std::index_sequence<i...>) {
+			return VecN(M_convert<i>(other.template get<i>())...);
+		}(std::index_sequence_for<Ts...>{})) {}
+
+		// The axes of a Vec, in x, y, z order.
+		public: template<typename X, typename Y, typename Z>
+		requires(sizeof...(Ts) == 3 && detail::axes_constructible<detail::types<Ts...>, detail::types<
+			decltype(std::declval<Vec<X, Y, Z> const&>().x),
+			decltype(std::declval<Vec<X, Y, Z> const&>().y),
+			decltype(std::declval<Vec<X, Y, Z> const&>().z)>>)
+		constexpr explicit
+		VecN(Vec<X, Y, Z> const& vec)
+		noexcept(noexcept(base(vec.x, vec.y, vec.z)))
+		: base(vec.x, vec.y, vec.z) {}
+
+		private: template<std::size_t i, typename U>
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		M_convert(U const& value) {
+			if constexpr(std::is_void_v<detail::type_at<i, Ts...>> || std::same_as<std::remove_cv_t<U>, NoState>) return NoState();
+			else return static_cast<value_type_at<i>>(value);
+		}
+
+
+
+		// Axis i.
+		public: template<std::size_t i>
+		requires(i < sizeof...(Ts))
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		get() &
+		noexcept { return (static_cast<axis_base<i>&>(*this).value); }
+
+		public: template<std::size_t i>
+		requires(i < sizeof...(Ts))
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		get() const&
+		noexcept { return (static_cast<axis_base<i> const&>(*this).value); }
+
+		public: template<std::size_t i>
+		requires(i < sizeof...(Ts))
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		get() &&
+		noexcept { return std::move(static_cast<axis_base<i>&>(*this).value); }
+
+		// The same axes as a Vec, for three of them.
+		public: INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		to_vec() const
+		requires(sizeof...(Ts) == 3)
+		{ return ink::Vec{get<0>(), get<1>(), get<2>()}; }
+
+
+
+		// Sum of the products of matching axes, in axis order: ((a0 * b0 + a1 * b1) + a2 * b2) + ..., as Vec::dot.
+		private: template<typename L, typename R, std::size_t... i>
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr auto
+		M_fold_dot(L const& lhs, R const& rhs, std::index_sequence<i...>)
+		-> decltype((... + (lhs.template get<i>() * rhs.template get<i>())))
+		{ return (... + (lhs.template get<i>() * rhs.template get<i>())); }
+
+		// fused_mul_add(a0, b0, fused_mul_add(a1, b1, ... an * bn)), as Vec::dot_fma for three axes.
+		private: template<std::size_t i, typename L, typename R>
+		INK_GENERIC_VEC_FORCE_INLINE static constexpr decltype(auto)
+		M_fold_dot_fma(L const& lhs, R const& rhs) {
+			if constexpr(i + 1 == sizeof...(Ts)) return lhs.template get<i>() * rhs.template get<i>();
+			else return detail::fused_mul_add(lhs.template get<i>(), rhs.template get<i>(), M_fold_dot_fma<i + 1>(lhs, rhs));
+		}
+
+
+
+		// Returns the dot product of this and the rhs vector. A 'void' axis on either side drops its term.
+		public: template<typename... Us>
+		requires(sizeof...(Us) == sizeof...(Ts)) &&
+		requires(VecN const& l, VecN<Us...> const& r) { {M_fold_dot(l, r, std::index_sequence_for<Ts...>{})}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		dot(VecN<Us...> const& rhs) const
+		{ return M_fold_dot(*this, rhs, std::index_sequence_for<Ts...>{}); }
+
+		// Returns the magnitude of the vector squared. Cheaper than directly getting the magnitude.
+		public: INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		mag2() const
+		requires requires(VecN const& v) { {v.dot(v)}; }
+		{ return dot(*this); }
+
+		// dot(), accumulated with fused multiply-adds where the axes allow it. See Vec::dot_fma().
+		public: template<typename... Us>
+		requires requires(VecN const& l, VecN<Us...> const& r) { {l.dot(r)}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		dot_fma(VecN<Us...> const& rhs) const
+		{ return M_fold_dot_fma<0>(*this, rhs); }
+
+		// mag2(), accumulated with fused multiply-adds.
+		public: INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		mag2_fma() const
+		requires requires(VecN const& v) { {v.dot_fma(v)}; }
+		{ return dot_fma(*this); }
+
+		// Returns the magnitude (length) of the vector. See Precision for the tiers.
+		public: template<Precision precision = Precision::Exact>
+		requires requires(VecN const& v) { {detail::sqrt<precision>(v.mag2())}; }
+		INK_GENERIC_VEC_FORCE_INLINE decltype(auto)
+		mag() const
+		{ return detail::sqrt<precision>(mag2()); }
+
+		// Returns 1 / mag(). Not finite for the zero vector.
+		public: template<Precision precision = Precision::Exact>
+		requires requires(VecN const& v) { {detail::inv_sqrt<precision>(v.mag2())}; }
+		INK_GENERIC_VEC_FORCE_INLINE decltype(auto)
+		inv_mag() const
+		{ return detail::inv_sqrt<precision>(mag2()); }
+
+		// Returns the vector scaled to a magnitude of 1, by a single multiplication with inv_mag(). NaN for the zero vector.
+		public: template<Precision precision = Precision::Exact>
+		requires requires(VecN const& v) { {v * v.template inv_mag<precision>()}; }
+		INK_GENERIC_VEC_FORCE_INLINE decltype(auto)
+		normalize() const
+		{ return *this * inv_mag<precision>(); }
+
+		// Returns the magnitude of (this - rhs) squared.
+		public: template<typename... Us>
+		requires requires(VecN const& l, VecN<Us...> const& r) { {(l - r).mag2()}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		distance2(VecN<Us...> const& rhs) const
+		{ return (*this - rhs).mag2(); }
+
+		// Returns the magnitude of (this - rhs). See Precision for the tiers.
+		public: template<Precision precision = Precision::Exact, typename... Us>
+		requires requires(VecN const& l, VecN<Us...> const& r) { {detail::sqrt<precision>(l.distance2(r))}; }
+		INK_GENERIC_VEC_FORCE_INLINE decltype(auto)
+		distance(VecN<Us...> const& rhs) const
+		{ return detail::sqrt<precision>(distance2(rhs)); }
+
+	};
+
+	template<typename... Os>
+	VecN(Os...) -> VecN<std::conditional_t<(std::is_null_pointer_v<Os> || std::same_as<NoState, Os>), void, Os>...>;
+
+	template<typename X, typename Y, typename Z>
+	VecN(Vec<X, Y, Z>) -> VecN<X, Y, Z>;
+
+	// Axis i of 'vec'.
+	template<std::size_t i, typename... Ts>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	get(VecN<Ts...>& vec)
+	noexcept { return vec.template get<i>(); }
+
+	template<std::size_t i, typename... Ts>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	get(VecN<Ts...> const& vec)
+	noexcept { return vec.template get<i>(); }
+
+	template<std::size_t i, typename... Ts>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	get(VecN<Ts...>&& vec)
+	noexcept { return std::move(vec).template get<i>(); }
+
+
+
+	// Vectorial Operation, axis by axis. Vectors of different sizes never combine.
+	template<typename... L, typename... R, template<typename...> typename Constraint, bool MustBeNoexcept>
+	struct OpConstraint_t<Constraint, VecN<L...>, VecN<R...>, MustBeNoexcept>:
+	std::bool_constant<(
+		sizeof...(L) == sizeof...(R) &&
+		[]<std::size_t... i>(std::index_sequence<i...>) {
+			if constexpr(sizeof...(L) != sizeof...(R)) return false;
+			else return (Constraint<
+				typename VecN<L...>::template value_type_at<i>,
+				typename VecN<R...>::template value_type_at<i>,
+				std::bool_constant<MustBeNoexcept>>{}() && ...);
+		}(std::index_sequence_for<L...>{})
+	)> {};
+
+	// Scalar Operation. Scalar Right Hand Side.
+	template<typename... L, typename RHS, template<typename...> typename Constraint, bool MustBeNoexcept>
+	requires(!detail::is_vec_n<RHS> && !concepts::same_template<RHS, Vec<void>> && !vec_expression<RHS>)
+	struct OpConstraint_t<Constraint, VecN<L...>, RHS, MustBeNoexcept>:
+	std::bool_constant<(
+		[]<std::size_t... i>(std::index_sequence<i...>) {
+			return (Constraint<typename VecN<L...>::template value_type_at<i>, RHS, std::bool_constant<MustBeNoexcept>>{}() && ...);
+		}(std::index_sequence_for<L...>{})
+	)> {};
+
+	// Scalar Operation. Scalar Left Hand Side.
+	template<typename... R, typename LHS, template<typename...> typename Constraint, bool MustBeNoexcept>
+	requires(!detail::is_vec_n<LHS> && !concepts::same_template<LHS, Vec<void>> && !vec_expression<LHS>)
+	struct OpConstraint_t<Constraint, LHS, VecN<R...>, MustBeNoexcept>:
+	std::bool_constant<(
+		[]<std::size_t... i>(std::index_sequence<i...>) {
+			return (Constraint<LHS, typename VecN<R...>::template value_type_at<i>, std::bool_constant<MustBeNoexcept>>{}() && ...);
+		}(std::index_sequence_for<R...>{})
+	)> {};
+
+
+
+	// A Vec and a VecN never combine, in either order, rather than one of them passing for a scalar: convert first.
+	template<typename... L, typename RX, typename RY, typename RZ, template<typename...> typename Constraint, bool MustBeNoexcept>
+	struct OpConstraint_t<Constraint, VecN<L...>, Vec<RX, RY, RZ>, MustBeNoexcept>: std::false_type {};
+
+	template<typename LX, typename LY, typename LZ, typename... R, template<typename...> typename Constraint, bool MustBeNoexcept>
+	struct OpConstraint_t<Constraint, Vec<LX, LY, LZ>, VecN<R...>, MustBeNoexcept>: std::false_type {};
+
+
+
+	namespace detail {
+
+		// VecN{op(lhs[i], rhs[i])...}.
+		template<typename Op, typename... L, typename... R>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		zip_n(Op const& op, VecN<L...> const& lhs, VecN<R...> const& rhs) {
+			return [&]<std::size_t... i>(std::index_sequence<i...>) {
+				return ink::generic_vec::VecN{op(lhs.template get<i>(), rhs.template get<i>())...};
+			}(std::index_sequence_for<L...>{});
+		}
+
+		// VecN{op(lhs[i], rhs)...}, the scalar masked out of the 'void' axes so that they stay 'void'.
+		template<typename Op, typename... L, typename S>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		zip_n_scalar(Op const& op, VecN<L...> const& lhs, S const& rhs) {
+			return [&]<std::size_t... i>(std::index_sequence<i...>) {
+				return ink::generic_vec::VecN{op(lhs.template get<i>(), masked<!std::is_void_v<L>>(rhs))...};
+			}(std::index_sequence_for<L...>{});
+		}
+
+		// VecN{op(lhs, rhs[i])...}.
+		template<typename Op, typename S, typename... R>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		zip_n_scalar(Op const& op, S const& lhs, VecN<R...> const& rhs) {
+			return [&]<std::size_t... i>(std::index_sequence<i...>) {
+				return ink::generic_vec::VecN{op(masked<!std::is_void_v<R>>(lhs), rhs.template get<i>())...};
+			}(std::index_sequence_for<R...>{});
+		}
+
+		// VecN{op(vec[i])...}.
+		template<typename Op, typename... Ts>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		map_n(Op const& op, VecN<Ts...> const& vec) {
+			return [&]<std::size_t... i>(std::index_sequence<i...>) {
+				return ink::generic_vec::VecN{op(vec.template get<i>())...};
+			}(std::index_sequence_for<Ts...>{});
+		}
+
+		// Whether Trait holds for the type of every axis of Vector.
+		template<template<typename...> typename Trait, typename Vector>
+		inline constexpr bool unary_n = false;
+
+		template<template<typename...> typename Trait, typename... Ts>
+		inline constexpr bool unary_n<Trait, VecN<Ts...>> =
+			[]<std::size_t... i>(std::index_sequence<i...>) {
+				return (Trait<typename VecN<Ts...>::template value_type_at<i>>::value && ...);
+			}(std::index_sequence_for<Ts...>{});
+
+		// op(lhs[i], rhs[i]) for every i, in place.
+		template<typename Op, typename... L, typename... R>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr void
+		each_n(Op const& op, VecN<L...>& lhs, VecN<R...> const& rhs) {
+			[&]<std::size_t... i>(std::index_sequence<i...>) {
+				(op(lhs.template get<i>(), rhs.template get<i>()), ...);
+			}(std::index_sequence_for<L...>{});
+		}
+
+		// op(lhs[i], rhs) for every i, in place.
+		template<typename Op, typename... L, typename S>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr void
+		each_n_scalar(Op const& op, VecN<L...>& lhs, S const& rhs) {
+			[&]<std::size_t... i>(std::index_sequence<i...>) {
+				(op(lhs.template get<i>(), rhs), ...);
+			}(std::index_sequence_for<L...>{});
+		}
+
+	}
+
+	/*
+	 * Every operator of Vec, for VecN: element-wise against another VecN of the same size, or against a scalar on either
+	 * side, which a 'void' axis ignores. Comparisons are element-wise, and return a VecN of their results.
+	 */
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_add_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator+(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_add_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l + r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_add_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator+(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_add_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l + r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_add_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator+(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_add_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l + r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_sub_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator-(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_sub_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l - r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_sub_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator-(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_sub_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l - r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_sub_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator-(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_sub_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l - r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_mul_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator*(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mul_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l * r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_mul_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator*(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mul_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l * r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_mul_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator*(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mul_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l * r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_div_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator/(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_div_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l / r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_div_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator/(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_div_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l / r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_div_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator/(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_div_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l / r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_mod_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator%(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mod_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l % r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_mod_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator%(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mod_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l % r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_mod_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator%(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mod_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l % r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_and_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator&(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_and_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l & r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_bitwise_and_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator&(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_and_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l & r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_and_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator&(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_and_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l & r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_or_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator|(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_or_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l | r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_bitwise_or_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator|(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_or_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l | r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_or_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator|(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_or_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l | r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_xor_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator^(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_xor_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l ^ r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_bitwise_xor_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator^(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_xor_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l ^ r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_xor_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator^(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_xor_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l ^ r; }, lhs, rhs); }
+
+
+
+	// The scalar operand of a shift must be an integer, so that 'stream << vec' is never mistaken for a shift of each axis.
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_shift_left_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator<<(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_left_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l << r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_shift_left_t, LVec, T>{}() && std::integral<T> )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator<<(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_left_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l << r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_shift_left_t, T, RVec>{}() && std::integral<T> )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator<<(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_left_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l << r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_shift_right_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator>>(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_right_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l >> r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_shift_right_t, LVec, T>{}() && std::integral<T> )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator>>(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_right_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l >> r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_shift_right_t, T, RVec>{}() && std::integral<T> )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator>>(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_right_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l >> r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_logical_and_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator&&(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_logical_and_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l && r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_logical_and_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator&&(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_logical_and_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l && r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_logical_and_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator&&(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_logical_and_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l && r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_logical_or_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator||(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_logical_or_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) -> decltype(auto) { return l || r; }, lhs, rhs); }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_logical_or_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator||(VecN<L...> const& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_logical_or_t, LVec, T, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l || r; }, lhs, rhs); }
+
+	template<typename T, typename... R, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_logical_or_t, T, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator||(T const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_logical_or_t, T, RVec, true>{}())
+	{ return detail::zip_n_scalar([](auto const& l, auto const& r) -> decltype(auto) { return l || r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_cmp_eq_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator==(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_cmp_eq_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) { return l == r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_cmp_neq_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator!=(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_cmp_neq_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) { return l != r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_cmp_less_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator<(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_cmp_less_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) { return l < r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_cmp_less_eq_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator<=(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_cmp_less_eq_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) { return l <= r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_cmp_greater_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator>(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_cmp_greater_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) { return l > r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_cmp_greater_eq_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator>=(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_cmp_greater_eq_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) { return l >= r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_cmp_threeway_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator<=>(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_cmp_threeway_t, LVec, RVec, true>{}())
+	{ return detail::zip_n([](auto const& l, auto const& r) { return l <=> r; }, lhs, rhs); }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_add_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator+=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_add_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l += r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_add_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator+=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_add_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l += r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_sub_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator-=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_sub_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l -= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_sub_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator-=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_sub_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l -= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_mul_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator*=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mul_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l *= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_mul_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator*=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mul_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l *= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_div_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator/=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_div_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l /= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_div_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator/=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_div_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l /= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_mod_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator%=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mod_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l %= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_mod_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator%=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_mod_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l %= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_and_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator&=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_and_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l &= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_bitwise_and_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator&=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_and_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l &= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_or_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator|=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_or_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l |= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_bitwise_or_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator|=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_or_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l |= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_bitwise_xor_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator^=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_xor_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l ^= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_bitwise_xor_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator^=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_bitwise_xor_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l ^= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_shift_left_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator<<=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_left_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l <<= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_shift_left_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator<<=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_left_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l <<= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... L, typename... R, typename LVec = VecN<L...>, typename RVec = VecN<R...>>
+	requires( OpConstraint_t<concepts::can_shift_right_assign_t, LVec, RVec>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator>>=(VecN<L...>& lhs, VecN<R...> const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_right_assign_t, LVec, RVec, true>{}())
+	{ detail::each_n([](auto& l, auto const& r) { l >>= r; }, lhs, rhs); return lhs; }
+
+	template<typename... L, typename T, typename LVec = VecN<L...>>
+	requires( OpConstraint_t<concepts::can_shift_right_assign_t, LVec, T>{}() )
+	INK_GENERIC_VEC_FORCE_INLINE constexpr VecN<L...>&
+	operator>>=(VecN<L...>& lhs, T const& rhs)
+	noexcept(OpConstraint_t<concepts::can_shift_right_assign_t, LVec, T, true>{}())
+	{ detail::each_n_scalar([](auto& l, auto const& r) { l >>= r; }, lhs, rhs); return lhs; }
+
+
+
+	template<typename... Ts>
+	requires(detail::unary_n<concepts::can_unary_add_t, VecN<Ts...>>)
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator+(VecN<Ts...> const& vec)
+	{ return detail::map_n([](auto const& a) { return +a; }, vec); }
+
+	template<typename... Ts>
+	requires(detail::unary_n<concepts::can_unary_sub_t, VecN<Ts...>>)
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator-(VecN<Ts...> const& vec)
+	{ return detail::map_n([](auto const& a) { return -a; }, vec); }
+
+	template<typename... Ts>
+	requires(detail::unary_n<concepts::can_logical_not_t, VecN<Ts...>>)
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator!(VecN<Ts...> const& vec)
+	{ return detail::map_n([](auto const& a) { return !a; }, vec); }
+
+	template<typename... Ts>
+	requires(detail::unary_n<concepts::can_bitwise_not_t, VecN<Ts...>>)
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	operator~(VecN<Ts...> const& vec)
+	{ return detail::map_n([](auto const& a) { return ~a; }, vec); }
+
+
+
+	// Returns 'a * b + c', axis by axis, fused where the axis type allows it. See fma() of Vec.
+	template<typename... A, typename... B, typename... C>
+	requires(sizeof...(A) == sizeof...(B) && sizeof...(B) == sizeof...(C))
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	fma(VecN<A...> const& a, VecN<B...> const& b, VecN<C...> const& c) {
+		return [&]<std::size_t... i>(std::index_sequence<i...>) {
+			return ink::generic_vec::VecN{detail::fused_mul_add(a.template get<i>(), b.template get<i>(), c.template get<i>())...};
+		}(std::index_sequence_for<A...>{});
+	}
+
+	// Returns 'a * s + c', for a scalar 's'.
+	template<typename... A, typename S, typename... C>
+	requires(sizeof...(A) == sizeof...(C) && !detail::is_vec_n<S> && !concepts::same_template<S, Vec<void>> && !vec_expression<S>)
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	fma(VecN<A...> const& a, S const& s, VecN<C...> const& c) {
+		return [&]<std::size_t... i>(std::index_sequence<i...>) {
+			return ink::generic_vec::VecN{detail::fused_mul_add(a.template get<i>(), detail::masked<!std::is_void_v<A>>(s), c.template get<i>())...};
+		}(std::index_sequence_for<A...>{});
+	}
+
+	// Returns 's * x + y', the BLAS 'axpy' update, for a scalar 's'.
+	template<typename S, typename... X, typename... Y>
+	requires requires(S const& s, VecN<X...> const& x, VecN<Y...> const& y) { {generic_vec::fma(x, s, y)}; }
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	axpy(S const& s, VecN<X...> const& x, VecN<Y...> const& y)
+	{ return generic_vec::fma(x, s, y); }
+
+	// Returns the smaller of each pair of axes. Where they compare equal, or unordered, the axis of 'lhs' is kept.
+	template<typename... L, typename... R>
+	requires(sizeof...(L) == sizeof...(R))
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	min(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	{ return detail::zip_n([](auto const& l, auto const& r) { return detail::axis_min(l, r); }, lhs, rhs); }
+
+	// Returns the larger of each pair of axes. Where they compare equal, or unordered, the axis of 'lhs' is kept.
+	template<typename... L, typename... R>
+	requires(sizeof...(L) == sizeof...(R))
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	max(VecN<L...> const& lhs, VecN<R...> const& rhs)
+	{ return detail::zip_n([](auto const& l, auto const& r) { return detail::axis_max(l, r); }, lhs, rhs); }
+
+	// Whether every axis holding state is true. True with no axes at all.
+	template<typename... Ts>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+	all(VecN<Ts...> const& vec)
+	noexcept {
+		return [&]<std::size_t... i>(std::index_sequence<i...>) {
+			return ((std::is_void_v<Ts> || bool(vec.template get<i>())) && ...);
+		}(std::index_sequence_for<Ts...>{});
+	}
+
+	// Whether any axis holding state is true. False with no axes at all.
+	template<typename... Ts>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr bool
+	any(VecN<Ts...> const& vec)
+	noexcept {
+		return [&]<std::size_t... i>(std::index_sequence<i...>) {
+			return ((!std::is_void_v<Ts> && bool(vec.template get<i>())) || ...);
+		}(std::index_sequence_for<Ts...>{});
+	}
+
+}
+
+template<typename... Ts>
+struct std::tuple_size<ink::generic_vec::VecN<Ts...>>: std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template<std::size_t i, typename... Ts>
+struct std::tuple_element<i, ink::generic_vec::VecN<Ts...>> {
+	using type = typename ink::generic_vec::VecN<Ts...>::template value_type_at<i>;
+};
+
+namespace ink {
+
+	using generic_vec::VecN;
+	using generic_vec::get;
+
+}
+
+#endif
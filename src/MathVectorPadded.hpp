@@ -0,0 +1,150 @@
+#ifndef INK_GENERIC_VEC_PADDED_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_PADDED_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+#include "MathVector.hpp"
+
+namespace ink {
+
+	namespace generic_vec {
+
+		namespace detail {
+
+			// Scalar operands whose product with a T lane is still a T, and so keep the result padded.
+			template<typename S, typename T>
+			concept lane_scalar = std::is_arithmetic_v<S> && std::same_as<decltype(std::declval<T>() * std::declval<S>()), T>;
+
+		}
+
+		/**
+		 * Vec<T> padded with an unused fourth lane, so that it is exactly 4 * sizeof(T) bytes, and aligned to that size:
+		 * 16 bytes for float, 32 for double. Every element of an array of them then sits in a single aligned register
+		 * and never straddles a cache line, at the cost of a third more memory.
+		 *
+		 * It is a Vec<T>, and converts to and from one implicitly, so it works with every Vec operation.
+		 * The arithmetic operators between padded vectors (and with scalars that keep the lane type) compute all
+		 * four lanes, which lets the compiler lower each of them to one aligned load, one instruction and one store.
+		 * The padding lane starts at zero, but its value is unspecified after any arithmetic (a division leaves 0 / 0 in it),
+		 * and it never shows up in x, y, z, dot(), comparisons or any other result.
+		 */
+		template<typename T>
+		requires(std::is_arithmetic_v<T>)
+		class alignas(4 * sizeof(T)) PaddedVec: public Vec<T> {
+
+			private: using base = Vec<T>;
+
+			private: T M_pad = T();
+
+			private: constexpr
+			PaddedVec(T x, T y, T z, T pad)
+			noexcept: base(x, y, z), M_pad(pad) {}
+
+
+
+			public: constexpr
+			PaddedVec()
+			noexcept: base() {}
+
+			public: constexpr
+			PaddedVec(T x, T y, T z)
+			noexcept: base(x, y, z) {}
+
+			public: constexpr
+			PaddedVec(base const& vec)
+			noexcept: base(vec) {}
+
+
+
+			public: template<std::same_as<PaddedVec> L, std::same_as<PaddedVec> R>
+			INK_GENERIC_VEC_FORCE_INLINE friend constexpr PaddedVec
+			operator+(L const& lhs, R const& rhs)
+			noexcept { return PaddedVec(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.M_pad + rhs.M_pad); }
+
+			public: template<std::same_as<PaddedVec> L, std::same_as<PaddedVec> R>
+			INK_GENERIC_VEC_FORCE_INLINE friend constexpr PaddedVec
+			operator-(L const& lhs, R const& rhs)
+			noexcept { return PaddedVec(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.M_pad - rhs.M_pad); }
+
+			public: template<std::same_as<PaddedVec> L, std::same_as<PaddedVec> R>
+			INK_GENERIC_VEC_FORCE_INLINE friend constexpr PaddedVec
+			operator*(L const& lhs, R const& rhs)
+			noexcept { return PaddedVec(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.M_pad * rhs.M_pad); }
+
+			// Integers have no vector division to map to, and must not divide the padding by zero.
+			public: template<std::same_as<PaddedVec> L, std::same_as<PaddedVec> R>
+			INK_GENERIC_VEC_FORCE_INLINE friend constexpr PaddedVec
+			operator/(L const& lhs, R const& rhs)
+			noexcept {
+				if constexpr(std::is_floating_point_v<T>) return PaddedVec(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.M_pad / rhs.M_pad);
+				else return PaddedVec(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, T());
+			}
+
+			public: template<std::same_as<PaddedVec> L, detail::lane_scalar<T> S>
+			INK_GENERIC_VEC_FORCE_INLINE friend constexpr PaddedVec
+			operator*(L const& lhs, S const& rhs)
+			noexcept { return PaddedVec(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.M_pad * rhs); }
+
+			public: template<detail::lane_scalar<T> S, std::same_as<PaddedVec> R>
+			INK_GENERIC_VEC_FORCE_INLINE friend constexpr PaddedVec
+			operator*(S const& lhs, R const& rhs)
+			noexcept { return PaddedVec(lhs * rhs.x, lhs * rhs.y, lhs * rhs.z, lhs * rhs.M_pad); }
+
+			public: template<std::same_as<PaddedVec> L, detail::lane_scalar<T> S>
+			INK_GENERIC_VEC_FORCE_INLINE friend constexpr PaddedVec
+			operator/(L const& lhs, S const& rhs)
+			noexcept { return PaddedVec(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.M_pad / rhs); }
+
+			public: INK_GENERIC_VEC_FORCE_INLINE friend constexpr PaddedVec
+			operator-(PaddedVec const& vec)
+			noexcept { return PaddedVec(-vec.x, -vec.y, -vec.z, -vec.M_pad); }
+
+
+
+			public: using base::operator+=;
+			public: using base::operator-=;
+			public: using base::operator*=;
+			public: using base::operator/=;
+
+			public: INK_GENERIC_VEC_FORCE_INLINE constexpr PaddedVec&
+			operator+=(PaddedVec const& rhs)
+			noexcept { return *this = *this + rhs; }
+
+			public: INK_GENERIC_VEC_FORCE_INLINE constexpr PaddedVec&
+			operator-=(PaddedVec const& rhs)
+			noexcept { return *this = *this - rhs; }
+
+			public: INK_GENERIC_VEC_FORCE_INLINE constexpr PaddedVec&
+			operator*=(PaddedVec const& rhs)
+			noexcept { return *this = *this * rhs; }
+
+			public: INK_GENERIC_VEC_FORCE_INLINE constexpr PaddedVec&
+			operator/=(PaddedVec const& rhs)
+			noexcept { return *this = *this / rhs; }
+
+		};
+
+		namespace detail {
+
+			// True when PaddedVec<T> is laid out as four T, in x, y, z, padding order, and aligned to its size.
+			template<typename T>
+			concept padded_layout =
+				sizeof(PaddedVec<T>) == 4 * sizeof(T) &&
+				alignof(PaddedVec<T>) == 4 * sizeof(T) &&
+				std::is_trivially_copyable_v<PaddedVec<T>> &&
+				std::bit_cast<std::array<T, 4>>(PaddedVec<T>(T(1), T(2), T(3))) == std::array<T, 4>{T(1), T(2), T(3), T(0)};
+
+			static_assert(padded_layout<float> && padded_layout<double>);
+
+		}
+
+	}
+
+	using generic_vec::PaddedVec;
+
+}
+
+#endif
@@ -0,0 +1,391 @@
+#ifndef INK_GENERIC_VEC_PARALLEL_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_PARALLEL_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MathVector.hpp"
+#include "MathVectorSum.hpp"
+
+/*
+ * Parallel batch algorithms over contiguous arrays of Vec, run on a work-stealing thread pool.
+ *
+ * Every algorithm splits its range into chunks of a whole number of cache lines, about 'detail::chunk_bytes' each,
+ * and at least a few per thread so that threads which finish early can steal from the others.
+ * Reductions keep one partial result per chunk and combine them in chunk order once all chunks are done:
+ * the result does not depend on which thread ran which chunk, so floating point sums are reproducible from run to run.
+ * Ranges shorter than two chunks run on the calling thread, without touching the pool.
+ */
+namespace ink::generic_vec::parallel {
+
+	namespace detail {
+
+		// Assumed size of a cache line. std::hardware_destructive_interference_size is neither always available nor ABI stable.
+		inline constexpr std::size_t cache_line = 64;
+
+		// Approximate amount of data, in bytes, that one chunk covers.
+		inline constexpr std::size_t chunk_bytes = 32u << 10;
+
+		// A range of chunk indices owned by one thread. The owner takes chunks from its front, thieves take half of its back.
+		struct alignas(cache_line) ChunkRange {
+			std::mutex lock;
+			std::size_t begin = 0;
+			std::size_t end = 0;
+		};
+
+		// One partial result of a reduction, on its own cache line so that threads never write to the same line.
+		template<typename T>
+		struct alignas(cache_line) Partial {
+			T value;
+		};
+
+	}
+
+
+
+	/**
+	 * A fixed set of threads that run the chunks of one job at a time, the calling thread included.
+	 *
+	 * The chunks of a job are dealt out evenly as one contiguous range per thread. A thread works through its own range
+	 * front to back and, once it runs dry, steals the back half of another thread's range.
+	 * Calling run() from inside one of the pool's own chunks runs the nested job on the calling thread.
+	 */
+	class ThreadPool {
+
+		private: using chunk_fn = void (*)(void const* job, std::size_t chunk);
+
+		private: std::vector<std::thread> M_threads;
+		private: std::unique_ptr<detail::ChunkRange[]> M_ranges;
+
+		private: std::mutex M_run;
+		private: std::mutex M_mutex;
+		private: std::condition_variable M_wake;
+		private: std::condition_variable M_done;
+		private: std::size_t M_generation = 0;
+		private: unsigned M_pending = 0;
+		private: bool M_stop = false;
+
+		private: chunk_fn M_fn = nullptr;
+		private: void const* M_job = nullptr;
+		private: std::exception_ptr M_error;
+
+		// The pool whose worker is the current thread, if any.
+		private: static inline thread_local ThreadPool const* M_current = nullptr;
+
+
+
+		// 'threads' counts the calling thread: a pool of 1 runs everything on the caller and starts no thread at all.
+		public: explicit
+		ThreadPool(unsigned threads = std::thread::hardware_concurrency())
+		: M_ranges(std::make_unique<detail::ChunkRange[]>(std::max(threads, 1u))) {
+			M_threads.reserve(std::max(threads, 1u) - 1);
+			for (unsigned i = 1; i < threads; ++i) M_threads.emplace_back([this, i] { M_worker(i); });
+		}
+
+		public: ThreadPool(ThreadPool const&) = delete;
+		public: ThreadPool& operator=(ThreadPool const&) = delete;
+
+		public:
+		~ThreadPool() {
+			{
+				std::lock_guard lock(M_mutex);
+				M_stop = true;
+			}
+			M_wake.notify_all();
+			for (auto& thread : M_threads) thread.join();
+		}
+
+		// The pool shared by every algorithm that is not given one, with one thread per hardware thread.
+		public: static ThreadPool&
+		shared() {
+			static ThreadPool pool;
+			return pool;
+		}
+
+		// Number of threads that run a job, the calling thread included.
+		public: unsigned
+		size() const
+		noexcept { return unsigned(M_threads.size()) + 1; }
+
+		/**
+		 * Calls 'f(chunk)' once for every chunk in [0, chunks), spread over the pool, and returns when all are done.
+		 * The first exception thrown by 'f' is rethrown here, once every chunk has run.
+		 */
+		public: template<typename F>
+		void
+		run(std::size_t chunks, F const& f) {
+			if (chunks < 2 || size() == 1 || M_current == this) {
+				for (std::size_t chunk = 0; chunk < chunks; ++chunk) f(chunk);
+				return;
+			}
+
+			std::lock_guard run_lock(M_run);
+			const unsigned threads = size();
+			for (unsigned i = 0; i < threads; ++i) {
+				std::lock_guard lock(M_ranges[i].lock);
+				M_ranges[i].begin = chunks * i / threads;
+				M_ranges[i].end = chunks * (i + 1) / threads;
+			}
+			{
+				std::lock_guard lock(M_mutex);
+				M_fn = [](void const* job, std::size_t chunk) { (*static_cast<F const*>(job))(chunk); };
+				M_job = &f;
+				M_pending = threads - 1;
+				++M_generation;
+			}
+			M_wake.notify_all();
+
+			M_current = this;
+			M_work(0);
+			M_current = nullptr;
+
+			std::unique_lock lock(M_mutex);
+			M_done.wait(lock, [this] { return M_pending == 0; });
+			if (M_error) std::rethrow_exception(std::exchange(M_error, nullptr));
+		}
+
+
+
+		private: void
+		M_worker(unsigned self) {
+			M_current = this;
+			std::size_t seen = 0;
+			for (;;) {
+				{
+					std::unique_lock lock(M_mutex);
+					M_wake.wait(lock, [&] { return M_stop || M_generation != seen; });
+					if (M_stop) return;
+					seen = M_generation;
+				}
+				M_work(self);
+				{
+					std::lock_guard lock(M_mutex);
+					if (--M_pending == 0) M_done.notify_one();
+				}
+			}
+		}
+
+		private: void
+		M_work(unsigned self)
+		noexcept {
+			std::size_t chunk;
+			while (M_take(self, chunk) || M_steal(self, chunk)) {
+				try { M_fn(M_job, chunk); }
+				catch (...) {
+					std::lock_guard lock(M_mutex);
+					if (!M_error) M_error = std::current_exception();
+				}
+			}
+		}
+
+		private: bool
+		M_take(unsigned self, std::size_t& chunk)
+		noexcept {
+			auto& range = M_ranges[self];
+			std::lock_guard lock(range.lock);
+			if (range.begin == range.end) return false;
+			chunk = range.begin++;
+			return true;
+		}
+
+		// Moves the back half of the first non-empty range after 'self' into 'self', and takes its first chunk.
+		private: bool
+		M_steal(unsigned self, std::size_t& chunk)
+		noexcept {
+			const unsigned threads = size();
+			for (unsigned i = 1; i < threads; ++i) {
+				auto& victim = M_ranges[(self + i) % threads];
+				std::size_t begin, end;
+				{
+					std::lock_guard lock(victim.lock);
+					if (victim.begin == victim.end) continue;
+					begin = victim.begin + (victim.end - victim.begin) / 2;
+					end = victim.end;
+					victim.end = begin;
+				}
+				chunk = begin;
+				auto& range = M_ranges[self];
+				std::lock_guard lock(range.lock);
+				range.begin = begin + 1;
+				range.end = end;
+				return true;
+			}
+			return false;
+		}
+
+	};
+
+
+
+	namespace detail {
+
+		/**
+		 * Number of elements of type E per chunk: about chunk_bytes, but no more than a quarter of each thread's share,
+		 * and always a whole number of cache lines, so that no two chunks of an array aligned to a cache line write to the same line.
+		 */
+		template<typename E>
+		constexpr std::size_t
+		chunk_elements(std::size_t count, unsigned threads)
+		noexcept {
+			constexpr std::size_t line = std::lcm(sizeof(E), cache_line) / sizeof(E);
+			constexpr std::size_t target = std::max<std::size_t>(1, chunk_bytes / sizeof(E) / line) * line;
+			const std::size_t share = (count / (4 * std::size_t(threads)) + line - 1) / line * line;
+			return std::max(line, std::min(target, share));
+		}
+
+		// Calls 'f(begin, end)' for every chunk of [0, count).
+		template<typename E, typename F>
+		void
+		for_each_chunk(std::size_t count, ThreadPool& pool, F const& f) {
+			const std::size_t size = chunk_elements<E>(count, pool.size());
+			pool.run((count + size - 1) / size, [&](std::size_t chunk) {
+				f(chunk * size, std::min(count, (chunk + 1) * size));
+			});
+		}
+
+		// init, reduced in order with 'map(i)' for every i in [0, count). 'reduce' must be associative.
+		template<typename E, typename T, typename Reduce, typename Map>
+		T
+		reduce_chunks(std::size_t count, T init, Reduce const& reduce, Map const& map, ThreadPool& pool) {
+			const std::size_t size = chunk_elements<E>(count, pool.size());
+			const std::size_t chunks = (count + size - 1) / size;
+			std::vector<Partial<T>> partials(chunks);
+			pool.run(chunks, [&](std::size_t chunk) {
+				const std::size_t end = std::min(count, (chunk + 1) * size);
+				T acc = T(map(chunk * size));
+				for (std::size_t i = chunk * size + 1; i < end; ++i) acc = T(reduce(std::move(acc), map(i)));
+				partials[chunk].value = std::move(acc);
+			});
+			for (auto& partial : partials) init = T(reduce(std::move(init), std::move(partial.value)));
+			return init;
+		}
+
+		template<typename T>
+		constexpr decltype(auto)
+		axis_min(T const& lhs, T const& rhs) {
+			if constexpr(std::same_as<T, NoState>) return NoState();
+			else return rhs < lhs ? rhs : lhs;
+		}
+
+		template<typename T>
+		constexpr decltype(auto)
+		axis_max(T const& lhs, T const& rhs) {
+			if constexpr(std::same_as<T, NoState>) return NoState();
+			else return lhs < rhs ? rhs : lhs;
+		}
+
+	}
+
+
+
+	// out[i] = op(in[i]), for 'count' elements.
+	template<typename In, typename Out, typename Op>
+	requires requires(In const& in, Out& out, Op const& op) { {out = op(in)}; }
+	inline void
+	transform(In const* in, Out* out, std::size_t count, Op op, ThreadPool& pool = ThreadPool::shared()) {
+		detail::for_each_chunk<Out>(count, pool, [&](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) out[i] = op(in[i]);
+		});
+	}
+
+	// out[i] = op(lhs[i], rhs[i]), for 'count' elements. 'op' may be any operator of Vec, as in std::plus<>{}.
+	template<typename Lhs, typename Rhs, typename Out, typename Op>
+	requires requires(Lhs const& lhs, Rhs const& rhs, Out& out, Op const& op) { {out = op(lhs, rhs)}; }
+	inline void
+	transform(Lhs const* lhs, Rhs const* rhs, Out* out, std::size_t count, Op op, ThreadPool& pool = ThreadPool::shared()) {
+		detail::for_each_chunk<Out>(count, pool, [&](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) out[i] = op(lhs[i], rhs[i]);
+		});
+	}
+
+	// init, reduced with every one of the 'count' elements by the associative 'op'.
+	template<typename In, typename T, typename Op>
+	requires requires(T const& acc, In const& in, Op const& op) { {T(op(acc, in))}; {T(op(acc, acc))}; }
+	inline T
+	reduce(In const* in, std::size_t count, T init, Op op, ThreadPool& pool = ThreadPool::shared())
+	{ return detail::reduce_chunks<In>(count, std::move(init), op, [in](std::size_t i) -> In const& { return in[i]; }, pool); }
+
+	// init, reduced by the associative 'reduce_op' with 'transform_op(in[i])', for every one of the 'count' elements.
+	template<typename In, typename T, typename ReduceOp, typename TransformOp>
+	requires requires(T const& acc, In const& in, ReduceOp const& reduce_op, TransformOp const& transform_op) {
+		{T(transform_op(in))}; {T(reduce_op(acc, transform_op(in)))}; {T(reduce_op(acc, acc))}; }
+	inline T
+	transform_reduce(In const* in, std::size_t count, T init, ReduceOp reduce_op, TransformOp transform_op, ThreadPool& pool = ThreadPool::shared())
+	{ return detail::reduce_chunks<In>(count, std::move(init), reduce_op, [&](std::size_t i) { return transform_op(in[i]); }, pool); }
+
+	// init, reduced by the associative 'reduce_op' with 'transform_op(lhs[i], rhs[i])', for every one of the 'count' elements.
+	template<typename Lhs, typename Rhs, typename T, typename ReduceOp, typename TransformOp>
+	requires requires(T const& acc, Lhs const& lhs, Rhs const& rhs, ReduceOp const& reduce_op, TransformOp const& transform_op) {
+		{T(transform_op(lhs, rhs))}; {T(reduce_op(acc, transform_op(lhs, rhs)))}; {T(reduce_op(acc, acc))}; }
+	inline T
+	transform_reduce(Lhs const* lhs, Rhs const* rhs, std::size_t count, T init, ReduceOp reduce_op, TransformOp transform_op, ThreadPool& pool = ThreadPool::shared())
+	{ return detail::reduce_chunks<Lhs>(count, std::move(init), reduce_op, [&](std::size_t i) { return transform_op(lhs[i], rhs[i]); }, pool); }
+
+
+
+	// Sum of the 'count' vectors, e.g. for a centroid. Each chunk, and then the chunk sums, are accumulated as 'mode' says.
+	template<Summation mode = Summation::Pairwise, typename X, typename Y, typename Z>
+	requires requires(Vec<X, Y, Z> const* in) { {generic_vec::sum<mode>(in, std::size_t())}; }
+	inline Vec<X, Y, Z>
+	sum(Vec<X, Y, Z> const* in, std::size_t count, ThreadPool& pool = ThreadPool::shared()) {
+		using V = Vec<X, Y, Z>;
+		const std::size_t size = detail::chunk_elements<V>(count, pool.size());
+		std::vector<detail::Partial<V>> partials((count + size - 1) / size);
+		detail::for_each_chunk<V>(count, pool, [&](std::size_t begin, std::size_t end) {
+			partials[begin / size].value = generic_vec::sum<mode>(in + begin, end - begin);
+		});
+		std::vector<V> sums;
+		sums.reserve(partials.size());
+		for (auto const& partial : partials) sums.push_back(partial.value);
+		return generic_vec::sum<mode>(sums.data(), sums.size());
+	}
+
+	// Smallest value of each axis over the 'count' vectors, which is the low corner of their bounding box. 'count' must not be 0.
+	template<typename X, typename Y, typename Z>
+	inline Vec<X, Y, Z>
+	min(Vec<X, Y, Z> const* in, std::size_t count, ThreadPool& pool = ThreadPool::shared()) {
+		assert(count > 0);
+		return parallel::reduce(in, count, in[0], [](Vec<X, Y, Z> const& lhs, Vec<X, Y, Z> const& rhs) {
+			return Vec<X, Y, Z>(detail::axis_min(lhs.x, rhs.x), detail::axis_min(lhs.y, rhs.y), detail::axis_min(lhs.z, rhs.z));
+		}, pool);
+	}
+
+	// Largest value of each axis over the 'count' vectors, which is the high corner of their bounding box. 'count' must not be 0.
+	template<typename X, typename Y, typename Z>
+	inline Vec<X, Y, Z>
+	max(Vec<X, Y, Z> const* in, std::size_t count, ThreadPool& pool = ThreadPool::shared()) {
+		assert(count > 0);
+		return parallel::reduce(in, count, in[0], [](Vec<X, Y, Z> const& lhs, Vec<X, Y, Z> const& rhs) {
+			return Vec<X, Y, Z>(detail::axis_max(lhs.x, rhs.x), detail::axis_max(lhs.y, rhs.y), detail::axis_max(lhs.z, rhs.z));
+		}, pool);
+	}
+
+	// Sum of lhs[i].dot(rhs[i]) over the 'count' pairs.
+	template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+		typename T = std::remove_cvref_t<decltype(std::declval<Vec<LX, LY, LZ> const&>().dot(std::declval<Vec<RX, RY, RZ> const&>()))>>
+	inline T
+	dot_sum(Vec<LX, LY, LZ> const* lhs, Vec<RX, RY, RZ> const* rhs, std::size_t count, ThreadPool& pool = ThreadPool::shared()) {
+		return parallel::transform_reduce(lhs, rhs, count, T(), std::plus<>(),
+			[](Vec<LX, LY, LZ> const& l, Vec<RX, RY, RZ> const& r) { return l.dot(r); }, pool);
+	}
+
+	// Sum of in[i].mag2() over the 'count' vectors.
+	template<typename X, typename Y, typename Z,
+		typename T = std::remove_cvref_t<decltype(std::declval<Vec<X, Y, Z> const&>().mag2())>>
+	inline T
+	mag2_sum(Vec<X, Y, Z> const* in, std::size_t count, ThreadPool& pool = ThreadPool::shared())
+	{ return parallel::transform_reduce(in, count, T(), std::plus<>(), [](Vec<X, Y, Z> const& v) { return v.mag2(); }, pool); }
+
+}
+
+#endif
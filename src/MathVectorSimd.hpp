@@ -0,0 +1,991 @@
+#ifndef INK_GENERIC_VEC_SIMD_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_SIMD_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include "MathVector.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define INK_GENERIC_VEC_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace ink::generic_vec::simd {
+
+	namespace detail {
+
+		enum class BinaryOp: std::size_t
+		{ Add , Sub , Mul , Div };
+
+		enum class CmpOp: std::size_t
+		{ Eq , Neq , Lt , Le , Gt , Ge };
+
+		// double for float, float for double: what the cast kernels of KernelTable<T> convert to.
+		template<typename T>
+		using other_floating_t = std::conditional_t<std::same_as<T, float>, double, float>;
+
+		/**
+		 * Every batch kernel for element type T, for one instruction set.
+		 * Binary, scalar and 'cmp' kernels work on flat arrays of 'n' scalars,
+		 * while the others work on 'count' interleaved xyz vectors.
+		 * The masked comparison kernels compare with a single rhs vector, rather than an array of them, when passed true.
+		 * The magnitude kernels come in one version per Precision, indexed by it.
+		 * The transform kernels take the matrix first, as its x, y and z columns then its translation, 12 scalars,
+		 * and add the translation in the version at index 1, for points, but not in the one at 0, for directions.
+		 * The swizzle kernel at index 9 * a + 3 * b + c gives each vector the axes a, b and c of its input, as its x, y and z.
+		 * The half and bfloat kernels convert 'n' scalars to and from the bits of IEEE binary16 and of bfloat16, rounding
+		 * to nearest even. The quantize kernels convert 'count' vectors to and from int16 axes, with 6 parameters per
+		 * call: the scale of each axis, x, y, z, then its offset; quantize takes the inverse of the scales instead.
+		 * The cast kernels convert 'n' scalars as static_cast does: to and from int32, truncating toward zero,
+		 * and to the other one of float and double.
+		 */
+		template<typename T>
+		struct KernelTable {
+			void (*add)(T const*, T const*, T*, std::size_t);
+			void (*sub)(T const*, T const*, T*, std::size_t);
+			void (*mul)(T const*, T const*, T*, std::size_t);
+			void (*div)(T const*, T const*, T*, std::size_t);
+			void (*mul_scalar)(T const*, T, T*, std::size_t);
+			void (*div_scalar)(T const*, T, T*, std::size_t);
+			std::array<void (*)(T const*, T const*, bool*, std::size_t), 6> cmp;
+			std::array<void (*)(T const*, T const*, bool, std::uint8_t*, std::size_t), 6> cmp_mask;
+			std::array<void (*)(T const*, T const*, bool, std::uint64_t*, std::size_t), 6> cmp_all;
+			std::array<void (*)(T const*, T const*, bool, std::uint64_t*, std::size_t), 6> cmp_any;
+			void (*dot)(T const*, T const*, T*, std::size_t);
+			void (*cross)(T const*, T const*, T*, std::size_t);
+			std::array<void (*)(T const*, T*, std::size_t), 2> mag;
+			std::array<void (*)(T const*, T*, std::size_t), 2> inv_mag;
+			std::array<void (*)(T const*, T*, std::size_t), 2> normalize;
+			std::array<void (*)(T const*, T const*, T*, std::size_t), 2> distance;
+			std::array<void (*)(T const*, T const*, T*, std::size_t), 2> transform;
+			std::array<void (*)(T const*, T*, std::size_t), 27> swizzle;
+			void (*to_half)(T const*, std::uint16_t*, std::size_t);
+			void (*from_half)(std::uint16_t const*, T*, std::size_t);
+			void (*to_bfloat)(T const*, std::uint16_t*, std::size_t);
+			void (*from_bfloat)(std::uint16_t const*, T*, std::size_t);
+			void (*quantize)(T const*, T const*, std::int16_t*, std::size_t);
+			void (*dequantize)(std::int16_t const*, T const*, T*, std::size_t);
+			void (*to_int32)(T const*, std::int32_t*, std::size_t);
+			void (*from_int32)(std::int32_t const*, T*, std::size_t);
+			void (*to_other)(T const*, other_floating_t<T>*, std::size_t);
+		};
+
+		template<BinaryOp op, typename T>
+		constexpr T
+		apply_scalar(T lhs, T rhs)
+		noexcept {
+			if		constexpr(op == BinaryOp::Add) return lhs + rhs;
+			else if	constexpr(op == BinaryOp::Sub) return lhs - rhs;
+			else if	constexpr(op == BinaryOp::Mul) return lhs * rhs;
+			else if	constexpr(op == BinaryOp::Div) return lhs / rhs;
+		}
+
+		template<CmpOp op, typename T>
+		constexpr bool
+		compare_scalar(T lhs, T rhs)
+		noexcept {
+			if		constexpr(op == CmpOp::Eq)  return lhs == rhs;
+			else if	constexpr(op == CmpOp::Neq) return lhs != rhs;
+			else if	constexpr(op == CmpOp::Lt)  return lhs <  rhs;
+			else if	constexpr(op == CmpOp::Le)  return lhs <= rhs;
+			else if	constexpr(op == CmpOp::Gt)  return lhs >  rhs;
+			else if	constexpr(op == CmpOp::Ge)  return lhs >= rhs;
+		}
+
+		// The bits of the IEEE binary16 closest to 'value', ties to even. NaNs stay NaNs, quieted, as F16C converts them.
+		constexpr std::uint16_t
+		half_from_float(float value)
+		noexcept {
+			const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+			const std::uint32_t sign = (bits >> 16) & 0x8000u;
+			const std::uint32_t abs = bits & 0x7FFFFFFFu;
+			if (abs > 0x7F800000u) return static_cast<std::uint16_t>(sign | 0x7E00u | ((abs >> 13) & 0x3FFu));
+			// 65520, halfway between the largest half and 2^16, and up round to infinity.
+			if (abs >= 0x477FF000u) return static_cast<std::uint16_t>(sign | 0x7C00u);
+			// Below the smallest normal half, 2^-14: adding 0.5 lines the subnormal steps up with the float's last bits,
+			// and the addition itself rounds to even.
+			if (abs < 0x38800000u) return static_cast<std::uint16_t>(sign | (std::bit_cast<std::uint32_t>(std::bit_cast<float>(abs) + 0.5f) - 0x3F000000u));
+			return static_cast<std::uint16_t>(sign | ((abs - 0x38000000u + 0xFFFu + ((abs >> 13) & 1u)) >> 13));
+		}
+
+		// The value of the IEEE binary16 of bits 'half'. Exact.
+		constexpr float
+		half_to_float(std::uint16_t half)
+		noexcept {
+			const std::uint32_t sign = std::uint32_t(half & 0x8000u) << 16;
+			const std::uint32_t abs = half & 0x7FFFu;
+			if (abs >= 0x7C00u) return std::bit_cast<float>(sign | 0x7F800000u | (abs & 0x3FFu) << 13);
+			if (abs >= 0x0400u) return std::bit_cast<float>(sign | ((abs << 13) + 0x38000000u));
+			return std::bit_cast<float>(sign | std::bit_cast<std::uint32_t>(float(abs) * 0x1p-24f));
+		}
+
+		// The bits of the bfloat16 closest to 'value', ties to even: the top half of a float, rounded. NaNs are quieted.
+		constexpr std::uint16_t
+		bfloat_from_float(float value)
+		noexcept {
+			const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+			if ((bits & 0x7FFFFFFFu) > 0x7F800000u) return static_cast<std::uint16_t>((bits >> 16) | 0x40u);
+			return static_cast<std::uint16_t>((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+		}
+
+		// The value of the bfloat16 of bits 'bfloat'. Exact.
+		constexpr float
+		bfloat_to_float(std::uint16_t bfloat)
+		noexcept { return std::bit_cast<float>(std::uint32_t(bfloat) << 16); }
+
+		/**
+		 * 'value' rounded to the nearest int16, ties to even, and saturated, as the quantize kernels do it:
+		 * clamped first with the operand order of the SSE min and max, so that NaN comes out as the largest int16.
+		 */
+		template<typename T>
+		inline std::int16_t
+		quantize_scalar(T value)
+		noexcept {
+			value = value < T(32767) ? value : T(32767);
+			value = value > T(-32768) ? value : T(-32768);
+			return static_cast<std::int16_t>(std::nearbyint(value));
+		}
+
+		/**
+		 * Index tables for two-source permutes over interleaved xyz data held in three registers of 'width' lanes.
+		 * 'deinterleave<k>' gathers axis k in two passes: first from registers 0 and 1, then from register 2.
+		 * 'interleave<r>' builds register r in two passes: first from the x and y registers, then from z.
+		 * 'swizzle' builds register r of the same data with the axes of every vector permuted, in the same two passes
+		 * as 'deinterleave'; register 0 never needs the second one.
+		 */
+		template<typename Index, std::size_t width>
+		struct PermuteIndices {
+
+			using table = std::array<Index, width>;
+
+			static constexpr std::array<table, 2>
+			deinterleave(std::size_t k)
+			noexcept {
+				std::array<table, 2> out{};
+				for (std::size_t i = 0; i < width; ++i) {
+					const std::size_t flat = 3 * i + k;
+					const bool early = flat < 2 * width;
+					out[0][i] = static_cast<Index>(early ? flat : 0);
+					out[1][i] = static_cast<Index>(early ? i : width + (flat - 2 * width));
+				}
+				return out;
+			}
+
+			static constexpr std::array<table, 2>
+			interleave(std::size_t r)
+			noexcept {
+				std::array<table, 2> out{};
+				for (std::size_t p = 0; p < width; ++p) {
+					const std::size_t flat = r * width + p;
+					const std::size_t k = flat % 3, i = flat / 3;
+					out[0][p] = static_cast<Index>(k == 0 ? i : k == 1 ? width + i : 0);
+					out[1][p] = static_cast<Index>(k == 2 ? width + i : p);
+				}
+				return out;
+			}
+
+			static constexpr std::array<table, 2>
+			swizzle(std::size_t r, std::array<std::size_t, 3> pick)
+			noexcept {
+				std::array<table, 2> out{};
+				for (std::size_t p = 0; p < width; ++p) {
+					const std::size_t flat = r * width + p;
+					const std::size_t from = flat - flat % 3 + pick[flat % 3];
+					const bool early = from < 2 * width;
+					out[0][p] = static_cast<Index>(early ? from : 0);
+					out[1][p] = static_cast<Index>(early ? p : width + (from - 2 * width));
+				}
+				return out;
+			}
+
+		};
+
+	}
+
+
+
+	/*
+	 * Each kernel rounds every product and sum on its own, as the operators of Vec do. Contracting them into fused
+	 * multiply-adds, as compilers may for targets that have them, would make results depend on the processor.
+	 */
+	#if defined(__clang__)
+	#pragma float_control(push)
+	#pragma clang fp contract(off)
+	#elif defined(__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC optimize("fp-contract=off")
+	#endif
+
+	// Portable fallback, one element at a time.
+	namespace scalar {
+
+		template<typename T>
+		struct traits {
+			using reg = T;
+			static constexpr std::size_t width = 1;
+
+			static reg load(T const* p) { return *p; }
+			static void store(T* p, reg r) { *p = r; }
+			static reg set1(T v) { return v; }
+			static reg add(reg a, reg b) { return a + b; }
+			static reg sub(reg a, reg b) { return a - b; }
+			static reg mul(reg a, reg b) { return a * b; }
+			static reg div(reg a, reg b) { return a / b; }
+			static reg sqrt(reg a) { return std::sqrt(a); }
+			// Return 'b' when either is NaN, as the x86 instructions do.
+			static reg min(reg a, reg b) { return a < b ? a : b; }
+			static reg max(reg a, reg b) { return a > b ? a : b; }
+
+			#ifdef INK_GENERIC_VEC_RSQRT_ESTIMATE
+			static reg rsqrt(reg a) requires std::same_as<T, float> { return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a))); }
+			#endif
+
+			template<detail::CmpOp op>
+			static unsigned cmp(reg a, reg b) { return detail::compare_scalar<op>(a, b); }
+
+			static void load3(T const* p, reg& x, reg& y, reg& z) { x = p[0]; y = p[1]; z = p[2]; }
+			static void store3(T* p, reg x, reg y, reg z) { p[0] = x; p[1] = y; p[2] = z; }
+		};
+
+		#include "MathVectorSimdKernels.inl"
+
+	}
+
+
+
+	#ifdef INK_GENERIC_VEC_SIMD_X86
+
+	namespace sse2 {
+
+		#if defined(__clang__)
+		#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+		#else
+		#pragma GCC push_options
+		#pragma GCC target("sse2")
+		#endif
+
+		template<typename T> struct traits;
+
+		template<>
+		struct traits<float> {
+			using reg = __m128;
+			static constexpr std::size_t width = 4;
+
+			static reg load(float const* p) { return _mm_loadu_ps(p); }
+			static void store(float* p, reg r) { _mm_storeu_ps(p, r); }
+			static reg set1(float v) { return _mm_set1_ps(v); }
+			static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+			static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+			static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+			static reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+			static reg sqrt(reg a) { return _mm_sqrt_ps(a); }
+			static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+			static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+			static reg rsqrt(reg a) { return _mm_rsqrt_ps(a); }
+
+			template<detail::CmpOp op>
+			static unsigned cmp(reg a, reg b) {
+				if		constexpr(op == detail::CmpOp::Eq)  return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b)));
+				else if	constexpr(op == detail::CmpOp::Neq) return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpneq_ps(a, b)));
+				else if	constexpr(op == detail::CmpOp::Lt)  return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(a, b)));
+				else if	constexpr(op == detail::CmpOp::Le)  return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(a, b)));
+				else if	constexpr(op == detail::CmpOp::Gt)  return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpgt_ps(a, b)));
+				else if	constexpr(op == detail::CmpOp::Ge)  return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpge_ps(a, b)));
+			}
+
+			// [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] -> [x0..x3] [y0..y3] [z0..z3]
+			static void load3(float const* p, reg& x, reg& y, reg& z) {
+				const reg a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+				x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+				y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+				z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+			}
+
+			static void store3(float* p, reg x, reg y, reg z) {
+				_mm_storeu_ps(p,     _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps(p + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+			}
+
+			// Rounded to nearest even by the conversion, and saturated by the pack.
+			static void store_i16(std::int16_t* p, reg r) {
+				const __m128i q = _mm_cvtps_epi32(r);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(q, q));
+			}
+
+			static reg load_i16(std::int16_t const* p) {
+				const __m128i q = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(p));
+				return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(q, q), 16));
+			}
+
+			// Truncated toward zero, as static_cast does.
+			static void store_i32(std::int32_t* p, reg r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(r)); }
+			static reg load_i32(std::int32_t const* p) { return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))); }
+
+			// Widened to double, exactly.
+			static void store_other(double* p, reg r) {
+				_mm_storeu_pd(p,     _mm_cvtps_pd(r));
+				_mm_storeu_pd(p + 2, _mm_cvtps_pd(_mm_movehl_ps(r, r)));
+			}
+		};
+
+		template<>
+		struct traits<double> {
+			using reg = __m128d;
+			static constexpr std::size_t width = 2;
+
+			static reg load(double const* p) { return _mm_loadu_pd(p); }
+			static void store(double* p, reg r) { _mm_storeu_pd(p, r); }
+			static reg set1(double v) { return _mm_set1_pd(v); }
+			static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+			static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+			static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+			static reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+			static reg sqrt(reg a) { return _mm_sqrt_pd(a); }
+			static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+			static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+
+			template<detail::CmpOp op>
+			static unsigned cmp(reg a, reg b) {
+				if		constexpr(op == detail::CmpOp::Eq)  return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(a, b)));
+				else if	constexpr(op == detail::CmpOp::Neq) return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpneq_pd(a, b)));
+				else if	constexpr(op == detail::CmpOp::Lt)  return static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(a, b)));
+				else if	constexpr(op == detail::CmpOp::Le)  return static_cast<unsigned>(_mm_movemask_pd(_mm_cmple_pd(a, b)));
+				else if	constexpr(op == detail::CmpOp::Gt)  return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpgt_pd(a, b)));
+				else if	constexpr(op == detail::CmpOp::Ge)  return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpge_pd(a, b)));
+			}
+
+			// [x0 y0] [z0 x1] [y1 z1] -> [x0 x1] [y0 y1] [z0 z1]
+			static void load3(double const* p, reg& x, reg& y, reg& z) {
+				const reg a = _mm_loadu_pd(p), b = _mm_loadu_pd(p + 2), c = _mm_loadu_pd(p + 4);
+				x = _mm_shuffle_pd(a, b, 2);
+				y = _mm_shuffle_pd(a, c, 1);
+				z = _mm_shuffle_pd(b, c, 2);
+			}
+
+			static void store3(double* p, reg x, reg y, reg z) {
+				_mm_storeu_pd(p,     _mm_shuffle_pd(x, y, 0));
+				_mm_storeu_pd(p + 2, _mm_shuffle_pd(z, x, 2));
+				_mm_storeu_pd(p + 4, _mm_shuffle_pd(y, z, 3));
+			}
+
+			// Truncated toward zero, as static_cast does.
+			static void store_i32(std::int32_t* p, reg r) { _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_cvttpd_epi32(r)); }
+			static reg load_i32(std::int32_t const* p) { return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(p))); }
+
+			// Narrowed to float, rounding to nearest even.
+			static void store_other(float* p, reg r) { _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_castps_si128(_mm_cvtpd_ps(r))); }
+		};
+
+		#include "MathVectorSimdKernels.inl"
+
+		#if defined(__clang__)
+		#pragma clang attribute pop
+		#else
+		#pragma GCC pop_options
+		#endif
+
+	}
+
+
+
+	namespace avx2 {
+
+		#if defined(__clang__)
+		#pragma clang attribute push(__attribute__((target("avx2,f16c"))), apply_to = function)
+		#else
+		#pragma GCC push_options
+		#pragma GCC target("avx2,f16c")
+		#endif
+
+		template<typename T> struct traits;
+
+		template<>
+		struct traits<float> {
+			using reg = __m256;
+			static constexpr std::size_t width = 8;
+
+			static reg load(float const* p) { return _mm256_loadu_ps(p); }
+			static void store(float* p, reg r) { _mm256_storeu_ps(p, r); }
+			static reg set1(float v) { return _mm256_set1_ps(v); }
+			static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+			static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+			static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+			static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+			static reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+			static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+			static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+			static reg rsqrt(reg a) { return _mm256_rsqrt_ps(a); }
+
+			template<detail::CmpOp op>
+			static unsigned cmp(reg a, reg b) {
+				if		constexpr(op == detail::CmpOp::Eq)  return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+				else if	constexpr(op == detail::CmpOp::Neq) return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)));
+				else if	constexpr(op == detail::CmpOp::Lt)  return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)));
+				else if	constexpr(op == detail::CmpOp::Le)  return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)));
+				else if	constexpr(op == detail::CmpOp::Gt)  return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)));
+				else if	constexpr(op == detail::CmpOp::Ge)  return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ)));
+			}
+
+			// Each axis is blended out of the three registers, then put in order with a single permute.
+			static void load3(float const* p, reg& x, reg& y, reg& z) {
+				const reg a = _mm256_loadu_ps(p), b = _mm256_loadu_ps(p + 8), c = _mm256_loadu_ps(p + 16);
+				x = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(a, b, 0x92), c, 0x24), _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+				y = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(a, b, 0x24), c, 0x49), _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6));
+				z = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(a, b, 0x49), c, 0x92), _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+			}
+
+			static void store3(float* p, reg x, reg y, reg z) {
+				const reg bx = _mm256_permutevar8x32_ps(x, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+				const reg by = _mm256_permutevar8x32_ps(y, _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2));
+				const reg bz = _mm256_permutevar8x32_ps(z, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+				_mm256_storeu_ps(p,      _mm256_blend_ps(_mm256_blend_ps(bx, by, 0x92), bz, 0x24));
+				_mm256_storeu_ps(p + 8,  _mm256_blend_ps(_mm256_blend_ps(bx, by, 0x24), bz, 0x49));
+				_mm256_storeu_ps(p + 16, _mm256_blend_ps(_mm256_blend_ps(bx, by, 0x49), bz, 0x92));
+			}
+
+			static void store_half(std::uint16_t* p, reg r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtps_ph(r, _MM_FROUND_TO_NEAREST_INT)); }
+			static reg load_half(std::uint16_t const* p) { return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))); }
+
+			// Rounds the low 16 bits away, to nearest even, and quiets NaNs, as detail::bfloat_from_float.
+			static void store_bfloat(std::uint16_t* p, reg r) {
+				const __m256i bits = _mm256_castps_si256(r);
+				const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+				const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, _mm256_set1_epi32(0x7FFF)), lsb), 16);
+				const __m256i nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x40));
+				const __m256i out = _mm256_blendv_epi8(rounded, nan, _mm256_castps_si256(_mm256_cmp_ps(r, r, _CMP_UNORD_Q)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packus_epi32(_mm256_castsi256_si128(out), _mm256_extracti128_si256(out, 1)));
+			}
+
+			static reg load_bfloat(std::uint16_t const* p) {
+				const __m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)));
+				return _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16));
+			}
+
+			// Rounded to nearest even by the conversion, and saturated by the pack.
+			static void store_i16(std::int16_t* p, reg r) {
+				const __m256i q = _mm256_cvtps_epi32(r);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(_mm256_castsi256_si128(q), _mm256_extracti128_si256(q, 1)));
+			}
+
+			static reg load_i16(std::int16_t const* p)
+			{ return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)))); }
+
+			// Truncated toward zero, as static_cast does.
+			static void store_i32(std::int32_t* p, reg r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm256_cvttps_epi32(r)); }
+			static reg load_i32(std::int32_t const* p) { return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p))); }
+
+			// Widened to double, exactly.
+			static void store_other(double* p, reg r) {
+				_mm256_storeu_pd(p,     _mm256_cvtps_pd(_mm256_castps256_ps128(r)));
+				_mm256_storeu_pd(p + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(r, 1)));
+			}
+		};
+
+		template<>
+		struct traits<double> {
+			using reg = __m256d;
+			static constexpr std::size_t width = 4;
+
+			static reg load(double const* p) { return _mm256_loadu_pd(p); }
+			static void store(double* p, reg r) { _mm256_storeu_pd(p, r); }
+			static reg set1(double v) { return _mm256_set1_pd(v); }
+			static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+			static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+			static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+			static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+			static reg sqrt(reg a) { return _mm256_sqrt_pd(a); }
+			static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+			static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+
+			template<detail::CmpOp op>
+			static unsigned cmp(reg a, reg b) {
+				if		constexpr(op == detail::CmpOp::Eq)  return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+				else if	constexpr(op == detail::CmpOp::Neq) return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ)));
+				else if	constexpr(op == detail::CmpOp::Lt)  return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)));
+				else if	constexpr(op == detail::CmpOp::Le)  return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ)));
+				else if	constexpr(op == detail::CmpOp::Gt)  return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)));
+				else if	constexpr(op == detail::CmpOp::Ge)  return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GE_OQ)));
+			}
+
+			static void load3(double const* p, reg& x, reg& y, reg& z) {
+				const reg a = _mm256_loadu_pd(p), b = _mm256_loadu_pd(p + 4), c = _mm256_loadu_pd(p + 8);
+				x = _mm256_permute4x64_pd(_mm256_blend_pd(_mm256_blend_pd(a, b, 0x4), c, 0x2), _MM_SHUFFLE(1, 2, 3, 0));
+				y = _mm256_permute4x64_pd(_mm256_blend_pd(_mm256_blend_pd(a, b, 0x9), c, 0x4), _MM_SHUFFLE(2, 3, 0, 1));
+				z = _mm256_permute4x64_pd(_mm256_blend_pd(_mm256_blend_pd(a, b, 0x2), c, 0x9), _MM_SHUFFLE(3, 0, 1, 2));
+			}
+
+			static void store3(double* p, reg x, reg y, reg z) {
+				const reg bx = _mm256_permute4x64_pd(x, _MM_SHUFFLE(1, 2, 3, 0));
+				const reg by = _mm256_permute4x64_pd(y, _MM_SHUFFLE(2, 3, 0, 1));
+				const reg bz = _mm256_permute4x64_pd(z, _MM_SHUFFLE(3, 0, 1, 2));
+				_mm256_storeu_pd(p,     _mm256_blend_pd(_mm256_blend_pd(bx, by, 0x2), bz, 0x4));
+				_mm256_storeu_pd(p + 4, _mm256_blend_pd(_mm256_blend_pd(bx, by, 0x9), bz, 0x2));
+				_mm256_storeu_pd(p + 8, _mm256_blend_pd(_mm256_blend_pd(bx, by, 0x4), bz, 0x9));
+			}
+
+			// Truncated toward zero, as static_cast does.
+			static void store_i32(std::int32_t* p, reg r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvttpd_epi32(r)); }
+			static reg load_i32(std::int32_t const* p) { return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))); }
+
+			// Narrowed to float, rounding to nearest even.
+			static void store_other(float* p, reg r) { _mm_storeu_ps(p, _mm256_cvtpd_ps(r)); }
+		};
+
+		#include "MathVectorSimdKernels.inl"
+
+		#if defined(__clang__)
+		#pragma clang attribute pop
+		#else
+		#pragma GCC pop_options
+		#endif
+
+	}
+
+
+
+	namespace avx512 {
+
+		#if defined(__clang__)
+		#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+		#else
+		#pragma GCC push_options
+		#pragma GCC target("avx512f")
+		#endif
+
+		template<typename T> struct traits;
+
+		template<>
+		struct traits<float> {
+			using reg = __m512;
+			static constexpr std::size_t width = 16;
+			using indices = detail::PermuteIndices<std::int32_t, width>;
+
+			static reg load(float const* p) { return _mm512_loadu_ps(p); }
+			static void store(float* p, reg r) { _mm512_storeu_ps(p, r); }
+			static reg set1(float v) { return _mm512_set1_ps(v); }
+			static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+			static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+			static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+			static reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+			// Zero-masked with every lane enabled: the same instructions, without the undefined pass-through
+			// register of the plain intrinsics, which GCC 12 reports as possibly uninitialized.
+			static reg sqrt(reg a) { return _mm512_maskz_sqrt_ps(__mmask16(0xFFFF), a); }
+			static reg min(reg a, reg b) { return _mm512_maskz_min_ps(__mmask16(0xFFFF), a, b); }
+			static reg max(reg a, reg b) { return _mm512_maskz_max_ps(__mmask16(0xFFFF), a, b); }
+			static reg rsqrt(reg a) { return _mm512_maskz_rsqrt14_ps(__mmask16(0xFFFF), a); }
+
+			template<detail::CmpOp op>
+			static unsigned cmp(reg a, reg b) {
+				if		constexpr(op == detail::CmpOp::Eq)  return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+				else if	constexpr(op == detail::CmpOp::Neq) return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ);
+				else if	constexpr(op == detail::CmpOp::Lt)  return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+				else if	constexpr(op == detail::CmpOp::Le)  return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+				else if	constexpr(op == detail::CmpOp::Gt)  return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+				else if	constexpr(op == detail::CmpOp::Ge)  return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+			}
+
+			template<std::size_t k>
+			static reg deinterleave(reg a, reg b, reg c) {
+				static constexpr auto idx = indices::deinterleave(k);
+				const reg t = _mm512_permutex2var_ps(a, _mm512_loadu_si512(idx[0].data()), b);
+				return _mm512_permutex2var_ps(t, _mm512_loadu_si512(idx[1].data()), c);
+			}
+
+			template<std::size_t r>
+			static reg interleave(reg x, reg y, reg z) {
+				static constexpr auto idx = indices::interleave(r);
+				const reg t = _mm512_permutex2var_ps(x, _mm512_loadu_si512(idx[0].data()), y);
+				return _mm512_permutex2var_ps(t, _mm512_loadu_si512(idx[1].data()), z);
+			}
+
+			template<std::size_t r, std::size_t a, std::size_t b, std::size_t c>
+			static reg swizzle(reg x, reg y, reg z) {
+				static constexpr auto idx = indices::swizzle(r, {a, b, c});
+				const reg t = _mm512_permutex2var_ps(x, _mm512_loadu_si512(idx[0].data()), y);
+				if constexpr(r == 0) return t;
+				else return _mm512_permutex2var_ps(t, _mm512_loadu_si512(idx[1].data()), z);
+			}
+
+			static void load3(float const* p, reg& x, reg& y, reg& z) {
+				const reg a = _mm512_loadu_ps(p), b = _mm512_loadu_ps(p + 16), c = _mm512_loadu_ps(p + 32);
+				x = deinterleave<0>(a, b, c);
+				y = deinterleave<1>(a, b, c);
+				z = deinterleave<2>(a, b, c);
+			}
+
+			static void store3(float* p, reg x, reg y, reg z) {
+				_mm512_storeu_ps(p,      interleave<0>(x, y, z));
+				_mm512_storeu_ps(p + 16, interleave<1>(x, y, z));
+				_mm512_storeu_ps(p + 32, interleave<2>(x, y, z));
+			}
+
+			static void store_half(std::uint16_t* p, reg r)
+			{ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_maskz_cvtps_ph(__mmask16(0xFFFF), r, _MM_FROUND_TO_NEAREST_INT)); }
+
+			static reg load_half(std::uint16_t const* p)
+			{ return _mm512_maskz_cvtph_ps(__mmask16(0xFFFF), _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p))); }
+
+			// Rounds the low 16 bits away, to nearest even, and quiets NaNs, as detail::bfloat_from_float.
+			static void store_bfloat(std::uint16_t* p, reg r) {
+				const __m512i bits = _mm512_castps_si512(r);
+				const __m512i lsb = _mm512_and_si512(_mm512_maskz_srli_epi32(__mmask16(0xFFFF), bits, 16), _mm512_set1_epi32(1));
+				const __m512i rounded = _mm512_maskz_srli_epi32(__mmask16(0xFFFF), _mm512_add_epi32(_mm512_add_epi32(bits, _mm512_set1_epi32(0x7FFF)), lsb), 16);
+				const __m512i nan = _mm512_or_si512(_mm512_maskz_srli_epi32(__mmask16(0xFFFF), bits, 16), _mm512_set1_epi32(0x40));
+				const __m512i out = _mm512_mask_mov_epi32(rounded, _mm512_cmp_ps_mask(r, r, _CMP_UNORD_Q), nan);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_maskz_cvtepi32_epi16(__mmask16(0xFFFF), out));
+			}
+
+			static reg load_bfloat(std::uint16_t const* p) {
+				const __m512i bits = _mm512_maskz_cvtepu16_epi32(__mmask16(0xFFFF), _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)));
+				return _mm512_castsi512_ps(_mm512_maskz_slli_epi32(__mmask16(0xFFFF), bits, 16));
+			}
+
+			// Rounded to nearest even by the conversion, and saturated by the narrowing.
+			static void store_i16(std::int16_t* p, reg r) {
+				const __m512i q = _mm512_maskz_cvtps_epi32(__mmask16(0xFFFF), r);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_maskz_cvtsepi32_epi16(__mmask16(0xFFFF), q));
+			}
+
+			static reg load_i16(std::int16_t const* p) {
+				const __m512i q = _mm512_maskz_cvtepi16_epi32(__mmask16(0xFFFF), _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)));
+				return _mm512_maskz_cvtepi32_ps(__mmask16(0xFFFF), q);
+			}
+
+			// Truncated toward zero, as static_cast does.
+			static void store_i32(std::int32_t* p, reg r) { _mm512_storeu_si512(p, _mm512_maskz_cvttps_epi32(__mmask16(0xFFFF), r)); }
+			static reg load_i32(std::int32_t const* p) { return _mm512_maskz_cvtepi32_ps(__mmask16(0xFFFF), _mm512_loadu_si512(p)); }
+
+			// Widened to double, exactly.
+			static void store_other(double* p, reg r) {
+				const __m256 lo = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(__mmask8(0xF), _mm512_castps_pd(r), 0));
+				const __m256 hi = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(__mmask8(0xF), _mm512_castps_pd(r), 1));
+				_mm512_storeu_pd(p,     _mm512_maskz_cvtps_pd(__mmask8(0xFF), lo));
+				_mm512_storeu_pd(p + 8, _mm512_maskz_cvtps_pd(__mmask8(0xFF), hi));
+			}
+		};
+
+		template<>
+		struct traits<double> {
+			using reg = __m512d;
+			static constexpr std::size_t width = 8;
+			using indices = detail::PermuteIndices<std::int64_t, width>;
+
+			static reg load(double const* p) { return _mm512_loadu_pd(p); }
+			static void store(double* p, reg r) { _mm512_storeu_pd(p, r); }
+			static reg set1(double v) { return _mm512_set1_pd(v); }
+			static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+			static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+			static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+			static reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+			// Zero-masked for the same reason as traits<float>.
+			static reg sqrt(reg a) { return _mm512_maskz_sqrt_pd(__mmask8(0xFF), a); }
+			static reg min(reg a, reg b) { return _mm512_maskz_min_pd(__mmask8(0xFF), a, b); }
+			static reg max(reg a, reg b) { return _mm512_maskz_max_pd(__mmask8(0xFF), a, b); }
+
+			template<detail::CmpOp op>
+			static unsigned cmp(reg a, reg b) {
+				if		constexpr(op == detail::CmpOp::Eq)  return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+				else if	constexpr(op == detail::CmpOp::Neq) return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ);
+				else if	constexpr(op == detail::CmpOp::Lt)  return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+				else if	constexpr(op == detail::CmpOp::Le)  return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+				else if	constexpr(op == detail::CmpOp::Gt)  return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+				else if	constexpr(op == detail::CmpOp::Ge)  return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+			}
+
+			template<std::size_t k>
+			static reg deinterleave(reg a, reg b, reg c) {
+				static constexpr auto idx = indices::deinterleave(k);
+				const reg t = _mm512_permutex2var_pd(a, _mm512_loadu_si512(idx[0].data()), b);
+				return _mm512_permutex2var_pd(t, _mm512_loadu_si512(idx[1].data()), c);
+			}
+
+			template<std::size_t r>
+			static reg interleave(reg x, reg y, reg z) {
+				static constexpr auto idx = indices::interleave(r);
+				const reg t = _mm512_permutex2var_pd(x, _mm512_loadu_si512(idx[0].data()), y);
+				return _mm512_permutex2var_pd(t, _mm512_loadu_si512(idx[1].data()), z);
+			}
+
+			template<std::size_t r, std::size_t a, std::size_t b, std::size_t c>
+			static reg swizzle(reg x, reg y, reg z) {
+				static constexpr auto idx = indices::swizzle(r, {a, b, c});
+				const reg t = _mm512_permutex2var_pd(x, _mm512_loadu_si512(idx[0].data()), y);
+				if constexpr(r == 0) return t;
+				else return _mm512_permutex2var_pd(t, _mm512_loadu_si512(idx[1].data()), z);
+			}
+
+			static void load3(double const* p, reg& x, reg& y, reg& z) {
+				const reg a = _mm512_loadu_pd(p), b = _mm512_loadu_pd(p + 8), c = _mm512_loadu_pd(p + 16);
+				x = deinterleave<0>(a, b, c);
+				y = deinterleave<1>(a, b, c);
+				z = deinterleave<2>(a, b, c);
+			}
+
+			static void store3(double* p, reg x, reg y, reg z) {
+				_mm512_storeu_pd(p,      interleave<0>(x, y, z));
+				_mm512_storeu_pd(p + 8,  interleave<1>(x, y, z));
+				_mm512_storeu_pd(p + 16, interleave<2>(x, y, z));
+			}
+
+			// Truncated toward zero, as static_cast does.
+			static void store_i32(std::int32_t* p, reg r)
+			{ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_maskz_cvttpd_epi32(__mmask8(0xFF), r)); }
+
+			static reg load_i32(std::int32_t const* p)
+			{ return _mm512_maskz_cvtepi32_pd(__mmask8(0xFF), _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p))); }
+
+			// Narrowed to float, rounding to nearest even.
+			static void store_other(float* p, reg r) { _mm256_storeu_ps(p, _mm512_maskz_cvtpd_ps(__mmask8(0xFF), r)); }
+		};
+
+		#include "MathVectorSimdKernels.inl"
+
+		#if defined(__clang__)
+		#pragma clang attribute pop
+		#else
+		#pragma GCC pop_options
+		#endif
+
+	}
+
+	#endif
+
+	#if defined(__clang__)
+	#pragma float_control(pop)
+	#elif defined(__GNUC__)
+	#pragma GCC pop_options
+	#endif
+
+
+
+	// Instruction sets with a dedicated set of batch kernels. AVX2 comes with F16C, as on every processor that has it.
+	enum class Isa: std::size_t
+	{ Scalar , SSE2 , AVX2 , AVX512 };
+
+	// Returns the best instruction set supported by the running CPU.
+	inline Isa
+	detect_isa()
+	noexcept {
+		#ifdef INK_GENERIC_VEC_SIMD_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")) return Isa::AVX2;
+		if (__builtin_cpu_supports("sse2")) return Isa::SSE2;
+		#endif
+		return Isa::Scalar;
+	}
+
+	// Returns the instruction set picked for this process. Detected once, on first use.
+	inline Isa
+	active_isa()
+	noexcept {
+		static const Isa isa = detect_isa();
+		return isa;
+	}
+
+	// Returns the kernels of the given instruction set, or the scalar ones if it was not compiled in.
+	template<std::floating_point T>
+	constexpr detail::KernelTable<T>
+	kernels_for(Isa isa)
+	noexcept {
+		switch (isa) {
+			#ifdef INK_GENERIC_VEC_SIMD_X86
+			case Isa::AVX512: return avx512::kernel_table<T>();
+			case Isa::AVX2: return avx2::kernel_table<T>();
+			case Isa::SSE2: return sse2::kernel_table<T>();
+			#endif
+			default: return scalar::kernel_table<T>();
+		}
+	}
+
+	// Returns the kernels of the active instruction set.
+	template<std::floating_point T>
+	inline detail::KernelTable<T> const&
+	kernels()
+	noexcept {
+		static const detail::KernelTable<T> table = kernels_for<T>(active_isa());
+		return table;
+	}
+
+	namespace detail {
+
+		// The kernels treat an array of Vec<T> as a flat array of 3 * count scalars, in x, y, z order.
+		template<typename T>
+		inline T const*
+		flat(Vec<T> const* vecs)
+		noexcept { return reinterpret_cast<T const*>(vecs); }
+
+		template<typename T>
+		inline T*
+		flat(Vec<T>* vecs)
+		noexcept { return reinterpret_cast<T*>(vecs); }
+
+		// Whether simd::convert() may treat the vectors as flat arrays of scalars: each side holds one arithmetic type.
+		template<typename A, typename B, typename C, typename D, typename E, typename F>
+		concept flat_cast =
+			std::same_as<A, B> && std::same_as<B, C> && std::is_arithmetic_v<A> && generic_vec::detail::interleaved_layout<A> &&
+			std::same_as<D, E> && std::same_as<E, F> && std::is_arithmetic_v<D> && generic_vec::detail::interleaved_layout<D>;
+
+	}
+
+
+
+	// out[i] = lhs[i] + rhs[i], for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	add(Vec<T> const* lhs, Vec<T> const* rhs, Vec<T>* out, std::size_t count)
+	noexcept { kernels<T>().add(detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = lhs[i] - rhs[i], for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	sub(Vec<T> const* lhs, Vec<T> const* rhs, Vec<T>* out, std::size_t count)
+	noexcept { kernels<T>().sub(detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = lhs[i] * rhs[i], for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	mul(Vec<T> const* lhs, Vec<T> const* rhs, Vec<T>* out, std::size_t count)
+	noexcept { kernels<T>().mul(detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = lhs[i] * rhs, for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	mul(Vec<T> const* lhs, T rhs, Vec<T>* out, std::size_t count)
+	noexcept { kernels<T>().mul_scalar(detail::flat(lhs), rhs, detail::flat(out), 3 * count); }
+
+	// out[i] = lhs[i] / rhs[i], for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	div(Vec<T> const* lhs, Vec<T> const* rhs, Vec<T>* out, std::size_t count)
+	noexcept { kernels<T>().div(detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = lhs[i] / rhs, for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	div(Vec<T> const* lhs, T rhs, Vec<T>* out, std::size_t count)
+	noexcept { kernels<T>().div_scalar(detail::flat(lhs), rhs, detail::flat(out), 3 * count); }
+
+
+
+	// out[i] = (lhs[i] == rhs[i]), for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	equal(Vec<T> const* lhs, Vec<T> const* rhs, Vec<bool>* out, std::size_t count)
+	noexcept { kernels<T>().cmp[std::size_t(detail::CmpOp::Eq)](detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = (lhs[i] != rhs[i]), for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	not_equal(Vec<T> const* lhs, Vec<T> const* rhs, Vec<bool>* out, std::size_t count)
+	noexcept { kernels<T>().cmp[std::size_t(detail::CmpOp::Neq)](detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = (lhs[i] < rhs[i]), for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	less(Vec<T> const* lhs, Vec<T> const* rhs, Vec<bool>* out, std::size_t count)
+	noexcept { kernels<T>().cmp[std::size_t(detail::CmpOp::Lt)](detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = (lhs[i] <= rhs[i]), for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	less_equal(Vec<T> const* lhs, Vec<T> const* rhs, Vec<bool>* out, std::size_t count)
+	noexcept { kernels<T>().cmp[std::size_t(detail::CmpOp::Le)](detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = (lhs[i] > rhs[i]), for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	greater(Vec<T> const* lhs, Vec<T> const* rhs, Vec<bool>* out, std::size_t count)
+	noexcept { kernels<T>().cmp[std::size_t(detail::CmpOp::Gt)](detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+	// out[i] = (lhs[i] >= rhs[i]), for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	greater_equal(Vec<T> const* lhs, Vec<T> const* rhs, Vec<bool>* out, std::size_t count)
+	noexcept { kernels<T>().cmp[std::size_t(detail::CmpOp::Ge)](detail::flat(lhs), detail::flat(rhs), detail::flat(out), 3 * count); }
+
+
+
+	// std::memmove() of 'count' vectors: 'in' and 'out' may overlap.
+	template<typename X, typename Y, typename Z>
+	requires(bitwise_copyable<Vec<X, Y, Z>>)
+	inline void
+	copy(Vec<X, Y, Z> const* in, Vec<X, Y, Z>* out, std::size_t count)
+	noexcept { if (count != 0) std::memmove(out, in, count * sizeof(Vec<X, Y, Z>)); }
+
+	/**
+	 * out[i] = Vec<D, E, F>(in[i]), for 'count' vectors, with each axis converted as static_cast does.
+	 * A copy() between vectors of the same type. The kernels convert between float, double and std::int32_t, and the
+	 * other pairs of vectors of a single arithmetic type go through a flat loop over their scalars, which the compiler
+	 * vectorizes; anything else converts one vector at a time. 'in' and 'out' may not overlap, unless of the same type.
+	 */
+	template<typename A, typename B, typename C, typename D, typename E, typename F>
+	requires(std::is_constructible_v<Vec<D, E, F>, Vec<A, B, C> const&>)
+	inline void
+	convert(Vec<A, B, C> const* in, Vec<D, E, F>* out, std::size_t count)
+	noexcept(std::is_nothrow_constructible_v<Vec<D, E, F>, Vec<A, B, C> const&>) {
+		if constexpr(std::same_as<Vec<A, B, C>, Vec<D, E, F>> && bitwise_copyable<Vec<A, B, C>>) copy(in, out, count);
+		else if constexpr(detail::flat_cast<A, B, C, D, E, F>) {
+			if		constexpr(std::floating_point<A> && std::same_as<D, std::int32_t>) kernels<A>().to_int32(detail::flat(in), detail::flat(out), 3 * count);
+			else if	constexpr(std::same_as<A, std::int32_t> && std::floating_point<D>) kernels<D>().from_int32(detail::flat(in), detail::flat(out), 3 * count);
+			else if	constexpr(std::floating_point<A> && std::same_as<D, detail::other_floating_t<A>>) kernels<A>().to_other(detail::flat(in), detail::flat(out), 3 * count);
+			else {
+				A const* flat_in = detail::flat(in);
+				D* flat_out = detail::flat(out);
+				for (std::size_t i = 0; i < 3 * count; ++i) flat_out[i] = static_cast<D>(flat_in[i]);
+			}
+		}
+		else for (std::size_t i = 0; i < count; ++i) out[i] = Vec<D, E, F>(in[i]);
+	}
+
+
+
+	// out[i] = lhs[i].dot(rhs[i]), for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	dot(Vec<T> const* lhs, Vec<T> const* rhs, T* out, std::size_t count)
+	noexcept { kernels<T>().dot(detail::flat(lhs), detail::flat(rhs), out, count); }
+
+	// out[i] = lhs[i].cross(rhs[i]), for 'count' vectors.
+	template<std::floating_point T>
+	inline void
+	cross(Vec<T> const* lhs, Vec<T> const* rhs, Vec<T>* out, std::size_t count)
+	noexcept { kernels<T>().cross(detail::flat(lhs), detail::flat(rhs), detail::flat(out), count); }
+
+
+
+	// out[i] = in[i].mag<precision>(), for 'count' vectors.
+	template<Precision precision = Precision::Exact, std::floating_point T>
+	inline void
+	mag(Vec<T> const* in, T* out, std::size_t count)
+	noexcept { kernels<T>().mag[std::size_t(precision)](detail::flat(in), out, count); }
+
+	// out[i] = in[i].inv_mag<precision>(), for 'count' vectors.
+	template<Precision precision = Precision::Exact, std::floating_point T>
+	inline void
+	inv_mag(Vec<T> const* in, T* out, std::size_t count)
+	noexcept { kernels<T>().inv_mag[std::size_t(precision)](detail::flat(in), out, count); }
+
+	// out[i] = in[i].normalize<precision>(), for 'count' vectors.
+	template<Precision precision = Precision::Exact, std::floating_point T>
+	inline void
+	normalize(Vec<T> const* in, Vec<T>* out, std::size_t count)
+	noexcept { kernels<T>().normalize[std::size_t(precision)](detail::flat(in), detail::flat(out), count); }
+
+	// out[i] = lhs[i].distance<precision>(rhs[i]), for 'count' vectors.
+	template<Precision precision = Precision::Exact, std::floating_point T>
+	inline void
+	distance(Vec<T> const* lhs, Vec<T> const* rhs, T* out, std::size_t count)
+	noexcept { kernels<T>().distance[std::size_t(precision)](detail::flat(lhs), detail::flat(rhs), out, count); }
+
+}
+
+#endif
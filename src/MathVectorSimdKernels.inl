@@ -0,0 +1,524 @@
+// Generic batch kernels, written once against a 'traits<T>' instruction set description.
+// Deliberately has no include guard: MathVectorSimd.hpp includes it once per instruction set,
+// inside a namespace that defines 'traits', and under the matching target options.
+
+template<detail::BinaryOp op, typename isa>
+static inline typename isa::reg
+apply(typename isa::reg lhs, typename isa::reg rhs) {
+	if		constexpr(op == detail::BinaryOp::Add) return isa::add(lhs, rhs);
+	else if	constexpr(op == detail::BinaryOp::Sub) return isa::sub(lhs, rhs);
+	else if	constexpr(op == detail::BinaryOp::Mul) return isa::mul(lhs, rhs);
+	else if	constexpr(op == detail::BinaryOp::Div) return isa::div(lhs, rhs);
+}
+
+// Element-wise 'op' over 'n' scalars.
+template<detail::BinaryOp op, typename T>
+static void
+binary(T const* lhs, T const* rhs, T* out, std::size_t n) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= n; i += isa::width)
+		isa::store(out + i, apply<op, isa>(isa::load(lhs + i), isa::load(rhs + i)));
+	for (; i < n; ++i)
+		out[i] = detail::apply_scalar<op>(lhs[i], rhs[i]);
+}
+
+// Element-wise 'op' over 'n' scalars, with rhs broadcast.
+template<detail::BinaryOp op, typename T>
+static void
+binary_scalar(T const* lhs, T rhs, T* out, std::size_t n) {
+	using isa = traits<T>;
+	const auto r = isa::set1(rhs);
+	std::size_t i = 0;
+	for (; i + isa::width <= n; i += isa::width)
+		isa::store(out + i, apply<op, isa>(isa::load(lhs + i), r));
+	for (; i < n; ++i)
+		out[i] = detail::apply_scalar<op>(lhs[i], rhs);
+}
+
+// Element-wise comparison over 'n' scalars, producing one bool each.
+template<detail::CmpOp op, typename T>
+static void
+compare(T const* lhs, T const* rhs, bool* out, std::size_t n) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= n; i += isa::width) {
+		const unsigned bits = isa::template cmp<op>(isa::load(lhs + i), isa::load(rhs + i));
+		for (std::size_t k = 0; k < isa::width; ++k) out[i + k] = (bits >> k) & 1u;
+	}
+	for (; i < n; ++i)
+		out[i] = detail::compare_scalar<op>(lhs[i], rhs[i]);
+}
+
+// Compares the interleaved xyz vectors [i, i + width) of 'lhs' with those of 'rhs', or with the single vector 'rhs'
+// when 'broadcast'. Bit k of 'x', 'y' and 'z' is the comparison of that axis of vector i + k.
+template<detail::CmpOp op, typename T>
+static inline void
+compare3(T const* lhs, T const* rhs, bool broadcast, std::size_t i, unsigned& x, unsigned& y, unsigned& z) {
+	using isa = traits<T>;
+	typename isa::reg lx, ly, lz, rx, ry, rz;
+	isa::load3(lhs + 3 * i, lx, ly, lz);
+	if (broadcast) { rx = isa::set1(rhs[0]); ry = isa::set1(rhs[1]); rz = isa::set1(rhs[2]); }
+	else isa::load3(rhs + 3 * i, rx, ry, rz);
+	x = isa::template cmp<op>(lx, rx);
+	y = isa::template cmp<op>(ly, ry);
+	z = isa::template cmp<op>(lz, rz);
+}
+
+// compare3() for the single vector i, as a 3 bit mask.
+template<detail::CmpOp op, typename T>
+static inline unsigned
+compare3_one(T const* lhs, T const* rhs, bool broadcast, std::size_t i) {
+	T const* l = lhs + 3 * i;
+	T const* r = broadcast ? rhs : rhs + 3 * i;
+	return
+		unsigned(detail::compare_scalar<op>(l[0], r[0])) |
+		unsigned(detail::compare_scalar<op>(l[1], r[1])) << 1 |
+		unsigned(detail::compare_scalar<op>(l[2], r[2])) << 2;
+}
+
+// The low 8 bits of 'bits', one per byte: byte k is 1 where bit k is set. The multiply copies them to every byte,
+// the 'and' keeps bit k of byte k, and the add carries it up to the top bit of its byte, without touching the next.
+static inline std::uint64_t
+spread_bits(unsigned bits) {
+	const std::uint64_t ones = ((bits & 0xFFu) * 0x0101010101010101ull) & 0x8040201008040201ull;
+	return ((ones + 0x7F7F7F7F7F7F7F7Full) >> 7) & 0x0101010101010101ull;
+}
+
+// Comparison of 'count' interleaved xyz vectors, producing one 3 bit mask each: bit a for axis a.
+template<detail::CmpOp op, typename T>
+static void
+compare_masks(T const* lhs, T const* rhs, bool broadcast, std::uint8_t* out, std::size_t count) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		unsigned x, y, z;
+		compare3<op>(lhs, rhs, broadcast, i, x, y, z);
+		for (std::size_t k = 0; k < isa::width; k += 8) {
+			const std::uint64_t bytes = spread_bits(x >> k) | spread_bits(y >> k) << 1 | spread_bits(z >> k) << 2;
+			constexpr std::size_t n = isa::width < 8 ? isa::width : 8;
+			if constexpr(std::endian::native == std::endian::little) std::memcpy(out + i + k, &bytes, n);
+			else for (std::size_t b = 0; b < n; ++b) out[i + k + b] = static_cast<std::uint8_t>(bytes >> (8 * b));
+		}
+	}
+	for (; i < count; ++i)
+		out[i] = static_cast<std::uint8_t>(compare3_one<op>(lhs, rhs, broadcast, i));
+}
+
+// Comparison of 'count' interleaved xyz vectors, reduced to one bit each, bit i % 64 of out[i / 64]: set when the
+// comparison holds on every axis, or on any axis when 'any'. The bits past 'count' in the last word are cleared.
+template<detail::CmpOp op, bool any, typename T>
+static void
+compare_bits(T const* lhs, T const* rhs, bool broadcast, std::uint64_t* out, std::size_t count) {
+	using isa = traits<T>;
+	static_assert(64 % isa::width == 0, "a register's worth of bits must not straddle two words");
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		unsigned x, y, z;
+		compare3<op>(lhs, rhs, broadcast, i, x, y, z);
+		const std::uint64_t bits = any ? (x | y | z) : (x & y & z);
+		if (i % 64 == 0) out[i / 64] = 0;
+		out[i / 64] |= bits << (i % 64);
+	}
+	for (; i < count; ++i) {
+		const unsigned m = compare3_one<op>(lhs, rhs, broadcast, i);
+		if (i % 64 == 0) out[i / 64] = 0;
+		out[i / 64] |= std::uint64_t(any ? m != 0 : m == 7u) << (i % 64);
+	}
+}
+
+// Dot product of 'count' pairs of interleaved xyz vectors.
+template<typename T>
+static void
+dot(T const* lhs, T const* rhs, T* out, std::size_t count) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		typename isa::reg lx, ly, lz, rx, ry, rz;
+		isa::load3(lhs + 3 * i, lx, ly, lz);
+		isa::load3(rhs + 3 * i, rx, ry, rz);
+		isa::store(out + i, isa::add(isa::add(isa::mul(lx, rx), isa::mul(ly, ry)), isa::mul(lz, rz)));
+	}
+	for (; i < count; ++i) {
+		T const* l = lhs + 3 * i;
+		T const* r = rhs + 3 * i;
+		out[i] = (l[0] * r[0]) + (l[1] * r[1]) + (l[2] * r[2]);
+	}
+}
+
+// Cross product of 'count' pairs of interleaved xyz vectors.
+template<typename T>
+static void
+cross(T const* lhs, T const* rhs, T* out, std::size_t count) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		typename isa::reg lx, ly, lz, rx, ry, rz;
+		isa::load3(lhs + 3 * i, lx, ly, lz);
+		isa::load3(rhs + 3 * i, rx, ry, rz);
+		isa::store3(out + 3 * i,
+			isa::sub(isa::mul(ly, rz), isa::mul(lz, ry)),
+			isa::sub(isa::mul(lz, rx), isa::mul(lx, rz)),
+			isa::sub(isa::mul(lx, ry), isa::mul(ly, rx)));
+	}
+	for (; i < count; ++i) {
+		T const* l = lhs + 3 * i;
+		T const* r = rhs + 3 * i;
+		T* o = out + 3 * i;
+		const T x = (l[1] * r[2]) - (l[2] * r[1]);
+		const T y = (l[2] * r[0]) - (l[0] * r[2]);
+		const T z = (l[0] * r[1]) - (l[1] * r[0]);
+		o[0] = x; o[1] = y; o[2] = z;
+	}
+}
+
+// 1 / sqrt(x). Precision::Fast refines the instruction set's estimate, when it has one, exactly as generic_vec::detail::inv_sqrt does.
+template<Precision precision, typename T>
+static inline typename traits<T>::reg
+inv_sqrt(typename traits<T>::reg x) {
+	using isa = traits<T>;
+	if constexpr(precision == Precision::Fast && requires { isa::rsqrt(x); }) {
+		// Clamped as generic_vec::detail::inv_sqrt does. Every min returns its second operand for NaN, so NaN stays NaN.
+		const auto v = isa::min(isa::set1(std::numeric_limits<T>::max()), x);
+		const auto y = isa::rsqrt(v);
+		return isa::mul(y, isa::sub(isa::set1(T(1.5)), isa::mul(isa::mul(isa::mul(isa::set1(T(0.5)), v), y), y)));
+	}
+	else return isa::div(isa::set1(T(1)), isa::sqrt(x));
+}
+
+// sqrt(x). Precision::Fast multiplies by the reciprocal square root rather than dividing, as generic_vec::detail::sqrt does.
+template<Precision precision, typename T>
+static inline typename traits<T>::reg
+root(typename traits<T>::reg x) {
+	using isa = traits<T>;
+	if constexpr(precision == Precision::Fast && requires { isa::rsqrt(x); })
+		return isa::mul(x, inv_sqrt<precision, T>(isa::max(x, isa::set1(std::numeric_limits<T>::min()))));
+	else return isa::sqrt(x);
+}
+
+template<typename T>
+static inline T
+mag2_of(T const* p)
+{ return (p[0] * p[0]) + (p[1] * p[1]) + (p[2] * p[2]); }
+
+// Magnitude of 'count' interleaved xyz vectors.
+template<Precision precision, typename T>
+static void
+mag(T const* in, T* out, std::size_t count) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		typename isa::reg x, y, z;
+		isa::load3(in + 3 * i, x, y, z);
+		isa::store(out + i, root<precision, T>(isa::add(isa::add(isa::mul(x, x), isa::mul(y, y)), isa::mul(z, z))));
+	}
+	for (; i < count; ++i)
+		out[i] = generic_vec::detail::sqrt<precision>(mag2_of(in + 3 * i));
+}
+
+// Reciprocal magnitude of 'count' interleaved xyz vectors.
+template<Precision precision, typename T>
+static void
+inv_mag(T const* in, T* out, std::size_t count) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		typename isa::reg x, y, z;
+		isa::load3(in + 3 * i, x, y, z);
+		isa::store(out + i, inv_sqrt<precision, T>(isa::add(isa::add(isa::mul(x, x), isa::mul(y, y)), isa::mul(z, z))));
+	}
+	for (; i < count; ++i)
+		out[i] = generic_vec::detail::inv_sqrt<precision>(mag2_of(in + 3 * i));
+}
+
+// 'count' interleaved xyz vectors, each scaled by its reciprocal magnitude.
+template<Precision precision, typename T>
+static void
+normalize(T const* in, T* out, std::size_t count) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		typename isa::reg x, y, z;
+		isa::load3(in + 3 * i, x, y, z);
+		const auto s = inv_sqrt<precision, T>(isa::add(isa::add(isa::mul(x, x), isa::mul(y, y)), isa::mul(z, z)));
+		isa::store3(out + 3 * i, isa::mul(x, s), isa::mul(y, s), isa::mul(z, s));
+	}
+	for (; i < count; ++i) {
+		T const* p = in + 3 * i;
+		T* o = out + 3 * i;
+		const T s = generic_vec::detail::inv_sqrt<precision>(mag2_of(p));
+		const T x = p[0] * s, y = p[1] * s, z = p[2] * s;
+		o[0] = x; o[1] = y; o[2] = z;
+	}
+}
+
+// Distance between 'count' pairs of interleaved xyz vectors.
+template<Precision precision, typename T>
+static void
+distance(T const* lhs, T const* rhs, T* out, std::size_t count) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		typename isa::reg lx, ly, lz, rx, ry, rz;
+		isa::load3(lhs + 3 * i, lx, ly, lz);
+		isa::load3(rhs + 3 * i, rx, ry, rz);
+		const auto dx = isa::sub(lx, rx), dy = isa::sub(ly, ry), dz = isa::sub(lz, rz);
+		isa::store(out + i, root<precision, T>(isa::add(isa::add(isa::mul(dx, dx), isa::mul(dy, dy)), isa::mul(dz, dz))));
+	}
+	for (; i < count; ++i) {
+		T const* l = lhs + 3 * i;
+		T const* r = rhs + 3 * i;
+		const T d[3] = { l[0] - r[0], l[1] - r[1], l[2] - r[2] };
+		out[i] = generic_vec::detail::sqrt<precision>(mag2_of(d));
+	}
+}
+
+// Affine transform of 'count' interleaved xyz vectors by the matrix 'm', laid out as KernelTable describes, adding its
+// translation when 'point'. The matrix is broadcast into registers once, and the vectors stream through it.
+// Each block is loaded before it is stored, so 'in' and 'out' may be the same array.
+template<bool point, typename T>
+static void
+transform(T const* m, T const* in, T* out, std::size_t count) {
+	using isa = traits<T>;
+	const typename isa::reg
+		xx = isa::set1(m[0]), xy = isa::set1(m[1]), xz = isa::set1(m[2]),
+		yx = isa::set1(m[3]), yy = isa::set1(m[4]), yz = isa::set1(m[5]),
+		zx = isa::set1(m[6]), zy = isa::set1(m[7]), zz = isa::set1(m[8]);
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		typename isa::reg x, y, z;
+		isa::load3(in + 3 * i, x, y, z);
+		auto ox = isa::add(isa::add(isa::mul(xx, x), isa::mul(yx, y)), isa::mul(zx, z));
+		auto oy = isa::add(isa::add(isa::mul(xy, x), isa::mul(yy, y)), isa::mul(zy, z));
+		auto oz = isa::add(isa::add(isa::mul(xz, x), isa::mul(yz, y)), isa::mul(zz, z));
+		if constexpr(point) {
+			ox = isa::add(ox, isa::set1(m[9]));
+			oy = isa::add(oy, isa::set1(m[10]));
+			oz = isa::add(oz, isa::set1(m[11]));
+		}
+		isa::store3(out + 3 * i, ox, oy, oz);
+	}
+	for (; i < count; ++i) {
+		T const* p = in + 3 * i;
+		T* o = out + 3 * i;
+		T x = (m[0] * p[0]) + (m[3] * p[1]) + (m[6] * p[2]);
+		T y = (m[1] * p[0]) + (m[4] * p[1]) + (m[7] * p[2]);
+		T z = (m[2] * p[0]) + (m[5] * p[1]) + (m[8] * p[2]);
+		if constexpr(point) { x += m[9]; y += m[10]; z += m[11]; }
+		o[0] = x; o[1] = y; o[2] = z;
+	}
+}
+
+// Permutes the axes of 'count' interleaved xyz vectors: out[i] gets the axes a, b and c of in[i], as its x, y and z.
+// Instruction sets with two-source permutes shuffle the raw registers directly, the others deinterleave them and store
+// the axis registers back in the new order. 'in' and 'out' may be the same array.
+template<std::size_t a, std::size_t b, std::size_t c, typename T>
+static void
+swizzle(T const* in, T* out, std::size_t count) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	for (; i + isa::width <= count; i += isa::width) {
+		if constexpr(requires(typename isa::reg r) { isa::template swizzle<0, a, b, c>(r, r, r); }) {
+			const auto p = in + 3 * i;
+			const auto r0 = isa::load(p), r1 = isa::load(p + isa::width), r2 = isa::load(p + 2 * isa::width);
+			isa::store(out + 3 * i,                  isa::template swizzle<0, a, b, c>(r0, r1, r2));
+			isa::store(out + 3 * i + isa::width,     isa::template swizzle<1, a, b, c>(r0, r1, r2));
+			isa::store(out + 3 * i + 2 * isa::width, isa::template swizzle<2, a, b, c>(r0, r1, r2));
+		} else {
+			typename isa::reg v[3];
+			isa::load3(in + 3 * i, v[0], v[1], v[2]);
+			isa::store3(out + 3 * i, v[a], v[b], v[c]);
+		}
+	}
+	for (; i < count; ++i) {
+		const T v[3] = { in[3 * i], in[3 * i + 1], in[3 * i + 2] };
+		out[3 * i] = v[a]; out[3 * i + 1] = v[b]; out[3 * i + 2] = v[c];
+	}
+}
+
+// The 27 swizzle kernels, in the order KernelTable describes.
+template<typename T, std::size_t... s>
+static constexpr std::array<void (*)(T const*, T*, std::size_t), 27>
+swizzle_table(std::index_sequence<s...>)
+noexcept { return { &swizzle<s / 9, s / 3 % 3, s % 3, T>... }; }
+
+// Converts 'n' scalars to 16 bit floats, IEEE binary16 when 'half' and bfloat16 otherwise, rounding to nearest even.
+// Instruction sets without the conversions, and double, which goes through float, take the portable scalar path.
+template<bool half, typename T>
+static void
+to_float16(T const* in, std::uint16_t* out, std::size_t n) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	if constexpr(half && requires(typename isa::reg r) { isa::store_half(out, r); })
+		for (; i + isa::width <= n; i += isa::width) isa::store_half(out + i, isa::load(in + i));
+	else if constexpr(!half && requires(typename isa::reg r) { isa::store_bfloat(out, r); })
+		for (; i + isa::width <= n; i += isa::width) isa::store_bfloat(out + i, isa::load(in + i));
+	for (; i < n; ++i)
+		out[i] = half ? detail::half_from_float(static_cast<float>(in[i])) : detail::bfloat_from_float(static_cast<float>(in[i]));
+}
+
+// Converts 'n' 16 bit floats back, exactly.
+template<bool half, typename T>
+static void
+from_float16(std::uint16_t const* in, T* out, std::size_t n) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	if constexpr(half && requires { isa::load_half(in); })
+		for (; i + isa::width <= n; i += isa::width) isa::store(out + i, isa::load_half(in + i));
+	else if constexpr(!half && requires { isa::load_bfloat(in); })
+		for (; i + isa::width <= n; i += isa::width) isa::store(out + i, isa::load_bfloat(in + i));
+	for (; i < n; ++i)
+		out[i] = static_cast<T>(half ? detail::half_to_float(in[i]) : detail::bfloat_to_float(in[i]));
+}
+
+// The 3 registers of parameter 'first + axis' for a block of 3 registers of interleaved xyz data: lane p of register r
+// belongs to axis (r * width + p) % 3.
+template<typename T>
+static inline void
+axis_pattern(T const* params, std::size_t first, typename traits<T>::reg (&out)[3]) {
+	using isa = traits<T>;
+	for (std::size_t r = 0; r < 3; ++r) {
+		T lanes[isa::width];
+		for (std::size_t p = 0; p < isa::width; ++p) lanes[p] = params[first + (r * isa::width + p) % 3];
+		out[r] = isa::load(lanes);
+	}
+}
+
+// Quantizes 'count' interleaved xyz vectors to int16: (v - offset) * inverse scale, clamped and rounded as
+// detail::quantize_scalar does. 'params' holds the inverse scales then the offsets, per axis.
+template<typename T>
+static void
+quantize(T const* in, T const* params, std::int16_t* out, std::size_t count) {
+	using isa = traits<T>;
+	const std::size_t n = 3 * count;
+	std::size_t i = 0;
+	if constexpr(requires(typename isa::reg r) { isa::store_i16(out, r); }) {
+		typename isa::reg scale[3], offset[3];
+		axis_pattern(params, 0, scale);
+		axis_pattern(params, 3, offset);
+		const auto lo = isa::set1(T(-32768)), hi = isa::set1(T(32767));
+		for (; i + 3 * isa::width <= n; i += 3 * isa::width)
+			for (std::size_t r = 0; r < 3; ++r) {
+				const auto v = isa::mul(isa::sub(isa::load(in + i + r * isa::width), offset[r]), scale[r]);
+				isa::store_i16(out + i + r * isa::width, isa::max(isa::min(v, hi), lo));
+			}
+	}
+	for (; i < n; ++i)
+		out[i] = detail::quantize_scalar((in[i] - params[3 + i % 3]) * params[i % 3]);
+}
+
+// Dequantizes 'count' interleaved xyz vectors of int16: q * scale + offset. 'params' holds the scales then the offsets.
+template<typename T>
+static void
+dequantize(std::int16_t const* in, T const* params, T* out, std::size_t count) {
+	using isa = traits<T>;
+	const std::size_t n = 3 * count;
+	std::size_t i = 0;
+	if constexpr(requires { isa::load_i16(in); }) {
+		typename isa::reg scale[3], offset[3];
+		axis_pattern(params, 0, scale);
+		axis_pattern(params, 3, offset);
+		for (; i + 3 * isa::width <= n; i += 3 * isa::width)
+			for (std::size_t r = 0; r < 3; ++r)
+				isa::store(out + i + r * isa::width, isa::add(isa::mul(isa::load_i16(in + i + r * isa::width), scale[r]), offset[r]));
+	}
+	for (; i < n; ++i)
+		out[i] = static_cast<T>(in[i]) * params[i % 3] + params[3 + i % 3];
+}
+
+// Converts 'n' scalars to int32, truncating toward zero as static_cast does, for which values out of range are undefined.
+template<typename T>
+static void
+to_int32(T const* in, std::int32_t* out, std::size_t n) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	if constexpr(requires(typename isa::reg r) { isa::store_i32(out, r); })
+		for (; i + isa::width <= n; i += isa::width) isa::store_i32(out + i, isa::load(in + i));
+	for (; i < n; ++i) out[i] = static_cast<std::int32_t>(in[i]);
+}
+
+// Converts 'n' int32 to T, rounding to nearest even where T cannot hold them exactly, as static_cast does.
+template<typename T>
+static void
+from_int32(std::int32_t const* in, T* out, std::size_t n) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	if constexpr(requires { isa::load_i32(in); })
+		for (; i + isa::width <= n; i += isa::width) isa::store(out + i, isa::load_i32(in + i));
+	for (; i < n; ++i) out[i] = static_cast<T>(in[i]);
+}
+
+// Converts 'n' scalars to the other one of float and double: exactly to double, rounding to nearest even to float.
+template<typename T>
+static void
+to_other(T const* in, detail::other_floating_t<T>* out, std::size_t n) {
+	using isa = traits<T>;
+	std::size_t i = 0;
+	if constexpr(requires(typename isa::reg r) { isa::store_other(out, r); })
+		for (; i + isa::width <= n; i += isa::width) isa::store_other(out + i, isa::load(in + i));
+	for (; i < n; ++i) out[i] = static_cast<detail::other_floating_t<T>>(in[i]);
+}
+
+// Every kernel of this instruction set for element type T.
+template<typename T>
+static constexpr detail::KernelTable<T>
+kernel_table()
+noexcept {
+	return {
+		&binary<detail::BinaryOp::Add, T>,
+		&binary<detail::BinaryOp::Sub, T>,
+		&binary<detail::BinaryOp::Mul, T>,
+		&binary<detail::BinaryOp::Div, T>,
+		&binary_scalar<detail::BinaryOp::Mul, T>,
+		&binary_scalar<detail::BinaryOp::Div, T>,
+		{
+			&compare<detail::CmpOp::Eq, T>,
+			&compare<detail::CmpOp::Neq, T>,
+			&compare<detail::CmpOp::Lt, T>,
+			&compare<detail::CmpOp::Le, T>,
+			&compare<detail::CmpOp::Gt, T>,
+			&compare<detail::CmpOp::Ge, T>,
+		},
+		{
+			&compare_masks<detail::CmpOp::Eq, T>,
+			&compare_masks<detail::CmpOp::Neq, T>,
+			&compare_masks<detail::CmpOp::Lt, T>,
+			&compare_masks<detail::CmpOp::Le, T>,
+			&compare_masks<detail::CmpOp::Gt, T>,
+			&compare_masks<detail::CmpOp::Ge, T>,
+		},
+		{
+			&compare_bits<detail::CmpOp::Eq, false, T>,
+			&compare_bits<detail::CmpOp::Neq, false, T>,
+			&compare_bits<detail::CmpOp::Lt, false, T>,
+			&compare_bits<detail::CmpOp::Le, false, T>,
+			&compare_bits<detail::CmpOp::Gt, false, T>,
+			&compare_bits<detail::CmpOp::Ge, false, T>,
+		},
+		{
+			&compare_bits<detail::CmpOp::Eq, true, T>,
+			&compare_bits<detail::CmpOp::Neq, true, T>,
+			&compare_bits<detail::CmpOp::Lt, true, T>,
+			&compare_bits<detail::CmpOp::Le, true, T>,
+			&compare_bits<detail::CmpOp::Gt, true, T>,
+			&compare_bits<detail::CmpOp::Ge, true, T>,
+		},
+		&dot<T>,
+		&cross<T>,
+		{ &mag<Precision::Exact, T>, &mag<Precision::Fast, T> },
+		{ &inv_mag<Precision::Exact, T>, &inv_mag<Precision::Fast, T> },
+		{ &normalize<Precision::Exact, T>, &normalize<Precision::Fast, T> },
+		{ &distance<Precision::Exact, T>, &distance<Precision::Fast, T> },
+		{ &transform<false, T>, &transform<true, T> },
+		swizzle_table<T>(std::make_index_sequence<27>{}),
+		&to_float16<true, T>,
+		&from_float16<true, T>,
+		&to_float16<false, T>,
+		&from_float16<false, T>,
+		&quantize<T>,
+		&dequantize<T>,
+		&to_int32<T>,
+		&from_int32<T>,
+		&to_other<T>,
+	};
+}
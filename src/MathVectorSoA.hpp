@@ -0,0 +1,405 @@
+#ifndef INK_GENERIC_VEC_SOA_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_SOA_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cassert>
+#include <concepts>
+#include <type_traits>
+#include <vector>
+#include "MathVector.hpp"
+
+namespace ink {
+
+	namespace generic_vec {
+
+		template<typename X, typename Y, typename Z>
+		class VecSoA;
+
+		namespace detail {
+
+			/**
+			 * Stand-in for the storage of a 'void' axis.
+			 * Indexing it yields NoState, and resizing it does nothing, so that it occupies no memory at all.
+			 */
+			struct NoStateLane {
+
+				public: constexpr NoState
+				operator[](std::size_t) const
+				noexcept { return NoState(); }
+
+				public: constexpr void
+				resize(std::size_t) const
+				noexcept {}
+
+				public: constexpr void
+				reserve(std::size_t) const
+				noexcept {}
+
+				public: constexpr void
+				clear() const
+				noexcept {}
+
+			};
+
+			// Whether a lane is the storage of a 'void' axis, which batched operations skip.
+			template<typename Lane>
+			concept no_state_lane = std::same_as<std::remove_cvref_t<Lane>, NoStateLane>;
+
+			/**
+			 * Stand-in for a scalar operand in a batched operation.
+			 * Indexing it yields the same value for every element.
+			 */
+			template<typename T>
+			struct BroadcastLane {
+
+				T const& value;
+
+				public: constexpr T const&
+				operator[](std::size_t) const
+				noexcept { return value; }
+
+			};
+
+			// Whether the lane of an axis of type T, a std::vector<T>, is a contiguous array of T: not so for bool.
+			template<typename T>
+			concept soa_axis = std::is_void_v<T> || requires(std::vector<T>& lane) { {lane.data()} -> std::same_as<T*>; };
+
+			template<typename T, XYZ tag> struct SoAMember;
+			template<typename T> struct SoAMember<T, XYZ::X> { std::vector<T> x; };
+			template<typename T> struct SoAMember<T, XYZ::Y> { std::vector<T> y; };
+			template<typename T> struct SoAMember<T, XYZ::Z> { std::vector<T> z; };
+
+			template<> struct SoAMember<void, XYZ::X> { static constexpr NoStateLane x{}; };
+			template<> struct SoAMember<void, XYZ::Y> { static constexpr NoStateLane y{}; };
+			template<> struct SoAMember<void, XYZ::Z> { static constexpr NoStateLane z{}; };
+
+			// Reference to an element of a lane, that stays 'void' for 'void' axes.
+			template<typename T> struct lane_ref { using type = T&; using const_type = T const&; };
+			template<> struct lane_ref<void> { using type = void; using const_type = void; };
+
+			template<typename T>
+			using lane_ref_t = typename lane_ref<T>::type;
+
+			template<typename T>
+			using lane_const_ref_t = typename lane_ref<T>::const_type;
+
+			// Maps a Vec<X, Y, Z> to the matching VecSoA<X, Y, Z>.
+			template<typename T> struct soa_of;
+			template<typename X, typename Y, typename Z> struct soa_of<Vec<X, Y, Z>> { using type = VecSoA<X, Y, Z>; };
+
+			template<typename T>
+			using soa_of_t = typename soa_of<std::remove_cvref_t<T>>::type;
+
+			// Returns the lane of the given axis of a VecSoA, or a broadcast of a scalar.
+			template<XYZ tag, typename T>
+			constexpr decltype(auto)
+			lane_of(T const& operand)
+			noexcept {
+				if constexpr(concepts::same_template<T, VecSoA<void, void, void>>) {
+					if		constexpr(tag == XYZ::X) return (operand.x);
+					else if	constexpr(tag == XYZ::Y) return (operand.y);
+					else if	constexpr(tag == XYZ::Z) return (operand.z);
+				}
+				else return BroadcastLane<T>{operand};
+			}
+
+			// Returns something indexable for the lane, going through the raw pointer where there is one.
+			template<typename Lane>
+			constexpr decltype(auto)
+			lane_data(Lane const& lane)
+			noexcept {
+				if constexpr(requires { lane.data(); }) return lane.data();
+				else return (lane);
+			}
+
+		}
+
+	}
+
+	namespace generic_vec {
+
+		/**
+		 * Structure-of-arrays counterpart to Vec<X, Y, Z>.
+		 * Every non-void axis is kept in its own contiguous array, and 'void' axes take no storage at all.
+		 * Batched operations run one tight loop per axis, which the compiler can turn into packed SIMD.
+		 */
+		template<typename X, typename Y = X, typename Z = Y>
+		class VecSoA:
+			public detail::SoAMember<X, detail::XYZ::X>,
+			public detail::SoAMember<Y, detail::XYZ::Y>,
+			public detail::SoAMember<Z, detail::XYZ::Z>
+		{
+
+			template<typename,typename,typename> friend class VecSoA;
+
+			static_assert(detail::soa_axis<X> && detail::soa_axis<Y> && detail::soa_axis<Z>,
+				"VecSoA keeps each axis in a contiguous std::vector, which std::vector<bool> is not");
+
+			public: using value_type = Vec<X, Y, Z>;
+			public: using reference = Vec<detail::lane_ref_t<X>, detail::lane_ref_t<Y>, detail::lane_ref_t<Z>>;
+			public: using const_reference = Vec<detail::lane_const_ref_t<X>, detail::lane_const_ref_t<Y>, detail::lane_const_ref_t<Z>>;
+			public: using size_type = std::size_t;
+
+			private: size_type M_size = 0;
+
+
+
+			public: constexpr
+			VecSoA() = default;
+
+			public: constexpr explicit
+			VecSoA(size_type n)
+			{ resize(n); }
+
+			public: constexpr
+			VecSoA(size_type n, value_type const& fill)
+			{
+				reserve(n);
+				for (size_type i = 0; i < n; ++i) push_back(fill);
+			}
+
+
+
+			public: constexpr size_type
+			size() const
+			noexcept { return M_size; }
+
+			public: constexpr bool
+			empty() const
+			noexcept { return M_size == 0; }
+
+			public: constexpr void
+			resize(size_type n)
+			{
+				this->x.resize(n);
+				this->y.resize(n);
+				this->z.resize(n);
+				M_size = n;
+			}
+
+			public: constexpr void
+			reserve(size_type n)
+			{
+				this->x.reserve(n);
+				this->y.reserve(n);
+				this->z.reserve(n);
+			}
+
+			public: constexpr void
+			clear()
+			noexcept
+			{
+				this->x.clear();
+				this->y.clear();
+				this->z.clear();
+				M_size = 0;
+			}
+
+			public: constexpr void
+			push_back(value_type const& vec)
+			{
+				if constexpr(!std::is_void_v<X>) this->x.push_back(vec.x);
+				if constexpr(!std::is_void_v<Y>) this->y.push_back(vec.y);
+				if constexpr(!std::is_void_v<Z>) this->z.push_back(vec.z);
+				++M_size;
+			}
+
+
+
+			// Returns a Vec of references into the lanes at index i.
+			public: constexpr reference
+			operator[](size_type i)
+			noexcept { return reference(M_at(this->x, i), M_at(this->y, i), M_at(this->z, i)); }
+
+			public: constexpr const_reference
+			operator[](size_type i) const
+			noexcept { return const_reference(M_at(this->x, i), M_at(this->y, i), M_at(this->z, i)); }
+
+
+
+			// Returns the dot product of every pair of elements of this and the rhs batch.
+			template<typename RX, typename RY, typename RZ>
+			requires requires(Vec<X, Y, Z> const& l, Vec<RX, RY, RZ> const& r) { {l.dot(r)}; }
+			constexpr auto
+			dot(VecSoA<RX, RY, RZ> const& rhs) const
+			{
+				assert(size() == rhs.size());
+				using result_type = std::remove_cvref_t<decltype(std::declval<Vec<X, Y, Z> const&>().dot(std::declval<Vec<RX, RY, RZ> const&>()))>;
+
+				std::vector<result_type> out(size());
+				auto* o = out.data();
+				auto&& lx = detail::lane_data(this->x); auto&& rx = detail::lane_data(rhs.x);
+				auto&& ly = detail::lane_data(this->y); auto&& ry = detail::lane_data(rhs.y);
+				auto&& lz = detail::lane_data(this->z); auto&& rz = detail::lane_data(rhs.z);
+				for (size_type i = 0, n = size(); i < n; ++i) o[i] = (lx[i] * rx[i]) + (ly[i] * ry[i]) + (lz[i] * rz[i]);
+				return out;
+			}
+
+			// Returns the cross product of every pair of elements of this and the rhs batch.
+			template<typename RX, typename RY, typename RZ>
+			requires requires(Vec<X, Y, Z> const& l, Vec<RX, RY, RZ> const& r) { {l.cross(r)}; }
+			constexpr auto
+			cross(VecSoA<RX, RY, RZ> const& rhs) const
+			{
+				assert(size() == rhs.size());
+				using result_type = detail::soa_of_t<decltype(std::declval<Vec<X, Y, Z> const&>().cross(std::declval<Vec<RX, RY, RZ> const&>()))>;
+
+				result_type out(size());
+				auto&& lx = detail::lane_data(this->x); auto&& rx = detail::lane_data(rhs.x);
+				auto&& ly = detail::lane_data(this->y); auto&& ry = detail::lane_data(rhs.y);
+				auto&& lz = detail::lane_data(this->z); auto&& rz = detail::lane_data(rhs.z);
+				const size_type n = size();
+
+				if constexpr(!detail::no_state_lane<decltype(out.x)>)
+				{ auto* o = out.x.data(); for (size_type i = 0; i < n; ++i) o[i] = (ly[i] * rz[i]) - (lz[i] * ry[i]); }
+				if constexpr(!detail::no_state_lane<decltype(out.y)>)
+				{ auto* o = out.y.data(); for (size_type i = 0; i < n; ++i) o[i] = (lz[i] * rx[i]) - (lx[i] * rz[i]); }
+				if constexpr(!detail::no_state_lane<decltype(out.z)>)
+				{ auto* o = out.z.data(); for (size_type i = 0; i < n; ++i) o[i] = (lx[i] * ry[i]) - (ly[i] * rx[i]); }
+
+				return out;
+			}
+
+			// Returns the magnitude squared of every element of the batch.
+			constexpr auto
+			mag2() const
+			requires requires(Vec<X, Y, Z> const& v) { {v.dot(v)}; }
+			{ return dot(*this); }
+
+
+
+			/**
+			 * Applies 'op' element-wise on every axis of lhs and rhs, writing into a new batch.
+			 * Either side may be a scalar, in which case it is broadcast across the batch.
+			 * Axes that are 'void' in the result are skipped entirely.
+			 */
+			public: template<typename ResultVec, typename Lhs, typename Rhs, typename Op>
+			static constexpr auto
+			zip(Lhs const& lhs, Rhs const& rhs, Op op)
+			{
+				using result_type = detail::soa_of_t<ResultVec>;
+				constexpr bool lvec = concepts::same_template<Lhs, VecSoA<void, void, void>>;
+				constexpr bool rvec = concepts::same_template<Rhs, VecSoA<void, void, void>>;
+
+				size_type n;
+				if constexpr(lvec) n = lhs.size(); else n = rhs.size();
+				if constexpr(lvec && rvec) assert(lhs.size() == rhs.size());
+
+				result_type out(n);
+				M_zip_lane<detail::XYZ::X>(out.x, lhs, rhs, n, op);
+				M_zip_lane<detail::XYZ::Y>(out.y, lhs, rhs, n, op);
+				M_zip_lane<detail::XYZ::Z>(out.z, lhs, rhs, n, op);
+				return out;
+			}
+
+
+
+			private: template<typename Lane>
+			static constexpr decltype(auto)
+			M_at(Lane& lane, size_type i)
+			noexcept { return lane[i]; }
+
+			private: template<detail::XYZ tag, typename OutLane, typename Lhs, typename Rhs, typename Op>
+			static constexpr void
+			M_zip_lane(OutLane& out, Lhs const& lhs, Rhs const& rhs, size_type n, Op& op)
+			{
+				if constexpr(!detail::no_state_lane<OutLane>) {
+					auto* o = out.data();
+					auto&& llane = detail::lane_of<tag>(lhs);
+					auto&& rlane = detail::lane_of<tag>(rhs);
+					auto&& l = detail::lane_data(llane);
+					auto&& r = detail::lane_data(rlane);
+					for (size_type i = 0; i < n; ++i) o[i] = op(l[i], r[i]);
+				}
+			}
+
+		};
+
+	}
+
+	using generic_vec::VecSoA;
+
+	namespace generic_vec {
+
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_add_t, LVec, RVec>{}() )
+		static constexpr auto
+		operator+(VecSoA<LX, LY, LZ> const& lhs, VecSoA<RX, RY, RZ> const& rhs)
+		{
+			using result_vec = decltype(std::declval<LVec const&>() + std::declval<RVec const&>());
+			return VecSoA<LX, LY, LZ>::template zip<result_vec>(lhs, rhs, [](auto const& l, auto const& r) { return l + r; });
+		}
+
+
+
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_sub_t, LVec, RVec>{}() )
+		static constexpr auto
+		operator-(VecSoA<LX, LY, LZ> const& lhs, VecSoA<RX, RY, RZ> const& rhs)
+		{
+			using result_vec = decltype(std::declval<LVec const&>() - std::declval<RVec const&>());
+			return VecSoA<LX, LY, LZ>::template zip<result_vec>(lhs, rhs, [](auto const& l, auto const& r) { return l - r; });
+		}
+
+
+
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_mul_t, LVec, RVec>{}() )
+		static constexpr auto
+		operator*(VecSoA<LX, LY, LZ> const& lhs, VecSoA<RX, RY, RZ> const& rhs)
+		{
+			using result_vec = decltype(std::declval<LVec const&>() * std::declval<RVec const&>());
+			return VecSoA<LX, LY, LZ>::template zip<result_vec>(lhs, rhs, [](auto const& l, auto const& r) { return l * r; });
+		}
+
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( !concepts::same_template<T, VecSoA<void, void, void>> && OpConstraint_t<concepts::can_mul_t, OVec, T>{}() )
+		static constexpr auto
+		operator*(VecSoA<X, Y, Z> const& lhs, T const& rhs)
+		{
+			using result_vec = decltype(std::declval<OVec const&>() * std::declval<T const&>());
+			return VecSoA<X, Y, Z>::template zip<result_vec>(lhs, rhs, [](auto const& l, auto const& r) { return l * r; });
+		}
+
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( !concepts::same_template<T, VecSoA<void, void, void>> && OpConstraint_t<concepts::can_mul_t, T, OVec>{}() )
+		static constexpr auto
+		operator*(T const& lhs, VecSoA<X, Y, Z> const& rhs)
+		{
+			using result_vec = decltype(std::declval<T const&>() * std::declval<OVec const&>());
+			return VecSoA<X, Y, Z>::template zip<result_vec>(lhs, rhs, [](auto const& l, auto const& r) { return l * r; });
+		}
+
+
+
+		template<typename LX, typename LY, typename LZ, typename RX, typename RY, typename RZ,
+			typename LVec = Vec<LX, LY, LZ>,
+			typename RVec = Vec<RX, RY, RZ>>
+		requires( OpConstraint_t<concepts::can_div_t, LVec, RVec>{}() )
+		static constexpr auto
+		operator/(VecSoA<LX, LY, LZ> const& lhs, VecSoA<RX, RY, RZ> const& rhs)
+		{
+			using result_vec = decltype(std::declval<LVec const&>() / std::declval<RVec const&>());
+			return VecSoA<LX, LY, LZ>::template zip<result_vec>(lhs, rhs, [](auto const& l, auto const& r) { return l / r; });
+		}
+
+		template<typename X, typename Y, typename Z, typename T, typename OVec = Vec<X, Y, Z>>
+		requires( !concepts::same_template<T, VecSoA<void, void, void>> && OpConstraint_t<concepts::can_div_t, OVec, T>{}() )
+		static constexpr auto
+		operator/(VecSoA<X, Y, Z> const& lhs, T const& rhs)
+		{
+			using result_vec = decltype(std::declval<OVec const&>() / std::declval<T const&>());
+			return VecSoA<X, Y, Z>::template zip<result_vec>(lhs, rhs, [](auto const& l, auto const& r) { return l / r; });
+		}
+
+	}
+
+}
+
+#endif
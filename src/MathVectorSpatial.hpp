@@ -0,0 +1,941 @@
+#ifndef INK_GENERIC_VEC_SPATIAL_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_SPATIAL_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MathVector.hpp"
+#include "MathVectorGrid.hpp"
+
+/*
+ * Spatial indices over Vec<T>: axis-aligned boxes, a bounding volume hierarchy and a uniform hash grid.
+ *
+ * Every query comes in two forms: one query at a time, and a batch of them. The batched queries of the BVH walk the tree
+ * once per packet of 'packet_width' queries, testing each node against every query of the packet at once, in SIMD
+ * registers. A packet pays off when its queries are close together, so batches are best sorted spatially first,
+ * for instance by the morton_encode() of their cell. Nearest-neighbour packets gain the least: each lane prunes by its
+ * own distance, and their searches drift apart.
+ *
+ * Results are reported through callbacks, called with the index of each item in the array the index was built from,
+ * so that nothing is allocated per query.
+ */
+namespace ink::generic_vec {
+
+	// Queries handled together by the batched queries of BVH.
+	inline constexpr std::size_t packet_width = 8;
+
+	/**
+	 * The closest item a ray or nearest-neighbour query found.
+	 * 'distance' is the ray parameter of the hit for rays, and the squared distance for nearest-neighbour queries.
+	 */
+	template<std::floating_point T>
+	struct QueryHit {
+
+		static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+		std::uint32_t index = none;
+		T distance = std::numeric_limits<T>::infinity();
+
+		constexpr explicit
+		operator bool() const
+		noexcept { return index != none; }
+
+	};
+
+
+
+	// Axis-aligned box. The default one is empty: inverted, so that growing it by anything gives exactly that thing.
+	template<std::floating_point T>
+	struct AABB {
+
+		Vec<T> lo = Vec<T>(std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity());
+		Vec<T> hi = Vec<T>(-std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity());
+
+		// The box of a single point.
+		static constexpr AABB
+		of(Vec<T> const& point)
+		noexcept { return AABB{point, point}; }
+
+		// The box of the sphere of the given center and radius.
+		static constexpr AABB
+		of(Vec<T> const& center, T radius)
+		noexcept {
+			const Vec<T> r(radius, radius, radius);
+			return AABB{center - r, center + r};
+		}
+
+		constexpr bool
+		empty() const
+		noexcept { return any(hi < lo); }
+
+		constexpr AABB&
+		grow(Vec<T> const& point)
+		noexcept { lo = min(lo, point); hi = max(hi, point); return *this; }
+
+		constexpr AABB&
+		grow(AABB const& box)
+		noexcept { lo = min(lo, box.lo); hi = max(hi, box.hi); return *this; }
+
+		constexpr Vec<T>
+		center() const
+		noexcept { return (lo + hi) * T(0.5); }
+
+		constexpr Vec<T>
+		extent() const
+		noexcept { return hi - lo; }
+
+		// Surface area, the cost measure of the BVH build. Zero when empty.
+		constexpr T
+		surface_area() const
+		noexcept {
+			if (empty()) return T(0);
+			const Vec<T> e = extent();
+			return T(2) * (e.x * e.y + e.y * e.z + e.z * e.x);
+		}
+
+		constexpr bool
+		contains(Vec<T> const& point) const
+		noexcept { return all(lo <= point) && all(point <= hi); }
+
+		constexpr bool
+		overlaps(AABB const& box) const
+		noexcept { return all(lo <= box.hi) && all(box.lo <= hi); }
+
+		// Squared distance from 'point' to the nearest point of the box. Zero inside.
+		constexpr T
+		distance2(Vec<T> const& point) const
+		noexcept { return max(max(lo - point, point - hi), Vec<T>(T(0), T(0), T(0))).mag2(); }
+
+		/**
+		 * Ray parameter at which the ray enters the box, clamped to 0 for origins inside it, or infinity when the ray
+		 * misses it before 't_max'. 'inv_dir' is 1 / direction per axis: infinities for zero axes are fine.
+		 *
+		 * A zero axis whose origin lies on a face of the box gives 0 * inf = NaN for that face. The ray then runs along
+		 * the face, inside the slab, so NaN counts as -inf for the entry and +inf for the exit. detail::lanes_ray() orders
+		 * its min and max the same way, so that packets find exactly what single rays find.
+		 */
+		constexpr T
+		ray_entry(Vec<T> const& origin, Vec<T> const& inv_dir, T t_max) const
+		noexcept {
+			// 'b' when either is NaN, as the SIMD instructions do.
+			constexpr auto lesser = [](T a, T b) { return a < b ? a : b; };
+			constexpr auto greater = [](T a, T b) { return a > b ? a : b; };
+			constexpr T inf = std::numeric_limits<T>::infinity();
+			T t_in = T(0), t_out = t_max;
+			auto slab = [&](T lo, T hi, T o, T inv) {
+				const T t0 = (lo - o) * inv, t1 = (hi - o) * inv;
+				t_in = greater(lesser(greater(t0, -inf), greater(t1, -inf)), t_in);
+				t_out = lesser(greater(lesser(t0, inf), lesser(t1, inf)), t_out);
+			};
+			slab(lo.x, hi.x, origin.x, inv_dir.x);
+			slab(lo.y, hi.y, origin.y, inv_dir.y);
+			slab(lo.z, hi.z, origin.z, inv_dir.z);
+			return t_in <= t_out ? t_in : inf;
+		}
+
+	};
+
+
+
+	namespace detail {
+
+		// Registers of the widest instruction set the build targets, for the node tests of packets. The tests are only
+		// a few instructions each: not worth a dispatch through simd::kernels(), which would cost as much again.
+		#if defined(INK_GENERIC_VEC_SIMD_X86) && defined(__AVX2__)
+		template<typename T> using packet_isa = simd::avx2::traits<T>;
+		#elif defined(INK_GENERIC_VEC_SIMD_X86) && defined(__SSE2__)
+		template<typename T> using packet_isa = simd::sse2::traits<T>;
+		#else
+		template<typename T> using packet_isa = simd::scalar::traits<T>;
+		#endif
+
+		// A value per query of a packet, as a structure of arrays.
+		template<std::floating_point T>
+		struct Packet {
+			alignas(64) std::array<T, packet_width> x, y, z;
+		};
+
+		// The packet of the first 'n' points, the last one repeated in the unused lanes so that they compute something harmless.
+		template<std::floating_point T, typename Get>
+		inline Packet<T>
+		gather(std::size_t n, Get&& get)
+		noexcept {
+			Packet<T> p;
+			for (std::size_t l = 0; l < packet_width; ++l) {
+				const Vec<T> v = get(std::min(l, n - 1));
+				p.x[l] = v.x; p.y[l] = v.y; p.z[l] = v.z;
+			}
+			return p;
+		}
+
+		// Lanes whose box [lo, hi] overlaps 'box', as a mask.
+		template<std::floating_point T>
+		inline unsigned
+		lanes_overlap(AABB<T> const& box, Packet<T> const& lo, Packet<T> const& hi)
+		noexcept {
+			using isa = packet_isa<T>;
+			constexpr auto le = simd::detail::CmpOp::Le;
+			unsigned mask = 0;
+			for (std::size_t l = 0; l < packet_width; l += isa::width) {
+				mask |= (
+					isa::template cmp<le>(isa::load(&lo.x[l]), isa::set1(box.hi.x)) & isa::template cmp<le>(isa::set1(box.lo.x), isa::load(&hi.x[l])) &
+					isa::template cmp<le>(isa::load(&lo.y[l]), isa::set1(box.hi.y)) & isa::template cmp<le>(isa::set1(box.lo.y), isa::load(&hi.y[l])) &
+					isa::template cmp<le>(isa::load(&lo.z[l]), isa::set1(box.hi.z)) & isa::template cmp<le>(isa::set1(box.lo.z), isa::load(&hi.z[l]))
+				) << l;
+			}
+			return mask;
+		}
+
+		// Lanes whose point comes within sqrt(limit2[l]) of 'box': AABB::distance2() on every lane at once.
+		template<std::floating_point T>
+		inline unsigned
+		lanes_within(AABB<T> const& box, Packet<T> const& p, T const* limit2)
+		noexcept {
+			using isa = packet_isa<T>;
+			const auto zero = isa::set1(T(0));
+			auto axis = [&](T lo, T hi, T const* v) {
+				const auto x = isa::load(v);
+				const auto d = isa::max(isa::max(isa::sub(isa::set1(lo), x), isa::sub(x, isa::set1(hi))), zero);
+				return isa::mul(d, d);
+			};
+			unsigned mask = 0;
+			for (std::size_t l = 0; l < packet_width; l += isa::width) {
+				const auto d2 = isa::add(isa::add(axis(box.lo.x, box.hi.x, &p.x[l]), axis(box.lo.y, box.hi.y, &p.y[l])), axis(box.lo.z, box.hi.z, &p.z[l]));
+				mask |= isa::template cmp<simd::detail::CmpOp::Le>(d2, isa::load(limit2 + l)) << l;
+			}
+			return mask;
+		}
+
+		/**
+		 * Lanes whose ray enters 'box' before t_max[l]: AABB::ray_entry() on every lane at once.
+		 * min() and max() give their second operand when either is NaN, which turns the NaN of a face a ray runs along
+		 * into -inf for the entry and +inf for the exit, as ray_entry() does.
+		 */
+		template<std::floating_point T>
+		inline unsigned
+		lanes_ray(AABB<T> const& box, Packet<T> const& origin, Packet<T> const& inv_dir, T const* t_max)
+		noexcept {
+			using isa = packet_isa<T>;
+			const auto inf = isa::set1(std::numeric_limits<T>::infinity()), minus_inf = isa::set1(-std::numeric_limits<T>::infinity());
+			unsigned mask = 0;
+			for (std::size_t l = 0; l < packet_width; l += isa::width) {
+				auto t_in = isa::set1(T(0)), t_out = isa::load(t_max + l);
+				auto slab = [&](T lo, T hi, T const* o, T const* inv) {
+					const auto t0 = isa::mul(isa::sub(isa::set1(lo), isa::load(o)), isa::load(inv));
+					const auto t1 = isa::mul(isa::sub(isa::set1(hi), isa::load(o)), isa::load(inv));
+					t_in = isa::max(isa::min(isa::max(t0, minus_inf), isa::max(t1, minus_inf)), t_in);
+					t_out = isa::min(isa::max(isa::min(t0, inf), isa::min(t1, inf)), t_out);
+				};
+				slab(box.lo.x, box.hi.x, &origin.x[l], &inv_dir.x[l]);
+				slab(box.lo.y, box.hi.y, &origin.y[l], &inv_dir.y[l]);
+				slab(box.lo.z, box.hi.z, &origin.z[l], &inv_dir.z[l]);
+				mask |= isa::template cmp<simd::detail::CmpOp::Le>(t_in, t_out) << l;
+			}
+			return mask;
+		}
+
+		// Reciprocal of each axis, for ray_entry().
+		template<std::floating_point T>
+		constexpr Vec<T>
+		inverse(Vec<T> const& dir)
+		noexcept { return Vec<T>(T(1) / dir.x, T(1) / dir.y, T(1) / dir.z); }
+
+	}
+
+	/**
+	 * Bounding volume hierarchy over axis-aligned boxes, built with the binned surface area heuristic.
+	 *
+	 * Nodes are stored depth first, each one 8 * sizeof(T) bytes and aligned to that size, so that a node never
+	 * straddles a cache line: 32 bytes for float. The first child of an interior node is the node right after it,
+	 * and only the second one needs an index. The boxes of the items are copied in leaf order, so that the items of a
+	 * leaf are contiguous in memory. The tree is at most 'max_depth' levels deep, whatever the input.
+	 */
+	template<std::floating_point T>
+	class BVH {
+
+		public: static constexpr std::size_t max_depth = 64;
+
+		// Bins of the SAH build, per axis.
+		public: static constexpr std::size_t bins = 16;
+
+		public: struct alignas(8 * sizeof(T)) Node {
+			AABB<T> box;
+			std::uint32_t offset;		// Second child for interior nodes, first item for leaves.
+			std::uint16_t count;		// Items of a leaf. Zero for interior nodes.
+			std::uint16_t axis;			// Split axis of an interior node.
+		};
+
+		private: std::vector<Node> M_nodes;
+		private: std::vector<AABB<T>> M_boxes;
+		private: std::vector<std::uint32_t> M_indices;
+
+
+
+		public:
+		BVH() = default;
+
+		// Builds the hierarchy over 'count' boxes, with up to 'leaf_size' items per leaf.
+		public:
+		BVH(AABB<T> const* boxes, std::size_t count, std::size_t leaf_size = 4)
+		{ M_build(boxes, count, std::clamp<std::size_t>(leaf_size, 1, 255)); }
+
+		// Builds the hierarchy over 'count' points.
+		public:
+		BVH(Vec<T> const* points, std::size_t count, std::size_t leaf_size = 4) {
+			std::vector<AABB<T>> boxes(count);
+			for (std::size_t i = 0; i < count; ++i) boxes[i] = AABB<T>::of(points[i]);
+			M_build(boxes.data(), count, std::clamp<std::size_t>(leaf_size, 1, 255));
+		}
+
+		public: std::vector<Node> const&
+		nodes() const
+		noexcept { return M_nodes; }
+
+		public: std::size_t
+		size() const
+		noexcept { return M_indices.size(); }
+
+		// The box of all the items. Empty for an empty hierarchy.
+		public: AABB<T>
+		bounds() const
+		noexcept { return M_nodes.empty() ? AABB<T>() : M_nodes.front().box; }
+
+
+
+		// Calls f(index) for every item whose box overlaps 'box'.
+		public: template<typename F>
+		void
+		overlap(AABB<T> const& box, F&& f) const {
+			M_traverse(
+				[&](Node const& node) { return node.box.overlaps(box); },
+				[](Node const&) { return false; },
+				[&](std::uint32_t item) { if (M_boxes[item].overlaps(box)) f(M_indices[item]); });
+		}
+
+		// Calls f(index) for every item whose box comes within 'radius' of 'center'.
+		public: template<typename F>
+		void
+		radius(Vec<T> const& center, T radius, F&& f) const {
+			const T r2 = radius * radius;
+			M_traverse(
+				[&](Node const& node) { return node.box.distance2(center) <= r2; },
+				[](Node const&) { return false; },
+				[&](std::uint32_t item) { if (M_boxes[item].distance2(center) <= r2) f(M_indices[item]); });
+		}
+
+		/**
+		 * The first item along the ray from 'origin' in direction 'dir', up to parameter 't_max'.
+		 * intersect(index, origin, dir, t_max) returns the ray parameter at which it hits the item of that index,
+		 * or anything not below t_max for a miss. It is only called for items whose box the ray enters before t_max.
+		 */
+		public: template<typename F>
+		QueryHit<T>
+		ray(Vec<T> const& origin, Vec<T> const& dir, T t_max, F&& intersect) const
+		{ return M_ray(origin, dir, t_max, M_by_index(intersect)); }
+
+		// ray(), with the boxes themselves as the items.
+		public: QueryHit<T>
+		ray(Vec<T> const& origin, Vec<T> const& dir, T t_max = std::numeric_limits<T>::infinity()) const
+		{ return M_ray(origin, dir, t_max, M_box_entry()); }
+
+		/**
+		 * The item nearest to 'point', no further than sqrt(max_distance2). distance2(index, point) returns the squared
+		 * distance to the item of that index, which must not be below the squared distance to its box.
+		 */
+		public: template<typename F>
+		QueryHit<T>
+		nearest(Vec<T> const& point, F&& distance2, T max_distance2 = std::numeric_limits<T>::infinity()) const
+		{ return M_nearest(point, M_by_index(distance2), max_distance2); }
+
+		// nearest(), with the boxes themselves as the items: exact for hierarchies built over points.
+		public: QueryHit<T>
+		nearest(Vec<T> const& point, T max_distance2 = std::numeric_limits<T>::infinity()) const
+		{ return M_nearest(point, M_box_distance2(), max_distance2); }
+
+		// The ray query, with intersect() called by leaf order slot rather than by index.
+		private: template<typename F>
+		QueryHit<T>
+		M_ray(Vec<T> const& origin, Vec<T> const& dir, T t_max, F&& intersect) const {
+			const Vec<T> inv = detail::inverse(dir);
+			const std::array<bool, 3> negative = { dir.x < 0, dir.y < 0, dir.z < 0 };
+			QueryHit<T> hit;
+			hit.distance = t_max;
+			M_traverse(
+				[&](Node const& node) { return node.box.ray_entry(origin, inv, hit.distance) < hit.distance; },
+				[&](Node const& node) { return negative[node.axis]; },
+				[&](std::uint32_t item) {
+					if (!(M_boxes[item].ray_entry(origin, inv, hit.distance) < hit.distance)) return;
+					const T t = T(intersect(item, origin, dir, hit.distance));
+					if (t < hit.distance) hit = {M_indices[item], t};
+				});
+			if (!hit) hit.distance = std::numeric_limits<T>::infinity();
+			return hit;
+		}
+
+		// The nearest-neighbour query, with distance2() called by leaf order slot rather than by index.
+		private: template<typename F>
+		QueryHit<T>
+		M_nearest(Vec<T> const& point, F&& distance2, T max_distance2) const {
+			QueryHit<T> hit;
+			hit.distance = max_distance2;
+			if (M_nodes.empty() || !(M_nodes.front().box.distance2(point) <= hit.distance)) return QueryHit<T>();
+
+			// Nodes still to visit, with the distance to their box: by the time they are popped, the best hit may
+			// have come close enough to skip them without touching them.
+			std::array<std::pair<std::uint32_t, T>, max_depth> stack;
+			std::size_t top = 0;
+			std::uint32_t index = 0;
+			while (true) {
+				Node const& node = M_nodes[index];
+				if (node.count == 0) {
+					// Descend into the nearer child first: its hits shrink the search around the other one.
+					std::uint32_t near = index + 1, far = node.offset;
+					T d_near = M_nodes[near].box.distance2(point), d_far = M_nodes[far].box.distance2(point);
+					if (d_far < d_near) { std::swap(near, far); std::swap(d_near, d_far); }
+					if (d_near <= hit.distance) {
+						if (d_far <= hit.distance) stack[top++] = { far, d_far };
+						index = near;
+						continue;
+					}
+				}
+				else {
+					for (std::uint32_t item = node.offset; item < node.offset + node.count; ++item) {
+						if (!(M_boxes[item].distance2(point) <= hit.distance)) continue;
+						const T d = T(distance2(item, point));
+						if (d <= hit.distance && (d < hit.distance || !hit)) hit = {M_indices[item], d};
+					}
+				}
+				do {
+					if (top == 0) {
+						if (!hit) hit.distance = std::numeric_limits<T>::infinity();
+						return hit;
+					}
+					--top;
+				} while (!(stack[top].second <= hit.distance));
+				index = stack[top].first;
+			}
+		}
+
+
+
+		// Calls f(query, index) for every item whose box overlaps boxes[query], for 'count' queries.
+		public: template<typename F>
+		void
+		overlap(AABB<T> const* boxes, std::size_t count, F&& f) const {
+			for (std::size_t base = 0; base < count; base += packet_width) {
+				const std::size_t n = std::min(packet_width, count - base);
+				const auto lo = detail::gather<T>(n, [&](std::size_t l) { return boxes[base + l].lo; });
+				const auto hi = detail::gather<T>(n, [&](std::size_t l) { return boxes[base + l].hi; });
+				M_traverse_packet(
+					(1u << n) - 1,
+					[&](Node const& node) { return detail::lanes_overlap(node.box, lo, hi); },
+					[](Node const&, unsigned) { return false; },
+					[&](std::uint32_t item, std::size_t l) { if (M_boxes[item].overlaps(boxes[base + l])) f(base + l, M_indices[item]); });
+			}
+		}
+
+		// Calls f(query, index) for every item whose box comes within 'radius' of centers[query], for 'count' queries.
+		public: template<typename F>
+		void
+		radius(Vec<T> const* centers, T radius, std::size_t count, F&& f) const {
+			const T r2 = radius * radius;
+			alignas(64) std::array<T, packet_width> limit2;
+			limit2.fill(r2);
+			for (std::size_t base = 0; base < count; base += packet_width) {
+				const std::size_t n = std::min(packet_width, count - base);
+				const auto p = detail::gather<T>(n, [&](std::size_t l) { return centers[base + l]; });
+				M_traverse_packet(
+					(1u << n) - 1,
+					[&](Node const& node) { return detail::lanes_within(node.box, p, limit2.data()); },
+					[](Node const&, unsigned) { return false; },
+					[&](std::uint32_t item, std::size_t l) { if (M_boxes[item].distance2(centers[base + l]) <= r2) f(base + l, M_indices[item]); });
+			}
+		}
+
+		// ray() for 'count' rays, with their own origins and directions, into out[0, count).
+		public: template<typename F>
+		void
+		rays(Vec<T> const* origins, Vec<T> const* dirs, T t_max, std::size_t count, QueryHit<T>* out, F&& intersect) const
+		{ M_rays(origins, dirs, t_max, count, out, M_by_index(intersect)); }
+
+		// rays(), with the boxes themselves as the items.
+		public: void
+		rays(Vec<T> const* origins, Vec<T> const* dirs, T t_max, std::size_t count, QueryHit<T>* out) const
+		{ M_rays(origins, dirs, t_max, count, out, M_box_entry()); }
+
+		// nearest() for 'count' points, into out[0, count).
+		public: template<typename F>
+		void
+		nearest(Vec<T> const* points, std::size_t count, QueryHit<T>* out, F&& distance2, T max_distance2 = std::numeric_limits<T>::infinity()) const
+		{ M_nearest(points, count, out, M_by_index(distance2), max_distance2); }
+
+		// nearest() for 'count' points, with the boxes themselves as the items.
+		public: void
+		nearest(Vec<T> const* points, std::size_t count, QueryHit<T>* out, T max_distance2 = std::numeric_limits<T>::infinity()) const
+		{ M_nearest(points, count, out, M_box_distance2(), max_distance2); }
+
+
+
+		private: template<typename F>
+		void
+		M_rays(Vec<T> const* origins, Vec<T> const* dirs, T t_max, std::size_t count, QueryHit<T>* out, F&& intersect) const {
+			for (std::size_t base = 0; base < count; base += packet_width) {
+				const std::size_t n = std::min(packet_width, count - base);
+				const auto o = detail::gather<T>(n, [&](std::size_t l) { return origins[base + l]; });
+				const auto inv = detail::gather<T>(n, [&](std::size_t l) { return detail::inverse(dirs[base + l]); });
+				alignas(64) std::array<T, packet_width> best;
+				best.fill(t_max);
+				std::fill_n(out + base, n, QueryHit<T>());
+				M_traverse_packet(
+					(1u << n) - 1,
+					[&](Node const& node) { return detail::lanes_ray(node.box, o, inv, best.data()); },
+					[&](Node const& node, unsigned active) {
+						const std::size_t l = std::size_t(std::countr_zero(active));
+						return (node.axis == 0 ? inv.x[l] : node.axis == 1 ? inv.y[l] : inv.z[l]) < 0;
+					},
+					[&](std::uint32_t item, std::size_t l) {
+						const Vec<T> origin = origins[base + l], dir = dirs[base + l];
+						if (!(M_boxes[item].ray_entry(origin, detail::inverse(dir), best[l]) < best[l])) return;
+						const T t = T(intersect(item, origin, dir, best[l]));
+						if (t < best[l]) { best[l] = t; out[base + l] = {M_indices[item], t}; }
+					});
+			}
+		}
+
+		private: template<typename F>
+		void
+		M_nearest(Vec<T> const* points, std::size_t count, QueryHit<T>* out, F&& distance2, T max_distance2) const {
+			if (M_nodes.empty()) { std::fill_n(out, count, QueryHit<T>()); return; }
+			for (std::size_t base = 0; base < count; base += packet_width) {
+				const std::size_t n = std::min(packet_width, count - base);
+				const auto p = detail::gather<T>(n, [&](std::size_t l) { return points[base + l]; });
+				alignas(64) std::array<T, packet_width> best;
+				best.fill(max_distance2);
+				std::fill_n(out + base, n, QueryHit<T>());
+
+				// Lanes only prune by their own best distance: until a lane has one, the packet drags it through
+				// every node another lane enters. A greedy descent to the nearest leaf of each lane gives them all a
+				// good bound up front, for about the cost of a tree depth of box tests.
+				for (std::size_t l = 0; l < n; ++l) {
+					const Vec<T> q = points[base + l];
+					std::uint32_t index = 0;
+					while (M_nodes[index].count == 0) {
+						Node const& node = M_nodes[index];
+						index = M_nodes[node.offset].box.distance2(q) < M_nodes[index + 1].box.distance2(q) ? node.offset : index + 1;
+					}
+					Node const& leaf = M_nodes[index];
+					for (std::uint32_t item = leaf.offset; item < leaf.offset + leaf.count; ++item) {
+						const T d = T(distance2(item, q));
+						if (d <= best[l] && (d < best[l] || !out[base + l])) { best[l] = d; out[base + l] = {M_indices[item], d}; }
+					}
+				}
+
+				M_traverse_packet(
+					(1u << n) - 1,
+					[&](Node const& node) { return detail::lanes_within(node.box, p, best.data()); },
+					[&](Node const& node, unsigned active) {
+						const Vec<T> q = points[base + std::size_t(std::countr_zero(active))];
+						return M_nodes[node.offset].box.distance2(q) < (&node + 1)->box.distance2(q);
+					},
+					[&](std::uint32_t item, std::size_t l) {
+						const Vec<T> q = points[base + l];
+						if (!(M_boxes[item].distance2(q) <= best[l])) return;
+						const T d = T(distance2(item, q));
+						if (d <= best[l] && (d < best[l] || !out[base + l])) { best[l] = d; out[base + l] = {M_indices[item], d}; }
+					});
+			}
+		}
+
+		// A user callback taking an item index, as one taking its leaf order slot.
+		private: template<typename F>
+		auto
+		M_by_index(F& f) const
+		noexcept { return [this, &f](std::uint32_t item, auto const&... args) { return f(M_indices[item], args...); }; }
+
+		// Callbacks that treat the boxes as the items themselves.
+		private: auto
+		M_box_entry() const
+		noexcept {
+			return [this](std::uint32_t item, Vec<T> const& origin, Vec<T> const& dir, T t_max)
+			{ return M_boxes[item].ray_entry(origin, detail::inverse(dir), t_max); };
+		}
+
+		private: auto
+		M_box_distance2() const
+		noexcept { return [this](std::uint32_t item, Vec<T> const& point) { return M_boxes[item].distance2(point); }; }
+
+		/**
+		 * Depth first walk. enter(node) says whether to look into a node; swap(node) whether to visit the second child
+		 * of an interior node first; visit(item) is called for the items of every leaf entered, by their leaf order slot.
+		 */
+		private: template<typename Enter, typename Swap, typename Visit>
+		void
+		M_traverse(Enter&& enter, Swap&& swap, Visit&& visit) const {
+			if (M_nodes.empty()) return;
+			std::array<std::uint32_t, max_depth> stack;
+			std::size_t top = 0;
+			std::uint32_t index = 0;
+			while (true) {
+				Node const& node = M_nodes[index];
+				if (enter(node)) {
+					if (node.count == 0) {
+						const bool far_first = swap(node);
+						stack[top++] = far_first ? index + 1 : node.offset;
+						index = far_first ? node.offset : index + 1;
+						continue;
+					}
+					for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i) visit(i);
+				}
+				if (top == 0) return;
+				index = stack[--top];
+			}
+		}
+
+		// M_traverse() for a packet: enter(node) returns the lanes to look into it with, visit(item, lane) is per lane.
+		private: template<typename Enter, typename Swap, typename Visit>
+		void
+		M_traverse_packet(unsigned lanes, Enter&& enter, Swap&& swap, Visit&& visit) const {
+			if (M_nodes.empty()) return;
+			std::array<std::pair<std::uint32_t, unsigned>, max_depth> stack;
+			std::size_t top = 0;
+			std::uint32_t index = 0;
+			while (true) {
+				Node const& node = M_nodes[index];
+				const unsigned active = enter(node) & lanes;
+				if (active != 0) {
+					if (node.count == 0) {
+						const bool far_first = swap(node, active);
+						stack[top++] = { far_first ? index + 1 : node.offset, active };
+						index = far_first ? node.offset : index + 1;
+						lanes = active;
+						continue;
+					}
+					for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i)
+						for (unsigned m = active; m != 0; m &= m - 1) visit(i, std::size_t(std::countr_zero(m)));
+				}
+				if (top == 0) return;
+				std::tie(index, lanes) = stack[--top];
+			}
+		}
+
+
+
+		private: struct BuildTask {
+			std::uint32_t begin, end;
+			std::uint32_t parent;		// Interior node whose second child this is, or 'none'.
+			std::uint32_t depth;
+		};
+
+		private: void
+		M_build(AABB<T> const* boxes, std::size_t count, std::size_t leaf_size) {
+			M_indices.resize(count);
+			for (std::size_t i = 0; i < count; ++i) M_indices[i] = std::uint32_t(i);
+			if (count == 0) return;
+
+			std::vector<Vec<T>> centers(count);
+			for (std::size_t i = 0; i < count; ++i) centers[i] = boxes[i].center();
+
+			M_nodes.reserve(2 * (count / leaf_size) + 1);
+			constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+			std::vector<BuildTask> tasks{ BuildTask{0, std::uint32_t(count), none, 0} };
+
+			while (!tasks.empty()) {
+				const BuildTask task = tasks.back();
+				tasks.pop_back();
+
+				const std::uint32_t index = std::uint32_t(M_nodes.size());
+				if (task.parent != none) M_nodes[task.parent].offset = index;
+				M_nodes.push_back(Node{AABB<T>(), task.begin, std::uint16_t(task.end - task.begin), 0});
+
+				AABB<T> box, centroids;
+				for (std::uint32_t i = task.begin; i < task.end; ++i) {
+					box.grow(boxes[M_indices[i]]);
+					centroids.grow(centers[M_indices[i]]);
+				}
+				M_nodes[index].box = box;
+
+				const std::size_t n = task.end - task.begin;
+				if (n <= leaf_size) continue;
+				std::uint32_t mid = M_split(boxes, centers, task, centroids);
+				// Items whose centroids all coincide can be split anywhere.
+				if (mid == task.begin) mid = task.begin + std::uint32_t(n / 2);
+
+				M_nodes[index].count = 0;
+				M_nodes[index].axis = std::uint16_t(M_largest_axis(centroids));
+				tasks.push_back(BuildTask{mid, task.end, index, task.depth + 1});
+				tasks.push_back(BuildTask{task.begin, mid, none, task.depth + 1});
+			}
+
+			M_boxes.resize(count);
+			for (std::size_t i = 0; i < count; ++i) M_boxes[i] = boxes[M_indices[i]];
+		}
+
+		private: static std::size_t
+		M_largest_axis(AABB<T> const& box)
+		noexcept {
+			const Vec<T> e = box.extent();
+			return e.x >= e.y && e.x >= e.z ? 0 : e.y >= e.z ? 1 : 2;
+		}
+
+		private: static T
+		M_axis(Vec<T> const& v, std::size_t axis)
+		noexcept { return axis == 0 ? v.x : axis == 1 ? v.y : v.z; }
+
+		/**
+		 * Partitions the items of 'task' along the cheapest binned SAH split, and returns where the second half begins,
+		 * or task.begin when their centroids cannot be told apart.
+		 * Past half of max_depth, splits at the median instead: 32 more levels of halving cover any 32 bit count of items,
+		 * so the depth never exceeds max_depth.
+		 */
+		private: std::uint32_t
+		M_split(AABB<T> const* boxes, std::vector<Vec<T>> const& centers, BuildTask const& task, AABB<T> const& centroids) {
+			const std::size_t n = task.end - task.begin;
+			const std::size_t axis = M_largest_axis(centroids);
+			const T lo = M_axis(centroids.lo, axis), hi = M_axis(centroids.hi, axis);
+			if (!(lo < hi)) return task.begin;
+
+			auto first = M_indices.begin() + task.begin, last = M_indices.begin() + task.end;
+			auto key = [&](std::uint32_t i) { return M_axis(centers[i], axis); };
+
+			if (task.depth >= max_depth / 2) {
+				auto middle = first + std::ptrdiff_t(n / 2);
+				std::nth_element(first, middle, last, [&](std::uint32_t a, std::uint32_t b) { return key(a) < key(b); });
+				return task.begin + std::uint32_t(n / 2);
+			}
+
+			struct Bin { AABB<T> box; std::size_t count = 0; };
+			std::array<Bin, bins> bin{};
+			const T scale = T(bins) / (hi - lo);
+			auto bin_of = [&](std::uint32_t i) { return std::min(bins - 1, std::size_t((key(i) - lo) * scale)); };
+			for (auto it = first; it != last; ++it) {
+				Bin& b = bin[bin_of(*it)];
+				b.box.grow(boxes[*it]);
+				++b.count;
+			}
+
+			// Cost of each split plane, from a sweep from the right and one from the left.
+			std::array<T, bins - 1> right_cost;
+			AABB<T> acc;
+			std::size_t acc_count = 0;
+			for (std::size_t b = bins - 1; b > 0; --b) {
+				acc.grow(bin[b].box);
+				acc_count += bin[b].count;
+				right_cost[b - 1] = acc.surface_area() * T(acc_count);
+			}
+			acc = AABB<T>();
+			acc_count = 0;
+			T best_cost = std::numeric_limits<T>::infinity();
+			std::size_t best = 0;
+			for (std::size_t b = 0; b + 1 < bins; ++b) {
+				acc.grow(bin[b].box);
+				acc_count += bin[b].count;
+				const T cost = acc.surface_area() * T(acc_count) + right_cost[b];
+				if (acc_count != 0 && acc_count != n && cost < best_cost) { best_cost = cost; best = b; }
+			}
+
+			if (best_cost == std::numeric_limits<T>::infinity()) return task.begin;
+
+			auto middle = std::partition(first, last, [&](std::uint32_t i) { return bin_of(i) <= best; });
+			return task.begin + std::uint32_t(middle - first);
+		}
+
+	};
+
+
+
+	/**
+	 * Uniform grid of cubic cells over points, stored as a hash table: only the cells that hold points take memory.
+	 *
+	 * Cells are hashed with spatial_hash() into a power of two number of buckets, about one per point, and the points
+	 * are stored sorted by bucket in a single array, along with their cell. A query visits every cell its range covers, and checks each point of
+	 * those cells' buckets exactly, so hash collisions cost time but never give wrong results.
+	 * Queries are cheapest when their radius is about the size of a cell.
+	 */
+	template<std::floating_point T>
+	class HashGrid {
+
+		private: T M_cell_size = T(1);
+		private: Vec<std::int32_t> M_cells_lo, M_cells_hi;		// Bounds of the cells that hold points.
+		private: std::uint32_t M_mask = 0;
+		private: std::vector<std::uint32_t> M_start;
+		private: std::vector<Vec<T>> M_points;
+		private: std::vector<Vec<std::int32_t>> M_point_cells;
+		private: std::vector<std::uint32_t> M_indices;
+
+
+
+		public:
+		HashGrid() = default;
+
+		public:
+		HashGrid(Vec<T> const* points, std::size_t count, T cell_size)
+		: M_cell_size(cell_size) {
+			const std::size_t buckets = std::bit_ceil(std::max<std::size_t>(count, 1));
+			M_mask = std::uint32_t(buckets - 1);
+
+			std::vector<Vec<std::int32_t>> cells(count);
+			std::vector<std::uint32_t> hashes(count);
+			if constexpr(std::same_as<T, float>) simd::to_cell(points, cell_size, cells.data(), count);
+			else for (std::size_t i = 0; i < count; ++i) cells[i] = to_cell(points[i], cell_size);
+			simd::spatial_hash(cells.data(), hashes.data(), count);
+			for (std::size_t i = 0; i < count; ++i) {
+				M_cells_lo = i ? min(M_cells_lo, cells[i]) : cells[i];
+				M_cells_hi = i ? max(M_cells_hi, cells[i]) : cells[i];
+			}
+
+			// Counting sort by bucket.
+			M_start.assign(buckets + 1, 0);
+			for (std::size_t i = 0; i < count; ++i) ++M_start[(hashes[i] & M_mask) + 1];
+			for (std::size_t b = 0; b < buckets; ++b) M_start[b + 1] += M_start[b];
+			std::vector<std::uint32_t> fill(M_start.begin(), M_start.end() - 1);
+			M_points.resize(count);
+			M_point_cells.resize(count);
+			M_indices.resize(count);
+			for (std::size_t i = 0; i < count; ++i) {
+				const std::uint32_t slot = fill[hashes[i] & M_mask]++;
+				M_points[slot] = points[i];
+				M_point_cells[slot] = cells[i];
+				M_indices[slot] = std::uint32_t(i);
+			}
+		}
+
+		public: T
+		cell_size() const
+		noexcept { return M_cell_size; }
+
+		public: std::size_t
+		size() const
+		noexcept { return M_points.size(); }
+
+		// Calls f(index) for every point within 'radius' of 'center'.
+		public: template<typename F>
+		void
+		radius(Vec<T> const& center, T radius, F&& f) const {
+			const T r2 = radius * radius;
+			M_cells(AABB<T>::of(center, radius), [&](std::uint32_t slot) {
+				if ((M_points[slot] - center).mag2() <= r2) f(M_indices[slot]);
+			});
+		}
+
+		// Calls f(index) for every point inside 'box'.
+		public: template<typename F>
+		void
+		overlap(AABB<T> const& box, F&& f) const {
+			M_cells(box, [&](std::uint32_t slot) { if (box.contains(M_points[slot])) f(M_indices[slot]); });
+		}
+
+		/**
+		 * The point nearest to 'point', no further than 'max_radius'. Searches cells in rings of growing distance around
+		 * the cell of 'point', and stops as soon as no further ring can hold anything nearer, or past the last ring
+		 * that reaches a cell holding points: any 'max_radius', infinity included, is fine.
+		 */
+		public: QueryHit<T>
+		nearest(Vec<T> const& point, T max_radius) const {
+			QueryHit<T> hit;
+			hit.distance = max_radius * max_radius;
+			if (M_points.empty()) return QueryHit<T>();
+			const Vec<std::int32_t> c = to_cell(point, M_cell_size);
+			const std::int64_t reach_cells = std::max({
+				std::int64_t(c.x) - M_cells_lo.x, std::int64_t(M_cells_hi.x) - c.x,
+				std::int64_t(c.y) - M_cells_lo.y, std::int64_t(M_cells_hi.y) - c.y,
+				std::int64_t(c.z) - M_cells_lo.z, std::int64_t(M_cells_hi.z) - c.z,
+			});
+			// Compared as T before the cast, which is undefined for values out of range.
+			const std::int32_t last = std::int32_t(std::min<std::int64_t>(reach_cells, std::numeric_limits<std::int32_t>::max() - 1));
+			const T wanted = max_radius / M_cell_size;
+			const std::int32_t rings = !(wanted >= T(0)) ? 0 : wanted < T(last) ? std::int32_t(wanted) + 1 : last;
+			for (std::int32_t k = 0; k <= rings; ++k) {
+				M_ring(c, k, [&](std::uint32_t slot) {
+					const T d = (M_points[slot] - point).mag2();
+					if (d <= hit.distance && (d < hit.distance || !hit)) hit = {M_indices[slot], d};
+				});
+				// Every cell of the next rings is at least k cells away.
+				const T reach = T(k) * M_cell_size;
+				if (hit && hit.distance <= reach * reach) break;
+			}
+			if (!hit) hit.distance = std::numeric_limits<T>::infinity();
+			return hit;
+		}
+
+		// Calls f(query, index) for every point within 'radius' of centers[query], for 'count' queries.
+		public: template<typename F>
+		void
+		radius(Vec<T> const* centers, T radius, std::size_t count, F&& f) const {
+			for (std::size_t q = 0; q < count; ++q)
+				this->radius(centers[q], radius, [&](std::uint32_t index) { f(q, index); });
+		}
+
+		// Calls f(query, index) for every point inside boxes[query], for 'count' queries.
+		public: template<typename F>
+		void
+		overlap(AABB<T> const* boxes, std::size_t count, F&& f) const {
+			for (std::size_t q = 0; q < count; ++q)
+				overlap(boxes[q], [&](std::uint32_t index) { f(q, index); });
+		}
+
+		// nearest() for 'count' points, into out[0, count).
+		public: void
+		nearest(Vec<T> const* points, std::size_t count, QueryHit<T>* out, T max_radius) const {
+			for (std::size_t q = 0; q < count; ++q) out[q] = nearest(points[q], max_radius);
+		}
+
+
+
+		// Calls visit(slot) for every point of the given cell.
+		private: template<typename Visit>
+		void
+		M_cell(Vec<std::int32_t> const& cell, Visit& visit) const {
+			const std::uint32_t bucket = spatial_hash(cell) & M_mask;
+			for (std::uint32_t slot = M_start[bucket]; slot < M_start[bucket + 1]; ++slot) {
+				// Points of other cells share the bucket: only those of this cell count.
+				if (all(M_point_cells[slot] == cell)) visit(slot);
+			}
+		}
+
+		// Calls visit(slot) for every point of the cells that 'box' covers.
+		private: template<typename Visit>
+		void
+		M_cells(AABB<T> const& box, Visit&& visit) const {
+			if (M_points.empty() || box.empty()) return;
+			const Vec<std::int32_t> lo = to_cell(box.lo, M_cell_size), hi = to_cell(box.hi, M_cell_size);
+			for (std::int32_t z = lo.z; z <= hi.z; ++z)
+				for (std::int32_t y = lo.y; y <= hi.y; ++y)
+					for (std::int32_t x = lo.x; x <= hi.x; ++x)
+						M_cell(Vec<std::int32_t>(x, y, z), visit);
+		}
+
+		// Calls visit(slot) for every point of the cells at Chebyshev distance exactly 'k' from 'center'.
+		private: template<typename Visit>
+		void
+		M_ring(Vec<std::int32_t> const& center, std::int32_t k, Visit&& visit) const {
+			for (std::int32_t dz = -k; dz <= k; ++dz)
+				for (std::int32_t dy = -k; dy <= k; ++dy) {
+					// Inside the ring, only the two end cells of each row lie on it.
+					const bool edge = dz == -k || dz == k || dy == -k || dy == k;
+					for (std::int32_t dx = -k; dx <= k; dx += (edge || k == 0) ? 1 : 2 * k)
+						M_cell(center + Vec<std::int32_t>(dx, dy, dz), visit);
+				}
+		}
+
+	};
+
+}
+
+namespace ink {
+
+	using generic_vec::AABB;
+	using generic_vec::BVH;
+	using generic_vec::HashGrid;
+	using generic_vec::QueryHit;
+
+}
+
+#endif
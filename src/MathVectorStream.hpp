@@ -0,0 +1,445 @@
+#ifndef INK_GENERIC_VEC_STREAM_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_STREAM_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <future>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MathVector.hpp"
+#include "MathVectorFile.hpp"
+#include "MathVectorMask.hpp"
+#include "MathVectorSum.hpp"
+
+/*
+ * Streaming pipelines over arrays of Vec too large for memory, one fixed-size chunk at a time.
+ *
+ * stream<X, Y, Z>(path) reads a file of MathVectorFile.hpp in chunks of about 'chunk_bytes', and stream(span) does the
+ * same for vectors already mapped into memory, as those of a VecFile. Stages chain onto the stream and run on each chunk
+ * in turn, in place, in the order they were added:
+ * - map(f) replaces every vector v by f(v), of the same type.
+ * - apply(f) calls f on the whole chunk, as a std::span<Vec>, for the batched algorithms of simd:: and parallel::.
+ * - filter(p) keeps the vectors for which p(v) holds, and filter_all() / filter_any() those that compare to a vector as
+ *   given, through the batched comparison masks of MathVectorMask.hpp.
+ * A terminal operation then runs the stream: reduce(), sum(), count(), for_each(), for_each_chunk(), to_vector(), or
+ * save() to write the result to a file, chunk by chunk.
+ *
+ *     const auto centroid = stream<float>("points.vec")
+ *         .apply([&](std::span<Vec<float>> c) { simd::transform_points(m, c.data(), c.data(), c.size()); })
+ *         .filter_all(std::greater_equal<>(), lo)
+ *         .sum();
+ *
+ * While the stages run on one chunk, the next is read on another thread, so that reading overlaps computing. Memory
+ * stays bounded by the chunk size whatever the size of the file: two chunks of vectors, plus one more of raw bytes for
+ * files whose layout or byte order differs from this machine's. Streams over a mapping only bound the memory they
+ * allocate: the pages of the mapping stay cached for as long as the system sees fit.
+ *
+ * Stages are added to a stream as an rvalue, as in the chain above: std::move() a stream held in a variable.
+ */
+namespace ink::generic_vec {
+
+	namespace detail {
+
+		// Amount of data, in bytes, that a chunk covers unless told otherwise.
+		inline constexpr std::size_t stream_chunk_bytes = 16u << 20;
+
+		// Reads 'size' bytes at 'offset' in 'file'. A file that ends before them was cut short since its header was read.
+		inline void
+		read_at(std::FILE* file, std::uint64_t offset, void* out, std::size_t size, char const* path) {
+			#if defined(_WIN32)
+			const int seek = _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+			#else
+			const int seek = ::fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+			#endif
+			if (seek != 0) throw_errno("cannot seek in", path);
+			if (size != 0 && std::fread(out, 1, size, file) != size) {
+				if (std::ferror(file)) throw_errno("cannot read from", path);
+				throw FileError(std::string("'") + path + "' ends before its last vector");
+			}
+		}
+
+		// Axis 'axis' of 'vec', for writing to.
+		template<std::size_t axis, typename V>
+		constexpr auto&
+		axis_ref(V& vec)
+		noexcept {
+			if		constexpr(axis == 0) return vec.x;
+			else if	constexpr(axis == 1) return vec.y;
+			else return vec.z;
+		}
+
+		/**
+		 * The vectors of a file of MathVectorFile.hpp, read in chunks with plain reads into memory the stream owns.
+		 * A file of this machine's layout is read straight into the chunk, any other through one chunk of raw bytes.
+		 */
+		template<typename X, typename Y, typename Z>
+		class FileChunks {
+
+			public: using value_type = Vec<X, Y, Z>;
+
+			private: std::string M_path;
+			private: FilePtr M_file;
+			private: bool M_native = true;
+			private: FileHeader M_header{};
+			private: std::vector<unsigned char> M_raw;
+
+			public: explicit
+			FileChunks(char const* path)
+			: M_path(path), M_file(std::fopen(path, "rb")) {
+				if (!M_file) throw_errno("cannot open", path);
+				#if defined(_WIN32)
+				const bool ended = _fseeki64(M_file.get(), 0, SEEK_END) == 0;
+				const std::int64_t size = ended ? _ftelli64(M_file.get()) : -1;
+				#else
+				const bool ended = ::fseeko(M_file.get(), 0, SEEK_END) == 0;
+				const std::int64_t size = ended ? std::int64_t(::ftello(M_file.get())) : -1;
+				#endif
+				if (size < 0) throw_errno("cannot read the size of", path);
+				unsigned char bytes[sizeof(FileHeader)] = {};
+				read_at(M_file.get(), 0, bytes, std::min<std::size_t>(sizeof(bytes), std::size_t(size)), path);
+				M_header = read_header<X, Y, Z>(bytes, std::uint64_t(size), path, M_native);
+			}
+
+			public: std::size_t
+			size() const
+			noexcept { return std::size_t(M_header.count); }
+
+			// Vectors [begin, begin + count) of the file into 'out'.
+			public: void
+			read(std::size_t begin, std::size_t count, value_type* out) {
+				if (count == 0) return;
+				if (contiguous_records<X, Y, Z>(M_header, M_native)) {
+					read_at(M_file.get(), M_header.data + begin * sizeof(value_type), out, M_records_bytes(count), M_path.c_str());
+				} else if (M_header.layout == FileLayout::Interleaved) {
+					M_raw.resize(M_records_bytes(count));
+					read_at(M_file.get(), M_header.data + begin * M_header.record_size, M_raw.data(), M_raw.size(), M_path.c_str());
+					M_decode<X, 0>(M_raw.data() + M_header.offset[0], out, count);
+					M_decode<Y, 1>(M_raw.data() + M_header.offset[1], out, count);
+					M_decode<Z, 2>(M_raw.data() + M_header.offset[2], out, count);
+				} else {
+					M_read_lane<X, 0>(begin, count, out);
+					M_read_lane<Y, 1>(begin, count, out);
+					M_read_lane<Z, 2>(begin, count, out);
+				}
+			}
+
+			// The bytes that 'count' interleaved records cover: the file may end with the last axis of its last record.
+			private: std::size_t
+			M_records_bytes(std::size_t count) const
+			noexcept {
+				constexpr std::uint64_t sizes[3] = { axis_size<X>(), axis_size<Y>(), axis_size<Z>() };
+				std::uint64_t end = 0;
+				for (std::size_t a = 0; a < 3; ++a)
+					if (sizes[a] != 0) end = std::max(end, M_header.offset[a] + sizes[a]);
+				return (count - 1) * std::size_t(M_header.record_size) + std::size_t(end);
+			}
+
+			private: template<typename T, std::size_t axis>
+			void
+			M_read_lane(std::size_t begin, std::size_t count, value_type* out) {
+				if constexpr(!std::is_void_v<T>) {
+					M_raw.resize(count * sizeof(T));
+					read_at(M_file.get(), M_header.offset[axis] + begin * sizeof(T), M_raw.data(), M_raw.size(), M_path.c_str());
+					M_decode<T, axis>(M_raw.data(), out, count);
+				}
+			}
+
+			// Axis 'axis' of 'count' vectors from raw bytes, one every axis_stride<T>() of them.
+			private: template<typename T, std::size_t axis>
+			void
+			M_decode(unsigned char const* raw, value_type* out, std::size_t count)
+			noexcept {
+				if constexpr(!std::is_void_v<T>) {
+					const std::ptrdiff_t stride = axis_stride<T>(M_header);
+					for (std::size_t i = 0; i < count; ++i) axis_ref<axis>(out[i]) = read_element<T>(raw + std::ptrdiff_t(i) * stride, M_native);
+				}
+			}
+
+		};
+
+		// Vectors already in memory, as the mapping of a VecFile, copied out one chunk at a time.
+		template<typename V>
+		class SpanChunks {
+
+			public: using value_type = V;
+
+			private: std::span<V const> M_vecs;
+
+			public: explicit
+			SpanChunks(std::span<V const> vecs)
+			noexcept: M_vecs(vecs) {}
+
+			public: std::size_t
+			size() const
+			noexcept { return M_vecs.size(); }
+
+			public: void
+			read(std::size_t begin, std::size_t count, V* out)
+			noexcept { std::copy_n(M_vecs.data() + begin, count, out); }
+
+		};
+
+		// The header of an interleaved file of Vec<X, Y, Z>, before its vectors are counted.
+		template<typename X, typename Y, typename Z>
+		requires file_vec<X, Y, Z>
+		inline FileHeader
+		interleaved_header(std::type_identity<Vec<X, Y, Z>>)
+		noexcept { return make_header<X, Y, Z>(FileLayout::Interleaved, 0); }
+
+		// Stages of a Stream: each one takes a chunk and returns what is left of it, in place.
+
+		template<typename F>
+		struct MapStage {
+			F f;
+			template<typename V> std::span<V> operator()(std::span<V> chunk) { for (V& v : chunk) v = f(std::as_const(v)); return chunk; }
+		};
+
+		template<typename F>
+		struct ApplyStage {
+			F f;
+			template<typename V> std::span<V> operator()(std::span<V> chunk) { f(chunk); return chunk; }
+		};
+
+		// Moves every vector that passes over the ones that do not, without branching on which.
+		template<typename P>
+		struct FilterStage {
+			P p;
+			template<typename V>
+			std::span<V>
+			operator()(std::span<V> chunk) {
+				std::size_t kept = 0;
+				for (std::size_t i = 0; i < chunk.size(); ++i) {
+					const bool keep = bool(p(std::as_const(chunk[i])));
+					chunk[kept] = chunk[i];
+					kept += keep;
+				}
+				return chunk.first(kept);
+			}
+		};
+
+		// Keeps the vectors whose comparison to 'rhs' holds on all axes, or any, from the bits of a batched comparison.
+		template<bool all, typename Cmp, typename T>
+		struct MaskStage {
+			Cmp cmp;
+			Vec<T> rhs;
+			std::vector<std::uint64_t> bits;
+
+			std::span<Vec<T>>
+			operator()(std::span<Vec<T>> chunk) {
+				bits.resize((chunk.size() + 63) / 64);
+				if constexpr(all) simd::mask_all(chunk.data(), rhs, cmp, bits.data(), chunk.size());
+				else simd::mask_any(chunk.data(), rhs, cmp, bits.data(), chunk.size());
+				std::size_t kept = 0;
+				for (std::size_t w = 0; w < bits.size(); ++w)
+					for (std::uint64_t word = bits[w]; word != 0; word &= word - 1)
+						chunk[kept++] = chunk[64 * w + std::size_t(std::countr_zero(word))];
+				return chunk.first(kept);
+			}
+		};
+
+	}
+
+	/**
+	 * A chain of stages over the vectors of 'Source', run one chunk at a time by a terminal operation, while the next
+	 * chunk is read. See the top of this file.
+	 */
+	template<typename Source, typename... Stages>
+	class Stream {
+
+		template<typename, typename...> friend class Stream;
+
+		public: using value_type = typename Source::value_type;
+
+		private: Source M_source;
+		private: std::size_t M_chunk;
+		private: std::tuple<Stages...> M_stages;
+
+		// A stream of chunks of about 'chunk_bytes', but never less than one vector.
+		public: explicit
+		Stream(Source source, std::size_t chunk_bytes = detail::stream_chunk_bytes, std::tuple<Stages...> stages = {})
+		: M_source(std::move(source)), M_chunk(std::max<std::size_t>(1, chunk_bytes / sizeof(value_type))), M_stages(std::move(stages)) {}
+
+		// The number of vectors the source holds, before any stage.
+		public: std::size_t
+		source_size() const
+		noexcept { return M_source.size(); }
+
+		// The number of vectors in a chunk.
+		public: std::size_t
+		chunk_size() const
+		noexcept { return M_chunk; }
+
+		// Replaces every vector v by f(v).
+		public: template<typename F>
+		requires requires(value_type& v, F& f) { {v = f(std::as_const(v))}; }
+		auto
+		map(F f) &&
+		{ return M_then(detail::MapStage<F>{ std::move(f) }); }
+
+		// Calls f on each whole chunk, as a std::span<value_type> it may change in place.
+		public: template<typename F>
+		requires std::invocable<F&, std::span<value_type>>
+		auto
+		apply(F f) &&
+		{ return M_then(detail::ApplyStage<F>{ std::move(f) }); }
+
+		// Keeps the vectors v for which p(v) holds.
+		public: template<typename P>
+		requires requires(value_type const& v, P& p) { {bool(p(v))}; }
+		auto
+		filter(P p) &&
+		{ return M_then(detail::FilterStage<P>{ std::move(p) }); }
+
+		// Keeps the vectors v for which cmp(v, rhs) holds on every axis. 'cmp' is one of std::less<> and the like.
+		public: template<typename Cmp, std::floating_point T>
+		requires(std::same_as<value_type, Vec<T>> && simd::detail::is_comparison<Cmp>)
+		auto
+		filter_all(Cmp cmp, Vec<T> const& rhs) &&
+		{ return M_then(detail::MaskStage<true, Cmp, T>{ cmp, rhs, {} }); }
+
+		// Keeps the vectors v for which cmp(v, rhs) holds on some axis.
+		public: template<typename Cmp, std::floating_point T>
+		requires(std::same_as<value_type, Vec<T>> && simd::detail::is_comparison<Cmp>)
+		auto
+		filter_any(Cmp cmp, Vec<T> const& rhs) &&
+		{ return M_then(detail::MaskStage<false, Cmp, T>{ cmp, rhs, {} }); }
+
+		// Calls f on what is left of each chunk after the stages, as a std::span<value_type const>.
+		public: template<typename F>
+		requires std::invocable<F&, std::span<value_type const>>
+		void
+		for_each_chunk(F f)
+		{ M_run(f); }
+
+		// Calls f on every vector left after the stages.
+		public: template<typename F>
+		requires std::invocable<F&, value_type const&>
+		void
+		for_each(F f)
+		{ M_run([&](std::span<value_type const> chunk) { for (value_type const& v : chunk) f(v); }); }
+
+		// init, reduced in order with every vector left after the stages: acc = op(acc, v).
+		public: template<typename T, typename Op>
+		requires requires(T& acc, value_type const& v, Op& op) { {acc = op(std::move(acc), v)}; }
+		T
+		reduce(T init, Op op) {
+			M_run([&](std::span<value_type const> chunk) { for (value_type const& v : chunk) init = op(std::move(init), v); });
+			return init;
+		}
+
+		// The number of vectors left after the stages.
+		public: std::size_t
+		count() {
+			std::size_t n = 0;
+			M_run([&](std::span<value_type const> chunk) { n += chunk.size(); });
+			return n;
+		}
+
+		// Sum of the vectors left after the stages. Each chunk, and then the chunk sums, are accumulated as 'mode' says.
+		public: template<Summation mode = Summation::Pairwise>
+		requires requires(value_type const* in) { {generic_vec::sum<mode>(in, std::size_t())}; }
+		value_type
+		sum() {
+			std::vector<value_type> sums;
+			M_run([&](std::span<value_type const> chunk) { sums.push_back(generic_vec::sum<mode>(chunk.data(), chunk.size())); });
+			return generic_vec::sum<mode>(sums.data(), sums.size());
+		}
+
+		// The vectors left after the stages, in memory: only bounded by how many of them pass the filters.
+		public: std::vector<value_type>
+		to_vector() {
+			std::vector<value_type> out;
+			M_run([&](std::span<value_type const> chunk) { out.insert(out.end(), chunk.begin(), chunk.end()); });
+			return out;
+		}
+
+		// Writes the vectors left after the stages to a new file at 'path', interleaved, as save() does.
+		public: void
+		save(char const* path)
+		requires requires { {detail::interleaved_header(std::type_identity<value_type>())}; }
+		{
+			detail::FileHeader header = detail::interleaved_header(std::type_identity<value_type>());
+			detail::FilePtr file = detail::open_for_writing(path);
+			std::uint64_t position = sizeof(header);
+			detail::write_bytes(file.get(), &header, sizeof(header), path);
+			detail::pad_to(file.get(), position, header.data, path);
+			M_run([&](std::span<value_type const> chunk) {
+				detail::write_bytes(file.get(), chunk.data(), chunk.size_bytes(), path);
+				header.count += chunk.size();
+			});
+			// The count is only known now.
+			if (std::fseek(file.get(), 0, SEEK_SET) != 0) detail::throw_errno("cannot seek in", path);
+			detail::write_bytes(file.get(), &header, sizeof(header), path);
+			detail::close_written(std::move(file), path);
+		}
+
+		private: template<typename Stage>
+		Stream<Source, Stages..., Stage>
+		M_then(Stage stage) {
+			return Stream<Source, Stages..., Stage>(std::move(M_source), M_chunk * sizeof(value_type),
+				std::tuple_cat(std::move(M_stages), std::tuple<Stage>(std::move(stage))));
+		}
+
+		// Runs every stage on each chunk in turn, and hands what is left to 'sink', while the next chunk is read.
+		private: template<typename Sink>
+		void
+		M_run(Sink&& sink) {
+			const std::size_t total = M_source.size();
+			if (total == 0) return;
+
+			std::vector<value_type> buffers[2] = { std::vector<value_type>(std::min(M_chunk, total)), std::vector<value_type>(std::min(M_chunk, total)) };
+			const auto fetch = [this, total](std::size_t begin, value_type* out) {
+				return std::async(std::launch::async, [this, total, begin, out] {
+					const std::size_t count = std::min(M_chunk, total - begin);
+					M_source.read(begin, count, out);
+					return count;
+				});
+			};
+
+			// Declared after the buffers, so that a read still running when a stage throws finishes before they go.
+			std::future<std::size_t> pending = fetch(0, buffers[0].data());
+			for (std::size_t begin = 0, k = 0; begin < total; k ^= 1) {
+				const std::size_t count = pending.get();
+				if (begin + count < total) pending = fetch(begin + count, buffers[k ^ 1].data());
+
+				std::span<value_type> chunk(buffers[k].data(), count);
+				std::apply([&](auto&... stage) { ((chunk = stage(chunk)), ...); }, M_stages);
+				sink(std::span<value_type const>(chunk));
+				begin += count;
+			}
+		}
+
+	};
+
+	// Streams the vectors of the file at 'path', in chunks of about 'chunk_bytes'. Throws as VecFile does.
+	template<typename X, typename Y = X, typename Z = Y>
+	requires detail::file_vec<X, Y, Z>
+	inline Stream<detail::FileChunks<X, Y, Z>>
+	stream(char const* path, std::size_t chunk_bytes = detail::stream_chunk_bytes)
+	{ return Stream<detail::FileChunks<X, Y, Z>>(detail::FileChunks<X, Y, Z>(path), chunk_bytes); }
+
+	// Streams vectors in memory, such as VecFile::vecs(), in chunks of about 'chunk_bytes'. They must outlive the stream.
+	template<typename X, typename Y, typename Z>
+	inline Stream<detail::SpanChunks<Vec<X, Y, Z>>>
+	stream(std::span<Vec<X, Y, Z> const> vecs, std::size_t chunk_bytes = detail::stream_chunk_bytes)
+	{ return Stream<detail::SpanChunks<Vec<X, Y, Z>>>(detail::SpanChunks<Vec<X, Y, Z>>(vecs), chunk_bytes); }
+
+}
+
+namespace ink {
+
+	using generic_vec::Stream;
+	using generic_vec::stream;
+
+}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef INK_GENERIC_VEC_SUM_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_SUM_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <array>
+#include <concepts>
+#include <type_traits>
+#include "MathVector.hpp"
+
+namespace ink {
+
+	namespace generic_vec {
+
+		/**
+		 * How sum() accumulates, from fastest to most accurate. All of them run at about the same speed once the data
+		 * comes from beyond L2; for n floating point vectors, the error of each axis grows as:
+		 * - Naive:    O(n), a running sum per lane of the accumulator.
+		 * - Pairwise: O(log n), by summing blocks naively and then adding the block sums up in pairs, recursively.
+		 * - Kahan:    O(1), every addition carries the rounding error of the previous one over into the next.
+		 *
+		 * Kahan summation relies on floating point arithmetic not being reassociated: it is silently lost under -ffast-math.
+		 * Integer vectors are always summed naively, since they have no rounding error to make up for.
+		 */
+		enum class Summation
+		{ Naive , Pairwise , Kahan };
+
+		namespace detail {
+
+			// Number of vectors per block of pairwise summation, summed naively.
+			inline constexpr std::size_t pairwise_block = 1024;
+
+			// Running sum that carries the rounding error of each addition over into the next one.
+			template<typename T>
+			struct KahanSum {
+
+				T sum{};
+				T comp{};
+
+				constexpr void
+				add(T const& value) {
+					const T y = T(value - comp);
+					const T t = T(sum + y);
+					comp = T((t - sum) - y);
+					sum = t;
+				}
+
+				constexpr T
+				value() const
+				{ return T(sum - comp); }
+
+			};
+
+			// Vec<T> that can be summed as a flat array of 3 * n floating point values.
+			template<typename V>
+			concept flat_summable =
+				std::same_as<typename V::value_type_x, typename V::value_type_y> &&
+				std::same_as<typename V::value_type_x, typename V::value_type_z> &&
+				std::floating_point<typename V::value_type_x> &&
+				interleaved_layout<typename V::value_type_x>;
+
+			/**
+			 * Naive or Kahan sum of 'count' vectors, read as a flat array of scalars into 3 * 16 independent lanes:
+			 * lane k always holds axis k % 3. The lanes break the dependency between consecutive additions, and are
+			 * wide enough for the compiler to turn the loop into whole-register vector additions.
+			 *
+			 * Kahan summation first adds up four values per lane, and only compensates that partial sum. Its error is then
+			 * a few ulps of each partial sum, still independent of 'count', while the long chain of dependent operations
+			 * of each compensated addition runs a quarter as often, and mostly hides behind memory accesses.
+			 */
+			template<Summation mode, typename T>
+			inline Vec<T>
+			sum_flat(Vec<T> const* in, std::size_t count) {
+				constexpr std::size_t lanes = 3 * 16;
+				T const* flat = reinterpret_cast<T const*>(in);
+				const std::size_t n = 3 * count;
+				const std::size_t body = n / lanes * lanes;
+
+				std::array<T, lanes> sum{};
+				std::array<T, lanes> comp{};
+				auto add = [&](std::size_t k, T value) {
+					if constexpr(mode == Summation::Kahan) {
+						const T y = value - comp[k];
+						const T t = sum[k] + y;
+						comp[k] = (t - sum[k]) - y;
+						sum[k] = t;
+					}
+					else sum[k] += value;
+				};
+
+				std::size_t i = 0;
+				if constexpr(mode == Summation::Kahan) {
+					for (; i + 4 * lanes <= n; i += 4 * lanes)
+						for (std::size_t k = 0; k < lanes; ++k)
+							add(k, (flat[i + k] + flat[i + lanes + k]) + (flat[i + 2 * lanes + k] + flat[i + 3 * lanes + k]));
+				}
+				for (; i < body; i += lanes)
+					for (std::size_t k = 0; k < lanes; ++k) add(k, flat[i + k]);
+				for (i = body; i < n; ++i) add(i - body, flat[i]);
+
+				// Fold the lanes of each axis together, carrying their compensations along.
+				if constexpr(mode == Summation::Kahan) {
+					std::array<KahanSum<T>, 3> axes{};
+					for (std::size_t k = 0; k < lanes; ++k) {
+						axes[k % 3].add(sum[k]);
+						axes[k % 3].add(-comp[k]);
+					}
+					return Vec<T>(axes[0].value(), axes[1].value(), axes[2].value());
+				}
+				else {
+					std::array<T, 3> axes{};
+					for (std::size_t k = 0; k < lanes; ++k) axes[k % 3] += sum[k];
+					return Vec<T>(axes[0], axes[1], axes[2]);
+				}
+			}
+
+			// Naive or Kahan sum of 'count' vectors of any type, through the Vec operators.
+			template<Summation mode, typename V>
+			inline V
+			sum_vec(V const* in, std::size_t count) {
+				if constexpr(mode == Summation::Kahan) {
+					KahanSum<V> acc;
+					for (std::size_t i = 0; i < count; ++i) acc.add(in[i]);
+					return acc.value();
+				}
+				else {
+					V acc{};
+					for (std::size_t i = 0; i < count; ++i) acc = V(acc + in[i]);
+					return acc;
+				}
+			}
+
+			template<Summation mode, typename V>
+			inline V
+			sum_block(V const* in, std::size_t count) {
+				if constexpr(flat_summable<V>) return sum_flat<mode>(in, count);
+				else return sum_vec<mode>(in, count);
+			}
+
+			// Splits at a whole number of blocks, so that every block but the last is full.
+			template<typename V>
+			inline V
+			sum_pairwise(V const* in, std::size_t count) {
+				if (count <= pairwise_block) return sum_block<Summation::Naive>(in, count);
+				const std::size_t half = (count / pairwise_block + 1) / 2 * pairwise_block;
+				return V(sum_pairwise(in, half) + sum_pairwise(in + half, count - half));
+			}
+
+		}
+
+		// Sum of the 'count' vectors, accumulated as 'mode' says.
+		template<Summation mode = Summation::Pairwise, typename X, typename Y, typename Z>
+		requires requires(Vec<X, Y, Z> const& v) { {Vec<X, Y, Z>(v + v)}; {Vec<X, Y, Z>(v - v)}; }
+		inline Vec<X, Y, Z>
+		sum(Vec<X, Y, Z> const* in, std::size_t count) {
+			using V = Vec<X, Y, Z>;
+			constexpr bool floating =
+				std::is_floating_point_v<typename V::value_type_x> ||
+				std::is_floating_point_v<typename V::value_type_y> ||
+				std::is_floating_point_v<typename V::value_type_z>;
+
+			if constexpr(!floating || mode == Summation::Naive) return detail::sum_block<Summation::Naive>(in, count);
+			else if constexpr(mode == Summation::Pairwise) return detail::sum_pairwise(in, count);
+			else return detail::sum_block<Summation::Kahan>(in, count);
+		}
+
+	}
+
+	using generic_vec::Summation;
+
+}
+
+#endif
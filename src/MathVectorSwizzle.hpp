@@ -0,0 +1,254 @@
+#ifndef INK_GENERIC_VEC_SWIZZLE_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_SWIZZLE_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <array>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include "MathVector.hpp"
+#include "MathVectorSimd.hpp"
+
+/*
+ * Swizzles: the axes of a Vec picked by name, reordered or repeated, as in shader code.
+ *
+ * swizzle<"zyx">(v) is the Vec (v.z, v.y, v.x), swizzle<"xy">(v) the Vec<T, T, void> (v.x, v.y), and swizzle<"xxz">(v)
+ * repeats x. '_' leaves an axis 'void': swizzle<"x_z">(v) drops y. The result is an ordinary Vec, so every operator
+ * applies to it, and once inlined it is no copy at all: only the registers the axes are already in, or a shuffle.
+ * A lazy expression of MathVectorExpr.hpp can be swizzled too, computing only the axes picked.
+ *
+ * swizzle_ref<"zx">(v) is the writable form, for names that repeat no axis: assigning a Vec to it writes the Vec's
+ * x and y into v.z and v.x. The whole right hand side is read before anything is written, so that swizzle_ref<"yx">(v) = v
+ * swaps x and y. It is a vec_expression, so it also reads as a lazy vector, and fuses into lazy expressions: even
+ * into one assigned to the very Vec it views, as v = lazy(v) + swizzle_ref<"zyx">(v), since assigning an expression to
+ * a Vec evaluates every axis before it writes any.
+ *
+ * simd::swizzle<"zyx">(in, out, count) permutes whole arrays of Vec<float> / Vec<double>: one register shuffle per
+ * register of data on instruction sets with two-source permutes, a deinterleave and interleave otherwise.
+ */
+namespace ink::generic_vec {
+
+	namespace detail {
+
+		// The index of an axis a swizzle names as '_'.
+		inline constexpr std::size_t no_axis = 3;
+
+		/**
+		 * The axes a swizzle names, parsed from a string literal at compile time: 'pick[k]' is the axis that goes to axis k
+		 * of the result, 0 to 2 for x to z, or no_axis. Any other character is a compile error.
+		 */
+		template<std::size_t n>
+		struct AxisNames {
+
+			static_assert(n >= 2 && n <= 4, "a swizzle names one to three axes");
+
+			std::array<std::size_t, 3> pick{ no_axis, no_axis, no_axis };
+
+			consteval
+			AxisNames(char const (&names)[n]) {
+				for (std::size_t k = 0; k + 1 < n; ++k) {
+					switch (names[k]) {
+						case 'x': pick[k] = 0; break;
+						case 'y': pick[k] = 1; break;
+						case 'z': pick[k] = 2; break;
+						case '_': break;
+						default: throw "a swizzle names its axes 'x', 'y' and 'z', or '_' for none";
+					}
+				}
+			}
+
+			// Whether some axis is named twice. Such a swizzle can be read, but not written through.
+			constexpr bool
+			repeats() const
+			noexcept {
+				for (std::size_t k = 0; k < 3; ++k)
+					for (std::size_t j = k + 1; j < 3; ++j)
+						if (pick[k] != no_axis && pick[k] == pick[j]) return true;
+				return false;
+			}
+
+			// Whether all three axes of the result are named, as the batched swizzle needs.
+			constexpr bool
+			full() const
+			noexcept { return pick[0] != no_axis && pick[1] != no_axis && pick[2] != no_axis; }
+
+		};
+
+		// Axis 'axis' of a Vec, a reference to it, or of an expression, computed. NoState for no_axis.
+		template<std::size_t axis, typename V>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		axis_of(V& vec)
+		noexcept {
+			if constexpr(vec_expression<std::remove_const_t<V>>) {
+				if		constexpr(axis == 0) return vec.x();
+				else if	constexpr(axis == 1) return vec.y();
+				else if	constexpr(axis == 2) return vec.z();
+				else return NoState();
+			} else {
+				if		constexpr(axis == 0) return (vec.x);
+				else if	constexpr(axis == 1) return (vec.y);
+				else if	constexpr(axis == 2) return (vec.z);
+				else return NoState();
+			}
+		}
+
+		template<typename V>
+		concept swizzlable = concepts::same_template<std::remove_cvref_t<V>, Vec<void>> || vec_expression<std::remove_cvref_t<V>>;
+
+	}
+
+	// The axes of 'vec' that 'axes' names, in that order, as a new Vec. See the top of this file.
+	template<detail::AxisNames axes, detail::swizzlable V>
+	INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+	swizzle(V const& vec)
+	noexcept(noexcept(ink::Vec{
+		detail::axis_of<axes.pick[0]>(vec), detail::axis_of<axes.pick[1]>(vec), detail::axis_of<axes.pick[2]>(vec) }))
+	{ return ink::Vec{ detail::axis_of<axes.pick[0]>(vec), detail::axis_of<axes.pick[1]>(vec), detail::axis_of<axes.pick[2]>(vec) }; }
+
+	/**
+	 * A writable view of the axes of a Vec that 'axes' names: what is assigned to its axis k goes to axis 'axes.pick[k]'
+	 * of the Vec. It refers to the Vec, so must not outlive it. See the top of this file.
+	 */
+	template<typename V, detail::AxisNames axes>
+	requires(!axes.repeats())
+	class SwizzleRef {
+
+		public: using is_vec_expression = void;
+		public: using value_type = decltype(generic_vec::swizzle<axes>(std::declval<V const&>()));
+		public: static constexpr bool is_noexcept = true;
+
+		private: V& M_vec;
+
+		public: constexpr explicit
+		SwizzleRef(V& vec)
+		noexcept: M_vec(vec) {}
+
+		public: constexpr
+		SwizzleRef(SwizzleRef const&) = default;
+
+		public: INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto) x() const noexcept { return detail::axis_of<axes.pick[0]>(M_vec); }
+		public: INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto) y() const noexcept { return detail::axis_of<axes.pick[1]>(M_vec); }
+		public: INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto) z() const noexcept { return detail::axis_of<axes.pick[2]>(M_vec); }
+
+		// The axes seen through the view, as a Vec of their own.
+		public: INK_GENERIC_VEC_FORCE_INLINE constexpr value_type
+		eval() const
+		noexcept { return generic_vec::swizzle<axes>(M_vec); }
+
+		// Writes each axis of 'value' through the view, converted to the axis it lands in. 'value' is read in full first.
+		public: template<typename E>
+		requires(detail::swizzlable<E> && std::constructible_from<value_type, E const&>)
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator=(E const& value) const {
+			const value_type read(value);
+			M_write<0>(read.x);
+			M_write<1>(read.y);
+			M_write<2>(read.z);
+			return *this;
+		}
+
+		// Writes the axes seen through 'other', which may be of the same Vec.
+		public: INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator=(SwizzleRef const& other) const
+		{ return *this = other.eval(); }
+
+		private: template<std::size_t k, typename T>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr void
+		M_write(T const& value) const {
+			if constexpr(axes.pick[k] != detail::no_axis && !std::same_as<std::remove_cv_t<T>, NoState>)
+				detail::axis_of<axes.pick[k]>(M_vec) = value;
+		}
+
+		// 'view op= rhs' is 'view = view op rhs', for any operator the Vec seen through the view has.
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l + r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator+=(R const& rhs) const
+		{ return *this = eval() + rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l - r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator-=(R const& rhs) const
+		{ return *this = eval() - rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l * r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator*=(R const& rhs) const
+		{ return *this = eval() * rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l / r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator/=(R const& rhs) const
+		{ return *this = eval() / rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l % r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator%=(R const& rhs) const
+		{ return *this = eval() % rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l & r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator&=(R const& rhs) const
+		{ return *this = eval() & rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l | r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator|=(R const& rhs) const
+		{ return *this = eval() | rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l ^ r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator^=(R const& rhs) const
+		{ return *this = eval() ^ rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l << r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator<<=(R const& rhs) const
+		{ return *this = eval() << rhs; }
+
+		public: template<typename R>
+		requires requires(value_type const& l, R const& r) { {SwizzleRef(std::declval<V&>()) = l >> r}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef const&
+		operator>>=(R const& rhs) const
+		{ return *this = eval() >> rhs; }
+
+	};
+
+	// The writable view of the axes of 'vec' that 'axes' names, none of them twice. See the top of this file.
+	template<detail::AxisNames axes, typename X, typename Y, typename Z>
+	requires(!axes.repeats())
+	INK_GENERIC_VEC_FORCE_INLINE constexpr SwizzleRef<Vec<X, Y, Z>, axes>
+	swizzle_ref(Vec<X, Y, Z>& vec)
+	noexcept { return SwizzleRef<Vec<X, Y, Z>, axes>(vec); }
+
+
+
+	namespace simd {
+
+		// out[i] = swizzle<axes>(in[i]), for 'count' vectors, 'axes' naming all three axes. 'in' and 'out' may be the same array.
+		template<generic_vec::detail::AxisNames axes, std::floating_point T>
+		requires(axes.full())
+		inline void
+		swizzle(Vec<T> const* in, Vec<T>* out, std::size_t count)
+		noexcept { kernels<T>().swizzle[9 * axes.pick[0] + 3 * axes.pick[1] + axes.pick[2]](detail::flat(in), detail::flat(out), count); }
+
+	}
+
+}
+
+namespace ink {
+
+	using generic_vec::swizzle;
+	using generic_vec::swizzle_ref;
+
+}
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef INK_GENERIC_VEC_TABLES_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_TABLES_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+#include <utility>
+#include "MathVector.hpp"
+#include "MathVectorGrid.hpp"
+
+/*
+ * Lookup tables of vectors built entirely at compile time, and the constexpr math they are built with.
+ *
+ * The tables are 'inline constexpr' variables: they are constant-initialized, live in read-only data,
+ * and cost nothing at startup. generate() builds custom ones the same way, from any constexpr function of the index.
+ *
+ * std::sqrt, std::sin and std::cos are not constexpr before C++26, so sqrt(), sin() and cos() here evaluate in
+ * plain arithmetic during constant evaluation, and call the standard functions at run time. The constant results are
+ * within an ulp or two of the run time ones, but not always bit for bit identical to them.
+ *
+ * Constant evaluation is bounded by the compiler's operation limit (-fconstexpr-ops-limit on GCC,
+ * -fconstexpr-steps on Clang): tables of more than a few tens of thousands of entries may need it raised.
+ */
+namespace ink::generic_vec::tables {
+
+	namespace detail {
+
+		// Rounds to the nearest integer, halves away from zero, without std::round.
+		constexpr double
+		round(double value)
+		noexcept { return double(std::int64_t(value < 0 ? value - 0.5 : value + 0.5)); }
+
+		// sin(r) and cos(r) for |r| <= pi / 4, by their Taylor series up to degree 19 and 18: error below 1e-17.
+		constexpr double
+		sin_poly(double r)
+		noexcept {
+			const double r2 = r * r;
+			double term = r, sum = r;
+			for (int k = 1; k < 10; ++k) {
+				term *= -r2 / double((2 * k) * (2 * k + 1));
+				sum += term;
+			}
+			return sum;
+		}
+
+		constexpr double
+		cos_poly(double r)
+		noexcept {
+			const double r2 = r * r;
+			double term = 1, sum = 1;
+			for (int k = 1; k < 10; ++k) {
+				term *= -r2 / double((2 * k - 1) * (2 * k));
+				sum += term;
+			}
+			return sum;
+		}
+
+		/**
+		 * Reduces 'value' to 'r' in [-pi / 4, pi / 4], with value = r + quadrant * pi / 2.
+		 * pi / 2 is split in two parts, so that the subtraction stays exact for |value| up to about 1e6.
+		 */
+		constexpr double
+		reduce_quadrant(double value, std::int64_t& quadrant)
+		noexcept {
+			constexpr double half_pi_hi = 1.57079632673412561417e+00;
+			constexpr double half_pi_lo = 6.07710050650619224932e-11;
+			const double k = round(value * (2 / std::numbers::pi));
+			quadrant = std::int64_t(k);
+			return (value - k * half_pi_hi) - k * half_pi_lo;
+		}
+
+		constexpr double
+		sqrt(double value)
+		noexcept {
+			if (!(value > 0) || value == std::numeric_limits<double>::infinity())
+				return value == 0 || value == std::numeric_limits<double>::infinity() ? value : std::numeric_limits<double>::quiet_NaN();
+
+			// Halving the exponent bits gives an estimate within a factor of about 1.06 for normal values, which
+			// Newton-Raphson then refines, doubling the correct bits each step until it settles.
+			double y = std::bit_cast<double>((std::bit_cast<std::uint64_t>(value) >> 1) + (std::uint64_t(0x3FF) << 51));
+			for (int i = 0; i < 64; ++i) {
+				const double next = 0.5 * (y + value / y);
+				if (next == y) break;
+				y = next;
+			}
+			return y;
+		}
+
+	}
+
+
+
+	// Square root, usable in constant expressions. Integers are promoted to double, as by std::sqrt.
+	template<typename T>
+	requires std::is_arithmetic_v<T>
+	constexpr auto
+	sqrt(T value)
+	noexcept {
+		using R = decltype(std::sqrt(value));
+		if (std::is_constant_evaluated()) return R(detail::sqrt(double(value)));
+		return std::sqrt(value);
+	}
+
+	// Sine of 'value' radians, usable in constant expressions. Accurate to about an ulp for |value| up to 1e6.
+	template<typename T>
+	requires std::is_arithmetic_v<T>
+	constexpr auto
+	sin(T value)
+	noexcept {
+		using R = decltype(std::sin(value));
+		if (std::is_constant_evaluated()) {
+			std::int64_t q = 0;
+			const double r = detail::reduce_quadrant(double(value), q);
+			switch (q & 3) {
+				case 0:  return R( detail::sin_poly(r));
+				case 1:  return R( detail::cos_poly(r));
+				case 2:  return R(-detail::sin_poly(r));
+				default: return R(-detail::cos_poly(r));
+			}
+		}
+		return std::sin(value);
+	}
+
+	// Cosine of 'value' radians, usable in constant expressions. See sin().
+	template<typename T>
+	requires std::is_arithmetic_v<T>
+	constexpr auto
+	cos(T value)
+	noexcept {
+		using R = decltype(std::cos(value));
+		if (std::is_constant_evaluated()) {
+			std::int64_t q = 0;
+			const double r = detail::reduce_quadrant(double(value), q);
+			switch (q & 3) {
+				case 0:  return R( detail::cos_poly(r));
+				case 1:  return R(-detail::sin_poly(r));
+				case 2:  return R(-detail::cos_poly(r));
+				default: return R( detail::sin_poly(r));
+			}
+		}
+		return std::cos(value);
+	}
+
+	// Returns 'v' scaled to a magnitude of 1, usable in constant expressions. NaN for the zero vector.
+	template<std::floating_point T>
+	constexpr Vec<T>
+	normalize(Vec<T> const& v)
+	noexcept {
+		const T inv = T(1) / tables::sqrt(v.mag2());
+		return Vec<T>(v.x * inv, v.y * inv, v.z * inv);
+	}
+
+
+
+	/**
+	 * The point at distance 'index' along the 3D Hilbert curve through the cube of side 2^bits, for bits up to 21.
+	 * Consecutive indices always map to points that differ by one along a single axis.
+	 * This is J. Skilling's transpose algorithm ("Programming the Hilbert curve", 2004).
+	 */
+	constexpr Vec<std::uint32_t>
+	hilbert_decode(std::uint64_t index, unsigned bits)
+	noexcept {
+		// Deal the bits of the index out to the axes, most significant first: the "transposed" index.
+		std::uint32_t p[3] = {};
+		for (unsigned b = 0; b < bits; ++b)
+			for (unsigned axis = 0; axis < 3; ++axis)
+				p[axis] |= std::uint32_t((index >> (3 * b + 2 - axis)) & 1) << b;
+
+		// Gray decode.
+		const std::uint32_t t = p[2] >> 1;
+		p[2] ^= p[1];
+		p[1] ^= p[0];
+		p[0] ^= t;
+
+		// Undo the excess work, from the second lowest bit up.
+		for (std::uint32_t q = 2; q != (std::uint32_t(1) << bits) && q != 0; q <<= 1) {
+			const std::uint32_t mask = q - 1;
+			for (int axis = 2; axis >= 0; --axis) {
+				if (p[axis] & q) p[0] ^= mask;
+				else {
+					const std::uint32_t swap = (p[0] ^ p[axis]) & mask;
+					p[0] ^= swap;
+					p[axis] ^= swap;
+				}
+			}
+		}
+		return Vec<std::uint32_t>(p[0], p[1], p[2]);
+	}
+
+
+
+	/**
+	 * A std::array of 'N' elements, element i being f(i). Usable in constant expressions whenever 'f' is,
+	 * and then the way to build custom tables at compile time:
+	 *
+	 *     inline constexpr auto ring = tables::generate<64>([](std::size_t i) { ... });
+	 */
+	template<std::size_t N, typename F>
+	requires std::invocable<F const&, std::size_t> && std::default_initializable<std::invoke_result_t<F const&, std::size_t>>
+	constexpr auto
+	generate(F const& f) {
+		std::array<std::invoke_result_t<F const&, std::size_t>, N> out{};
+		for (std::size_t i = 0; i < N; ++i) out[i] = f(i);
+		return out;
+	}
+
+	// Outward normals of the faces of an axis-aligned cube: +x, -x, +y, -y, +z, -z.
+	template<typename T>
+	requires std::is_signed_v<T>
+	inline constexpr std::array<Vec<T>, 6> cube_face_normals = {
+		Vec<T>(T(1), T(0), T(0)), Vec<T>(T(-1), T(0), T(0)),
+		Vec<T>(T(0), T(1), T(0)), Vec<T>(T(0), T(-1), T(0)),
+		Vec<T>(T(0), T(0), T(1)), Vec<T>(T(0), T(0), T(-1)) };
+
+	// Unit directions at N equal steps around the z axis, starting from +x: the rotations of +x by 2 pi i / N.
+	template<std::floating_point T, std::size_t N>
+	inline constexpr std::array<Vec<T>, N> circle_directions = generate<N>([](std::size_t i) {
+		const double angle = 2 * std::numbers::pi * double(i) / double(N);
+		return Vec<T>(T(tables::cos(angle)), T(tables::sin(angle)), T(0));
+	});
+
+	/**
+	 * N unit directions spread evenly over the sphere, on a Fibonacci spiral from +z down to -z:
+	 * point i sits at height 1 - (2i + 1) / N, and a golden angle further around the z axis than point i - 1.
+	 */
+	template<std::floating_point T, std::size_t N>
+	inline constexpr std::array<Vec<T>, N> fibonacci_sphere = generate<N>([](std::size_t i) {
+		// Turns of the golden angle, (3 - sqrt(5)) / 2, kept within [0, 1) before they become an angle.
+		const double turns = double(i) * (3 - tables::sqrt(5.0)) / 2;
+		const double angle = 2 * std::numbers::pi * (turns - double(std::uint64_t(turns)));
+		const double z = 1 - (2 * double(i) + 1) / double(N);
+		const double r = tables::sqrt(1 - z * z);
+		return Vec<T>(T(r * tables::cos(angle)), T(r * tables::sin(angle)), T(z));
+	});
+
+	// The points of the cube of side 2^bits in Morton order: element i is generic_vec::morton_decode(i).
+	template<unsigned bits>
+	requires(bits <= 7)
+	inline constexpr std::array<Vec<std::uint32_t>, std::size_t(1) << (3 * bits)> morton_order =
+		generate<std::size_t(1) << (3 * bits)>([](std::size_t i) { return morton_decode(i); });
+
+	// The points of the cube of side 2^bits in Hilbert order: element i is hilbert_decode(i, bits).
+	template<unsigned bits>
+	requires(bits <= 7)
+	inline constexpr std::array<Vec<std::uint32_t>, std::size_t(1) << (3 * bits)> hilbert_order =
+		generate<std::size_t(1) << (3 * bits)>([](std::size_t i) { return hilbert_decode(i, bits); });
+
+}
+
+#endif
@@ -0,0 +1,438 @@
+#ifndef INK_GENERIC_VEC_TRANSFORM_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_TRANSFORM_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <type_traits>
+#include "MathVector.hpp"
+#include "MathVectorSimd.hpp"
+
+/*
+ * Linear and affine transforms of Vec: 3x3 matrices, 4x4 affine matrices and rotation quaternions.
+ *
+ * Matrices are stored as their columns, each a Vec<T>: the images of the x, y and z axes. Applying any of them to a
+ * Vec keeps the axes of that Vec, as the Vec operators do: a 'void' axis contributes nothing, and gets nothing back,
+ * so that a rotation about z turns a Vec<float, float, void> in its plane. The element types of the transform and of
+ * the Vec may differ, and the result has the type of their products.
+ *
+ * The batched versions, in the simd namespace, broadcast the matrix into registers once and stream whole
+ * Vec<float> / Vec<double> arrays through it.
+ */
+namespace ink::generic_vec {
+
+	template<typename T>
+	class Quat;
+
+	namespace detail {
+
+		// The product of the matrix row (rx, ry, rz) with 'vec': an axis 'vec' does not hold drops its term entirely.
+		template<typename T, typename X, typename Y, typename Z>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		row_dot(T const& rx, T const& ry, T const& rz, Vec<X, Y, Z> const& vec)
+		noexcept(noexcept(rx * vec.x + ry * vec.y + rz * vec.z)) {
+			constexpr auto axes = Vec<X, Y, Z>::axes;
+			return
+				masked<has_axis<axes, XYZ::X>>(rx) * vec.x +
+				masked<has_axis<axes, XYZ::Y>>(ry) * vec.y +
+				masked<has_axis<axes, XYZ::Z>>(rz) * vec.z;
+		}
+
+		// 'vec' with only the given axes left: the others become 'void'.
+		template<unsigned axes, typename X, typename Y, typename Z>
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		keep_axes(Vec<X, Y, Z> const& vec)
+		noexcept {
+			return ink::Vec{
+				masked<has_axis<axes, XYZ::X>>(vec.x),
+				masked<has_axis<axes, XYZ::Y>>(vec.y),
+				masked<has_axis<axes, XYZ::Z>>(vec.z) };
+		}
+
+	}
+
+	/**
+	 * A 3x3 matrix, stored as its three columns: 'x', 'y' and 'z' are where it takes the x, y and z axes.
+	 * Default constructs to the identity.
+	 */
+	template<typename T>
+	class Mat3 {
+
+		public: using value_type = T;
+
+		public: Vec<T> x;
+		public: Vec<T> y;
+		public: Vec<T> z;
+
+		public: constexpr
+		Mat3()
+		noexcept : x(T(1), T(0), T(0)), y(T(0), T(1), T(0)), z(T(0), T(0), T(1)) {}
+
+		// The matrix of the given columns.
+		public: constexpr
+		Mat3(Vec<T> const& vx, Vec<T> const& vy, Vec<T> const& vz)
+		noexcept : x(vx), y(vy), z(vz) {}
+
+		public: template<typename U>
+		requires(std::convertible_to<U, T>)
+		constexpr explicit
+		Mat3(Mat3<U> const& other)
+		noexcept : x(Vec<T>(other.x)), y(Vec<T>(other.y)), z(Vec<T>(other.z)) {}
+
+		// The rotation of the unit quaternion 'q'.
+		public: constexpr explicit
+		Mat3(Quat<T> const& q)
+		noexcept {
+			const T xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+			const T xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+			const T wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+			x = Vec<T>(T(1) - T(2) * (yy + zz), T(2) * (xy + wz), T(2) * (xz - wy));
+			y = Vec<T>(T(2) * (xy - wz), T(1) - T(2) * (xx + zz), T(2) * (yz + wx));
+			z = Vec<T>(T(2) * (xz + wy), T(2) * (yz - wx), T(1) - T(2) * (xx + yy));
+		}
+
+		// The matrix of the given rows.
+		public: static constexpr Mat3
+		from_rows(Vec<T> const& rx, Vec<T> const& ry, Vec<T> const& rz)
+		noexcept { return Mat3(Vec<T>(rx.x, ry.x, rz.x), Vec<T>(rx.y, ry.y, rz.y), Vec<T>(rx.z, ry.z, rz.z)); }
+
+		// Scales each axis by the matching axis of 'factors'.
+		public: static constexpr Mat3
+		scale(Vec<T> const& factors)
+		noexcept { return Mat3(Vec<T>(factors.x, T(0), T(0)), Vec<T>(T(0), factors.y, T(0)), Vec<T>(T(0), T(0), factors.z)); }
+
+		public: constexpr Vec<T>
+		row_x() const
+		noexcept { return Vec<T>(x.x, y.x, z.x); }
+
+		public: constexpr Vec<T>
+		row_y() const
+		noexcept { return Vec<T>(x.y, y.y, z.y); }
+
+		public: constexpr Vec<T>
+		row_z() const
+		noexcept { return Vec<T>(x.z, y.z, z.z); }
+
+		public: constexpr Mat3
+		transpose() const
+		noexcept { return Mat3(row_x(), row_y(), row_z()); }
+
+		public: constexpr T
+		determinant() const
+		noexcept { return x.dot(y.cross(z)); }
+
+		// The inverse, from the cross products of the columns and a single division. Not finite when singular.
+		public: constexpr Mat3
+		inverse() const
+		noexcept requires(std::floating_point<T>) {
+			const Vec<T> rx = y.cross(z), ry = z.cross(x), rz = x.cross(y);
+			const T inv_det = T(1) / x.dot(rx);
+			return from_rows(rx * inv_det, ry * inv_det, rz * inv_det);
+		}
+
+		// The product with 'vec', over the axes 'vec' holds.
+		public: template<typename X, typename Y, typename Z, typename OVec = Vec<X, Y, Z>>
+		requires( OpConstraint_t<concepts::can_mul_t, Vec<T>, OVec>{}() )
+		INK_GENERIC_VEC_FORCE_INLINE friend constexpr decltype(auto)
+		operator*(Mat3 const& mat, Vec<X, Y, Z> const& vec)
+		noexcept(OpConstraint_t<concepts::can_mul_t, Vec<T>, OVec, true>{}()) {
+			using detail::masked;
+			using detail::has_axis;
+			constexpr auto axes = OVec::axes;
+			return ink::Vec{
+				masked<has_axis<axes, detail::XYZ::X>>(detail::row_dot(mat.x.x, mat.y.x, mat.z.x, vec)),
+				masked<has_axis<axes, detail::XYZ::Y>>(detail::row_dot(mat.x.y, mat.y.y, mat.z.y, vec)),
+				masked<has_axis<axes, detail::XYZ::Z>>(detail::row_dot(mat.x.z, mat.y.z, mat.z.z, vec)) };
+		}
+
+		// The matrix applying 'rhs' first, then 'lhs'.
+		public: template<typename U>
+		requires requires(Mat3 const& l, Vec<U> const& r) { {ink::generic_vec::Mat3{l * r, l * r, l * r}}; }
+		friend constexpr decltype(auto)
+		operator*(Mat3 const& lhs, Mat3<U> const& rhs)
+		noexcept { return ink::generic_vec::Mat3{lhs * rhs.x, lhs * rhs.y, lhs * rhs.z}; }
+
+	};
+
+	template<typename T>
+	Mat3(Vec<T>, Vec<T>, Vec<T>) -> Mat3<T>;
+
+
+
+	/**
+	 * A 4x4 affine matrix: the linear part 'linear', then the translation 'translation'.
+	 * The bottom row is always 0 0 0 1, and so is not stored. Default constructs to the identity.
+	 */
+	template<typename T>
+	class Affine {
+
+		public: using value_type = T;
+
+		public: Mat3<T> linear;
+		public: Vec<T> translation;
+
+		public: constexpr
+		Affine()
+		noexcept : linear(), translation(T(0), T(0), T(0)) {}
+
+		public: constexpr explicit
+		Affine(Mat3<T> const& lin, Vec<T> const& trans = Vec<T>(T(0), T(0), T(0)))
+		noexcept : linear(lin), translation(trans) {}
+
+		public: template<typename U>
+		requires(std::convertible_to<U, T>)
+		constexpr explicit
+		Affine(Affine<U> const& other)
+		noexcept : linear(Mat3<T>(other.linear)), translation(Vec<T>(other.translation)) {}
+
+		public: static constexpr Affine
+		translate(Vec<T> const& by)
+		noexcept { return Affine(Mat3<T>(), by); }
+
+		// Scales by 'scale', then rotates by the unit quaternion 'rotation', then translates by 'translation'.
+		public: static constexpr Affine
+		trs(Vec<T> const& trans, Quat<T> const& rotation, Vec<T> const& scale)
+		noexcept {
+			const Mat3<T> r(rotation);
+			return Affine(Mat3<T>(r.x * scale.x, r.y * scale.y, r.z * scale.z), trans);
+		}
+
+		// The image of the point 'vec': linear * vec + translation, over the axes 'vec' holds.
+		public: template<typename X, typename Y, typename Z>
+		requires requires(Mat3<T> const& m, Vec<X, Y, Z> const& v) { {m * v + detail::keep_axes<Vec<X, Y, Z>::axes>(Vec<T>())}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		transform_point(Vec<X, Y, Z> const& vec) const
+		noexcept { return linear * vec + detail::keep_axes<Vec<X, Y, Z>::axes>(translation); }
+
+		// The image of the direction 'vec': linear * vec, untouched by the translation.
+		// Normals need the inverse transpose instead: Affine(linear.inverse().transpose()) for a non-uniform scale.
+		public: template<typename X, typename Y, typename Z>
+		requires requires(Mat3<T> const& m, Vec<X, Y, Z> const& v) { {m * v}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		transform_direction(Vec<X, Y, Z> const& vec) const
+		noexcept { return linear * vec; }
+
+		// The inverse transform. Not finite when the linear part is singular.
+		public: constexpr Affine
+		inverse() const
+		noexcept requires(std::floating_point<T>) {
+			const Mat3<T> inv = linear.inverse();
+			return Affine(inv, -(inv * translation));
+		}
+
+		// The transform applying 'rhs' first, then 'lhs'.
+		public: friend constexpr Affine
+		operator*(Affine const& lhs, Affine const& rhs)
+		noexcept { return Affine(lhs.linear * rhs.linear, lhs.transform_point(rhs.translation)); }
+
+	};
+
+
+
+	/**
+	 * A quaternion x i + y j + z k + w. Unit quaternions are rotations, and only those are meant by rotate() and
+	 * the conversion to Mat3. Default constructs to the identity rotation.
+	 */
+	template<typename T>
+	class Quat {
+
+		public: using value_type = T;
+
+		public: T x;
+		public: T y;
+		public: T z;
+		public: T w;
+
+		public: constexpr
+		Quat()
+		noexcept : x(T(0)), y(T(0)), z(T(0)), w(T(1)) {}
+
+		public: constexpr
+		Quat(T vx, T vy, T vz, T vw)
+		noexcept : x(vx), y(vy), z(vz), w(vw) {}
+
+		public: template<typename U>
+		requires(std::convertible_to<U, T>)
+		constexpr explicit
+		Quat(Quat<U> const& other)
+		noexcept : x(T(other.x)), y(T(other.y)), z(T(other.z)), w(T(other.w)) {}
+
+		// The rotation by 'angle' radians about the unit vector 'axis'.
+		public: static Quat
+		axis_angle(Vec<T> const& axis, T angle)
+		noexcept requires(std::floating_point<T>) {
+			const T s = std::sin(angle / T(2));
+			return Quat(axis.x * s, axis.y * s, axis.z * s, std::cos(angle / T(2)));
+		}
+
+		// The vector part, x y z.
+		public: constexpr Vec<T>
+		vec() const
+		noexcept { return Vec<T>(x, y, z); }
+
+		public: constexpr T
+		dot(Quat const& rhs) const
+		noexcept { return (x * rhs.x) + (y * rhs.y) + (z * rhs.z) + (w * rhs.w); }
+
+		public: constexpr T
+		norm2() const
+		noexcept { return dot(*this); }
+
+		// The inverse rotation, for a unit quaternion.
+		public: constexpr Quat
+		conjugate() const
+		noexcept { return Quat(-x, -y, -z, w); }
+
+		// The inverse of any non-zero quaternion.
+		public: constexpr Quat
+		inverse() const
+		noexcept requires(std::floating_point<T>) {
+			const T s = T(1) / norm2();
+			return Quat(-x * s, -y * s, -z * s, w * s);
+		}
+
+		public: Quat
+		normalize() const
+		noexcept requires(std::floating_point<T>) {
+			const T s = T(1) / std::sqrt(norm2());
+			return Quat(x * s, y * s, z * s, w * s);
+		}
+
+		/**
+		 * 'vec' rotated by this unit quaternion, over the axes 'vec' holds: vec + 2w (u x vec) + 2u x (u x vec), for the
+		 * vector part u. Cheaper than Mat3(q) * vec for a single vector; batches are better off with the matrix.
+		 */
+		public: template<typename X, typename Y, typename Z>
+		requires requires(Vec<T> const& u, Vec<X, Y, Z> const& v, T const& s) { {v + u.cross(v) * s + u.cross(u.cross(v) * s)}; }
+		INK_GENERIC_VEC_FORCE_INLINE constexpr decltype(auto)
+		rotate(Vec<X, Y, Z> const& vec) const
+		noexcept {
+			const Vec<T> u = this->vec();
+			const auto t = u.cross(vec) * T(2);
+			return detail::keep_axes<Vec<X, Y, Z>::axes>(vec + t * w + u.cross(t));
+		}
+
+		// The rotation applying 'rhs' first, then 'lhs': the Hamilton product.
+		public: template<typename U>
+		friend constexpr decltype(auto)
+		operator*(Quat const& lhs, Quat<U> const& rhs)
+		noexcept {
+			return ink::generic_vec::Quat{
+				(lhs.w * rhs.x) + (lhs.x * rhs.w) + (lhs.y * rhs.z) - (lhs.z * rhs.y),
+				(lhs.w * rhs.y) - (lhs.x * rhs.z) + (lhs.y * rhs.w) + (lhs.z * rhs.x),
+				(lhs.w * rhs.z) + (lhs.x * rhs.y) - (lhs.y * rhs.x) + (lhs.z * rhs.w),
+				(lhs.w * rhs.w) - (lhs.x * rhs.x) - (lhs.y * rhs.y) - (lhs.z * rhs.z) };
+		}
+
+		public: friend constexpr bool
+		operator==(Quat const&, Quat const&)
+		noexcept = default;
+
+	};
+
+	template<typename T>
+	Quat(T, T, T, T) -> Quat<T>;
+
+	// The normalized linear interpolation of two unit quaternions, along the shorter arc. Cheap, but not at constant speed.
+	template<std::floating_point T>
+	inline Quat<T>
+	nlerp(Quat<T> const& from, Quat<T> const& to, T t)
+	noexcept {
+		const T s = from.dot(to) < T(0) ? -t : t;
+		return Quat<T>(
+			from.x + (to.x * s - from.x * t),
+			from.y + (to.y * s - from.y * t),
+			from.z + (to.z * s - from.z * t),
+			from.w + (to.w * s - from.w * t)).normalize();
+	}
+
+	// The spherical linear interpolation of two unit quaternions, along the shorter arc, at constant angular speed.
+	template<std::floating_point T>
+	inline Quat<T>
+	slerp(Quat<T> const& from, Quat<T> const& to, T t)
+	noexcept {
+		T d = from.dot(to);
+		const T sign = d < T(0) ? T(-1) : T(1);
+		d *= sign;
+		// Nearly parallel: the sines below vanish, and the straight line is as good as the arc.
+		if (d > T(0.9995)) return nlerp(from, to, t);
+		const T theta = std::acos(d);
+		const T inv_sin = T(1) / std::sin(theta);
+		const T a = std::sin((T(1) - t) * theta) * inv_sin;
+		const T b = std::sin(t * theta) * inv_sin * sign;
+		return Quat<T>(
+			from.x * a + to.x * b,
+			from.y * a + to.y * b,
+			from.z * a + to.z * b,
+			from.w * a + to.w * b);
+	}
+
+
+
+	namespace simd {
+
+		namespace detail {
+
+			// The matrix as the transform kernels take it: the x, y and z columns, then the translation.
+			template<typename T>
+			inline std::array<T, 12>
+			columns(Mat3<T> const& linear, Vec<T> const& translation)
+			noexcept {
+				return {
+					linear.x.x, linear.x.y, linear.x.z,
+					linear.y.x, linear.y.y, linear.y.z,
+					linear.z.x, linear.z.y, linear.z.z,
+					translation.x, translation.y, translation.z };
+			}
+
+		}
+
+		// out[i] = transform.transform_point(in[i]), for 'count' points. 'in' and 'out' may be the same array.
+		template<std::floating_point T>
+		inline void
+		transform_points(Affine<T> const& transform, Vec<T> const* in, Vec<T>* out, std::size_t count)
+		noexcept {
+			const auto m = detail::columns(transform.linear, transform.translation);
+			kernels<T>().transform[1](m.data(), detail::flat(in), detail::flat(out), count);
+		}
+
+		// out[i] = transform.transform_direction(in[i]), for 'count' directions. 'in' and 'out' may be the same array.
+		template<std::floating_point T>
+		inline void
+		transform_directions(Affine<T> const& transform, Vec<T> const* in, Vec<T>* out, std::size_t count)
+		noexcept {
+			const auto m = detail::columns(transform.linear, transform.translation);
+			kernels<T>().transform[0](m.data(), detail::flat(in), detail::flat(out), count);
+		}
+
+		// out[i] = mat * in[i], for 'count' vectors. 'in' and 'out' may be the same array.
+		template<std::floating_point T>
+		inline void
+		transform(Mat3<T> const& mat, Vec<T> const* in, Vec<T>* out, std::size_t count)
+		noexcept {
+			const auto m = detail::columns(mat, Vec<T>(T(0), T(0), T(0)));
+			kernels<T>().transform[0](m.data(), detail::flat(in), detail::flat(out), count);
+		}
+
+		// out[i] = rotation.rotate(in[i]), for 'count' vectors, through the matrix of the unit quaternion 'rotation'.
+		template<std::floating_point T>
+		inline void
+		rotate(Quat<T> const& rotation, Vec<T> const* in, Vec<T>* out, std::size_t count)
+		noexcept { simd::transform(Mat3<T>(rotation), in, out, count); }
+
+	}
+
+}
+
+namespace ink {
+
+	using generic_vec::Mat3;
+	using generic_vec::Affine;
+	using generic_vec::Quat;
+	using generic_vec::nlerp;
+	using generic_vec::slerp;
+
+}
+
+#endif
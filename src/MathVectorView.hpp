@@ -0,0 +1,243 @@
+#ifndef INK_GENERIC_VEC_VIEW_LIB_FILE_GUARD
+#define INK_GENERIC_VEC_VIEW_LIB_FILE_GUARD
+
+#include <cstddef>
+#include <compare>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include "MathVector.hpp"
+
+namespace ink {
+
+	namespace generic_vec {
+
+		namespace detail {
+
+			/**
+			 * One axis of a view: a base pointer, and the distance in bytes between consecutive elements.
+			 * Byte strides let an axis step over padding or unrelated attributes of any size.
+			 */
+			template<typename T>
+			class StridedLane {
+
+				private: using byte_type = std::conditional_t<std::is_const_v<T>, unsigned char const, unsigned char>;
+
+				private: T* M_data = nullptr;
+				private: std::ptrdiff_t M_stride = 0;
+
+				public: constexpr
+				StridedLane() = default;
+
+				public: constexpr
+				StridedLane(T* data, std::ptrdiff_t stride)
+				noexcept: M_data(data), M_stride(stride) {}
+
+				public: T&
+				operator[](std::ptrdiff_t i) const
+				noexcept { return *reinterpret_cast<T*>(reinterpret_cast<byte_type*>(M_data) + i * M_stride); }
+
+				public: constexpr T*
+				data() const
+				noexcept { return M_data; }
+
+				public: constexpr std::ptrdiff_t
+				stride() const
+				noexcept { return M_stride; }
+
+			};
+
+			// A 'void' axis has no storage to point into; every element of it is NoState.
+			template<>
+			class StridedLane<void> {
+
+				public: constexpr
+				StridedLane() = default;
+
+				public: constexpr
+				StridedLane(void const*, std::ptrdiff_t)
+				noexcept {}
+
+				public: constexpr NoState
+				operator[](std::ptrdiff_t) const
+				noexcept { return NoState(); }
+
+				public: constexpr std::nullptr_t
+				data() const
+				noexcept { return nullptr; }
+
+				public: constexpr std::ptrdiff_t
+				stride() const
+				noexcept { return 0; }
+
+			};
+
+			// Reference to an element of an axis, that stays 'void' for 'void' axes.
+			template<typename T> struct view_ref { using type = T&; };
+			template<> struct view_ref<void> { using type = void; };
+
+			template<typename T>
+			using view_ref_t = typename view_ref<T>::type;
+
+			template<typename T>
+			constexpr std::ptrdiff_t
+			element_stride()
+			noexcept {
+				if constexpr(std::is_void_v<T>) return 0;
+				else return sizeof(T);
+			}
+
+		}
+
+	}
+
+	namespace generic_vec {
+
+		/**
+		 * Non-owning view of 'count' vectors living in external memory, one strided lane per axis.
+		 * Elements are exposed as Vec<X&, Y&, Z&> proxies, so every Vec operator (including compound assignment)
+		 * reads and writes the underlying buffer directly. Use a const element type for read-only buffers.
+		 *
+		 * For tightly packed xyz data, prefer as_vecs(), which yields a real contiguous range of Vec<T>.
+		 */
+		template<typename X, typename Y = X, typename Z = Y>
+		class VecView {
+
+			public: using value_type = Vec<std::remove_const_t<X>, std::remove_const_t<Y>, std::remove_const_t<Z>>;
+			public: using reference = Vec<detail::view_ref_t<X>, detail::view_ref_t<Y>, detail::view_ref_t<Z>>;
+			public: using size_type = std::size_t;
+			public: using difference_type = std::ptrdiff_t;
+
+			private: detail::StridedLane<X> M_x;
+			private: detail::StridedLane<Y> M_y;
+			private: detail::StridedLane<Z> M_z;
+			private: size_type M_size = 0;
+
+
+
+			/**
+			 * Random access iterator, that holds the lanes of its view rather than a pointer to it, so that it stays valid
+			 * after a temporary view is gone. Dereferencing gives a reference proxy by value, which makes it a C++20
+			 * random_access_iterator, but only an input iterator to the C++17 iterator categories.
+			 */
+			public: class iterator {
+
+				public: using iterator_concept = std::random_access_iterator_tag;
+				public: using iterator_category = std::input_iterator_tag;
+				public: using value_type = VecView::value_type;
+				public: using reference = VecView::reference;
+				public: using difference_type = VecView::difference_type;
+				public: using pointer = void;
+
+				private: detail::StridedLane<X> M_x;
+				private: detail::StridedLane<Y> M_y;
+				private: detail::StridedLane<Z> M_z;
+				private: difference_type M_index = 0;
+
+				public: constexpr
+				iterator() = default;
+
+				public: constexpr
+				iterator(VecView const& view, difference_type index)
+				noexcept: M_x(view.M_x), M_y(view.M_y), M_z(view.M_z), M_index(index) {}
+
+				public: reference operator*() const noexcept { return reference(M_x[M_index], M_y[M_index], M_z[M_index]); }
+				public: reference operator[](difference_type n) const noexcept { return reference(M_x[M_index + n], M_y[M_index + n], M_z[M_index + n]); }
+
+				public: constexpr iterator& operator++() noexcept { ++M_index; return *this; }
+				public: constexpr iterator& operator--() noexcept { --M_index; return *this; }
+				public: constexpr iterator operator++(int) noexcept { iterator it = *this; ++M_index; return it; }
+				public: constexpr iterator operator--(int) noexcept { iterator it = *this; --M_index; return it; }
+				public: constexpr iterator& operator+=(difference_type n) noexcept { M_index += n; return *this; }
+				public: constexpr iterator& operator-=(difference_type n) noexcept { M_index -= n; return *this; }
+
+				public: friend constexpr iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+				public: friend constexpr iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+				public: friend constexpr iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+				public: friend constexpr difference_type operator-(iterator const& lhs, iterator const& rhs) noexcept { return lhs.M_index - rhs.M_index; }
+
+				public: friend constexpr bool operator==(iterator const& lhs, iterator const& rhs) noexcept { return lhs.M_index == rhs.M_index; }
+				public: friend constexpr auto operator<=>(iterator const& lhs, iterator const& rhs) noexcept { return lhs.M_index <=> rhs.M_index; }
+
+			};
+
+
+
+			public: constexpr
+			VecView() = default;
+
+			// Views 'count' vectors whose axes start at x, y and z, each advancing by its own stride in bytes.
+			public: constexpr
+			VecView(X* x, Y* y, Z* z, size_type count, difference_type stride_x, difference_type stride_y, difference_type stride_z)
+			noexcept: M_x(x, stride_x), M_y(y, stride_y), M_z(z, stride_z), M_size(count) {}
+
+			public: constexpr size_type size() const noexcept { return M_size; }
+			public: constexpr bool empty() const noexcept { return M_size == 0; }
+
+			public: constexpr iterator begin() const noexcept { return iterator(*this, 0); }
+			public: constexpr iterator end() const noexcept { return iterator(*this, static_cast<difference_type>(M_size)); }
+
+			// Returns a Vec of references to the i'th element.
+			public: reference
+			operator[](size_type i) const
+			noexcept {
+				const auto n = static_cast<difference_type>(i);
+				return reference(M_x[n], M_y[n], M_z[n]);
+			}
+
+			public: constexpr auto data_x() const noexcept { return M_x.data(); }
+			public: constexpr auto data_y() const noexcept { return M_y.data(); }
+			public: constexpr auto data_z() const noexcept { return M_z.data(); }
+
+		};
+
+
+
+		// Views xyz records of 'stride' bytes each (by default tightly packed), starting at 'data'.
+		template<typename T>
+		constexpr VecView<T>
+		interleaved(T* data, std::size_t count, std::ptrdiff_t stride = 3 * sizeof(T))
+		noexcept { return VecView<T>(data, data + 1, data + 2, count, stride, stride, stride); }
+
+		// Views records of 'stride' bytes each, where x, y and z point at the fields of the first record.
+		template<typename X, typename Y, typename Z>
+		constexpr VecView<X, Y, Z>
+		strided(X* x, Y* y, Z* z, std::size_t count, std::ptrdiff_t stride)
+		noexcept {
+			return VecView<X, Y, Z>(x, y, z, count,
+				std::is_void_v<X> ? 0 : stride,
+				std::is_void_v<Y> ? 0 : stride,
+				std::is_void_v<Z> ? 0 : stride);
+		}
+
+		// Views three separate arrays, one per axis (xxx yyy zzz).
+		template<typename X, typename Y, typename Z>
+		constexpr VecView<X, Y, Z>
+		planar(X* x, Y* y, Z* z, std::size_t count)
+		noexcept { return VecView<X, Y, Z>(x, y, z, count, detail::element_stride<X>(), detail::element_stride<Y>(), detail::element_stride<Z>()); }
+
+		/**
+		 * Reinterprets tightly packed xyz data as a contiguous span of Vec<T>.
+		 * Only available where Vec<T> is laid out exactly like three T, which holds for arithmetic T.
+		 */
+		template<typename T>
+		requires(detail::interleaved_layout<std::remove_const_t<T>>)
+		inline auto
+		as_vecs(T* data, std::size_t count)
+		noexcept {
+			using vec_type = std::conditional_t<std::is_const_v<T>, Vec<std::remove_const_t<T>> const, Vec<T>>;
+			return std::span<vec_type>(reinterpret_cast<vec_type*>(data), count);
+		}
+
+	}
+
+	using generic_vec::VecView;
+
+}
+
+// Its iterators hold no pointer to the view itself, so they outlive it.
+template<typename X, typename Y, typename Z>
+inline constexpr bool std::ranges::enable_borrowed_range<ink::generic_vec::VecView<X, Y, Z>> = true;
+
+#endif
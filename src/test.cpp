@@ -1,17 +1,1804 @@
 #include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <new>
 #include <numbers>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include "MathVector.hpp"
+#include "MathVectorArena.hpp"
+#include "MathVectorCompact.hpp"
+#include "MathVectorExpr.hpp"
+#include "MathVectorFile.hpp"
+#include "MathVectorGrid.hpp"
+#include "MathVectorMask.hpp"
+#include "MathVectorN.hpp"
+#include "MathVectorPadded.hpp"
+#include "MathVectorParallel.hpp"
+#include "MathVectorSimd.hpp"
+#include "MathVectorSoA.hpp"
+#include "MathVectorSpatial.hpp"
+#include "MathVectorStream.hpp"
+#include "MathVectorSum.hpp"
+#include "MathVectorSwizzle.hpp"
+#include "MathVectorTables.hpp"
+#include "MathVectorTransform.hpp"
+#include "MathVectorView.hpp"
 
+/*
+ * Runtime checks of the library, run by 'make run'. Each test_* function covers one header.
+ * Prints every failed check, with its line, and exits with a non-zero status if any failed.
+ */
+namespace ink {
 
+	// Unqualified scalar fma() inside ink must still find the one of <math.h>, rather than the one of Vec.
+	inline double
+	scalar_fma(double a, double b, double c)
+	noexcept { return fma(a, b, c); }
+
+}
+
+namespace {
+
+	int failures = 0;
+
+	void
+	check(bool condition, char const* expression, int line) {
+		if (condition) return;
+		++failures;
+		printf("test.cpp:%i: check failed: %s\n", line, expression);
+	}
+
+	#define INK_CHECK(...) check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __LINE__)
+
+	void
+	test_vec() {
+		int x = 0, y = 0;
+		ink::Vec<int&, int&, void> m(x, y);
+		m = ink::Vec(1, 2);
+		INK_CHECK(x == 1 && y == 2);
+
+		// fma() of Vec is found through argument-dependent lookup.
+		const ink::Vec<double> a(1., 2., 3.), b(4., 5., 6.);
+		INK_CHECK(all(fma(a, b, a) == ink::Vec<double>(5., 12., 21.)));
+		INK_CHECK(all(fma(a, 2., b) == ink::Vec<double>(6., 9., 12.)));
+		INK_CHECK(ink::scalar_fma(2., 3., 4.) == 10.);
+
+		// Compound assignment gives what the binary operators give, from a vector or a scalar.
+		using I = ink::Vec<int>;
+		const I i(7, -8, 9), j(2, 3, -4);
+		I k = i;
+		INK_CHECK(all((k += j) == i + j) && all((k -= j) == i) && all((k *= j) == i * j) && all((k /= j) == i));
+		k %= j;
+		INK_CHECK(all(k == i % j));
+		k = i;
+		k &= j; INK_CHECK(all(k == (i & j)));
+		k = i;
+		k |= j; INK_CHECK(all(k == (i | j)));
+		k = i;
+		k ^= j; INK_CHECK(all(k == (i ^ j)));
+		k = I(1, 2, 3);
+		k <<= I(1, 2, 3); INK_CHECK(all(k == I(2, 8, 24)));
+		k >>= I(1, 2, 3); INK_CHECK(all(k == I(1, 2, 3)));
+		k = i;
+		INK_CHECK(all((k += 3) == i + I(3, 3, 3)) && all((k -= 3) == i) && all((k *= 3) == i * 3) && all((k /= 3) == i));
+		k %= 4; INK_CHECK(all(k == i % 4));
+		k = i;
+		k <<= 2; INK_CHECK(all(k == (i << 2)));
+
+		// A 'void' axis of the rhs leaves that of the lhs as it is, and a 'void' axis of the lhs stays NoState.
+		using IIV = ink::Vec<int, int, void>;
+		k = i;
+		k += IIV(10, 20);
+		INK_CHECK(all(k == I(17, 12, 9)) && all(k == i + IIV(10, 20)));
+		k = i;
+		k *= IIV(2, 3);
+		INK_CHECK(all(k == I(14, -24, 9)));
+		k <<= IIV(1, 0);
+		INK_CHECK(all(k == I(28, -24, 9)));
+		k -= ink::Vec<void, void, int>(nullptr, nullptr, 9);
+		INK_CHECK(all(k == I(28, -24, 0)));
+		IIV partial(1, 2);
+		partial += i;
+		partial *= 3;
+		INK_CHECK(partial.x == 24 && partial.y == -18);
+
+		// Through references, into the variables they refer to.
+		int rx = 1, ry = 2, rz = 3;
+		ink::Vec<int&, int&, int&> view(rx, ry, rz);
+		view += I(10, 20, 30);
+		view *= 2;
+		view -= IIV(1, 1);
+		INK_CHECK(rx == 21 && ry == 43 && rz == 66);
+
+		// noexcept as the operations on the axes are, leaving out those a 'void' rhs axis skips.
+		ink::Vec<int, int, std::string> named(1, 2, "a");
+		static_assert(noexcept(k += j) && noexcept(k *= 2) && noexcept(view += j));
+		static_assert(!noexcept(named += ink::Vec<int, int, std::string>(1, 2, "b")));
+		static_assert(noexcept(named += IIV(1, 2)));
+		named += ink::Vec<int, int, std::string>(1, 2, "b");
+		named += IIV(1, 2);
+		INK_CHECK(named.x == 3 && named.y == 6 && named.z == "ab");
+
+		// A 'void' axis stays NoState through an operation with a scalar, on either side, instead of becoming 'NoState * 2'.
+		using IVI = ink::Vec<int, void, int>;
+		using VII = ink::Vec<void, int, int>;
+		const IVI s(7, nullptr, -9);
+		const VII t(nullptr, 5, 12);
+		const auto same = []<typename V>(V const& v, V const& expected) { return all(v == expected); };
+		INK_CHECK(same(s * 2, IVI(14, nullptr, -18)) && same(2 * s, IVI(14, nullptr, -18)));
+		INK_CHECK(same(s / 2, IVI(3, nullptr, -4)) && same(63 / s, IVI(9, nullptr, -7)));
+		INK_CHECK(same(s % 4, IVI(3, nullptr, -1)) && same(30 % s, IVI(2, nullptr, 3)));
+		INK_CHECK(same(t & 6, VII(nullptr, 4, 4)) && same(6 & t, VII(nullptr, 4, 4)));
+		INK_CHECK(same(t << 2, VII(nullptr, 20, 48)) && same(1 << t, VII(nullptr, 32, 4096)));
+		INK_CHECK(same(ink::Vec<float, void, float>(1.5f, nullptr, -2.5f) * 2.f, ink::Vec<float, void, float>(3.f, nullptr, -5.f)));
+		INK_CHECK(same(3.f / ink::Vec<float, void, float>(1.5f, nullptr, -2.f), ink::Vec<float, void, float>(2.f, nullptr, -1.5f)));
+
+		// cross with 'void' axes on either side gives what it gave when they went through DefaultToNoState: an axis only
+		// drops to NoState when neither of its products exists.
+		const IIV u(3, -5);
+		const I f(2, 3, 4);
+		INK_CHECK(same(u.cross(f), I(-20, -12, 19)) && same(f.cross(u), I(20, 12, -19)));
+		INK_CHECK(same(u.cross(IVI(7, nullptr, 2)), I(-10, -6, 35)));
+		INK_CHECK(same(IVI(7, nullptr, 2).cross(VII(nullptr, 4, -6)), I(-8, 42, 28)));
+		INK_CHECK(same(VII(nullptr, 4, -6).cross(u), I(-30, -18, -12)));
+		INK_CHECK(same(u.cross(u), ink::Vec<void, void, int>(nullptr, nullptr, 0)));
+		INK_CHECK(same(ink::Vec<int, void, void>(2, nullptr, nullptr).cross(ink::Vec<void, int, void>(nullptr, 3, nullptr)), ink::Vec<void, void, int>(nullptr, nullptr, 6)));
+	}
+
+	/**
+	 * Batched operations of VecSoA against the same operations on each of its vectors, 'void' axes and scalars
+	 * broadcast across the batch included.
+	 */
+	void
+	test_soa() {
+		using F = ink::Vec<float>;
+		using P = ink::Vec<float, void, float>;
+		constexpr std::size_t n = 37;
+
+		ink::VecSoA<float> a, b;
+		ink::VecSoA<float, void, float> p;
+		for (std::size_t i = 0; i < n; ++i) {
+			a.push_back(F(float(i) * .5f - 7.f, float(i % 5) + 1.f, -float(i) / 3.f));
+			b.push_back(F(float(i % 7) + .25f, -float(i) * 1.5f, float(i % 3) + 2.f));
+			p.push_back(P(float(i) - 3.f, nullptr, float(i % 4) + .5f));
+		}
+		INK_CHECK(a.size() == n && p.size() == n && !a.empty());
+		static_assert(std::same_as<decltype(p[0]), ink::Vec<float&, void, float&>>);
+
+		// Every element of 'soa' against f(i) of the operands at i.
+		const auto matches = [](auto const& soa, auto f) {
+			bool same = soa.size() == n;
+			for (std::size_t i = 0; same && i < n; ++i) same = all(soa[i] == f(i));
+			return same;
+		};
+		INK_CHECK(matches(a + b, [&](std::size_t i) { return F(a[i]) + F(b[i]); }));
+		INK_CHECK(matches(a - b, [&](std::size_t i) { return F(a[i]) - F(b[i]); }));
+		INK_CHECK(matches(a * b, [&](std::size_t i) { return F(a[i]) * F(b[i]); }));
+		INK_CHECK(matches(a / b, [&](std::size_t i) { return F(a[i]) / F(b[i]); }));
+		INK_CHECK(matches(a * 2.5f, [&](std::size_t i) { return F(a[i]) * 2.5f; }));
+		INK_CHECK(matches(2.5f * a, [&](std::size_t i) { return 2.5f * F(a[i]); }));
+		INK_CHECK(matches(a / 3.f, [&](std::size_t i) { return F(a[i]) / 3.f; }));
+		INK_CHECK(matches(a.cross(b), [&](std::size_t i) { return F(a[i]).cross(F(b[i])); }));
+
+		// 'void' axes on either side, and in the result.
+		INK_CHECK(matches(p + a, [&](std::size_t i) { return P(p[i]) + F(a[i]); }));
+		INK_CHECK(matches(a - p, [&](std::size_t i) { return F(a[i]) - P(p[i]); }));
+		INK_CHECK(matches(p * p, [&](std::size_t i) { return P(p[i]) * P(p[i]); }));
+		INK_CHECK(matches(p * 4.f, [&](std::size_t i) { return P(p[i]) * 4.f; }));
+		INK_CHECK(matches(p / a, [&](std::size_t i) { return P(p[i]) / F(a[i]); }));
+		INK_CHECK(matches(p.cross(a), [&](std::size_t i) { return P(p[i]).cross(F(a[i])); }));
+		INK_CHECK(matches(a.cross(p), [&](std::size_t i) { return F(a[i]).cross(P(p[i])); }));
+		static_assert(std::same_as<decltype(p * p), ink::VecSoA<float, void, float>>);
+
+		const std::vector<float> dots = a.dot(b), mixed = p.dot(a), mags = a.mag2();
+		bool same = dots.size() == n && mixed.size() == n && mags.size() == n;
+		for (std::size_t i = 0; same && i < n; ++i)
+			same = dots[i] == F(a[i]).dot(F(b[i])) && mixed[i] == P(p[i]).dot(F(a[i])) && mags[i] == F(a[i]).mag2();
+		INK_CHECK(same);
+
+		// Writes go through the references of operator[] into the lanes.
+		a[3] = F(1.f, 2.f, 3.f);
+		p[4].z = 9.f;
+		INK_CHECK(a.x[3] == 1.f && a.y[3] == 2.f && a.z[3] == 3.f && p.z[4] == 9.f);
+		const ink::VecSoA<int> filled(4, ink::Vec<int>(1, 2, 3));
+		INK_CHECK(filled.size() == 4 && all(filled[3] == ink::Vec<int>(1, 2, 3)));
+		a.clear();
+		INK_CHECK(a.empty() && (a + a).empty());
+	}
+
+	// Lazy assignment must give what the eager operators give, even when the target is one of the operands.
+	void
+	test_expr() {
+		using V = ink::Vec<int>;
+
+		V a(1, 2, 3), b(10, 20, 30);
+		a = ink::lazy(a) + b;
+		INK_CHECK(all(a == V(11, 22, 33)));
+
+		// The lhs reads u.y, u.z and u.x through references: assigning u.x first must not change what the z axis reads.
+		V u(1, 2, 3);
+		const V eager = V(u.y, u.z, u.x) * 2 + u;
+		u = ink::lazy(ink::Vec<int&, int&, int&>(u.y, u.z, u.x)) * 2 + u;
+		INK_CHECK(all(u == eager));
+		INK_CHECK(all(u == V(5, 8, 5)));
+
+		ink::Vec<float> f(1.f, 2.f, 3.f);
+		f = ink::lazy(f) / f.x - f * f.z;
+		INK_CHECK(all(f == ink::Vec<float>(-2.f, -4.f, -6.f)));
+	}
+
+	// Layouts of VecN follow aligned_axis_at: no padding between the axes, and 'void' ones take no room.
+	static_assert(sizeof(ink::VecN<char, double, int, char>) == 16);
+	static_assert(sizeof(ink::VecN<float, void, float, float>) == 3 * sizeof(float));
+	static_assert(sizeof(ink::VecN<float, float, float>) == sizeof(ink::Vec<float>));
+	static_assert(ink::generic_vec::detail::axis_order<char, double, int, char> == std::array<std::size_t, 4>{1, 2, 0, 3});
+
+	// Whether 'lhs op rhs' compiles, for the operators that mixed Vec and VecN operands could be mistaken for.
+	template<typename L, typename R>
+	constexpr bool
+	mixes()
+	noexcept {
+		return
+			requires(L const& l, R const& r) { l + r; } || requires(L const& l, R const& r) { l * r; } ||
+			requires(L const& l, R const& r) { l == r; } || requires(L const& l, R const& r) { l << r; } ||
+			requires(L& l, R const& r) { l += r; } || requires(L& l, R const& r) { l *= r; };
+	}
+
+	/**
+	 * PaddedVec against Vec: its four-lane operators must give what the Vec operators give on x, y and z, the padding
+	 * lane must stay out of every result, and any operand that is not a PaddedVec must fall back to the Vec operators.
+	 */
+	void
+	test_padded() {
+		using P = ink::PaddedVec<float>;
+		using F = ink::Vec<float>;
+		const P a(1.5f, -2.f, 4.f), b(.5f, 8.f, -3.f);
+		const auto same = []<typename V>(V const& v, auto const& expected) { return all(F(v) == expected); };
+
+		static_assert(std::same_as<decltype(a + b), P> && std::same_as<decltype(a * 2.f), P> && std::same_as<decltype(-a), P>);
+		INK_CHECK(same(a + b, F(a) + F(b)) && same(a - b, F(a) - F(b)) && same(a * b, F(a) * F(b)) && same(a / b, F(a) / F(b)));
+		INK_CHECK(same(a * 2.f, F(a) * 2.f) && same(2.f * a, 2.f * F(a)) && same(a / 4.f, F(a) / 4.f) && same(-a, -F(a)));
+
+		// The padding of a / b holds 0 / 0, which no result may see.
+		const P q = a / b;
+		INK_CHECK(q.dot(q) == F(q).dot(F(q)) && all(q == F(a) / F(b)) && q.mag2() == (F(a) / F(b)).mag2());
+
+		// Integers divide the padding by nothing, and leave it at zero.
+		using PI = ink::PaddedVec<int>;
+		const PI i(9, -8, 7), j(2, 3, -4);
+		INK_CHECK(all(ink::Vec<int>(i / j) == ink::Vec<int>(4, -2, -1)) && all(ink::Vec<int>(i / 2) == ink::Vec<int>(4, -4, 3)));
+		INK_CHECK(std::bit_cast<std::array<int, 4>>(i / j)[3] == 0 && std::bit_cast<std::array<int, 4>>(i * j / 2)[3] == 0);
+
+		// Compound assignment, from a padded vector, a Vec, or a scalar.
+		P k = a;
+		k += b; INK_CHECK(same(k, F(a) + F(b)));
+		k -= b; INK_CHECK(same(k, F(a)));
+		k *= b; INK_CHECK(same(k, F(a) * F(b)));
+		k /= b; INK_CHECK(same(k, F(a)));
+		k += F(1.f, 1.f, 1.f); INK_CHECK(same(k, F(a) + F(1.f, 1.f, 1.f)));
+		k = a;
+		k *= 2.f; INK_CHECK(same(k, F(a) * 2.f));
+		k /= 2.f; INK_CHECK(same(k, F(a)));
+		static_assert(std::same_as<decltype(k += b), P&> && std::same_as<decltype(k += F()), F&>);
+
+		// To and from Vec, keeping x, y and z.
+		const F plain(3.f, 5.f, 7.f);
+		const P padded = plain;
+		const F back = padded;
+		INK_CHECK(padded.x == 3.f && padded.y == 5.f && padded.z == 7.f && all(back == plain));
+		INK_CHECK(std::bit_cast<std::array<float, 4>>(padded)[3] == 0.f);
+
+		// Mixed with a Vec, or with a scalar that does not keep the lane type, the Vec operators take over.
+		static_assert(std::same_as<decltype(a + plain), F> && std::same_as<decltype(plain * a), F>);
+		static_assert(std::same_as<decltype(a * 2.), ink::Vec<double>>);
+		INK_CHECK(all(a + plain == F(a) + plain) && all(plain - a == plain - F(a)) && all(a * plain == F(a) * plain));
+		INK_CHECK(all(a / plain == F(a) / plain) && all(a * 2. == F(a) * 2.) && a.dot(plain) == F(a).dot(plain));
+	}
+
+	/**
+	 * VecN against the same operations on plain scalars, constructors whose arguments the layout reorders, and the
+	 * operators of mixed Vec and VecN operands, which must not compile rather than take either side for a scalar.
+	 */
+	void
+	test_vec_n() {
+		using ink::VecN;
+		using ink::get;
+
+		INK_CHECK(all(VecN(1, 2, 3, 4) + VecN(4, 3, 2, 1) == VecN(5, 5, 5, 5)));
+		INK_CHECK(VecN(1, 2, 3, 4).dot(VecN(1, 1, 1, 1)) == 10 && VecN(1., 2., 2.).mag() == 3.);
+		const auto scaled = VecN<int, void, float>(1, nullptr, 2.f) * 2;
+		static_assert(std::same_as<decltype(scaled), VecN<int, void, float> const>);
+		INK_CHECK(get<0>(scaled) == 2 && get<2>(scaled) == 4.f);
+		INK_CHECK(VecN<int, void, int>(1, nullptr, 2).mag2() == 5);
+		INK_CHECK(all(VecN(ink::Vec<int>(1, 2, 3)).to_vec() == ink::Vec<int>(1, 2, 3)));
+
+		// Stored double, int, char, char, and yet built and read in declaration order.
+		const VecN<char, double, int, char> packed('a', 2.5, 7, 'b');
+		const auto [c0, d1, i2, c3] = packed;
+		INK_CHECK(c0 == 'a' && d1 == 2.5 && i2 == 7 && c3 == 'b');
+		std::vector<int> items{1, 2, 3};
+		VecN<int, std::vector<int>, double> owning(1, std::move(items), 3.);
+		INK_CHECK(items.empty() && get<1>(owning).size() == 3);
+		const std::vector<int> moved = get<1>(std::move(owning));
+		INK_CHECK(moved.size() == 3 && get<1>(owning).empty());
+
+		VecN<int, int, int, int> v(12, -7, 5, 0);
+		INK_CHECK(all((v % 5) == VecN(12 % 5, -7 % 5, 0, 0)) && all((v << 2) == VecN(48, -28, 20, 0)) && all((2 - v) == VecN(-10, 9, -3, 2)));
+		INK_CHECK(all((v < VecN(13, -7, 4, 1)) == VecN(true, false, false, true)) && any(v >= VecN(12, 0, 0, 0)));
+		const auto order = v <=> VecN(12, -8, 6, 0);
+		INK_CHECK(get<0>(order) == 0 && get<1>(order) > 0 && get<2>(order) < 0 && get<3>(order) == 0);
+		v += VecN(1, 1, 1, 1);
+		v *= 2;
+		v >>= 1;
+		INK_CHECK(all(v == VecN(13, -6, 6, 1)) && all(-v == VecN(-13, 6, -6, -1)) && all(~VecN(0u, 1u) == VecN(~0u, ~1u)));
+		INK_CHECK(all(ink::generic_vec::fma(VecN(1., 2.), 3., VecN(1., 1.)) == VecN(4., 7.)));
+		INK_CHECK(all(min(VecN(1, 5), VecN(3, 2)) == VecN(1, 2)) && all(max(VecN(1, 5), VecN(3, 2)) == VecN(3, 5)));
+
+		using V = ink::Vec<int>;
+		using N = VecN<int, int, int>;
+		static_assert(!mixes<V, N>() && !mixes<N, V>());
+		static_assert(!mixes<ink::Vec<float, float, void>, VecN<float, float>>() && !mixes<VecN<float, float>, ink::Vec<float, float, void>>());
+		static_assert(mixes<V, int>() && mixes<N, int>() && mixes<int, N>() && mixes<N, N>());
+		INK_CHECK(all(V(1, 2, 3) + N(V(1, 1, 1)).to_vec() == V(2, 3, 4)) && all(N(V(1, 2, 3)) * 2 == N(2, 4, 6)));
+	}
+
+	// The iterators of every kind of view must satisfy the C++20 concepts the standard algorithms are constrained with.
+	template<typename View>
+	constexpr bool
+	view_concepts()
+	noexcept {
+		using It = std::ranges::iterator_t<View>;
+		return
+			std::indirectly_readable<It> && std::input_iterator<It> && std::random_access_iterator<It> &&
+			std::ranges::random_access_range<View> && std::ranges::sized_range<View> && std::ranges::borrowed_range<View>;
+	}
+
+	static_assert(view_concepts<ink::VecView<float>>());
+	static_assert(view_concepts<ink::VecView<float const>>());
+	static_assert(view_concepts<ink::VecView<float, void, double>>());
+	static_assert(view_concepts<ink::VecView<int> const>());
+	static_assert(std::same_as<std::common_reference_t<ink::Vec<float&, float&, float&>, ink::Vec<float>&>, ink::Vec<float>>);
+
+	void
+	test_view() {
+		using V = ink::Vec<float>;
+		float data[12] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+
+		// The iterator stays valid after the temporary view it came from is gone.
+		const auto found = std::ranges::find_if(ink::generic_vec::interleaved(data, 4), [](V const& v) { return v.x > 3.f; });
+		INK_CHECK(all(V(*found) == V(4.f, 5.f, 6.f)));
+
+		const auto view = ink::generic_vec::interleaved(data, 4);
+		INK_CHECK(std::ranges::count_if(view, [](V const& v) { return v.z > 6.f; }) == 2);
+		INK_CHECK(view.end() - view.begin() == 4 && all(V(view.begin()[3]) == V(10.f, 11.f, 12.f)));
+
+		for (auto v : view) v *= 2.f;
+		INK_CHECK(data[0] == 2.f && data[11] == 24.f);
+
+		std::vector<V> copied;
+		std::ranges::copy(view | std::views::reverse, std::back_inserter(copied));
+		INK_CHECK(copied.size() == 4 && all(copied[0] == V(20.f, 22.f, 24.f)) && all(copied[3] == V(2.f, 4.f, 6.f)));
+
+		float x[3] = { 1, 2, 3 };
+		double z[3] = { 4, 5, 6 };
+		const auto planar = ink::generic_vec::planar(x, static_cast<void*>(nullptr), z, 3);
+		const auto max_z = std::ranges::max_element(planar, {}, [](auto const& v) { return double(v.z); });
+		INK_CHECK((*max_z).x == 3.f && max_z - planar.begin() == 2);
+	}
+
+	/**
+	 * Pairwise and Kahan sums of a million vectors stay within a few ulps of the sum of their magnitudes, against a
+	 * double precision reference, where the naive sum of an axis that keeps adding the same value drifts well past it.
+	 * Vectors that are not three floats of one type go through the Vec operators, and must hold to the same bounds.
+	 */
+	void
+	test_sum() {
+		using ink::Summation;
+		using ink::generic_vec::sum;
+		using V = ink::Vec<float>;
+		using M = ink::Vec<float, void, double>;
+		static_assert(!ink::generic_vec::detail::flat_summable<M>);
+		constexpr std::size_t n = 1 << 20;
+		constexpr double eps = std::numeric_limits<float>::epsilon();
+
+		std::mt19937 rng(7);
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+		std::vector<V> vecs(n);
+		std::vector<M> mixed(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			vecs[i] = V(unit(rng), .1f, unit(rng) * 2.f - .5f);
+			mixed[i] = M(vecs[i].x, nullptr, vecs[i].z);
+		}
+
+		// Relative error of each axis of 'total' to the sum of that axis, scaled by the sum of its magnitudes.
+		double exact[3] = {}, magnitude[3] = {};
+		for (V const& v : vecs) {
+			exact[0] += v.x; exact[1] += v.y; exact[2] += v.z;
+			magnitude[0] += std::fabs(v.x); magnitude[1] += std::fabs(v.y); magnitude[2] += std::fabs(v.z);
+		}
+		const auto within = [&](double ulps, double x, double y, double z) {
+			return std::fabs(x - exact[0]) <= ulps * eps * magnitude[0]
+				&& std::fabs(y - exact[1]) <= ulps * eps * magnitude[1]
+				&& std::fabs(z - exact[2]) <= ulps * eps * magnitude[2];
+		};
+
+		const V pairwise = sum<Summation::Pairwise>(vecs.data(), n), kahan = sum<Summation::Kahan>(vecs.data(), n);
+		const V naive = sum<Summation::Naive>(vecs.data(), n);
+		INK_CHECK(within(16., pairwise.x, pairwise.y, pairwise.z));
+		INK_CHECK(within(2., kahan.x, kahan.y, kahan.z));
+		INK_CHECK(!within(16., naive.x, naive.y, naive.z));
+		INK_CHECK(std::fabs(naive.y - exact[1]) > 100. * eps * magnitude[1]);
+
+		const M mixed_pairwise = sum<Summation::Pairwise>(mixed.data(), n), mixed_kahan = sum<Summation::Kahan>(mixed.data(), n);
+		INK_CHECK(within(16., mixed_pairwise.x, exact[1], mixed_pairwise.z));
+		INK_CHECK(within(2., mixed_kahan.x, exact[1], mixed_kahan.z));
+		INK_CHECK(sum<Summation::Naive>(mixed.data(), n).z == exact[2]);
+
+		// Nothing to add up gives zero, in every mode.
+		INK_CHECK(all(sum<Summation::Naive>(vecs.data(), 0) == V(0.f, 0.f, 0.f)));
+		INK_CHECK(all(sum<Summation::Pairwise>(vecs.data(), 0) == V(0.f, 0.f, 0.f)));
+		INK_CHECK(all(sum<Summation::Kahan>(vecs.data(), 0) == V(0.f, 0.f, 0.f)));
+		INK_CHECK(all(sum<Summation::Kahan>(mixed.data(), 0) == M(0.f, nullptr, 0.)));
+		INK_CHECK(all(sum(static_cast<ink::Vec<int> const*>(nullptr), 0) == ink::Vec<int>(0, 0, 0)));
+	}
+
+	// The Fast tier stays within 3 ulps of Exact, keeps infinities and NaN, and every instruction set agrees with Vec.
+	void
+	test_precision() {
+		using V = ink::Vec<float>;
+		using ink::Precision;
+		namespace simd = ink::generic_vec::simd;
+		constexpr float inf = std::numeric_limits<float>::infinity();
+		constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+		const V vecs[] = {
+			V(3.f, 4.f, 12.f), V(1e-3f, 2e-3f, -5e-4f), V(1e18f, -3e17f, 2e18f), V(0.f, 0.f, 0.f),
+			V(inf, 0.f, 0.f), V(-inf, 1.f, 1.f), V(nan, 1.f, 1.f), V(0.5f, 0.25f, 2.f), V(7.f, -7.f, 7.f),
+		};
+		constexpr std::size_t count = std::size(vecs);
+
+		// Within 3 ulps of 'exact', or the same infinity or NaN. Instruction sets have estimates of different precisions.
+		const auto close = [](float fast, float exact) {
+			if (std::isnan(exact) || std::isnan(fast)) return std::isnan(exact) && std::isnan(fast);
+			if (std::isinf(exact)) return fast == exact;
+			return std::fabs(fast - exact) <= 3.f * std::numeric_limits<float>::epsilon() * exact;
+		};
+
+		for (V const& v : vecs) INK_CHECK(close(v.mag<Precision::Fast>(), v.mag()));
+		INK_CHECK(V(inf, 0.f, 0.f).inv_mag<Precision::Fast>() < 1e-19f);
+		INK_CHECK(std::isnan(V(nan, 0.f, 0.f).inv_mag<Precision::Fast>()));
+
+		for (auto isa : { simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+			if (isa > simd::active_isa()) continue;
+			const auto table = simd::kernels_for<float>(isa);
+			float mags[count], inv_mags[count];
+			table.mag[std::size_t(Precision::Fast)](simd::detail::flat(vecs), mags, count);
+			table.inv_mag[std::size_t(Precision::Fast)](simd::detail::flat(vecs), inv_mags, count);
+			for (std::size_t i = 0; i < count; ++i) {
+				INK_CHECK(close(mags[i], vecs[i].mag()));
+				// Skips the zero vector, whose Fast inverse is NaN, and infinite ones, whose Fast inverse is not 0.
+				if (vecs[i].mag() > 0.f && vecs[i].mag() < inf) INK_CHECK(close(inv_mags[i], vecs[i].inv_mag()));
+			}
+		}
+	}
+
+	// Equal, or both NaN.
+	template<typename T>
+	bool
+	same_scalar(T a, T b)
+	{ return a == b || (std::isnan(a) && std::isnan(b)); }
+
+	// The expected results, inlined from the operators of Vec, must not be contracted into fused multiply-adds either
+	// when built for a processor that has them, as the kernels are not. See MathVectorSimd.hpp.
+	#if defined(__clang__)
+	#pragma float_control(push)
+	#pragma clang fp contract(off)
+	#elif defined(__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC optimize("fp-contract=off")
+	#endif
+
+	/**
+	 * The element-wise, comparison and geometric kernels of every instruction set against the operators of Vec, over
+	 * every length up to two of the widest registers and then some, so that every kind of tail runs. Some lanes are
+	 * NaN, infinite, or equal on both sides, and some vectors are parallel, whose cross product is exactly 0.
+	 */
+	template<std::floating_point T>
+	void
+	test_kernels_of() {
+		namespace simd = ink::generic_vec::simd;
+		using V = ink::Vec<T>;
+		using Precision = ink::Precision;
+		constexpr std::size_t count = 2 * 64 / sizeof(T) + 3;
+		constexpr T nan = std::numeric_limits<T>::quiet_NaN(), inf = std::numeric_limits<T>::infinity();
+		constexpr T sentinel = T(-12345);
+
+		std::vector<V> lhs(count), rhs(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			lhs[i] = V(T(i) * T(0.37) - T(5), T(i % 7) + T(0.1), T(1) / T(i + 3));
+			rhs[i] = V(T(3) - T(i) * T(0.61), T(i % 4) * T(1.3) + T(0.2), T(i) * T(0.011) - T(0.2));
+			if (i % 5 == 0) rhs[i] = lhs[i];
+			if (i % 5 == 1) rhs[i] = lhs[i] * T(3);
+			if (i % 7 == 2) lhs[i].y = nan;
+			if (i % 9 == 4) rhs[i].x = nan;
+			if (i % 11 == 6) lhs[i].z = inf;
+		}
+		const T scalar = T(0.7);
+
+		// Expected results, one per vector, from the operators of Vec.
+		std::vector<V> add(count), sub(count), mul(count), div(count), mul_scalar(count), div_scalar(count), cross(count), normalized(count);
+		std::vector<ink::Vec<bool>> cmp[6];
+		std::vector<T> dot(count), mag(count), inv_mag(count), distance(count);
+		for (auto& c : cmp) c.resize(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			V const& l = lhs[i];
+			V const& r = rhs[i];
+			add[i] = l + r; sub[i] = l - r; mul[i] = l * r; div[i] = l / r;
+			mul_scalar[i] = l * scalar; div_scalar[i] = l / scalar;
+			cmp[0][i] = l == r; cmp[1][i] = l != r; cmp[2][i] = l < r; cmp[3][i] = l <= r; cmp[4][i] = l > r; cmp[5][i] = l >= r;
+			dot[i] = l.dot(r); cross[i] = l.cross(r);
+			mag[i] = l.mag(); inv_mag[i] = l.inv_mag(); normalized[i] = l.normalize(); distance[i] = l.distance(r);
+		}
+
+		// The first 'n' scalars of 'out' against those of 'expected', and the rest of 'out' untouched.
+		const auto matches = [](auto const& out, auto const* expected, std::size_t n, auto untouched) {
+			bool same = true;
+			for (std::size_t i = 0; i < out.size(); ++i) same = same && (i < n ? same_scalar(out[i], expected[i]) : out[i] == untouched);
+			return same;
+		};
+		const auto flat = [](auto const& values) {
+			using E = std::ranges::range_value_t<decltype(values)>;
+			if constexpr(std::is_arithmetic_v<E>) return values.data();
+			else return reinterpret_cast<typename E::value_type_x const*>(values.data());
+		};
+
+		for (auto isa : { simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+			if (isa > simd::active_isa()) continue;
+			const auto table = simd::kernels_for<T>(isa);
+			bool element_wise = true, compared = true, geometric = true;
+			for (std::size_t n = 0; n <= count; ++n) {
+				std::vector<T> out(3 * count, sentinel);
+				// 'kernel' on 'n' of lhs and rhs, writing 'written' scalars.
+				const auto run = [&](auto kernel, auto const& expected, std::size_t written) {
+					std::ranges::fill(out, sentinel);
+					kernel(simd::detail::flat(lhs.data()), simd::detail::flat(rhs.data()), out.data(), n);
+					return matches(out, flat(expected), written, sentinel);
+				};
+				element_wise = element_wise && run(table.add, add, n) && run(table.sub, sub, n) && run(table.mul, mul, n) && run(table.div, div, n);
+				std::ranges::fill(out, sentinel);
+				table.mul_scalar(simd::detail::flat(lhs.data()), scalar, out.data(), n);
+				element_wise = element_wise && matches(out, flat(mul_scalar), n, sentinel);
+				std::ranges::fill(out, sentinel);
+				table.div_scalar(simd::detail::flat(lhs.data()), scalar, out.data(), n);
+				element_wise = element_wise && matches(out, flat(div_scalar), n, sentinel);
+
+				for (std::size_t op = 0; op < 6; ++op) {
+					std::vector<unsigned char> bools(3 * count, 2);
+					table.cmp[op](simd::detail::flat(lhs.data()), simd::detail::flat(rhs.data()), reinterpret_cast<bool*>(bools.data()), n);
+					bool same = true;
+					for (std::size_t i = 0; i < bools.size(); ++i) same = same && bools[i] == (i < n ? flat(cmp[op])[i] : 2);
+					compared = compared && same;
+				}
+
+				// The geometric kernels take 'n' vectors.
+				geometric = geometric && run(table.dot, dot, n) && run(table.cross, cross, 3 * n) && run(table.distance[std::size_t(Precision::Exact)], distance, n);
+				std::ranges::fill(out, sentinel);
+				table.mag[std::size_t(Precision::Exact)](simd::detail::flat(lhs.data()), out.data(), n);
+				geometric = geometric && matches(out, mag.data(), n, sentinel);
+				std::ranges::fill(out, sentinel);
+				table.inv_mag[std::size_t(Precision::Exact)](simd::detail::flat(lhs.data()), out.data(), n);
+				geometric = geometric && matches(out, inv_mag.data(), n, sentinel);
+				std::ranges::fill(out, sentinel);
+				table.normalize[std::size_t(Precision::Exact)](simd::detail::flat(lhs.data()), out.data(), n);
+				geometric = geometric && matches(out, flat(normalized), 3 * n, sentinel);
+			}
+			INK_CHECK(element_wise);
+			INK_CHECK(compared);
+			INK_CHECK(geometric);
+		}
+
+		// The entry points, through the kernels of the active instruction set.
+		std::vector<V> out(count);
+		std::vector<ink::Vec<bool>> bools(count);
+		std::vector<T> scalars(count);
+		const auto same_vecs = [&](std::vector<V> const& expected) { return matches(std::span<T const>(flat(out), 3 * count), flat(expected), 3 * count, T()); };
+		simd::add(lhs.data(), rhs.data(), out.data(), count);
+		INK_CHECK(same_vecs(add));
+		simd::sub(lhs.data(), rhs.data(), out.data(), count);
+		INK_CHECK(same_vecs(sub));
+		simd::mul(lhs.data(), rhs.data(), out.data(), count);
+		INK_CHECK(same_vecs(mul));
+		simd::div(lhs.data(), rhs.data(), out.data(), count);
+		INK_CHECK(same_vecs(div));
+		simd::mul(lhs.data(), scalar, out.data(), count);
+		INK_CHECK(same_vecs(mul_scalar));
+		simd::div(lhs.data(), scalar, out.data(), count);
+		INK_CHECK(same_vecs(div_scalar));
+		simd::cross(lhs.data(), rhs.data(), out.data(), count);
+		INK_CHECK(same_vecs(cross));
+		simd::dot(lhs.data(), rhs.data(), scalars.data(), count);
+		INK_CHECK(matches(scalars, dot.data(), count, T()));
+
+		const auto same_bools = [&](std::size_t op) {
+			return std::ranges::equal(bools, cmp[op], [](ink::Vec<bool> const& a, ink::Vec<bool> const& b) { return all(a == b); });
+		};
+		simd::equal(lhs.data(), rhs.data(), bools.data(), count);
+		INK_CHECK(same_bools(0));
+		simd::not_equal(lhs.data(), rhs.data(), bools.data(), count);
+		INK_CHECK(same_bools(1));
+		simd::less(lhs.data(), rhs.data(), bools.data(), count);
+		INK_CHECK(same_bools(2));
+		simd::less_equal(lhs.data(), rhs.data(), bools.data(), count);
+		INK_CHECK(same_bools(3));
+		simd::greater(lhs.data(), rhs.data(), bools.data(), count);
+		INK_CHECK(same_bools(4));
+		simd::greater_equal(lhs.data(), rhs.data(), bools.data(), count);
+		INK_CHECK(same_bools(5));
+	}
+
+	#if defined(__clang__)
+	#pragma float_control(pop)
+	#elif defined(__GNUC__)
+	#pragma GCC pop_options
+	#endif
+
+	void
+	test_kernels() {
+		test_kernels_of<float>();
+		test_kernels_of<double>();
+	}
+
+	template<typename... T>
+	inline constexpr bool all_bitwise_copyable = (ink::bitwise_copyable<ink::Vec<T>> && ...);
+
+	static_assert(all_bitwise_copyable<bool, char, signed char, unsigned char, short, unsigned short, int, unsigned,
+		long, unsigned long, long long, unsigned long long, float, double, long double>);
+	static_assert(ink::bitwise_copyable<ink::Vec<float, double, int>> && ink::bitwise_copyable<ink::Vec<std::int8_t, float, std::uint64_t>>);
+	static_assert(ink::bitwise_copyable<ink::Vec<float, void, void>> && ink::bitwise_copyable<ink::Vec<void, double, void>>);
+	static_assert(ink::bitwise_copyable<ink::Vec<void, int, float>> && ink::bitwise_copyable<ink::Vec<void, void, void>>);
+	static_assert(ink::generic_vec::detail::interleaved_layout<std::int8_t> && ink::generic_vec::detail::interleaved_layout<std::int16_t>);
+	static_assert(ink::generic_vec::detail::interleaved_layout<std::int32_t> && ink::generic_vec::detail::interleaved_layout<std::int64_t>);
+	static_assert(ink::generic_vec::detail::interleaved_layout<float> && ink::generic_vec::detail::interleaved_layout<double>);
+	static_assert(sizeof(ink::Vec<float, void, void>) == sizeof(float) && sizeof(ink::Vec<void, void, double>) == sizeof(double));
+	static_assert(sizeof(ink::Vec<bool>) == 3 * sizeof(bool));
+
+	/**
+	 * The cast kernels of every instruction set against static_cast, over lengths that leave every kind of tail, then
+	 * simd::convert() down each of its paths, and simd::copy() between overlapping arrays.
+	 */
+	void
+	test_convert() {
+		namespace simd = ink::generic_vec::simd;
+
+		constexpr std::size_t n = 67;
+		std::vector<float> floats(n);
+		std::vector<double> doubles(n);
+		std::vector<std::int32_t> ints(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			const double sign = i % 2 == 0 ? 1. : -1.;
+			floats[i] = float(sign * (double(i) * 0.75 + (i % 5 == 0 ? 0.5 : 0.)));
+			doubles[i] = sign * (double(i) * 1e7 + 0.999);
+			ints[i] = std::int32_t(sign * double(i) * 32000011.);
+		}
+		floats[1] = -0.f;
+		floats[2] = 2147483520.f;
+		floats[3] = -2147483648.f;
+		doubles[1] = 1e300;
+		doubles[2] = -std::numeric_limits<double>::infinity();
+		doubles[3] = 1e-310;
+		doubles[4] = 2147483647.9;
+		ints[1] = std::numeric_limits<std::int32_t>::max();
+		ints[2] = std::numeric_limits<std::int32_t>::min();
+		ints[3] = 16777217;
+
+		// doubles[1] and doubles[2] are out of the range of int32, where static_cast is undefined: 'out_of_range' skips them.
+		const auto matches = [](auto const& out, auto const& in, std::size_t count, bool out_of_range = false) {
+			using T = std::ranges::range_value_t<decltype(out)>;
+			bool same = true;
+			for (std::size_t i = 0; i < count; ++i) same = same && ((out_of_range && (i == 1 || i == 2)) || out[i] == static_cast<T>(in[i]));
+			return same;
+		};
+		for (auto isa : { simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+			if (isa > simd::active_isa()) continue;
+			const auto float_table = simd::kernels_for<float>(isa);
+			const auto double_table = simd::kernels_for<double>(isa);
+			for (std::size_t count = 0; count <= n; count += count < 20 ? 1 : 7) {
+				std::vector<std::int32_t> to_int(n, -1);
+				std::vector<float> to_float(n, -1.f);
+				std::vector<double> to_double(n, -1.);
+
+				float_table.to_int32(floats.data(), to_int.data(), count);
+				INK_CHECK(matches(to_int, floats, count) && (count == n || to_int[count] == -1));
+				double_table.to_int32(doubles.data(), to_int.data(), count);
+				INK_CHECK(matches(to_int, doubles, count, true));
+				float_table.from_int32(ints.data(), to_float.data(), count);
+				INK_CHECK(matches(to_float, ints, count));
+				double_table.from_int32(ints.data(), to_double.data(), count);
+				INK_CHECK(matches(to_double, ints, count));
+				float_table.to_other(floats.data(), to_double.data(), count);
+				INK_CHECK(matches(to_double, floats, count));
+				double_table.to_other(doubles.data(), to_float.data(), count);
+				INK_CHECK(matches(to_float, doubles, count) && (count == n || to_float[count] == -1.f));
+			}
+		}
+
+		using F = ink::Vec<float>;
+		using D = ink::Vec<double>;
+		using I = ink::Vec<std::int32_t>;
+		constexpr std::size_t count = n / 3;
+		std::vector<F> fs(count);
+		std::vector<std::int16_t> shorts(3 * count);
+		for (std::size_t i = 0; i < count; ++i) fs[i] = F(floats[3 * i], floats[3 * i + 1], -floats[3 * i + 2]);
+		for (std::size_t i = 0; i < shorts.size(); ++i) shorts[i] = std::int16_t(int(i * 997 % 65536) - 32768);
+		const auto per_axis = [&](auto const& from, auto& to) {
+			for (std::size_t i = 0; i < count; ++i) to[i] = std::remove_cvref_t<decltype(to[i])>(from[i]);
+			return to;
+		};
+
+		std::vector<I> is(count), is_expected(count);
+		simd::convert(fs.data(), is.data(), count);
+		INK_CHECK(std::ranges::equal(is, per_axis(fs, is_expected), [](I const& a, I const& b) { return all(a == b); }));
+		std::vector<D> ds(count), ds_expected(count);
+		simd::convert(is.data(), ds.data(), count);
+		INK_CHECK(std::ranges::equal(ds, per_axis(is, ds_expected), [](D const& a, D const& b) { return all(a == b); }));
+		std::vector<F> back(count);
+		simd::convert(ds.data(), back.data(), count);
+		INK_CHECK(std::ranges::equal(back, is, [](F const& a, I const& b) { return all(a == F(b)); }));
+
+		// A flat loop, between types of no kernel.
+		std::vector<ink::Vec<std::int16_t>> short_vecs(count);
+		for (std::size_t i = 0; i < count; ++i) short_vecs[i] = ink::Vec<std::int16_t>(shorts[3 * i], shorts[3 * i + 1], shorts[3 * i + 2]);
+		simd::convert(short_vecs.data(), ds.data(), count);
+		INK_CHECK(std::ranges::equal(ds, per_axis(short_vecs, ds_expected), [](D const& a, D const& b) { return all(a == b); }));
+
+		// One vector at a time, between mixed and 'void' axes.
+		using M = ink::Vec<float, double, std::int32_t>;
+		using N = ink::Vec<double, float, long>;
+		std::vector<M> mixed(count);
+		std::vector<N> converted(count);
+		for (std::size_t i = 0; i < count; ++i) mixed[i] = M(fs[i].x, ds[i].y, is[i].z);
+		simd::convert(mixed.data(), converted.data(), count);
+		bool same = true;
+		for (std::size_t i = 0; i < count; ++i) same = same && converted[i].x == double(mixed[i].x) && converted[i].y == float(mixed[i].y) && converted[i].z == long(mixed[i].z);
+		INK_CHECK(same);
+		std::vector<ink::Vec<float, void, float>> planes(count);
+		std::vector<ink::Vec<double, void, double>> planes_out(count);
+		for (std::size_t i = 0; i < count; ++i) planes[i] = ink::Vec<float, void, float>(fs[i].x, nullptr, fs[i].z);
+		simd::convert(planes.data(), planes_out.data(), count);
+		INK_CHECK(std::ranges::equal(planes, planes_out, [](auto const& a, auto const& b) { return double(a.x) == b.x && double(a.z) == b.z; }));
+
+		// Same type: a copy, which may overlap either way.
+		std::vector<F> copies(count);
+		simd::convert(fs.data(), copies.data(), count);
+		INK_CHECK(std::ranges::equal(copies, fs, [](F const& a, F const& b) { return all(a == b); }));
+		simd::copy(copies.data(), copies.data() + 1, count - 1);
+		INK_CHECK(all(copies[0] == fs[0]) && std::ranges::equal(copies.begin() + 1, copies.end(), fs.begin(), fs.end() - 1, [](F const& a, F const& b) { return all(a == b); }));
+		simd::copy(copies.data() + 1, copies.data(), count - 1);
+		INK_CHECK(std::ranges::equal(copies.begin(), copies.end() - 1, fs.begin(), fs.end() - 1, [](F const& a, F const& b) { return all(a == b); }));
+		simd::copy(fs.data(), copies.data(), 0);
+		INK_CHECK(all(copies[0] == fs[0]));
+	}
+
+	/**
+	 * Masks of single vectors, select() and blend(), then the batch compares of every instruction set against mask()
+	 * of each vector, NaN and equal axes included. select() is found by argument-dependent lookup: it is not in ink.
+	 */
+	void
+	test_mask() {
+		namespace gv = ink::generic_vec;
+		namespace simd = ink::generic_vec::simd;
+		using V = ink::Vec<float>;
+
+		INK_CHECK(gv::mask(ink::Vec<int>(1, 2, 3) == ink::Vec<int>(1, 3, 3)).bits() == 0b101u);
+		INK_CHECK(gv::mask(ink::Vec<int, int, void>(1, 2), ink::Vec<int, int, void>(1, 3), std::equal_to<>()).bits() == 0b001u);
+		INK_CHECK(gv::mask(ink::Vec<float, float, void>(1.f, 2.f), ink::Vec<float, float, void>(2.f, 3.f), std::less<>()).all());
+		INK_CHECK((~gv::VecMask<0b101u>(0b001u)).bits() == 0b100u);
+		INK_CHECK(gv::popcount(V(1.f, 0.f, 2.f)) == 2 && gv::none(V(0.f, 0.f, 0.f)));
+		INK_CHECK(all(select(gv::VecMask<>(0b010u), ink::Vec<int>(1, 2, 3), ink::Vec<int>(4, 5, 6)) == ink::Vec<int>(4, 2, 6)));
+		INK_CHECK(all(select(ink::Vec<bool>(true, false, true), ink::Vec<double>(1., 2., 3.), ink::Vec<double>(4., 5., 6.)) == ink::Vec<double>(1., 5., 3.)));
+		const V lo(0.f, 0.f, 0.f), v(-1.f, 2.f, -3.f);
+		INK_CHECK(all(select(gv::mask(v < lo), lo, v) == V(0.f, 2.f, 0.f)));
+		INK_CHECK(all(gv::blend<0b100u>(ink::Vec<int>(1, 2, 3), ink::Vec<int>(4, 5, 6)) == ink::Vec<int>(4, 5, 3)));
+		const auto mixed = gv::blend<0b011u>(ink::Vec<int, int, void>(1, 2), V(4.f, 5.f, 6.f));
+		static_assert(std::same_as<decltype(mixed), ink::Vec<int, int, float> const>);
+		INK_CHECK(mixed.x == 1 && mixed.y == 2 && mixed.z == 6.f);
+
+		// 203 vectors: three whole words of bits and a partial one, and a tail for every register width.
+		constexpr std::size_t n = 203;
+		constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+		std::vector<V> a(n), b(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			const auto value = [&](std::size_t k) { return k % 11 == 0 ? nan : float(int(k * 7 % 5) - 2); };
+			a[i] = V(value(3 * i), value(3 * i + 1), value(3 * i + 2));
+			b[i] = V(value(3 * i + 5), value(3 * i + 1), value(3 * i + 7));
+		}
+		const V single(0.f, nan, -1.f);
+
+		const auto check_cmp = [&](auto cmp, std::size_t op) {
+			std::vector<gv::VecMask<>> masks(n);
+			std::vector<std::uint64_t> alls((n + 63) / 64, ~0ull), anys((n + 63) / 64, ~0ull);
+			bool same = true;
+			for (auto isa : { simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+				if (isa > simd::active_isa()) continue;
+				const auto table = simd::kernels_for<float>(isa);
+				for (bool broadcast : {false, true}) {
+					float const* rhs = broadcast ? simd::detail::flat(&single) : simd::detail::flat(b.data());
+					table.cmp_mask[op](simd::detail::flat(a.data()), rhs, broadcast, simd::detail::flat(masks.data()), n);
+					table.cmp_all[op](simd::detail::flat(a.data()), rhs, broadcast, alls.data(), n);
+					table.cmp_any[op](simd::detail::flat(a.data()), rhs, broadcast, anys.data(), n);
+					for (std::size_t i = 0; i < n; ++i) {
+						const auto expected = gv::mask(a[i], broadcast ? single : b[i], cmp);
+						same = same && masks[i] == expected;
+						same = same && bool(alls[i / 64] >> (i % 64) & 1u) == expected.all() && bool(anys[i / 64] >> (i % 64) & 1u) == expected.any();
+					}
+					same = same && alls.back() >> (n % 64) == 0 && anys.back() >> (n % 64) == 0;
+				}
+			}
+			// The public forms, through the dispatch.
+			simd::mask(a.data(), b.data(), cmp, masks.data(), n);
+			simd::mask_all(a.data(), single, cmp, alls.data(), n);
+			for (std::size_t i = 0; i < n; ++i)
+				same = same && masks[i] == gv::mask(a[i], b[i], cmp) && bool(alls[i / 64] >> (i % 64) & 1u) == gv::mask(a[i], single, cmp).all();
+			return same;
+		};
+		INK_CHECK(check_cmp(std::equal_to<>(), 0));
+		INK_CHECK(check_cmp(std::not_equal_to<>(), 1));
+		INK_CHECK(check_cmp(std::less<>(), 2));
+		INK_CHECK(check_cmp(std::less_equal<>(), 3));
+		INK_CHECK(check_cmp(std::greater<>(), 4));
+		INK_CHECK(check_cmp(std::greater_equal<>(), 5));
+	}
+
+	/**
+	 * Swizzles read and written, through views that alias what they are assigned from, then the batch swizzles of every
+	 * instruction set, for all 27 patterns, in place too.
+	 */
+	void
+	test_swizzle() {
+		namespace simd = ink::generic_vec::simd;
+		using ink::swizzle;
+		using ink::swizzle_ref;
+		using V = ink::Vec<int>;
+
+		INK_CHECK(all(swizzle<"zyx">(V(1, 2, 3)) == V(3, 2, 1)) && all(swizzle<"xxz">(V(1, 2, 3)) == V(1, 1, 3)));
+		const auto yx = swizzle<"yx">(ink::Vec<int, float, double>(1, 2.f, 3.));
+		static_assert(std::same_as<decltype(yx), ink::Vec<float, int, void> const>);
+		INK_CHECK(yx.x == 2.f && yx.y == 1);
+		static_assert(std::same_as<decltype(swizzle<"x_z">(V(1, 2, 3))), ink::Vec<int, void, int>>);
+		static_assert(std::same_as<decltype(swizzle<"zy">(ink::Vec<int, int, void>(1, 2))), ink::Vec<void, int, void>>);
+		INK_CHECK(all(swizzle<"zx">(ink::lazy(V(1, 2, 3)) * 2) == ink::Vec<int, int, void>(6, 2)));
+
+		V v(1, 2, 3);
+		swizzle_ref<"zx">(v) = ink::Vec<int, int, void>(7, 8);
+		INK_CHECK(all(v == V(8, 2, 7)));
+		v = V(1, 2, 3);
+		swizzle_ref<"yx">(v) = v;
+		swizzle_ref<"zy">(v) += ink::Vec<int, int, void>(10, 20);
+		INK_CHECK(all(v == V(2, 21, 13)));
+		swizzle_ref<"zyx">(v) <<= 1;
+		INK_CHECK(all(v == V(4, 42, 26)));
+
+		// Every axis is read before any is written, whichever side the view is on.
+		v = V(1, 2, 3);
+		v = swizzle_ref<"zyx">(v);
+		INK_CHECK(all(v == V(3, 2, 1)));
+		v = V(1, 2, 3);
+		v = ink::lazy(v) + swizzle_ref<"zyx">(v);
+		INK_CHECK(all(v == V(4, 4, 4)));
+		v = V(1, 2, 3);
+		swizzle_ref<"zyx">(v) = ink::lazy(v) * 2;
+		INK_CHECK(all(v == V(6, 4, 2)));
+		v = V(1, 2, 3);
+		swizzle_ref<"zyx">(v) = swizzle_ref<"yzx">(v);
+		INK_CHECK(all(v == V(1, 3, 2)));
+
+		// 11 vectors: a tail for every register width.
+		using F = ink::Vec<double>;
+		std::vector<F> in(11), out(11);
+		for (std::size_t i = 0; i < in.size(); ++i) in[i] = F(double(i), double(i) + .25, double(i) + .5);
+		bool same = true;
+		for (auto isa : { simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+			if (isa > simd::active_isa()) continue;
+			const auto table = simd::kernels_for<double>(isa);
+			for (std::size_t pattern = 0; pattern < 27; ++pattern) {
+				const std::size_t a = pattern / 9, b = pattern / 3 % 3, c = pattern % 3;
+				std::vector<F> inout = in;
+				table.swizzle[pattern](simd::detail::flat(in.data()), simd::detail::flat(out.data()), in.size());
+				table.swizzle[pattern](simd::detail::flat(inout.data()), simd::detail::flat(inout.data()), in.size());
+				for (std::size_t i = 0; i < in.size(); ++i) {
+					const double axes[] = {in[i].x, in[i].y, in[i].z};
+					same = same && all(out[i] == F(axes[a], axes[b], axes[c])) && all(inout[i] == out[i]);
+				}
+			}
+		}
+		INK_CHECK(same);
+		simd::swizzle<"zxy">(in.data(), out.data(), in.size());
+		INK_CHECK(std::ranges::equal(out, in, [](F const& o, F const& i) { return all(o == swizzle<"zxy">(i)); }));
+	}
+
+	// Conversions to 16 bit floats round to nearest even, and saturate to infinity only past the largest half.
+	static_assert(float(ink::Half(1.5f)) == 1.5f && ink::Half(1.f).bits() == 0x3C00u);
+	static_assert(ink::Half(65504.f).bits() == 0x7BFFu && ink::Half(65519.f).bits() == 0x7BFFu && ink::Half(65520.f).bits() == 0x7C00u);
+	static_assert(ink::Half(0x1p-24f).bits() == 0x0001u && float(ink::Half::from_bits(0x0001u)) == 0x1p-24f);
+	static_assert(ink::BFloat16(1.f + 0x1p-8f).bits() == 0x3F80u && ink::BFloat16(1.f + 0x3p-8f).bits() == 0x3F82u);
+
+	/**
+	 * Every 16 bit pattern of Half and BFloat16 round trips, conversions from float pick the nearest of the two
+	 * neighbouring values, the batch conversions of every instruction set match the scalar ones bit for bit, and
+	 * quantization stays within half a step of each axis over a fitted batch.
+	 */
+	void
+	test_compact() {
+		namespace simd = ink::generic_vec::simd;
+		using ink::Half;
+		using ink::BFloat16;
+		using F = ink::Vec<float>;
+
+		INK_CHECK(ink::Half(65504.f).bits() == 0x7BFFu && ink::Half(65520.f).bits() == 0x7C00u && ink::Half(0x1p-25f).bits() == 0u);
+		INK_CHECK(ink::Half(0x1p-24f).bits() == 0x0001u && ink::BFloat16(1.f + 0x3p-8f).bits() == 0x3F82u);
+		const auto sum = ink::Vec<Half>(1.f, 2.f, 3.f) + F(1.f, 2.f, 3.f);
+		static_assert(std::same_as<decltype(sum), F const>);
+		INK_CHECK(all(sum == F(2.f, 4.f, 6.f)) && all(ink::Vec<Half>(1.f, 2.f, 3.f) * 2.f == F(2.f, 4.f, 6.f)));
+
+		bool round_trips = true;
+		for (std::uint32_t b = 0; b <= 0xFFFFu; ++b) {
+			const float h = Half::from_bits(std::uint16_t(b)), bf = BFloat16::from_bits(std::uint16_t(b));
+			round_trips = round_trips && (std::isnan(h) ? std::isnan(float(Half(h))) : Half(h).bits() == b);
+			round_trips = round_trips && (std::isnan(bf) ? std::isnan(float(BFloat16(bf))) : BFloat16(bf).bits() == b);
+		}
+		INK_CHECK(round_trips);
+
+		// Floats of every magnitude either format holds, rounding and all.
+		std::mt19937 random(21);
+		std::uniform_real_distribution<float> mantissa(-2.f, 2.f);
+		std::uniform_int_distribution<int> exponent(-30, 17);
+		std::vector<float> values(3 * 1001);
+		for (float& v : values) v = std::ldexp(mantissa(random), exponent(random));
+		values[0] = std::numeric_limits<float>::infinity();
+		values[1] = -std::numeric_limits<float>::quiet_NaN();
+		values[2] = 65520.f;
+		values[3] = -0.f;
+
+		const auto nearest = [](float value, float rounded, float below, float above) {
+			// Comparisons with NaN neighbours, past zero or infinity, do not count.
+			const float d = std::fabs(rounded - value);
+			return !(std::fabs(below - value) < d) && !(std::fabs(above - value) < d);
+		};
+		bool rounds = true;
+		for (float v : values) {
+			if (!std::isfinite(v) || std::fabs(v) >= 65504.f) continue;
+			const Half h(v);
+			const BFloat16 bf(v);
+			rounds = rounds && nearest(v, h, Half::from_bits(std::uint16_t(h.bits() - 1)), Half::from_bits(std::uint16_t(h.bits() + 1)));
+			rounds = rounds && nearest(v, bf, BFloat16::from_bits(std::uint16_t(bf.bits() - 1)), BFloat16::from_bits(std::uint16_t(bf.bits() + 1)));
+		}
+		INK_CHECK(rounds);
+
+		const auto same_bits = [](std::vector<std::uint16_t> const& a, auto const& expected) {
+			bool same = true;
+			for (std::size_t i = 0; i < a.size(); ++i) same = same && a[i] == expected(i);
+			return same;
+		};
+		std::vector<std::uint16_t> halves(values.size()), bfloats(values.size());
+		std::vector<float> back(values.size());
+		bool batches = true;
+		for (auto isa : { simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+			if (isa > simd::active_isa()) continue;
+			const auto table = simd::kernels_for<float>(isa);
+			table.to_half(values.data(), halves.data(), values.size());
+			table.to_bfloat(values.data(), bfloats.data(), values.size());
+			batches = batches && same_bits(halves, [&](std::size_t i) { return Half(values[i]).bits(); });
+			// NaNs are quieted, but keep their sign.
+			batches = batches && same_bits(bfloats, [&](std::size_t i) { return BFloat16(values[i]).bits(); });
+			table.from_half(halves.data(), back.data(), values.size());
+			for (std::size_t i = 0; i < values.size(); ++i) batches = batches && (std::isnan(back[i]) ? std::isnan(values[i]) : back[i] == float(Half::from_bits(halves[i])));
+			table.from_bfloat(bfloats.data(), back.data(), values.size());
+			for (std::size_t i = 0; i < values.size(); ++i) batches = batches && (std::isnan(back[i]) ? std::isnan(values[i]) : back[i] == float(BFloat16::from_bits(bfloats[i])));
+		}
+		INK_CHECK(batches);
+
+		// The finite values as x, within the range of Half, a ramp as y, and a constant z.
+		std::vector<F> vecs;
+		for (std::size_t i = 4; i < values.size(); ++i)
+			if (std::fabs(values[i]) < 65504.f) vecs.push_back(F(values[i], float(i) * .37f, 7.f));
+		std::vector<ink::Vec<Half>> packed(vecs.size());
+		std::vector<F> unpacked(vecs.size());
+		simd::pack(vecs.data(), packed.data(), vecs.size());
+		simd::unpack(packed.data(), unpacked.data(), vecs.size());
+		INK_CHECK(std::ranges::equal(unpacked, vecs, [](F const& u, F const& v) { return all(u == F(ink::Vec<Half>(v))); }));
+
+		// Half a step per axis, the z axis constant, and values past the fitted range saturated.
+		const auto q = ink::Quantization<float>::fit(vecs.data(), vecs.size());
+		INK_CHECK(q.scale.z == 1.f && q.offset.z == 7.f);
+		bool bounded = true, encoded = true;
+		std::vector<ink::Vec<std::int16_t>> codes(vecs.size());
+		std::vector<F> decoded(vecs.size());
+		for (std::size_t i = 0; i < vecs.size(); ++i) {
+			const F error = q.decode(q.encode(vecs[i])) - vecs[i];
+			// Plus the rounding of the float arithmetic on the way, a few ulps of the values involved.
+			const F rounding = (max(vecs[i], -vecs[i]) + max(q.offset, -q.offset)) * (4.f * std::numeric_limits<float>::epsilon());
+			bounded = bounded && all(max(error, -error) <= q.scale * .5f + rounding);
+		}
+		INK_CHECK(bounded);
+		INK_CHECK(all(q.encode(q.offset + q.scale * 40000.f) == ink::Vec<std::int16_t>(std::int16_t(32767), std::int16_t(32767), std::int16_t(32767))));
+		for (auto isa : { simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+			if (isa > simd::active_isa()) continue;
+			const auto table = simd::kernels_for<float>(isa);
+			const F inverse = q.inverse_scale();
+			const float encode_params[6] = { inverse.x, inverse.y, inverse.z, q.offset.x, q.offset.y, q.offset.z };
+			const float decode_params[6] = { q.scale.x, q.scale.y, q.scale.z, q.offset.x, q.offset.y, q.offset.z };
+			// Kernels may fuse the multiply-add: a rounding apart, of terms up to the whole range.
+			const F decode_rounding = (max(q.offset, -q.offset) + q.scale * 32767.f) * (2.f * std::numeric_limits<float>::epsilon());
+			table.quantize(simd::detail::flat(vecs.data()), encode_params, simd::detail::flat(codes.data()), vecs.size());
+			table.dequantize(simd::detail::flat(codes.data()), decode_params, simd::detail::flat(decoded.data()), vecs.size());
+			for (std::size_t i = 0; i < vecs.size(); ++i) {
+				encoded = encoded && all(codes[i] == q.encode(vecs[i]));
+				const F difference = decoded[i] - q.decode(codes[i]);
+				encoded = encoded && all(max(difference, -difference) <= decode_rounding);
+			}
+		}
+		INK_CHECK(encoded);
+	}
+
+	static_assert(ink::generic_vec::detail::file_type_of<float>() == ink::generic_vec::FileType::Float && ink::generic_vec::detail::file_type_of<std::int16_t>() == ink::generic_vec::FileType::Int16);
+	static_assert(ink::generic_vec::detail::file_type_of<ink::generic_vec::Half>() == ink::generic_vec::FileType::Half && ink::generic_vec::detail::file_type_of<void>() == ink::generic_vec::FileType::Void);
+	static_assert(ink::generic_vec::detail::file_vec<float, float, float> && ink::generic_vec::detail::file_vec<char, double, void>);
+	static_assert(!ink::generic_vec::detail::file_vec<float*, float, float>);
+
+	// A path for a scratch file of the tests, in the temporary directory of the system.
+	std::string
+	scratch_path(char const* name)
+	{ return (std::filesystem::temp_directory_path() / name).string(); }
+
+	std::vector<unsigned char>
+	read_file(std::string const& path) {
+		std::vector<unsigned char> bytes(std::filesystem::file_size(path));
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		if (file == nullptr) throw std::runtime_error("cannot open " + path);
+		const std::size_t read = std::fread(bytes.data(), 1, bytes.size(), file);
+		std::fclose(file);
+		if (read != bytes.size()) throw std::runtime_error("cannot read " + path);
+		return bytes;
+	}
+
+	void
+	write_file(std::string const& path, std::vector<unsigned char> const& bytes) {
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+		if (file == nullptr) throw std::runtime_error("cannot create " + path);
+		const std::size_t written = std::fwrite(bytes.data(), 1, bytes.size(), file);
+		std::fclose(file);
+		if (written != bytes.size()) throw std::runtime_error("cannot write " + path);
+	}
+
+	// Whether f() throws an exception of type E.
+	template<typename E, typename F>
+	bool
+	throws(F&& f) {
+		try { f(); }
+		catch (E const&) { return true; }
+		catch (...) { return false; }
+		return false;
+	}
+
+	/**
+	 * Files saved and read back in both layouts, in place and copied, in the byte order of the machine and in the
+	 * other one, and the errors of files that are short, of other types, or not vector files at all.
+	 */
+	void
+	test_file() {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+		const std::string path = scratch_path("ink_test_vectors.bin");
+		const auto equal = [](auto const& a, auto const& b) { return std::ranges::equal(a, b, [](auto const& l, auto const& r) { return all(l == r); }); };
+
+		std::vector<F> vecs(1001);
+		for (std::size_t i = 0; i < vecs.size(); ++i) vecs[i] = F(float(i), -float(i) * .5f, 1.f / float(i + 1));
+
+		gv::save(path.c_str(), vecs);
+		{
+			const ink::VecFile<float> file(path);
+			INK_CHECK(file.size() == vecs.size() && file.native() && file.contiguous() && file.layout() == ink::FileLayout::Interleaved);
+			INK_CHECK(equal(file.vecs(), vecs) && equal(file.view(), vecs) && equal(file.to_vector(), vecs));
+			INK_CHECK(reinterpret_cast<std::uintptr_t>(file.vecs().data()) % 64 == 0);
+			const auto soa = file.to_soa();
+			bool same = soa.size() == vecs.size();
+			for (std::size_t i = 0; same && i < vecs.size(); ++i) same = all(F(soa[i]) == vecs[i]);
+			INK_CHECK(same);
+		}
+
+		// Mixed axes, with a 'void' one.
+		using M = ink::Vec<std::int16_t, void, double>;
+		std::vector<M> mixed;
+		for (std::size_t i = 0; i < 77; ++i) mixed.push_back(M(std::int16_t(i * 300), nullptr, double(i) / 3.));
+		gv::save(path.c_str(), mixed);
+		INK_CHECK(equal(gv::load<std::int16_t, void, double>(path.c_str()), mixed));
+
+		// Planar files view in place, but are no array of Vec.
+		gv::VecSoA<float, float, float> lanes;
+		for (F const& v : vecs) lanes.push_back(v);
+		gv::save(path.c_str(), lanes);
+		{
+			const ink::VecFile<float> file(path);
+			INK_CHECK(file.layout() == ink::FileLayout::Planar && !file.contiguous());
+			INK_CHECK(throws<ink::FileError>([&] { return file.vecs(); }));
+			INK_CHECK(equal(file.view(), vecs) && equal(file.to_vector(), vecs));
+			INK_CHECK(file.to_soa().x == lanes.x && file.to_soa().z == lanes.z);
+		}
+		INK_CHECK(equal(gv::load<float>(path.c_str()), vecs));
+
+		gv::save(path.c_str(), std::vector<F>());
+		INK_CHECK(gv::load<float>(path.c_str()).empty() && ink::VecFile<float>(path).vecs().empty());
+
+		// The same vectors, as a machine of the other byte order would have written them.
+		gv::save(path.c_str(), vecs);
+		std::vector<unsigned char> bytes = read_file(path);
+		gv::detail::FileHeader header;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		for (std::size_t at = header.data; at < bytes.size(); at += sizeof(float)) gv::detail::reverse_bytes(&bytes[at], sizeof(float));
+		gv::detail::swap_header(header);
+		std::memcpy(bytes.data(), &header, sizeof(header));
+		write_file(path, bytes);
+		{
+			const ink::VecFile<float> file(path);
+			INK_CHECK(!file.native() && !file.contiguous() && equal(file.to_vector(), vecs));
+			INK_CHECK(throws<ink::FileError>([&] { return file.vecs(); }) && throws<ink::FileError>([&] { return file.view(); }));
+		}
+
+		gv::save(path.c_str(), vecs);
+		bytes = read_file(path);
+		INK_CHECK(throws<ink::FileError>([&] { return gv::load<double>(path.c_str()); }));
+		INK_CHECK(throws<ink::FileError>([&] { return gv::load<float, float, void>(path.c_str()); }));
+		bytes.pop_back();
+		write_file(path, bytes);
+		INK_CHECK(throws<ink::FileError>([&] { return gv::load<float>(path.c_str()); }));
+		bytes[0] = 'X';
+		write_file(path, bytes);
+		INK_CHECK(throws<ink::FileError>([&] { return gv::load<float>(path.c_str()); }));
+		bytes.resize(10);
+		write_file(path, bytes);
+		INK_CHECK(throws<ink::FileError>([&] { return gv::load<float>(path.c_str()); }));
+
+		std::filesystem::remove(path);
+		INK_CHECK(throws<std::system_error>([&] { return gv::load<float>(path.c_str()); }));
+	}
+
+	// A source of a Stream that counts the reads started, and records the buffers and sizes they are given.
+	struct ProbeChunks {
+		using value_type = ink::Vec<float>;
+
+		std::size_t total;
+		std::atomic<std::size_t>* started;
+		std::vector<value_type*>* buffers;
+		std::size_t* largest;
+
+		std::size_t size() const { return total; }
+
+		void
+		read(std::size_t begin, std::size_t count, value_type* out) {
+			started->fetch_add(1);
+			if (std::ranges::find(*buffers, out) == buffers->end()) buffers->push_back(out);
+			*largest = std::max(*largest, count);
+			for (std::size_t i = 0; i < count; ++i) out[i] = value_type(float(begin + i), 1.f, 0.f);
+		}
+	};
+
+	/**
+	 * Streams over files of either layout and byte order, and over memory, against the same work done on a vector.
+	 * Files may end right after the last axis of their last record. The next chunk is read while the stages run on the
+	 * current one, into one of two buffers of at most one chunk.
+	 */
+	void
+	test_stream() {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+		const std::string path = scratch_path("ink_test_stream.bin"), out_path = scratch_path("ink_test_stream_out.bin");
+		const auto equal = [](auto const& a, auto const& b) { return std::ranges::equal(a, b, [](auto const& l, auto const& r) { return all(l == r); }); };
+
+		std::vector<F> vecs(5003);
+		for (std::size_t i = 0; i < vecs.size(); ++i) vecs[i] = F(float(i % 97) - 48.f, float(i % 13), float(i) * .25f);
+		const F lo(-10.f, 2.f, 0.f);
+		const auto scaled = [](F const& v) { return v * 2.f; };
+		std::vector<F> expected;
+		for (F const& v : vecs) if (all(scaled(v) >= lo)) expected.push_back(scaled(v));
+
+		// Chunks that do not divide the file, and chunks of a single vector.
+		for (std::size_t chunk_bytes : { std::size_t(1000), std::size_t(1), std::size_t(1) << 20 }) {
+			gv::save(path.c_str(), vecs);
+			INK_CHECK(equal(gv::stream<float>(path.c_str(), chunk_bytes).map(scaled).filter_all(std::greater_equal<>(), lo).to_vector(), expected));
+			gv::stream<float>(path.c_str(), chunk_bytes).map(scaled).filter([&](F const& v) { return all(v >= lo); }).save(out_path.c_str());
+			INK_CHECK(equal(gv::load<float>(out_path.c_str()), expected));
+
+			gv::VecSoA<float, float, float> lanes;
+			for (F const& v : vecs) lanes.push_back(v);
+			gv::save(path.c_str(), lanes);
+			INK_CHECK(gv::stream<float>(path.c_str(), chunk_bytes).map(scaled).filter_all(std::greater_equal<>(), lo).count() == expected.size());
+			std::vector<F> below;
+			for (F const& v : vecs) if (any(scaled(v) < lo)) below.push_back(scaled(v));
+			INK_CHECK(equal(gv::stream(std::span<F const>(vecs), chunk_bytes).map(scaled).filter_any(std::less<>(), lo).to_vector(), below));
+		}
+		const auto add = [](F acc, F const& v) { return acc + v; };
+		const F in_order = std::accumulate(vecs.begin(), vecs.end(), F(0.f, 0.f, 0.f), add);
+		INK_CHECK(all(gv::stream<float>(path.c_str(), 4096).reduce(F(0.f, 0.f, 0.f), add) == in_order));
+		const F total = gv::stream<float>(path.c_str(), 4096).sum(), error = total - in_order;
+		INK_CHECK(std::fabs(error.x) <= 1.f && std::fabs(error.y) <= 1.f && std::fabs(error.z) <= 1e-5f * in_order.z);
+
+		// Records of 16 bytes whose last 4 are padding, and a file without the padding of its last record.
+		using P = ink::Vec<double, float, void>;
+		std::vector<P> padded;
+		for (std::size_t i = 0; i < 333; ++i) padded.push_back(P(double(i) / 7., float(i), nullptr));
+		gv::save(path.c_str(), padded);
+		std::vector<unsigned char> bytes = read_file(path);
+		bytes.resize(bytes.size() - (sizeof(P) - sizeof(double) - sizeof(float)));
+		write_file(path, bytes);
+		INK_CHECK(equal(ink::VecFile<double, float, void>(path).to_vector(), padded));
+		for (std::size_t chunk_bytes : { std::size_t(160), std::size_t(1) << 20 })
+			INK_CHECK(equal(gv::stream<double, float, void>(path.c_str(), chunk_bytes).to_vector(), padded));
+
+		// The same file, from a machine of the other byte order, through the raw bytes.
+		gv::detail::FileHeader header;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		for (std::size_t at = header.data; at < bytes.size(); at += header.record_size) {
+			gv::detail::reverse_bytes(&bytes[at + header.offset[0]], sizeof(double));
+			gv::detail::reverse_bytes(&bytes[at + header.offset[1]], sizeof(float));
+		}
+		gv::detail::swap_header(header);
+		std::memcpy(bytes.data(), &header, sizeof(header));
+		write_file(path, bytes);
+		for (std::size_t chunk_bytes : { std::size_t(160), std::size_t(1) << 20 })
+			INK_CHECK(equal(gv::stream<double, float, void>(path.c_str(), chunk_bytes).to_vector(), padded));
+
+		// Cut any shorter, the file is refused.
+		bytes.pop_back();
+		write_file(path, bytes);
+		INK_CHECK(throws<ink::FileError>([&] { return gv::stream<double, float, void>(path.c_str()); }));
+		std::filesystem::remove(path);
+		std::filesystem::remove(out_path);
+
+		// Each chunk waits for the read of the next one to start, which it only does while the stages run.
+		constexpr std::size_t chunks = 8, chunk = 100;
+		std::atomic<std::size_t> started = 0;
+		std::vector<F*> buffers;
+		std::size_t largest = 0, seen = 0;
+		bool overlapped = true;
+		gv::Stream<ProbeChunks> probe(ProbeChunks{ chunks * chunk - 7, &started, &buffers, &largest }, chunk * sizeof(F));
+		const F probed = std::move(probe).apply([&](std::span<F>) {
+			const std::size_t next = std::min(++seen + 1, chunks);
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+			while (started.load() < next && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+			overlapped = overlapped && started.load() >= next;
+		}).sum();
+		INK_CHECK(overlapped && seen == chunks && started.load() == chunks);
+		INK_CHECK(buffers.size() == 2 && largest == chunk);
+		INK_CHECK(all(probed == F(float((chunks * chunk - 7) * (chunks * chunk - 8) / 2), float(chunks * chunk - 7), 0.f)));
+	}
+
+	static_assert(std::same_as<ink::VecVector<float>::allocator_type, std::pmr::polymorphic_allocator<ink::Vec<float>>>);
+
+	// An upstream resource that counts what it hands out, from the heap.
+	class CountingResource: public std::pmr::memory_resource {
+
+		public: std::size_t allocations = 0;
+		public: std::size_t outstanding = 0;
+
+		private: void*
+		do_allocate(std::size_t bytes, std::size_t alignment) override {
+			++allocations;
+			outstanding += bytes;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		private: void
+		do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+			outstanding -= bytes;
+			std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+		}
+
+		private: bool
+		do_is_equal(std::pmr::memory_resource const& other) const
+		noexcept override { return this == &other; }
+
+	};
+
+	/**
+	 * Arenas and pools: the alignment of what they hand out, an arena that stops taking memory once reset, blocks of a
+	 * pool used again, and sizes too large to allocate.
+	 */
+	void
+	test_arena() {
+		using F = ink::Vec<float>;
+		const auto aligned = [](void const* p, std::size_t alignment) { return reinterpret_cast<std::uintptr_t>(p) % alignment == 0; };
+		CountingResource upstream;
+		{
+			ink::VecArena arena(1024, &upstream);
+			bool all_aligned = true;
+			for (std::size_t n : { 1, 3, 100, 7, 1000, 5 }) {
+				const std::span<F> vecs = arena.allocate_array<F>(n);
+				all_aligned = all_aligned && vecs.size() == n && aligned(vecs.data(), 64);
+				std::fill(vecs.begin(), vecs.end(), F(1.f, 2.f, 3.f));
+			}
+			all_aligned = all_aligned && aligned(arena.allocate(8, 256), 256) && aligned(arena.allocate(1, 1), 64);
+			INK_CHECK(all_aligned && upstream.allocations > 1 && arena.used() <= arena.capacity());
+
+			// The frame is the same again once reset: it fits in the one block the reset merged the others into.
+			const std::size_t capacity = arena.capacity(), taken = upstream.allocations;
+			for (int frame = 0; frame < 3; ++frame) {
+				arena.reset();
+				INK_CHECK(arena.used() == 0 && arena.capacity() == capacity);
+				for (std::size_t n : { 1, 3, 100, 7, 1000, 5 }) arena.allocate_array<F>(n);
+				ink::VecVector<float> normals(&arena);
+				normals.assign(50, F(0.f, 0.f, 1.f));
+				INK_CHECK(aligned(normals.data(), 64));
+			}
+			INK_CHECK(upstream.allocations == taken + 1 && arena.capacity() == capacity);
+
+			// A block of a larger alignment than is left in the current one.
+			arena.reset();
+			INK_CHECK(arena.allocate(capacity - 3 * 64, 64) != nullptr);
+			INK_CHECK(aligned(arena.allocate(64, 4096), 4096) && upstream.allocations == taken + 2);
+
+			INK_CHECK(throws<std::bad_array_new_length>([&] { return arena.allocate_array<F>(std::size_t(-1) / sizeof(F) + 1); }));
+			INK_CHECK(throws<std::bad_array_new_length>([&] { return arena.allocate_array<F>(std::size_t(-1)); }));
+			INK_CHECK(throws<std::bad_alloc>([&] { return arena.allocate(std::size_t(-1) - 8, 64); }));
+			arena.release();
+			INK_CHECK(upstream.outstanding == 0 && arena.capacity() == 0);
+		}
+		{
+			auto pool = ink::VecPool::of<F>(100, 4, &upstream);
+			INK_CHECK(pool.block_size() % 64 == 0 && pool.capacity<F>() >= 100);
+			std::vector<std::span<F>> arrays;
+			for (int i = 0; i < 9; ++i) arrays.push_back(pool.allocate_array<F>(100));
+			INK_CHECK(std::ranges::all_of(arrays, [&](std::span<F> a) { return aligned(a.data(), 64); }));
+			const std::size_t taken = upstream.allocations;
+			void* const freed = arrays[4].data();
+			pool.deallocate(freed, 100 * sizeof(F), alignof(F));
+			INK_CHECK(pool.allocate_array<F>(100).data() == freed && upstream.allocations == taken);
+
+			// Larger than a block: from the upstream resource, and back to it.
+			void* const large = pool.allocate(pool.block_size() + 1, 64);
+			INK_CHECK(aligned(large, 64) && upstream.allocations == taken + 1);
+			pool.deallocate(large, pool.block_size() + 1, 64);
+
+			INK_CHECK(throws<std::bad_array_new_length>([&] { return pool.allocate_array<F>(std::size_t(-1) / 2); }));
+			pool.release();
+			INK_CHECK(upstream.outstanding == 0);
+		}
+	}
+
+	/**
+	 * The bitwise operators against their scalars, and the grid helpers against plain references, on 1003 random inputs:
+	 * an odd count, so that every batch kernel also runs its tail. Each batch path the running CPU supports must
+	 * match the scalar helpers, not only the one dispatch picks.
+	 */
+	void
+	test_grid() {
+		namespace gv = ink::generic_vec;
+		namespace simd = ink::generic_vec::simd;
+		using U = ink::Vec<std::uint32_t>;
+		using I = ink::Vec<std::int32_t>;
+		using F = ink::Vec<float>;
+
+		constexpr std::size_t n = 1003;
+		std::mt19937 random(15);
+		std::uniform_int_distribution<std::uint32_t> bits21(0, (1u << 21) - 1);
+		std::uniform_int_distribution<std::int32_t> ints(-100000, 100000);
+		std::uniform_int_distribution<std::int32_t> divisors(1, 77);
+		std::uniform_real_distribution<float> reals(-1000.f, 1000.f);
+
+		std::vector<U> points(n);
+		std::vector<I> cells(n), divs(n);
+		std::vector<F> reals_in(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			points[i] = U(bits21(random), bits21(random), bits21(random));
+			cells[i] = I(ints(random), ints(random), ints(random));
+			divs[i] = I(divisors(random), -divisors(random), divisors(random));
+			reals_in[i] = F(reals(random), reals(random), float(i % 7) * 0.37f);
+		}
+
+		bool ops = true, codes = true, division = true, to_cell = true;
+		for (std::size_t i = 0; i < n; ++i) {
+			const U a = points[i], b = points[n - 1 - i];
+			ops = ops && all((a & b) == U(a.x & b.x, a.y & b.y, a.z & b.z));
+			ops = ops && all((a | b) == U(a.x | b.x, a.y | b.y, a.z | b.z));
+			ops = ops && all((a ^ 0x5555u) == U(a.x ^ 0x5555u, a.y ^ 0x5555u, a.z ^ 0x5555u));
+			ops = ops && all((a << 3) == U(a.x << 3, a.y << 3, a.z << 3) && (a >> (b & 7u)) == U(a.x >> (b.x & 7), a.y >> (b.y & 7), a.z >> (b.z & 7)));
+			ops = ops && all(~a == U(~a.x, ~a.y, ~a.z));
+
+			codes = codes && all(gv::morton_decode(gv::morton_encode(a)) == a);
+			const auto flat = ink::Vec<std::uint32_t, std::uint32_t, void>(a.x, a.y);
+			codes = codes && all(gv::morton_decode<ink::Vec<std::uint32_t, std::uint32_t, void>>(gv::morton_encode(flat)) == flat);
+			codes = codes && (gv::morton_encode(a) >> 3) == gv::morton_encode(a >> 1u);
+
+			const I c = cells[i], d = divs[i];
+			const auto floor_of = [](std::int32_t l, std::int32_t r) { return std::int32_t(std::floor(double(l) / double(r))); };
+			division = division && all(gv::floor_div(c, d) == I(floor_of(c.x, d.x), floor_of(c.y, d.y), floor_of(c.z, d.z)));
+			division = division && all(gv::floor_div(c, 8) == (c >> 3));
+
+			const F r = reals_in[i];
+			to_cell = to_cell && all(gv::to_cell(r, 0.37f) == I(std::int32_t(std::floor(r.x / 0.37f)), std::int32_t(std::floor(r.y / 0.37f)), std::int32_t(std::floor(r.z / 0.37f))));
+			to_cell = to_cell && all(gv::to_cell(c, 16) == (c >> 4));
+		}
+		INK_CHECK(ops);
+		INK_CHECK(codes);
+		INK_CHECK(division);
+		INK_CHECK(to_cell);
+
+		// Hashes of nearby cells spread over the whole 32 bits.
+		std::uint32_t hashes_or = 0, hashes_and = ~0u;
+		for (std::int32_t k = 0; k < 64; ++k) {
+			hashes_or |= gv::spatial_hash(I(k, 0, 0));
+			hashes_and &= gv::spatial_hash(I(k, 0, 0));
+		}
+		INK_CHECK(hashes_or == ~0u && hashes_and == 0u);
+
+		std::vector<std::uint64_t> batch_codes(n);
+		std::vector<U> batch_points(n);
+		std::vector<std::uint32_t> batch_hashes(n);
+		std::vector<I> batch_cells(n);
+
+		const auto check_codes = [&] {
+			bool same = true;
+			for (std::size_t i = 0; i < n; ++i) same = same && batch_codes[i] == gv::morton_encode(points[i]) && all(batch_points[i] == points[i]);
+			return same;
+		};
+		const auto check_hashes = [&] {
+			bool same = true;
+			for (std::size_t i = 0; i < n; ++i) same = same && batch_hashes[i] == gv::spatial_hash(cells[i]);
+			return same;
+		};
+		const auto check_cells = [&] {
+			bool same = true;
+			for (std::size_t i = 0; i < n; ++i) same = same && all(batch_cells[i] == gv::to_cell(reals_in[i], 0.37f));
+			return same;
+		};
+
+		simd::morton_encode(points.data(), batch_codes.data(), n);
+		simd::morton_decode(batch_codes.data(), batch_points.data(), n);
+		INK_CHECK(check_codes());
+		simd::spatial_hash(cells.data(), batch_hashes.data(), n);
+		INK_CHECK(check_hashes());
+		simd::to_cell(reals_in.data(), 0.37f, batch_cells.data(), n);
+		INK_CHECK(check_cells());
+
+		#if defined(INK_GENERIC_VEC_SIMD_X86) && defined(__x86_64__)
+		if (__builtin_cpu_supports("bmi2")) {
+			std::ranges::fill(batch_points, U());
+			simd::bmi2::morton_encode(simd::detail::flat(points.data()), batch_codes.data(), n);
+			simd::bmi2::morton_decode(batch_codes.data(), simd::detail::flat(batch_points.data()), n);
+			INK_CHECK(check_codes());
+		}
+		#endif
+		#ifdef INK_GENERIC_VEC_SIMD_X86
+		if (simd::active_isa() >= simd::Isa::SSE2) {
+			std::ranges::fill(batch_cells, I());
+			simd::sse2::to_cell(simd::detail::flat(reals_in.data()), 0.37f, simd::detail::flat(batch_cells.data()), 3 * n);
+			INK_CHECK(check_cells());
+		}
+		if (simd::active_isa() >= simd::Isa::AVX2) {
+			std::ranges::fill(batch_cells, I());
+			std::ranges::fill(batch_hashes, 0u);
+			simd::avx2::to_cell(simd::detail::flat(reals_in.data()), 0.37f, simd::detail::flat(batch_cells.data()), 3 * n);
+			simd::avx2::spatial_hash(simd::detail::flat(cells.data()), batch_hashes.data(), n);
+			INK_CHECK(check_cells());
+			INK_CHECK(check_hashes());
+		}
+		#endif
+	}
+
+	/**
+	 * Axis-aligned rays, whose zero axes give 0 * inf = NaN on the faces their origin lies on, and nearest-neighbour
+	 * queries of any radius. Single rays and packets of rays must agree, hit for hit.
+	 */
+	void
+	test_spatial() {
+		namespace gv = ink::generic_vec;
+		using F = ink::Vec<float>;
+		constexpr float inf = std::numeric_limits<float>::infinity();
+
+		const gv::AABB<float> unit{F(0.f, 0.f, 0.f), F(1.f, 1.f, 1.f)};
+		const F up = gv::detail::inverse(F(0.f, 0.f, 1.f));
+		INK_CHECK(unit.ray_entry(F(0.f, .5f, -1.f), up, inf) == 1.f);
+		INK_CHECK(unit.ray_entry(F(1.f, 1.f, -1.f), up, inf) == 1.f);
+		INK_CHECK(unit.ray_entry(F(0.f, 0.f, -1.f), gv::detail::inverse(F(-0.f, -0.f, 1.f)), inf) == 1.f);
+		INK_CHECK(unit.ray_entry(F(0.f, .5f, .5f), up, inf) == 0.f);
+		INK_CHECK(unit.ray_entry(F(0.f, .5f, -1.f), up, .5f) == inf);
+		INK_CHECK(unit.ray_entry(F(-.1f, .5f, -1.f), up, inf) == inf);
+		INK_CHECK(unit.ray_entry(F(1.1f, .5f, -1.f), up, inf) == inf);
+		const gv::AABB<double> unit_d{ink::Vec<double>(0., 0., 0.), ink::Vec<double>(1., 1., 1.)};
+		INK_CHECK(unit_d.ray_entry(ink::Vec<double>(0., .5, -1.), gv::detail::inverse(ink::Vec<double>(0., 0., 1.)), 1e300) == 1.);
+
+		const F row[] = {F(0.f, 0.f, 5.f), F(1.f, 0.f, 5.f), F(2.f, 0.f, 5.f)};
+		const gv::BVH<float> points(row, 3, 1);
+		const auto hit = points.ray(F(1.f, 0.f, 0.f), F(0.f, 0.f, 1.f));
+		INK_CHECK(hit.index == 1 && hit.distance == 5.f);
+		INK_CHECK(!points.ray(F(.5f, 0.f, 0.f), F(0.f, 0.f, 1.f)));
+
+		// Rays along each axis, from on and off the planes of the points, against a lattice of points.
+		std::vector<F> lattice;
+		for (int z = 0; z < 4; ++z)
+			for (int y = 0; y < 4; ++y)
+				for (int x = 0; x < 4; ++x) lattice.push_back(F(float(x), float(y), float(z)));
+		const gv::BVH<float> bvh(lattice.data(), lattice.size());
+		std::vector<F> origins, dirs;
+		std::vector<bool> on_row;
+		for (int a = 0; a < 4; ++a)
+			for (int b = 0; b < 4; ++b)
+				for (float off : {0.f, .5f}) {
+					const float u = float(a) + off, v = float(b);
+					origins.insert(origins.end(), {F(-1.f, u, v), F(u, -1.f, v), F(u, v, -1.f), F(4.f, u, v)});
+					dirs.insert(dirs.end(), {F(1.f, 0.f, 0.f), F(0.f, 1.f, -0.f), F(0.f, 0.f, 1.f), F(-1.f, 0.f, 0.f)});
+					on_row.insert(on_row.end(), 4, off == 0.f);
+				}
+		std::vector<gv::QueryHit<float>> packets(origins.size());
+		bvh.rays(origins.data(), dirs.data(), inf, origins.size(), packets.data());
+		bool agree = true, exact = true;
+		for (std::size_t i = 0; i < origins.size(); ++i) {
+			const auto single = bvh.ray(origins[i], dirs[i]);
+			agree = agree && single.index == packets[i].index && single.distance == packets[i].distance;
+			// Rays along a row of the lattice hit its first point, one unit away. The others run between rows.
+			exact = exact && (on_row[i] ? single && single.distance == 1.f : !single);
+		}
+		INK_CHECK(agree);
+		INK_CHECK(exact);
+
+		// Radii beyond the extent of the grid, infinite or not a number, search up to its last cell and no further.
+		const gv::HashGrid<float> grid(lattice.data(), lattice.size(), .5f);
+		for (float radius : {inf, 1e30f, 3e9f, 100.f}) {
+			const auto near = grid.nearest(F(-50.f, 1.2f, 2.9f), radius);
+			INK_CHECK(near.index == 16 * 3 + 4 * 1 && near.distance == (F(-50.f, 1.2f, 2.9f) - lattice[52]).mag2());
+		}
+		INK_CHECK(!grid.nearest(F(-50.f, 1.2f, 2.9f), 10.f));
+		INK_CHECK(!grid.nearest(F(1.f, 1.f, 1.f), std::numeric_limits<float>::quiet_NaN()));
+	}
+
+	/**
+	 * Matrices, affine transforms and quaternions on exact integer cases, their inverses and the agreement of the
+	 * rotation paths on floats, then the batch transforms of every instruction set against the single ones, in place too.
+	 */
+	void
+	test_transform() {
+		namespace simd = ink::generic_vec::simd;
+		using ink::Mat3;
+		using ink::Affine;
+		using ink::Quat;
+		using V = ink::Vec<double>;
+
+		INK_CHECK(all(Mat3<int>() * ink::Vec<int>(1, 2, 3) == ink::Vec<int>(1, 2, 3)));
+		INK_CHECK(all(Mat3<int>(ink::Vec<int>(0, 1, 0), ink::Vec<int>(-1, 0, 0), ink::Vec<int>(0, 0, 1)) * ink::Vec<int>(1, 2, 3) == ink::Vec<int>(-2, 1, 3)));
+		const auto planar = Mat3<float>::scale(ink::Vec<float>(2.f, 3.f, 4.f)) * ink::Vec<int, int, void>(1, 2);
+		static_assert(std::same_as<decltype(planar), ink::Vec<float, float, void> const>);
+		INK_CHECK(planar.x == 2.f && planar.y == 6.f);
+		INK_CHECK(all(Affine<int>::translate(ink::Vec<int>(1, 2, 3)).transform_point(ink::Vec<int, void, int>(1, 1)) == ink::Vec<int, void, int>(2, 4)));
+		INK_CHECK(all(Affine<int>::translate(ink::Vec<int>(1, 2, 3)).transform_direction(ink::Vec<int>(1, 1, 1)) == ink::Vec<int>(1, 1, 1)));
+		INK_CHECK(Quat<int>(0, 0, 1, 0) * Quat<int>(0, 0, 1, 0) == Quat<int>(0, 0, 0, -1));
+		INK_CHECK(all(Quat<int>(0, 0, 1, 0).rotate(ink::Vec<int, int, void>(1, 2)) == ink::Vec<int, int, void>(-1, -2)));
+
+		const auto near = [](V const& a, V const& b) { return (a - b).mag() <= 1e-12 * (1. + b.mag()); };
+		const Quat<double> q = Quat<double>::axis_angle(V(1., 2., 2.) / 3., 0.7);
+		const Quat<double> r = Quat<double>::axis_angle(V(0., 0., 1.), std::numbers::pi / 2);
+		const V v(0.3, -1.5, 2.25);
+		INK_CHECK(near(r.rotate(V(1., 0., 0.)), V(0., 1., 0.)));
+		INK_CHECK(near(q.rotate(v), Mat3<double>(q) * v));
+		INK_CHECK(near((q * r).rotate(v), q.rotate(r.rotate(v))));
+		INK_CHECK(near(q.conjugate().rotate(q.rotate(v)), v) && near(q.inverse().rotate(q.rotate(v)), v));
+		INK_CHECK(std::fabs(Mat3<double>(q).determinant() - 1.) < 1e-12);
+
+		const Affine<double> a = Affine<double>::trs(V(1., -2., 3.), q, V(2., .5, 3.));
+		INK_CHECK(near(a.transform_point(v), a.linear * v + a.translation));
+		INK_CHECK(near(a.inverse().transform_point(a.transform_point(v)), v));
+		INK_CHECK(near((a * a.inverse()).transform_point(v), v));
+		INK_CHECK(near((a * Affine<double>::translate(v)).transform_point(V(0., 0., 0.)), a.transform_point(v)));
+		const Mat3<double> m = a.linear * a.linear.inverse();
+		INK_CHECK(near(m.x, V(1., 0., 0.)) && near(m.y, V(0., 1., 0.)) && near(m.z, V(0., 0., 1.)));
+
+		// Interpolation ends at its ends, keeps unit length, and takes the shorter arc whatever the sign of 'to'.
+		const Quat<double> minus_r(-r.x, -r.y, -r.z, -r.w);
+		INK_CHECK(near(ink::slerp(Quat<double>(), r, 0.).vec(), V(0., 0., 0.)) && near(ink::slerp(Quat<double>(), r, 1.).rotate(v), r.rotate(v)));
+		INK_CHECK(near(ink::slerp(Quat<double>(), r, .5).rotate(V(1., 0., 0.)), V(1., 1., 0.) / std::sqrt(2.)));
+		INK_CHECK(near(ink::slerp(Quat<double>(), minus_r, .5).rotate(V(1., 0., 0.)), V(1., 1., 0.) / std::sqrt(2.)));
+		INK_CHECK(near(ink::nlerp(Quat<double>(), r, .5).rotate(V(1., 0., 0.)), V(1., 1., 0.) / std::sqrt(2.)));
+		INK_CHECK(std::fabs(ink::slerp(q, r, .3).norm2() - 1.) < 1e-12);
+
+		// 37 vectors: a tail for every register width.
+		using F = ink::Vec<float>;
+		const Affine<float> af(a);
+		std::vector<F> in(37);
+		for (std::size_t i = 0; i < in.size(); ++i) in[i] = F(float(i) * .25f - 4.f, 1.f / float(i + 1), float(i % 5) - 2.f);
+		const auto close = [](F const& x, F const& y) { return (x - y).mag() <= 1e-5f * (1.f + y.mag()); };
+		bool same = true;
+		for (auto isa : { simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+			if (isa > simd::active_isa()) continue;
+			const auto table = simd::kernels_for<float>(isa);
+			const auto columns = simd::detail::columns(af.linear, af.translation);
+			std::vector<F> points(in.size()), directions = in;
+			table.transform[1](columns.data(), simd::detail::flat(in.data()), simd::detail::flat(points.data()), in.size());
+			table.transform[0](columns.data(), simd::detail::flat(directions.data()), simd::detail::flat(directions.data()), in.size());
+			for (std::size_t i = 0; i < in.size(); ++i)
+				same = same && close(points[i], af.transform_point(in[i])) && close(directions[i], af.transform_direction(in[i]));
+		}
+		INK_CHECK(same);
+
+		std::vector<F> out = in;
+		simd::transform_points(af, out.data(), out.data(), out.size());
+		simd::rotate(Quat<float>(q), in.data(), in.data(), in.size());
+		same = true;
+		for (std::size_t i = 0; i < in.size(); ++i) {
+			const F original(float(i) * .25f - 4.f, 1.f / float(i + 1), float(i % 5) - 2.f);
+			same = same && close(out[i], af.transform_point(original)) && close(in[i], Quat<float>(q).rotate(original));
+		}
+		INK_CHECK(same);
+	}
+
+	namespace tables = ink::generic_vec::tables;
+
+	// Every helper and table must be usable in constant expressions: these fail to compile otherwise.
+	static_assert(tables::sqrt(16.0) == 4.0 && tables::sqrt(2.0f) == 1.41421356f && tables::sqrt(0.0) == 0.0);
+	static_assert(tables::cos(0.0) == 1.0 && tables::sin(std::numbers::pi / 2) == 1.0);
+	static_assert(tables::cube_face_normals<int>[3].y == -1);
+	static_assert(tables::circle_directions<double, 4>[1].y == 1.0 && tables::circle_directions<double, 4>[2].x == -1.0);
+	static_assert(ink::generic_vec::morton_encode(ink::generic_vec::morton_decode(0x1234567)) == 0x1234567);
+	static_assert(tables::morton_order<1>[5].x == 1 && tables::morton_order<1>[5].y == 0 && tables::morton_order<1>[5].z == 1);
+	static_assert(tables::hilbert_order<1>[7].x == 1 && tables::hilbert_order<1>[7].y == 0 && tables::hilbert_order<1>[7].z == 0);
+
+	// The constant evaluation paths against the standard functions the same calls make at run time.
+	void
+	test_tables() {
+		constexpr auto directions = tables::circle_directions<double, 360>;
+		bool close = true;
+		for (std::size_t i = 0; i < directions.size(); ++i) {
+			const double angle = 2 * std::numbers::pi * double(i) / 360.;
+			close = close && std::fabs(directions[i].x - std::cos(angle)) <= 4e-16 && std::fabs(directions[i].y - std::sin(angle)) <= 4e-16;
+		}
+		INK_CHECK(close);
+
+		constexpr auto roots = tables::generate<1000>([](std::size_t i) { return tables::sqrt(double(i) * 1.37); });
+		bool exact = true;
+		for (std::size_t i = 0; i < roots.size(); ++i) exact = exact && std::fabs(roots[i] - std::sqrt(double(i) * 1.37)) <= 2 * std::numeric_limits<double>::epsilon() * roots[i];
+		INK_CHECK(exact);
+
+		bool unit = true;
+		for (auto const& v : tables::fibonacci_sphere<float, 256>) unit = unit && std::fabs(v.mag2() - 1.f) <= 1e-6f;
+		INK_CHECK(unit);
+
+		// Consecutive points of the Hilbert curve are neighbours, and both orders visit every point of the cube once.
+		constexpr auto& hilbert = tables::hilbert_order<3>;
+		bool adjacent = true;
+		for (std::size_t i = 1; i < hilbert.size(); ++i) {
+			const auto d = ink::Vec<std::int64_t>(hilbert[i]) - ink::Vec<std::int64_t>(hilbert[i - 1]);
+			adjacent = adjacent && std::abs(d.x) + std::abs(d.y) + std::abs(d.z) == 1;
+		}
+		INK_CHECK(adjacent);
+
+		std::vector<bool> hilbert_seen(512), morton_seen(512);
+		for (std::size_t i = 0; i < 512; ++i) {
+			hilbert_seen[ink::generic_vec::morton_encode(hilbert[i])] = true;
+			morton_seen[ink::generic_vec::morton_encode(tables::morton_order<3>[i])] = true;
+			INK_CHECK(ink::generic_vec::morton_encode(tables::morton_order<3>[i]) == i);
+		}
+		INK_CHECK(std::ranges::count(hilbert_seen, true) == 512 && std::ranges::count(morton_seen, true) == 512);
+	}
+
+	/**
+	 * Every algorithm against a serial loop, on pools of 1, 2, 3 and 8 threads, over enough vectors for dozens of chunks.
+	 * Integral values keep floating point sums exact whatever the order. Run it under the Linux-TSan config for races.
+	 */
+	void
+	test_parallel() {
+		namespace par = ink::generic_vec::parallel;
+		using V = ink::Vec<double>;
+
+		const std::size_t n = 100003;
+		std::vector<V> a(n), b(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			const double k = double(i % 1000);
+			a[i] = V(k, 1000. - k, double(i % 7) - 3.);
+			b[i] = V(double(i % 5), -k, 2.);
+		}
+
+		V serial_sum, serial_min = a[0], serial_max = a[0];
+		double serial_dot = 0., serial_mag2 = 0.;
+		for (std::size_t i = 0; i < n; ++i) {
+			serial_sum += a[i];
+			serial_min = min(serial_min, a[i]);
+			serial_max = max(serial_max, a[i]);
+			serial_dot += a[i].dot(b[i]);
+			serial_mag2 += a[i].mag2();
+		}
+
+		for (unsigned threads : { 1u, 2u, 3u, 8u }) {
+			par::ThreadPool pool(threads);
+			INK_CHECK(pool.size() == threads);
+
+			std::vector<V> out(n);
+			par::transform(a.data(), out.data(), n, [](V const& v) { return v * 2.; }, pool);
+			bool same = true;
+			for (std::size_t i = 0; i < n; ++i) same = same && all(out[i] == a[i] * 2.);
+			INK_CHECK(same);
+
+			par::transform(a.data(), b.data(), out.data(), n, std::minus<>(), pool);
+			same = true;
+			for (std::size_t i = 0; i < n; ++i) same = same && all(out[i] == a[i] - b[i]);
+			INK_CHECK(same);
+
+			INK_CHECK(all(par::reduce(a.data(), n, V(), std::plus<>(), pool) == serial_sum));
+			INK_CHECK(all(par::sum(a.data(), n, pool) == serial_sum));
+			INK_CHECK(all(par::min(a.data(), n, pool) == serial_min));
+			INK_CHECK(all(par::max(a.data(), n, pool) == serial_max));
+			INK_CHECK(par::dot_sum(a.data(), b.data(), n, pool) == serial_dot);
+			INK_CHECK(par::mag2_sum(a.data(), n, pool) == serial_mag2);
+
+			// Reductions combine their chunks in order: the same pool gives the same bits, even with rounding.
+			std::vector<ink::Vec<float>> f(n);
+			for (std::size_t i = 0; i < n; ++i) f[i] = ink::Vec<float>(0.1f, 1.f / float(i + 1), 1e-3f * float(i));
+			const auto first = par::sum<ink::Summation::Naive>(f.data(), n, pool);
+			INK_CHECK(all(par::sum<ink::Summation::Naive>(f.data(), n, pool) == first));
+
+			// Nested calls from inside a chunk run inline on the same pool.
+			const auto marked = [](V const& v) { return v.x == 0. && v.z == -3.; };
+			const double inner = par::mag2_sum(b.data(), n, pool);
+			const double nested = par::transform_reduce(a.data(), n, 0., std::plus<>(), [&](V const& v) {
+				return marked(v) ? par::mag2_sum(b.data(), n, pool) : 0.;
+			}, pool);
+			INK_CHECK(nested == double(std::ranges::count_if(a, marked)) * inner);
+
+			// The first exception of a chunk reaches the caller, and the pool keeps working after it.
+			bool thrown = false;
+			try {
+				par::transform(a.data(), out.data(), n, [](V const& v) {
+					if (v.x == 999. && v.z == 3.) throw std::runtime_error("chunk");
+					return v;
+				}, pool);
+			}
+			catch (std::runtime_error const&) { thrown = true; }
+			INK_CHECK(thrown);
+			INK_CHECK(all(par::sum(a.data(), n, pool) == serial_sum));
+		}
+	}
+
+}
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] const char* argv[]) {
-	
-	int x, y;
-	ink::Vec<int&, int&, void> m(x,y);
-	
-	m = ink::Vec(1,2);
-	
-	printf("%i %i\n", x, y);
-	
+
+	test_vec();
+	test_soa();
+	test_padded();
+	test_vec_n();
+	test_expr();
+	test_view();
+	test_precision();
+	test_sum();
+	test_arena();
+	test_kernels();
+	test_convert();
+	test_compact();
+	test_file();
+	test_stream();
+	test_mask();
+	test_swizzle();
+	test_grid();
+	test_spatial();
+	test_transform();
+	test_tables();
+	test_parallel();
+
+	if (failures != 0) {
+		printf("%i checks failed\n", failures);
+		return 1;
+	}
+	printf("All checks passed\n");
 	return 0;
 }